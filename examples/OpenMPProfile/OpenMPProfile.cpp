@@ -0,0 +1,163 @@
+//===- OpenMPProfile.cpp --------------------------------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Reference collector for the region profiling hooks emitted by clang under
+// -fopenmp-instrument. It aggregates the wall time, the wait time and the loop
+// iteration counts of every instrumented region and prints a flat profile when
+// the program exits.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// \brief The constant descriptor of a region, emitted by the compiler.
+struct RegionDesc {
+  int32_t Id;
+  int32_t Kind;
+  const char *PSource;
+};
+
+/// \brief Region kinds, in the order of the KMP_INSTR_REGION_* constants.
+const char *const KindNames[] = {"parallel", "loop", "barrier", "critical",
+                                 "task"};
+enum { BarrierKind = 2, CriticalKind = 3 };
+
+typedef std::chrono::steady_clock Clock;
+
+/// \brief A region being executed by the current thread.
+struct Frame {
+  const RegionDesc *Desc;
+  Clock::time_point Begin;
+  Clock::time_point Acquired;
+  /// Time spent waiting in the regions nested in this one.
+  Clock::duration NestedWait;
+};
+
+/// \brief Measurements accumulated over all the executions of a region.
+struct RegionStats {
+  const RegionDesc *Desc;
+  uint64_t Count;
+  Clock::duration Wall;
+  Clock::duration Wait;
+  uint64_t Iterations;
+};
+
+class Profile {
+  std::mutex Lock;
+  /// Each region has a single descriptor in the module that contains it.
+  std::map<const RegionDesc *, RegionStats> Regions;
+
+public:
+  ~Profile() { print(); }
+
+  void record(const RegionDesc *Desc, Clock::duration Wall,
+              Clock::duration Wait, int64_t Iterations) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    RegionStats &Stats = Regions[Desc];
+    if (!Stats.Desc)
+      Stats.Desc = Desc;
+    ++Stats.Count;
+    Stats.Wall += Wall;
+    Stats.Wait += Wait;
+    Stats.Iterations += Iterations;
+  }
+
+  void print();
+};
+
+double toMillis(Clock::duration D) {
+  return std::chrono::duration<double, std::milli>(D).count();
+}
+
+void Profile::print() {
+  std::lock_guard<std::mutex> Guard(Lock);
+  if (Regions.empty())
+    return;
+  std::vector<const RegionStats *> Sorted;
+  for (const auto &R : Regions)
+    Sorted.push_back(&R.second);
+  std::sort(Sorted.begin(), Sorted.end(),
+            [](const RegionStats *L, const RegionStats *R) {
+              return L->Wall > R->Wall;
+            });
+
+  FILE *OS = stderr;
+  if (const char *Path = std::getenv("OMP_PROFILE_FILE"))
+    if (FILE *F = std::fopen(Path, "w"))
+      OS = F;
+  std::fprintf(OS, "%-10s %-8s %10s %12s %12s %12s  %s\n", "id", "kind",
+               "calls", "wall(ms)", "wait(ms)", "iterations", "location");
+  for (const RegionStats *S : Sorted) {
+    unsigned Kind = S->Desc->Kind;
+    std::fprintf(OS, "%-10u %-8s %10llu %12.3f %12.3f %12llu  %s\n",
+                 (unsigned)S->Desc->Id,
+                 Kind < sizeof(KindNames) / sizeof(KindNames[0])
+                     ? KindNames[Kind]
+                     : "unknown",
+                 (unsigned long long)S->Count, toMillis(S->Wall),
+                 toMillis(S->Wait), (unsigned long long)S->Iterations,
+                 S->Desc->PSource ? S->Desc->PSource : "");
+  }
+  if (OS != stderr)
+    std::fclose(OS);
+}
+
+Profile &getProfile() {
+  static Profile P;
+  return P;
+}
+
+/// \brief The regions entered and not yet left by the current thread.
+thread_local std::vector<Frame> Stack;
+
+} // end anonymous namespace
+
+extern "C" {
+
+void __kmpc_instr_region_begin(void *Desc, int32_t GTid) {
+  // Make sure the profile outlives the threads recording into it.
+  getProfile();
+  Clock::time_point Now = Clock::now();
+  Frame F = {static_cast<const RegionDesc *>(Desc), Now, Now,
+             Clock::duration::zero()};
+  Stack.push_back(F);
+}
+
+void __kmpc_instr_region_acquired(void *Desc, int32_t GTid) {
+  if (!Stack.empty() && Stack.back().Desc == Desc)
+    Stack.back().Acquired = Clock::now();
+}
+
+void __kmpc_instr_region_end(void *Desc, int32_t GTid, int64_t Iterations) {
+  if (Stack.empty() || Stack.back().Desc != Desc)
+    return;
+  Frame F = Stack.back();
+  Stack.pop_back();
+  Clock::duration Wall = Clock::now() - F.Begin;
+  // Barriers are all wait, critical regions wait for their lock.
+  Clock::duration Wait = F.NestedWait;
+  if (F.Desc->Kind == BarrierKind)
+    Wait = Wall;
+  else if (F.Desc->Kind == CriticalKind)
+    Wait += F.Acquired - F.Begin;
+  if (!Stack.empty())
+    Stack.back().NestedWait += Wait;
+  getProfile().record(F.Desc, Wall, Wait, Iterations);
+}
+
+} // extern "C"
@@ -2188,8 +2188,10 @@ enum CXCursorKind {
   */
   CXCursor_OMPTargetEnterDataDirective   = 272,
   CXCursor_OMPTargetExitDataDirective    = 273,
+  CXCursor_OMPTaskLoopDirective          = 274,
+  CXCursor_OMPTaskLoopSimdDirective      = 275,
 
-  CXCursor_LastStmt                      = CXCursor_OMPTargetExitDataDirective,
+  CXCursor_LastStmt                      = CXCursor_OMPTaskLoopSimdDirective,
 
   /**
    * \brief Cursor that represents the translation unit itself.
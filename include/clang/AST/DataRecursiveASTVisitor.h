@@ -2448,6 +2448,14 @@ DEF_TRAVERSE_STMT(OMPTaskDirective, {
   return TraverseOMPExecutableDirective(S);
 })
 
+DEF_TRAVERSE_STMT(OMPTaskLoopDirective, {
+  return TraverseOMPExecutableDirective(S);
+})
+
+DEF_TRAVERSE_STMT(OMPTaskLoopSimdDirective, {
+  return TraverseOMPExecutableDirective(S);
+})
+
 DEF_TRAVERSE_STMT(OMPTaskyieldDirective, {
   return TraverseOMPExecutableDirective(S);
 })
@@ -1089,6 +1089,33 @@ class OMPReductionClause : public OMPVarListClause<OMPReductionClause> {
                                              SourceLocation(), N),
         Operator(OMPC_REDUCTION_unknown), Spec(), OperatorName() {}
 
+protected:
+  /// \brief Build a 'task_reduction' or 'in_reduction' clause with number of
+  /// variables \a N and an operator \a Op.
+  ///
+  /// \param K Kind of the clause.
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  /// \param N Number of the variables in the clause.
+  /// \param Op reduction operator.
+  ///
+  OMPReductionClause(OpenMPClauseKind K, SourceLocation StartLoc,
+                     SourceLocation EndLoc, unsigned N,
+                     OpenMPReductionClauseOperator Op,
+                     NestedNameSpecifierLoc Spec, DeclarationNameInfo OpName)
+      : OMPVarListClause<OMPReductionClause>(K, StartLoc, EndLoc, N),
+        Operator(Op), Spec(Spec), OperatorName(OpName) {}
+
+  /// \brief Build an empty 'task_reduction' or 'in_reduction' clause.
+  ///
+  /// \param K Kind of the clause.
+  /// \param N Number of variables.
+  ///
+  OMPReductionClause(OpenMPClauseKind K, unsigned N)
+      : OMPVarListClause<OMPReductionClause>(K, SourceLocation(),
+                                             SourceLocation(), N),
+        Operator(OMPC_REDUCTION_unknown), Spec(), OperatorName() {}
+
   /// \brief Sets the list of generated expresssions.
   void setOpExprs(ArrayRef<Expr *> OpExprs);
   /// \brief Sets the list of 1st helper parameters.
@@ -1157,7 +1184,9 @@ public:
   DeclarationNameInfo getOpName() const { return OperatorName; }
 
   static bool classof(const OMPClause *T) {
-    return T->getClauseKind() == OMPC_reduction;
+    return T->getClauseKind() == OMPC_reduction ||
+           T->getClauseKind() == OMPC_task_reduction ||
+           T->getClauseKind() == OMPC_in_reduction;
   }
 
   /// \brief Return the list of all generated expressions.
@@ -1186,6 +1215,133 @@ public:
   }
 };
 
+/// \brief This represents clause 'task_reduction' in the '#pragma omp
+/// taskgroup' directive.
+///
+/// \code
+/// #pragma omp taskgroup task_reduction(+ : a,b)
+/// \endcode
+/// In this example directive '#pragma omp taskgroup' has clause
+/// 'task_reduction' with operator '+' and variables 'a' and 'b'.
+///
+class OMPTaskReductionClause : public OMPReductionClause {
+  friend class OMPClauseReader;
+  friend class OMPClauseWriter;
+
+  /// \brief Build clause with number of variables \a N and an operator \a Op.
+  ///
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  /// \param N Number of the variables in the clause.
+  /// \param Op reduction operator.
+  ///
+  OMPTaskReductionClause(SourceLocation StartLoc, SourceLocation EndLoc,
+                         unsigned N, OpenMPReductionClauseOperator Op,
+                         NestedNameSpecifierLoc Spec,
+                         DeclarationNameInfo OpName)
+      : OMPReductionClause(OMPC_task_reduction, StartLoc, EndLoc, N, Op, Spec,
+                           OpName) {}
+
+  /// \brief Build an empty clause.
+  ///
+  /// \param N Number of variables.
+  ///
+  explicit OMPTaskReductionClause(unsigned N)
+      : OMPReductionClause(OMPC_task_reduction, N) {}
+
+public:
+  /// \brief Creates clause with a list of variables \a VL and an operator
+  /// \a Op.
+  ///
+  /// \param C AST context.
+  /// \brief StartLoc Starting location of the clause.
+  /// \brief EndLoc Ending location of the clause.
+  /// \param VL List of references to the variables.
+  /// \param Op reduction operator.
+  /// \param S nested name specifier.
+  /// \param OpName Reduction identifier.
+  ///
+  static OMPTaskReductionClause *
+  Create(const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+         ArrayRef<Expr *> VL, ArrayRef<Expr *> OpExprs,
+         ArrayRef<Expr *> HelperParams1, ArrayRef<Expr *> HelperParams2,
+         ArrayRef<Expr *> DefaultInits, OpenMPReductionClauseOperator Op,
+         NestedNameSpecifierLoc S, DeclarationNameInfo OpName);
+  /// \brief Creates an empty clause with the place for \a N variables.
+  ///
+  /// \param C AST context.
+  /// \param N The number of variables.
+  ///
+  static OMPTaskReductionClause *CreateEmpty(const ASTContext &C, unsigned N);
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_task_reduction;
+  }
+};
+
+/// \brief This represents clause 'in_reduction' in the '#pragma omp task'
+/// directive.
+///
+/// \code
+/// #pragma omp task in_reduction(+ : a)
+/// \endcode
+/// In this example directive '#pragma omp task' has clause 'in_reduction'
+/// with operator '+' and variable 'a'.
+///
+class OMPInReductionClause : public OMPReductionClause {
+  friend class OMPClauseReader;
+  friend class OMPClauseWriter;
+
+  /// \brief Build clause with number of variables \a N and an operator \a Op.
+  ///
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  /// \param N Number of the variables in the clause.
+  /// \param Op reduction operator.
+  ///
+  OMPInReductionClause(SourceLocation StartLoc, SourceLocation EndLoc,
+                       unsigned N, OpenMPReductionClauseOperator Op,
+                       NestedNameSpecifierLoc Spec, DeclarationNameInfo OpName)
+      : OMPReductionClause(OMPC_in_reduction, StartLoc, EndLoc, N, Op, Spec,
+                           OpName) {}
+
+  /// \brief Build an empty clause.
+  ///
+  /// \param N Number of variables.
+  ///
+  explicit OMPInReductionClause(unsigned N)
+      : OMPReductionClause(OMPC_in_reduction, N) {}
+
+public:
+  /// \brief Creates clause with a list of variables \a VL and an operator
+  /// \a Op.
+  ///
+  /// \param C AST context.
+  /// \brief StartLoc Starting location of the clause.
+  /// \brief EndLoc Ending location of the clause.
+  /// \param VL List of references to the variables.
+  /// \param Op reduction operator.
+  /// \param S nested name specifier.
+  /// \param OpName Reduction identifier.
+  ///
+  static OMPInReductionClause *
+  Create(const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+         ArrayRef<Expr *> VL, ArrayRef<Expr *> OpExprs,
+         ArrayRef<Expr *> HelperParams1, ArrayRef<Expr *> HelperParams2,
+         ArrayRef<Expr *> DefaultInits, OpenMPReductionClauseOperator Op,
+         NestedNameSpecifierLoc S, DeclarationNameInfo OpName);
+  /// \brief Creates an empty clause with the place for \a N variables.
+  ///
+  /// \param C AST context.
+  /// \param N The number of variables.
+  ///
+  static OMPInReductionClause *CreateEmpty(const ASTContext &C, unsigned N);
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_in_reduction;
+  }
+};
+
 /// \brief This represents clause 'map' in the '#pragma omp ...'
 /// directives.
 ///
@@ -1588,6 +1744,10 @@ public:
 ///
 class OMPScheduleClause : public OMPClause {
   friend class OMPClauseReader;
+  /// \brief A modifier of the 'schedule' clause.
+  OpenMPScheduleClauseModifier Modifier;
+  /// \brief Start location of the modifier in source code.
+  SourceLocation ModifierLoc;
   /// \brief A kind of the 'schedule' clause.
   OpenMPScheduleClauseKind Kind;
   /// \brief Start location of the kind in cource code.
@@ -1595,6 +1755,16 @@ class OMPScheduleClause : public OMPClause {
   /// \brief Chunk size.
   Stmt *ChunkSize;
 
+  /// \brief Set modifier of the clause.
+  ///
+  /// \param M Modifier of the clause.
+  ///
+  void setScheduleModifier(OpenMPScheduleClauseModifier M) { Modifier = M; }
+  /// \brief Set modifier location.
+  ///
+  /// \param MLoc Modifier location.
+  ///
+  void setScheduleModifierLoc(SourceLocation MLoc) { ModifierLoc = MLoc; }
   /// \brief Set kind of the clauses.
   ///
   /// \param K Argument of clause.
@@ -1615,23 +1785,34 @@ public:
   /// \brief Build 'schedule' clause with argument \a Kind and
   /// an expression \a E.
   ///
+  /// \brief M Modifier of the clause.
+  /// \brief MLoc Starting location of the modifier.
   /// \brief K Argument of the clause.
   /// \brief KLoc Starting location of the argument.
   /// \brief E Chunk size.
   /// \brief StartLoc Starting location of the clause.
   /// \brief EndLoc Ending location of the clause.
   ///
-  OMPScheduleClause(OpenMPScheduleClauseKind K, SourceLocation KLoc, Expr *E,
+  OMPScheduleClause(OpenMPScheduleClauseModifier M, SourceLocation MLoc,
+                    OpenMPScheduleClauseKind K, SourceLocation KLoc, Expr *E,
                     SourceLocation StartLoc, SourceLocation EndLoc)
-      : OMPClause(OMPC_schedule, StartLoc, EndLoc), Kind(K), KindLoc(KLoc),
-        ChunkSize(E) {}
+      : OMPClause(OMPC_schedule, StartLoc, EndLoc), Modifier(M),
+        ModifierLoc(MLoc), Kind(K), KindLoc(KLoc), ChunkSize(E) {}
 
   /// \brief Build an empty clause.
   ///
   explicit OMPScheduleClause()
       : OMPClause(OMPC_schedule, SourceLocation(), SourceLocation()),
+        Modifier(OMPC_SCHEDULE_MODIFIER_unknown), ModifierLoc(SourceLocation()),
         Kind(OMPC_SCHEDULE_unknown), KindLoc(SourceLocation()), ChunkSize(0) {}
 
+  /// \brief Get modifier of the clause.
+  ///
+  OpenMPScheduleClauseModifier getScheduleModifier() const { return Modifier; }
+  /// \brief Get modifier location.
+  ///
+  SourceLocation getScheduleModifierLoc() { return ModifierLoc; }
+
   /// \brief Get kind of the clause.
   ///
   OpenMPScheduleClauseKind getScheduleKind() const { return Kind; }
@@ -1732,30 +1913,87 @@ public:
 /// directive.
 ///
 /// \code
-/// #pragma omp for ordered
+/// #pragma omp for ordered(2)
 /// \endcode
-/// In this example directive '#pragma omp for' has clause 'ordered'.
+/// In this example directive '#pragma omp for' has clause 'ordered' with
+/// the number of doacross loops '2'.
 ///
 class OMPOrderedClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Number of doacross loops (if any).
+  Stmt *NumForLoops;
+  /// \brief Number of loops described by the doacross iteration space.
+  unsigned NumLoops;
+  /// \brief Counters, lower bounds, upper bounds and steps of the doacross
+  /// loops.
+  Stmt **LoopData;
+  /// \brief Set the number of doacross loops.
+  ///
+  /// \param E Number of loops.
+  ///
+  void setNumForLoops(Expr *E) { NumForLoops = E; }
+
 public:
   /// \brief Build 'ordered' clause.
   ///
+  /// \param E Number of doacross loops (if any).
   /// \param StartLoc Starting location of the clause.
   /// \param EndLoc Ending location of the clause.
   ///
-  OMPOrderedClause(SourceLocation StartLoc, SourceLocation EndLoc)
-      : OMPClause(OMPC_ordered, StartLoc, EndLoc) {}
+  OMPOrderedClause(Expr *E, SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_ordered, StartLoc, EndLoc), NumForLoops(E),
+        NumLoops(0), LoopData(0) {}
 
   /// \brief Build an empty clause.
   ///
   explicit OMPOrderedClause()
-      : OMPClause(OMPC_ordered, SourceLocation(), SourceLocation()) {}
+      : OMPClause(OMPC_ordered, SourceLocation(), SourceLocation()),
+        NumForLoops(0), NumLoops(0), LoopData(0) {}
+
+  /// \brief Return number of doacross loops, or 0 for a plain 'ordered'.
+  ///
+  Expr *getNumForLoops() const { return dyn_cast_or_null<Expr>(NumForLoops); }
+
+  /// \brief Sets iteration space of the doacross loops.
+  ///
+  /// \param C AST context.
+  /// \param Counters Iteration variables of the loops.
+  /// \param Lowers Lower bounds of the loops.
+  /// \param Uppers Upper bounds of the loops.
+  /// \param Steps Steps of the loops.
+  ///
+  void setLoopData(const ASTContext &C, ArrayRef<Expr *> Counters,
+                   ArrayRef<Expr *> Lowers, ArrayRef<Expr *> Uppers,
+                   ArrayRef<Expr *> Steps);
+
+  /// \brief Return number of loops with known iteration space.
+  unsigned getNumLoops() const { return NumLoops; }
+  /// \brief Return iteration variable of the loop \a I.
+  Expr *getLoopCounter(unsigned I) const {
+    assert(I < NumLoops && "Wrong loop number!");
+    return cast_or_null<Expr>(LoopData[I]);
+  }
+  /// \brief Return lower bound of the loop \a I.
+  Expr *getLoopLowerBound(unsigned I) const {
+    assert(I < NumLoops && "Wrong loop number!");
+    return cast_or_null<Expr>(LoopData[NumLoops + I]);
+  }
+  /// \brief Return upper bound of the loop \a I.
+  Expr *getLoopUpperBound(unsigned I) const {
+    assert(I < NumLoops && "Wrong loop number!");
+    return cast_or_null<Expr>(LoopData[2 * NumLoops + I]);
+  }
+  /// \brief Return step of the loop \a I.
+  Expr *getLoopStep(unsigned I) const {
+    assert(I < NumLoops && "Wrong loop number!");
+    return cast_or_null<Expr>(LoopData[3 * NumLoops + I]);
+  }
 
   static bool classof(const OMPClause *T) {
     return T->getClauseKind() == OMPC_ordered;
   }
 
-  child_range children() { return child_range(child_iterator(), child_iterator()); }
+  child_range children() { return child_range(&NumForLoops, &NumForLoops + 1); }
 };
 
 /// \brief This represents 'nowait' clause in the '#pragma omp ...'
@@ -2461,6 +2699,337 @@ public:
   child_range children() { return child_range(&ThreadLimit, &ThreadLimit + 1); }
 };
 
+/// \brief This represents 'grainsize' clause in the '#pragma omp ...'
+/// directive.
+///
+/// \code
+/// #pragma omp taskloop grainsize(4)
+/// \endcode
+/// In this example directive '#pragma omp taskloop' has clause 'grainsize'
+/// with single expression '4'.
+///
+class OMPGrainsizeClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Grainsize.
+  Stmt *Grainsize;
+  /// \brief Set the grainsize.
+  ///
+  /// \param E Grainsize.
+  ///
+  void setGrainsize(Expr *E) { Grainsize = E; }
+
+public:
+  /// \brief Build 'grainsize' clause.
+  ///
+  /// \param E Expression associated with this clause.
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  ///
+  OMPGrainsizeClause(Expr *E, SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_grainsize, StartLoc, EndLoc), Grainsize(E) {}
+
+  /// \brief Build an empty clause.
+  ///
+  explicit OMPGrainsizeClause()
+      : OMPClause(OMPC_grainsize, SourceLocation(), SourceLocation()),
+        Grainsize(0) {}
+
+  /// \brief Return the grainsize.
+  ///
+  Expr *getGrainsize() const { return dyn_cast_or_null<Expr>(Grainsize); }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_grainsize;
+  }
+
+  child_range children() { return child_range(&Grainsize, &Grainsize + 1); }
+};
+
+/// \brief This represents 'num_tasks' clause in the '#pragma omp ...'
+/// directive.
+///
+/// \code
+/// #pragma omp taskloop num_tasks(4)
+/// \endcode
+/// In this example directive '#pragma omp taskloop' has clause 'num_tasks'
+/// with single expression '4'.
+///
+class OMPNumTasksClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Number of tasks.
+  Stmt *NumTasks;
+  /// \brief Set the number of tasks.
+  ///
+  /// \param E Number of tasks.
+  ///
+  void setNumTasks(Expr *E) { NumTasks = E; }
+
+public:
+  /// \brief Build 'num_tasks' clause.
+  ///
+  /// \param E Expression associated with this clause.
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  ///
+  OMPNumTasksClause(Expr *E, SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_num_tasks, StartLoc, EndLoc), NumTasks(E) {}
+
+  /// \brief Build an empty clause.
+  ///
+  explicit OMPNumTasksClause()
+      : OMPClause(OMPC_num_tasks, SourceLocation(), SourceLocation()),
+        NumTasks(0) {}
+
+  /// \brief Return the number of tasks.
+  ///
+  Expr *getNumTasks() const { return dyn_cast_or_null<Expr>(NumTasks); }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_num_tasks;
+  }
+
+  child_range children() { return child_range(&NumTasks, &NumTasks + 1); }
+};
+
+/// \brief This represents 'priority' clause in the '#pragma omp ...'
+/// directive.
+///
+/// \code
+/// #pragma omp task priority(n)
+/// \endcode
+/// In this example directive '#pragma omp task' has clause 'priority'
+/// with single expression 'n'.
+///
+class OMPPriorityClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Priority of the task.
+  Stmt *Priority;
+  /// \brief Set the priority.
+  ///
+  /// \param E Priority.
+  ///
+  void setPriority(Expr *E) { Priority = E; }
+
+public:
+  /// \brief Build 'priority' clause.
+  ///
+  /// \param E Expression associated with this clause.
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  ///
+  OMPPriorityClause(Expr *E, SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_priority, StartLoc, EndLoc), Priority(E) {}
+
+  /// \brief Build an empty clause.
+  ///
+  explicit OMPPriorityClause()
+      : OMPClause(OMPC_priority, SourceLocation(), SourceLocation()),
+        Priority(0) {}
+
+  /// \brief Return the priority.
+  ///
+  Expr *getPriority() const { return dyn_cast_or_null<Expr>(Priority); }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_priority;
+  }
+
+  child_range children() { return child_range(&Priority, &Priority + 1); }
+};
+
+/// \brief This represents 'hint' clause in the '#pragma omp ...' directive.
+///
+/// \code
+/// #pragma omp critical (name) hint(omp_lock_hint_speculative)
+/// \endcode
+/// In this example directive '#pragma omp critical' has clause 'hint'
+/// with single expression 'omp_lock_hint_speculative'.
+///
+class OMPHintClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Hint for the lock.
+  Stmt *Hint;
+  /// \brief Set the hint.
+  ///
+  /// \param E Hint.
+  ///
+  void setHint(Expr *E) { Hint = E; }
+
+public:
+  /// \brief Build 'hint' clause.
+  ///
+  /// \param E Expression associated with this clause.
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  ///
+  OMPHintClause(Expr *E, SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_hint, StartLoc, EndLoc), Hint(E) {}
+
+  /// \brief Build an empty clause.
+  ///
+  explicit OMPHintClause()
+      : OMPClause(OMPC_hint, SourceLocation(), SourceLocation()), Hint(0) {}
+
+  /// \brief Return the hint.
+  ///
+  Expr *getHint() const { return dyn_cast_or_null<Expr>(Hint); }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_hint;
+  }
+
+  child_range children() { return child_range(&Hint, &Hint + 1); }
+};
+
+/// \brief This represents clause 'is_device_ptr' in the '#pragma omp ...'
+/// directives.
+///
+/// \code
+/// #pragma omp target is_device_ptr(a,b)
+/// \endcode
+/// In this example directive '#pragma omp target' has clause 'is_device_ptr'
+/// with the variables 'a' and 'b'.
+///
+class OMPIsDevicePtrClause : public OMPVarListClause<OMPIsDevicePtrClause> {
+  /// \brief Build clause with number of variables \a N.
+  ///
+  /// \param StartLoc Starting location of the clause.
+  /// \param EndLoc Ending location of the clause.
+  /// \param N Number of the variables in the clause.
+  ///
+  OMPIsDevicePtrClause(SourceLocation StartLoc, SourceLocation EndLoc,
+                       unsigned N)
+      : OMPVarListClause<OMPIsDevicePtrClause>(OMPC_is_device_ptr, StartLoc,
+                                               EndLoc, N) {}
+
+  /// \brief Build an empty clause.
+  ///
+  /// \param N Number of variables.
+  ///
+  explicit OMPIsDevicePtrClause(unsigned N)
+      : OMPVarListClause<OMPIsDevicePtrClause>(
+            OMPC_is_device_ptr, SourceLocation(), SourceLocation(), N) {}
+
+public:
+  /// \brief Creates clause with a list of variables \a VL.
+  ///
+  /// \param C AST context.
+  /// \brief StartLoc Starting location of the clause.
+  /// \brief EndLoc Ending location of the clause.
+  /// \param VL List of references to the variables.
+  ///
+  static OMPIsDevicePtrClause *Create(const ASTContext &C,
+                                      SourceLocation StartLoc,
+                                      SourceLocation EndLoc,
+                                      ArrayRef<Expr *> VL);
+  /// \brief Creates an empty clause with the place for \a N variables.
+  ///
+  /// \param C AST context.
+  /// \param N The number of variables.
+  ///
+  static OMPIsDevicePtrClause *CreateEmpty(const ASTContext &C, unsigned N);
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_is_device_ptr;
+  }
+
+  child_range children() {
+    return child_range(reinterpret_cast<Stmt **>(varlist_begin()),
+                       reinterpret_cast<Stmt **>(varlist_end()));
+  }
+};
+
+/// \brief This represents 'defaultmap' clause in the '#pragma omp ...'
+/// directive.
+///
+/// \code
+/// #pragma omp target defaultmap(tofrom: scalar)
+/// \endcode
+/// In this example directive '#pragma omp target' has 'defaultmap'
+/// clause with modifier 'tofrom' and kind 'scalar'.
+///
+class OMPDefaultmapClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief A modifier of the 'defaultmap' clause.
+  OpenMPDefaultmapClauseModifier Modifier;
+  /// \brief Start location of the modifier in source code.
+  SourceLocation ModifierLoc;
+  /// \brief A kind of the 'defaultmap' clause.
+  OpenMPDefaultmapClauseKind Kind;
+  /// \brief Start location of the kind in source code.
+  SourceLocation KindLoc;
+
+  /// \brief Set modifier of the clause.
+  ///
+  /// \param M Modifier of the clause.
+  ///
+  void setDefaultmapModifier(OpenMPDefaultmapClauseModifier M) {
+    Modifier = M;
+  }
+  /// \brief Set modifier location.
+  ///
+  /// \param MLoc Modifier location.
+  ///
+  void setDefaultmapModifierLoc(SourceLocation MLoc) { ModifierLoc = MLoc; }
+  /// \brief Set kind of the clause.
+  ///
+  /// \param K Argument of clause.
+  ///
+  void setDefaultmapKind(OpenMPDefaultmapClauseKind K) { Kind = K; }
+  /// \brief Set kind location.
+  ///
+  /// \param KLoc Kind location.
+  ///
+  void setDefaultmapKindLoc(SourceLocation KLoc) { KindLoc = KLoc; }
+
+public:
+  /// \brief Build 'defaultmap' clause with modifier \a M and kind \a K.
+  ///
+  /// \brief M Modifier of the clause.
+  /// \brief MLoc Starting location of the modifier.
+  /// \brief K Argument of the clause.
+  /// \brief KLoc Starting location of the argument.
+  /// \brief StartLoc Starting location of the clause.
+  /// \brief EndLoc Ending location of the clause.
+  ///
+  OMPDefaultmapClause(OpenMPDefaultmapClauseModifier M, SourceLocation MLoc,
+                      OpenMPDefaultmapClauseKind K, SourceLocation KLoc,
+                      SourceLocation StartLoc, SourceLocation EndLoc)
+      : OMPClause(OMPC_defaultmap, StartLoc, EndLoc), Modifier(M),
+        ModifierLoc(MLoc), Kind(K), KindLoc(KLoc) {}
+
+  /// \brief Build an empty clause.
+  ///
+  explicit OMPDefaultmapClause()
+      : OMPClause(OMPC_defaultmap, SourceLocation(), SourceLocation()),
+        Modifier(OMPC_DEFAULTMAP_MODIFIER_unknown),
+        ModifierLoc(SourceLocation()), Kind(OMPC_DEFAULTMAP_unknown),
+        KindLoc(SourceLocation()) {}
+
+  /// \brief Get modifier of the clause.
+  ///
+  OpenMPDefaultmapClauseModifier getDefaultmapModifier() const {
+    return Modifier;
+  }
+  /// \brief Get modifier location.
+  ///
+  SourceLocation getDefaultmapModifierLoc() { return ModifierLoc; }
+  /// \brief Get kind of the clause.
+  ///
+  OpenMPDefaultmapClauseKind getDefaultmapKind() const { return Kind; }
+  /// \brief Get kind location.
+  ///
+  SourceLocation getDefaultmapKindLoc() { return KindLoc; }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_defaultmap;
+  }
+
+  child_range children() {
+    return child_range(child_iterator(), child_iterator());
+  }
+};
+
 /// \brief This represents clause 'linear' in the '#pragma omp ...'
 /// directives.
 ///
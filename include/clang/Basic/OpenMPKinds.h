@@ -94,6 +94,35 @@ enum OpenMPScheduleClauseKind {
   NUM_OPENMP_SCHEDULE_KINDS
 };
 
+/// \brief OpenMP modifiers for 'schedule' clause. They share the value space
+/// of the schedule kinds, so that the same lookup routines can parse both.
+enum OpenMPScheduleClauseModifier {
+  OMPC_SCHEDULE_MODIFIER_unknown = NUM_OPENMP_SCHEDULE_KINDS,
+#define OPENMP_SCHEDULE_MODIFIER(Name) \
+  OMPC_SCHEDULE_MODIFIER_##Name,
+#include "clang/Basic/OpenMPKinds.def"
+  OMPC_SCHEDULE_MODIFIER_last
+};
+
+/// \brief OpenMP attributes for 'defaultmap' clause.
+enum OpenMPDefaultmapClauseKind {
+  OMPC_DEFAULTMAP_unknown = 0,
+#define OPENMP_DEFAULTMAP_KIND(Name) \
+  OMPC_DEFAULTMAP_##Name,
+#include "clang/Basic/OpenMPKinds.def"
+  NUM_OPENMP_DEFAULTMAP_KINDS
+};
+
+/// \brief OpenMP modifiers for 'defaultmap' clause. They share the value
+/// space of the defaultmap kinds, as the schedule modifiers do.
+enum OpenMPDefaultmapClauseModifier {
+  OMPC_DEFAULTMAP_MODIFIER_unknown = NUM_OPENMP_DEFAULTMAP_KINDS,
+#define OPENMP_DEFAULTMAP_MODIFIER(Name) \
+  OMPC_DEFAULTMAP_MODIFIER_##Name,
+#include "clang/Basic/OpenMPKinds.def"
+  OMPC_DEFAULTMAP_MODIFIER_last
+};
+
 /// \brief OpenMP attributes for 'dist_schedule' clause.
 enum OpenMPDistScheduleClauseKind {
   OMPC_DIST_SCHEDULE_unknown = 0,
@@ -42,8 +42,10 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/PointerUnion.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/AlignOf.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/DataTypes.h"
@@ -134,12 +136,27 @@ namespace SrcMgr {
     /// file considered as a system one.
     unsigned IsSystemFile : 1;
 
+    /// \brief True if DirectiveStartCache has been computed.
+    unsigned DirectiveStartsComputed : 1;
+
+    /// \brief The number of offsets in DirectiveStartCache.
+    unsigned NumDirectiveStarts : 30;
+
+    /// \brief A bump pointer allocated array of the sorted offsets of the
+    /// lines that may start a preprocessor directive.
+    ///
+    /// This is lazily computed the first time a conditional block of the file
+    /// is skipped, and is null if the offsets cannot be determined. This is
+    /// owned by the SourceManager BumpPointerAllocator object.
+    unsigned *DirectiveStartCache;
+
     ContentCache(const FileEntry *Ent = nullptr) : ContentCache(Ent, Ent) {}
 
     ContentCache(const FileEntry *Ent, const FileEntry *contentEnt)
       : Buffer(nullptr, false), OrigEntry(Ent), ContentsEntry(contentEnt),
         SourceLineCache(nullptr), NumLines(0), BufferOverridden(false),
-        IsSystemFile(false) {}
+        IsSystemFile(false), DirectiveStartsComputed(false),
+        NumDirectiveStarts(0), DirectiveStartCache(nullptr) {}
     
     ~ContentCache();
     
@@ -148,12 +165,15 @@ namespace SrcMgr {
     /// is not transferred, so this is a logical error.
     ContentCache(const ContentCache &RHS)
       : Buffer(nullptr, false), SourceLineCache(nullptr),
-        BufferOverridden(false), IsSystemFile(false) {
+        BufferOverridden(false), IsSystemFile(false),
+        DirectiveStartsComputed(false), NumDirectiveStarts(0),
+        DirectiveStartCache(nullptr) {
       OrigEntry = RHS.OrigEntry;
       ContentsEntry = RHS.ContentsEntry;
 
       assert(RHS.Buffer.getPointer() == nullptr &&
              RHS.SourceLineCache == nullptr &&
+             RHS.DirectiveStartCache == nullptr &&
              "Passed ContentCache object cannot own a buffer.");
 
       NumLines = RHS.NumLines;
@@ -925,6 +945,18 @@ public:
   /// \param Invalid If non-NULL, will be set true if an error occurred.
   StringRef getBufferData(FileID FID, bool *Invalid = nullptr) const;
 
+  /// \brief Return the sorted offsets of the lines of the file \p FID that
+  /// may start a preprocessor directive.
+  ///
+  /// The offsets are computed by \p Scan over the buffer of the file the
+  /// first time they are requested, and cached with the contents of the file
+  /// afterwards. Returns None if \p FID is not a file or \p Scan could not
+  /// determine them.
+  Optional<ArrayRef<unsigned>> getDirectiveStarts(
+      FileID FID,
+      llvm::function_ref<bool(StringRef, SmallVectorImpl<unsigned> &)> Scan)
+      const;
+
   /// \brief Get the number of FileIDs (files and macros) that were created
   /// during preprocessing of \p FID, including it.
   unsigned getNumCreatedFIDsForFileID(FileID FID) const {
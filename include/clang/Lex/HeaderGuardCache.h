@@ -0,0 +1,151 @@
+//===--- HeaderGuardCache.h - Persistent header guard facts -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the HeaderGuardCache interface.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_HEADERGUARDCACHE_H
+#define LLVM_CLANG_LEX_HEADERGUARDCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/DataTypes.h"
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace llvm {
+  class MemoryBuffer;
+  template <typename Info> class OnDiskIterableChainedHashTable;
+}
+namespace clang {
+  class FileEntry;
+  class FileManager;
+
+/// \brief A cache, shared by compilations, of the headers known to be
+/// guarded by an include guard or by \#pragma once.
+///
+/// The multiple-include optimization only learns the controlling macro of a
+/// header once it has been lexed to the end, which every compilation has to
+/// do again.  This cache records what earlier compilations found, so that a
+/// header whose controlling macro is already defined can be skipped without
+/// being opened.
+///
+/// This only helps the first inclusion of a header in a translation unit, and
+/// only when its guard is defined before that inclusion, which is rare: later
+/// inclusions are already skipped using the controlling macro found while
+/// lexing the first one.  Skipped headers are reported through
+/// PPCallbacks::FileSkipped, so that dependency files still list them.
+///
+/// Entries are keyed by the absolute path, size and modification time of the
+/// header, so that a header that changed is never matched.  The modification
+/// time only has a resolution of one second, so a header rewritten with the
+/// same size within that second would still match; as git does for racily
+/// clean files, no entry is recorded for a header modified less than two
+/// seconds before the cache was loaded, which every header is read after.
+///
+/// The cache is stored as an on-disk hash table.  It is only rewritten when a
+/// compilation found something it does not hold yet, under a lock and merged
+/// with its current contents, so that compilations running at the same time
+/// do not drop each other's entries.
+class HeaderGuardCache {
+public:
+  /// \brief The key of an entry: which version of which file it describes.
+  struct Key {
+    StringRef Filename;
+    uint64_t Size;
+    uint64_t ModTime;
+  };
+
+  /// \brief What is known about a header.
+  struct Entry {
+    /// \brief True if the header contains \#pragma once.
+    bool IsPragmaOnce;
+
+    /// \brief The macro that guards the whole header, or empty if there is
+    /// none.
+    StringRef ControllingMacro;
+
+    Entry() : IsPragmaOnce(false) {}
+  };
+
+  class Trait;
+
+private:
+  HeaderGuardCache(const HeaderGuardCache &) = delete;
+  void operator=(const HeaderGuardCache &) = delete;
+
+  typedef llvm::OnDiskIterableChainedHashTable<Trait> TableTy;
+
+  /// \brief The path of the cache file.
+  std::string Path;
+
+  /// \brief The contents of the cache file when it was loaded, if it was
+  /// valid.
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+
+  /// \brief The table of entries of Buffer.
+  std::unique_ptr<TableTy> Table;
+
+  struct RecordedEntry {
+    uint64_t Size;
+    uint64_t ModTime;
+    bool IsPragmaOnce;
+    std::string ControllingMacro;
+  };
+
+  /// \brief The entries recorded by this compilation, by absolute path.
+  llvm::StringMap<RecordedEntry> Recorded;
+
+  /// \brief When the cache was loaded.
+  time_t LoadTime;
+
+  explicit HeaderGuardCache(StringRef Path);
+
+  /// \brief Compute the key of \p File, storing its path in \p Filename.
+  static Key getKey(const FileEntry *File, FileManager &FileMgr,
+                    SmallVectorImpl<char> &Filename);
+
+  /// \brief Whether \p OnDisk, if any, already holds every recorded entry.
+  bool isUpToDate(const TableTy *OnDisk) const;
+
+  /// \brief Merge the recorded entries into the cache file, once the lock on
+  /// it is held.
+  bool writeLocked();
+
+public:
+  ~HeaderGuardCache();
+
+  /// \brief Load the cache stored at \p Path.
+  ///
+  /// A missing or unreadable cache file is treated as an empty cache.
+  static std::unique_ptr<HeaderGuardCache> Create(StringRef Path);
+
+  /// \brief Look up what an earlier compilation recorded about \p File.
+  ///
+  /// \returns true if \p File has an entry, which is stored in \p Result.
+  bool lookup(const FileEntry *File, FileManager &FileMgr,
+              Entry &Result) const;
+
+  /// \brief Record what this compilation found about \p File, unless it was
+  /// modified too recently for its key to tell it from a later version.
+  void record(const FileEntry *File, FileManager &FileMgr,
+              const Entry &Info);
+
+  /// \brief Merge the recorded entries into the cache file, unless it holds
+  /// them already.
+  ///
+  /// \returns true if an error occurred.
+  bool write();
+};
+
+} // end namespace clang.
+
+#endif
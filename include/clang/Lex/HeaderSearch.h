@@ -30,6 +30,7 @@ class DiagnosticsEngine;
 class ExternalPreprocessorSource;
 class FileEntry;
 class FileManager;
+class HeaderGuardCache;
 class HeaderSearchOptions;
 class IdentifierInfo;
 class Preprocessor;
@@ -235,6 +236,10 @@ class HeaderSearch {
 
   /// \brief Entity used to look up stored header file information.
   ExternalHeaderFileInfoSource *ExternalSource;
+
+  /// \brief The include guards recorded by earlier compilations, loaded the
+  /// first time they are needed.
+  std::unique_ptr<HeaderGuardCache> GuardCache;
   
   // Various statistics we track for performance analysis.
   unsigned NumIncluded;
@@ -247,6 +252,10 @@ class HeaderSearch {
   HeaderSearch(const HeaderSearch&) = delete;
   void operator=(const HeaderSearch&) = delete;
 
+  /// \brief Retrieve the header guard cache, loading it if needed, or null
+  /// if it is not used.
+  HeaderGuardCache *getHeaderGuardCache();
+
   friend class DirectoryLookup;
   
 public:
@@ -411,6 +420,10 @@ public:
   bool ShouldEnterIncludeFile(Preprocessor &PP, const FileEntry *File,
                               bool isImport, Module *CorrespondingModule);
 
+  /// \brief Record the include guards and \#pragma once headers found by
+  /// this compilation in the header guard cache, if there is one.
+  void writeHeaderGuardCache(SourceManager &SourceMgr);
+
   /// \brief Return whether the specified file is a normal header,
   /// a system header, or a C++ friendly system header.
   SrcMgr::CharacteristicKind getFileDirFlavor(const FileEntry *File) {
@@ -93,6 +93,10 @@ public:
   /// \brief The directory used for a user build.
   std::string ModuleUserBuildPath;
 
+  /// \brief The file recording the include guards of headers across
+  /// compilations, if any.
+  std::string HeaderGuardCachePath;
+
   /// The module/pch container format.
   std::string ModuleFormat;
 
@@ -429,6 +429,21 @@ public:
                                                    const LangOptions &LangOpts,
                                                    unsigned MaxLines = 0);
 
+  /// \brief Compute the offsets of the lines of \p Buffer that may start a
+  /// preprocessor directive.
+  ///
+  /// This is a conservative scan of the whole buffer that skips comments and
+  /// string and character literals, so that a '#' inside them is never
+  /// reported. Every line whose first token may be the '#' of a directive
+  /// gets the offset of its first non-whitespace character in \p Offsets, in
+  /// increasing order.
+  ///
+  /// \returns false if the buffer uses a construct the scan does not model,
+  /// in which case \p Offsets must not be used.
+  static bool computeDirectiveStarts(StringRef Buffer,
+                                     const LangOptions &LangOpts,
+                                     SmallVectorImpl<unsigned> &Offsets);
+
   /// \brief Checks that the given token is the first token that occurs after
   /// the given location (this excludes comments and whitespace). Returns the
   /// location immediately after the specified token. If the token is not found
@@ -8023,6 +8023,19 @@ public:
   StmtResult ActOnOpenMPTaskDirective(ArrayRef<OMPClause *> Clauses,
                                       Stmt *AStmt, SourceLocation StartLoc,
                                       SourceLocation EndLoc);
+  /// \brief Called on well-formed '\#pragma omp taskloop' after parsing
+  /// of the  associated statement.
+  StmtResult ActOnOpenMPTaskLoopDirective(OpenMPDirectiveKind Kind,
+                                          ArrayRef<OMPClause *> Clauses,
+                                          Stmt *AStmt, SourceLocation StartLoc,
+                                          SourceLocation EndLoc);
+  /// \brief Called on well-formed '\#pragma omp taskloop simd' after parsing
+  /// of the  associated statement.
+  StmtResult ActOnOpenMPTaskLoopSimdDirective(OpenMPDirectiveKind Kind,
+                                              ArrayRef<OMPClause *> Clauses,
+                                              Stmt *AStmt,
+                                              SourceLocation StartLoc,
+                                              SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp taskyield' after parsing
   /// of the  associated statement.
   StmtResult ActOnOpenMPTaskyieldDirective(SourceLocation StartLoc,
@@ -8034,6 +8047,7 @@ public:
   /// \brief Called on well-formed '\#pragma omp critical' after parsing
   /// of the  associated statement.
   StmtResult ActOnOpenMPCriticalDirective(const DeclarationNameInfo &DirName,
+                                          ArrayRef<OMPClause *> Clauses,
                                           Stmt *AStmt, SourceLocation StartLoc,
                                           SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp barrier' after parsing
@@ -8046,7 +8060,8 @@ public:
                                           SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp taskgroup' after parsing
   /// of the  associated statement.
-  StmtResult ActOnOpenMPTaskgroupDirective(Stmt *AStmt, SourceLocation StartLoc,
+  StmtResult ActOnOpenMPTaskgroupDirective(ArrayRef<OMPClause *> Clauses,
+                                           Stmt *AStmt, SourceLocation StartLoc,
                                            SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp atomic' after parsing
   /// of the  associated statement.
@@ -8060,7 +8075,8 @@ public:
                                        SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp ordered' after parsing
   /// of the  associated statement.
-  StmtResult ActOnOpenMPOrderedDirective(Stmt *AStmt, SourceLocation StartLoc,
+  StmtResult ActOnOpenMPOrderedDirective(ArrayRef<OMPClause *> Clauses,
+                                         Stmt *AStmt, SourceLocation StartLoc,
                                          SourceLocation EndLoc);
   /// \brief Called on well-formed '\#pragma omp teams' after parsing
   /// of the  associated statement.
@@ -8216,19 +8232,24 @@ public:
   OMPClause *ActOnOpenMPCopyPrivateClause(ArrayRef<Expr *> VarList,
                                           SourceLocation StartLoc,
                                           SourceLocation EndLoc);
-  /// \brief Called on well-formed 'reduction' clause.
-  OMPClause *ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
-                                        SourceLocation StartLoc,
-                                        SourceLocation EndLoc,
-                                        OpenMPReductionClauseOperator Op,
-                                        CXXScopeSpec &SS,
-                                        DeclarationNameInfo OpName);
+  /// \brief Called on well-formed 'reduction', 'task_reduction' or
+  /// 'in_reduction' clause.
+  OMPClause *
+  ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList, SourceLocation StartLoc,
+                             SourceLocation EndLoc,
+                             OpenMPReductionClauseOperator Op, CXXScopeSpec &SS,
+                             DeclarationNameInfo OpName,
+                             OpenMPClauseKind CKind = OMPC_reduction);
   /// \brief Called on well-formed 'map' clause.
   OMPClause *ActOnOpenMPMapClause(ArrayRef<Expr *> VarList,
                                   SourceLocation StartLoc,
                                   SourceLocation EndLoc,
                                   OpenMPMapClauseKind Kind,
                                   SourceLocation KindLoc);
+  /// \brief Called on well-formed 'is_device_ptr' clause.
+  OMPClause *ActOnOpenMPIsDevicePtrClause(ArrayRef<Expr *> VarList,
+                                          SourceLocation StartLoc,
+                                          SourceLocation EndLoc);
   /// \brief Called on well-formed 'to' clause.
   OMPClause *ActOnOpenMPToClause(ArrayRef<Expr *> VarList,
                                  SourceLocation StartLoc,
@@ -8249,7 +8270,8 @@ public:
                                SourceLocation EndLoc);
   /// \brief Called on well-formed 'ordered' clause.
   OMPClause *ActOnOpenMPOrderedClause(SourceLocation StartLoc,
-                                      SourceLocation EndLoc);
+                                      SourceLocation EndLoc,
+                                      Expr *NumForLoops = 0);
   /// \brief Called on well-formed 'nowait' clause.
   OMPClause *ActOnOpenMPNowaitClause(SourceLocation StartLoc,
                                      SourceLocation EndLoc);
@@ -8299,6 +8321,19 @@ public:
   OMPClause *ActOnOpenMPThreadLimitClause(Expr *ThreadLimit,
                                           SourceLocation StartLoc,
                                           SourceLocation EndLoc);
+  /// \brief Called on well-formed 'grainsize' clause.
+  OMPClause *ActOnOpenMPGrainsizeClause(Expr *Grainsize,
+                                        SourceLocation StartLoc,
+                                        SourceLocation EndLoc);
+  /// \brief Called on well-formed 'num_tasks' clause.
+  OMPClause *ActOnOpenMPNumTasksClause(Expr *NumTasks, SourceLocation StartLoc,
+                                       SourceLocation EndLoc);
+  /// \brief Called on well-formed 'priority' clause.
+  OMPClause *ActOnOpenMPPriorityClause(Expr *Priority, SourceLocation StartLoc,
+                                       SourceLocation EndLoc);
+  /// \brief Called on well-formed 'hint' clause.
+  OMPClause *ActOnOpenMPHintClause(Expr *Hint, SourceLocation StartLoc,
+                                   SourceLocation EndLoc);
   /// \brief Called on well-formed 'linear' clause.
   OMPClause *ActOnOpenMPLinearClause(ArrayRef<Expr *> VarList,
                                      SourceLocation StartLoc,
@@ -8326,10 +8361,13 @@ public:
                                                  SourceLocation StartLoc,
                                                  SourceLocation EndLoc);
   OMPClause *ActOnOpenMPSingleExprWithTypeClause(
-      OpenMPClauseKind Kind, unsigned Argument, SourceLocation ArgumentLoc,
-      Expr *Expr, SourceLocation StartLoc, SourceLocation EndLoc);
+      OpenMPClauseKind Kind, unsigned Modifier, SourceLocation ModifierLoc,
+      unsigned Argument, SourceLocation ArgumentLoc, Expr *Expr,
+      SourceLocation StartLoc, SourceLocation EndLoc);
   /// \brief Called on well-formed 'schedule' clause.
-  OMPClause *ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Argument,
+  OMPClause *ActOnOpenMPScheduleClause(OpenMPScheduleClauseModifier Modifier,
+                                       SourceLocation ModifierLoc,
+                                       OpenMPScheduleClauseKind Argument,
                                        SourceLocation ArgumentLoc,
                                        Expr *ChunkSize, SourceLocation StartLoc,
                                        SourceLocation EndLoc);
@@ -8338,6 +8376,13 @@ public:
   ActOnOpenMPDistScheduleClause(OpenMPDistScheduleClauseKind Argument,
                                 SourceLocation ArgumentLoc, Expr *ChunkSize,
                                 SourceLocation StartLoc, SourceLocation EndLoc);
+  /// \brief Called on well-formed 'defaultmap' clause.
+  OMPClause *ActOnOpenMPDefaultmapClause(OpenMPDefaultmapClauseModifier Modifier,
+                                         SourceLocation ModifierLoc,
+                                         OpenMPDefaultmapClauseKind Argument,
+                                         SourceLocation ArgumentLoc,
+                                         SourceLocation StartLoc,
+                                         SourceLocation EndLoc);
 
   /// \brief Marks all decls as used in associated captured statement.
   void MarkOpenMPClauses(ArrayRef<OMPClause *> Clauses);
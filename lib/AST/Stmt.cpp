@@ -1295,6 +1295,64 @@ OMPReductionClause *OMPReductionClause::CreateEmpty(const ASTContext &C,
   return new (Mem) OMPReductionClause(N);
 }
 
+OMPTaskReductionClause *OMPTaskReductionClause::Create(
+    const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+    ArrayRef<Expr *> VL, ArrayRef<Expr *> OpExprs,
+    ArrayRef<Expr *> HelperParams1, ArrayRef<Expr *> HelperParams2,
+    ArrayRef<Expr *> DefaultInits, OpenMPReductionClauseOperator Op,
+    NestedNameSpecifierLoc S, DeclarationNameInfo OpName) {
+  assert(VL.size() == OpExprs.size() &&
+         "Number of expressions is not the same as number of variables!");
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPReductionClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         5 * sizeof(Expr *) * VL.size());
+  OMPTaskReductionClause *Clause = new (Mem)
+      OMPTaskReductionClause(StartLoc, EndLoc, VL.size(), Op, S, OpName);
+  Clause->setVars(VL);
+  Clause->setOpExprs(OpExprs);
+  Clause->setHelperParameters1st(HelperParams1);
+  Clause->setHelperParameters2nd(HelperParams2);
+  Clause->setDefaultInits(DefaultInits);
+  return Clause;
+}
+
+OMPTaskReductionClause *OMPTaskReductionClause::CreateEmpty(const ASTContext &C,
+                                                            unsigned N) {
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPReductionClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         5 * sizeof(Expr *) * N);
+  return new (Mem) OMPTaskReductionClause(N);
+}
+
+OMPInReductionClause *OMPInReductionClause::Create(
+    const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+    ArrayRef<Expr *> VL, ArrayRef<Expr *> OpExprs,
+    ArrayRef<Expr *> HelperParams1, ArrayRef<Expr *> HelperParams2,
+    ArrayRef<Expr *> DefaultInits, OpenMPReductionClauseOperator Op,
+    NestedNameSpecifierLoc S, DeclarationNameInfo OpName) {
+  assert(VL.size() == OpExprs.size() &&
+         "Number of expressions is not the same as number of variables!");
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPReductionClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         5 * sizeof(Expr *) * VL.size());
+  OMPInReductionClause *Clause = new (Mem)
+      OMPInReductionClause(StartLoc, EndLoc, VL.size(), Op, S, OpName);
+  Clause->setVars(VL);
+  Clause->setOpExprs(OpExprs);
+  Clause->setHelperParameters1st(HelperParams1);
+  Clause->setHelperParameters2nd(HelperParams2);
+  Clause->setDefaultInits(DefaultInits);
+  return Clause;
+}
+
+OMPInReductionClause *OMPInReductionClause::CreateEmpty(const ASTContext &C,
+                                                        unsigned N) {
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPReductionClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         5 * sizeof(Expr *) * N);
+  return new (Mem) OMPInReductionClause(N);
+}
+
 void OMPReductionClause::setOpExprs(ArrayRef<Expr *> OpExprs) {
   assert(OpExprs.size() == numberOfVariables() &&
          "Number of expressions is not the same as the number of variables.");
@@ -1497,6 +1555,27 @@ OMPFromClause *OMPFromClause::CreateEmpty(const ASTContext &C, unsigned N) {
   return new (Mem) OMPFromClause(N);
 }
 
+OMPIsDevicePtrClause *OMPIsDevicePtrClause::Create(const ASTContext &C,
+                                                   SourceLocation StartLoc,
+                                                   SourceLocation EndLoc,
+                                                   ArrayRef<Expr *> VL) {
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPIsDevicePtrClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         sizeof(Expr *) * VL.size());
+  OMPIsDevicePtrClause *Clause =
+      new (Mem) OMPIsDevicePtrClause(StartLoc, EndLoc, VL.size());
+  Clause->setVars(VL);
+  return Clause;
+}
+
+OMPIsDevicePtrClause *OMPIsDevicePtrClause::CreateEmpty(const ASTContext &C,
+                                                        unsigned N) {
+  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPIsDevicePtrClause),
+                                                  llvm::alignOf<Expr *>()) +
+                         sizeof(Expr *) * N);
+  return new (Mem) OMPIsDevicePtrClause(N);
+}
+
 OMPFlushClause *OMPFlushClause::Create(const ASTContext &C,
                                        SourceLocation StartLoc,
                                        SourceLocation EndLoc,
@@ -1517,6 +1596,22 @@ OMPFlushClause *OMPFlushClause::CreateEmpty(const ASTContext &C, unsigned N) {
   return new (Mem) OMPFlushClause(N);
 }
 
+void OMPOrderedClause::setLoopData(const ASTContext &C,
+                                   ArrayRef<Expr *> Counters,
+                                   ArrayRef<Expr *> Lowers,
+                                   ArrayRef<Expr *> Uppers,
+                                   ArrayRef<Expr *> Steps) {
+  assert(Counters.size() == Lowers.size() && Lowers.size() == Uppers.size() &&
+         Lowers.size() == Steps.size() &&
+         "Number of counters, bounds and steps must be the same");
+  NumLoops = Lowers.size();
+  LoopData = new (C) Stmt *[4 * NumLoops];
+  std::copy(Counters.begin(), Counters.end(), LoopData);
+  std::copy(Lowers.begin(), Lowers.end(), LoopData + NumLoops);
+  std::copy(Uppers.begin(), Uppers.end(), LoopData + 2 * NumLoops);
+  std::copy(Steps.begin(), Steps.end(), LoopData + 3 * NumLoops);
+}
+
 OMPDependClause *
 OMPDependClause::Create(const ASTContext &C, SourceLocation StartLoc,
                         SourceLocation EndLoc, ArrayRef<Expr *> VL,
@@ -2214,6 +2309,76 @@ OMPTaskDirective *OMPTaskDirective::CreateEmpty(const ASTContext &C, unsigned N,
   return new (Mem) OMPTaskDirective(N);
 }
 
+OMPTaskLoopDirective *OMPTaskLoopDirective::Create(
+    const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+    ArrayRef<OMPClause *> Clauses, Stmt *AssociatedStmt, Expr *NewIterVar,
+    Expr *NewIterEnd, Expr *Init, Expr *Final, Expr *LowerBound,
+    Expr *UpperBound, ArrayRef<Expr *> VarCnts) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskLoopDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *) * 7 +
+                 sizeof(Stmt *) * VarCnts.size());
+  OMPTaskLoopDirective *Dir = new (Mem)
+      OMPTaskLoopDirective(StartLoc, EndLoc, VarCnts.size(), Clauses.size());
+  Dir->setClauses(Clauses);
+  Dir->setAssociatedStmt(AssociatedStmt);
+  Dir->setNewIterVar(NewIterVar);
+  Dir->setNewIterEnd(NewIterEnd);
+  Dir->setInit(Init);
+  Dir->setFinal(Final);
+  Dir->setLowerBound(LowerBound);
+  Dir->setUpperBound(UpperBound);
+  Dir->setCounters(VarCnts);
+  return Dir;
+}
+
+OMPTaskLoopDirective *
+OMPTaskLoopDirective::CreateEmpty(const ASTContext &C, unsigned N,
+                                  unsigned CollapsedNum, EmptyShell) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskLoopDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * N + sizeof(Stmt *) * 7 +
+                 sizeof(Stmt *) * CollapsedNum);
+  return new (Mem) OMPTaskLoopDirective(CollapsedNum, N);
+}
+
+OMPTaskLoopSimdDirective *OMPTaskLoopSimdDirective::Create(
+    const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+    ArrayRef<OMPClause *> Clauses, Stmt *AssociatedStmt, Expr *NewIterVar,
+    Expr *NewIterEnd, Expr *Init, Expr *Final, Expr *LowerBound,
+    Expr *UpperBound, ArrayRef<Expr *> VarCnts) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskLoopSimdDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *) * 7 +
+                 sizeof(Stmt *) * VarCnts.size());
+  OMPTaskLoopSimdDirective *Dir = new (Mem) OMPTaskLoopSimdDirective(
+      StartLoc, EndLoc, VarCnts.size(), Clauses.size());
+  Dir->setClauses(Clauses);
+  Dir->setAssociatedStmt(AssociatedStmt);
+  Dir->setNewIterVar(NewIterVar);
+  Dir->setNewIterEnd(NewIterEnd);
+  Dir->setInit(Init);
+  Dir->setFinal(Final);
+  Dir->setLowerBound(LowerBound);
+  Dir->setUpperBound(UpperBound);
+  Dir->setCounters(VarCnts);
+  return Dir;
+}
+
+OMPTaskLoopSimdDirective *
+OMPTaskLoopSimdDirective::CreateEmpty(const ASTContext &C, unsigned N,
+                                      unsigned CollapsedNum, EmptyShell) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskLoopSimdDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * N + sizeof(Stmt *) * 7 +
+                 sizeof(Stmt *) * CollapsedNum);
+  return new (Mem) OMPTaskLoopSimdDirective(CollapsedNum, N);
+}
+
 OMPTaskyieldDirective *OMPTaskyieldDirective::Create(const ASTContext &C,
                                                      SourceLocation StartLoc,
                                                      SourceLocation EndLoc) {
@@ -2250,27 +2415,30 @@ OMPMasterDirective *OMPMasterDirective::CreateEmpty(const ASTContext &C,
   return new (Mem) OMPMasterDirective();
 }
 
-OMPCriticalDirective *OMPCriticalDirective::Create(const ASTContext &C,
-                                                   DeclarationNameInfo Name,
-                                                   SourceLocation StartLoc,
-                                                   SourceLocation EndLoc,
-                                                   Stmt *AssociatedStmt) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPCriticalDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
+OMPCriticalDirective *OMPCriticalDirective::Create(
+    const ASTContext &C, DeclarationNameInfo Name, SourceLocation StartLoc,
+    SourceLocation EndLoc, ArrayRef<OMPClause *> Clauses,
+    Stmt *AssociatedStmt) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPCriticalDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPCriticalDirective *Dir =
-      new (Mem) OMPCriticalDirective(Name, StartLoc, EndLoc);
+      new (Mem) OMPCriticalDirective(Name, StartLoc, EndLoc, Clauses.size());
+  Dir->setClauses(Clauses);
   Dir->setAssociatedStmt(AssociatedStmt);
   Dir->setDirectiveName(Name);
   return Dir;
 }
 
 OMPCriticalDirective *OMPCriticalDirective::CreateEmpty(const ASTContext &C,
+                                                        unsigned N,
                                                         EmptyShell) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPCriticalDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
-  return new (Mem) OMPCriticalDirective();
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPCriticalDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * N + sizeof(Stmt *));
+  return new (Mem) OMPCriticalDirective(N);
 }
 
 OMPBarrierDirective *OMPBarrierDirective::Create(const ASTContext &C,
@@ -2303,25 +2471,28 @@ OMPTaskwaitDirective *OMPTaskwaitDirective::CreateEmpty(const ASTContext &C,
   return new (Mem) OMPTaskwaitDirective();
 }
 
-OMPTaskgroupDirective *OMPTaskgroupDirective::Create(const ASTContext &C,
-                                                     SourceLocation StartLoc,
-                                                     SourceLocation EndLoc,
-                                                     Stmt *AssociatedStmt) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskgroupDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
+OMPTaskgroupDirective *OMPTaskgroupDirective::Create(
+    const ASTContext &C, SourceLocation StartLoc, SourceLocation EndLoc,
+    ArrayRef<OMPClause *> Clauses, Stmt *AssociatedStmt) {
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskgroupDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *));
   OMPTaskgroupDirective *Dir =
-      new (Mem) OMPTaskgroupDirective(StartLoc, EndLoc);
+      new (Mem) OMPTaskgroupDirective(StartLoc, EndLoc, Clauses.size());
+  Dir->setClauses(Clauses);
   Dir->setAssociatedStmt(AssociatedStmt);
   return Dir;
 }
 
 OMPTaskgroupDirective *OMPTaskgroupDirective::CreateEmpty(const ASTContext &C,
+                                                          unsigned N,
                                                           EmptyShell) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskgroupDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
-  return new (Mem) OMPTaskgroupDirective();
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPTaskgroupDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * N + sizeof(Stmt *));
+  return new (Mem) OMPTaskgroupDirective(N);
 }
 
 OMPAtomicDirective *OMPAtomicDirective::Create(
@@ -2380,21 +2551,30 @@ OMPFlushDirective *OMPFlushDirective::CreateEmpty(const ASTContext &C,
 OMPOrderedDirective *OMPOrderedDirective::Create(const ASTContext &C,
                                                  SourceLocation StartLoc,
                                                  SourceLocation EndLoc,
+                                                 ArrayRef<OMPClause *> Clauses,
                                                  Stmt *AssociatedStmt) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPOrderedDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
-  OMPOrderedDirective *Dir = new (Mem) OMPOrderedDirective(StartLoc, EndLoc);
-  Dir->setAssociatedStmt(AssociatedStmt);
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPOrderedDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * Clauses.size() +
+                 (AssociatedStmt ? sizeof(Stmt *) : 0));
+  OMPOrderedDirective *Dir = new (Mem)
+      OMPOrderedDirective(StartLoc, EndLoc, Clauses.size(), AssociatedStmt != 0);
+  Dir->setClauses(Clauses);
+  if (AssociatedStmt)
+    Dir->setAssociatedStmt(AssociatedStmt);
   return Dir;
 }
 
 OMPOrderedDirective *OMPOrderedDirective::CreateEmpty(const ASTContext &C,
+                                                      unsigned N,
+                                                      bool HasAStmt,
                                                       EmptyShell) {
-  void *Mem = C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPOrderedDirective),
-                                                  llvm::alignOf<Stmt *>()) +
-                         sizeof(Stmt *));
-  return new (Mem) OMPOrderedDirective();
+  void *Mem =
+      C.Allocate(llvm::RoundUpToAlignment(sizeof(OMPOrderedDirective),
+                                          llvm::alignOf<OMPClause *>()) +
+                 sizeof(OMPClause *) * N + (HasAStmt ? sizeof(Stmt *) : 0));
+  return new (Mem) OMPOrderedDirective(N, HasAStmt);
 }
 
 OMPTeamsDirective *OMPTeamsDirective::Create(const ASTContext &C,
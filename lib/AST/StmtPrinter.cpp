@@ -710,7 +710,7 @@ void OMPClausePrinter::VisitOMPCopyPrivateClause(OMPCopyPrivateClause *Node) {
 
 void OMPClausePrinter::VisitOMPReductionClause(OMPReductionClause *Node) {
   if (!Node->varlist_empty()) {
-    OS << "reduction(";
+    OS << getOpenMPClauseName(Node->getClauseKind()) << "(";
     if (Node->getOperator() == OMPC_REDUCTION_custom) {
       if (NestedNameSpecifier *Qual = Node->getSpec().getNestedNameSpecifier())
         Qual->print(OS, Policy);
@@ -730,6 +730,15 @@ void OMPClausePrinter::VisitOMPReductionClause(OMPReductionClause *Node) {
   }
 }
 
+void
+OMPClausePrinter::VisitOMPTaskReductionClause(OMPTaskReductionClause *Node) {
+  VisitOMPReductionClause(Node);
+}
+
+void OMPClausePrinter::VisitOMPInReductionClause(OMPInReductionClause *Node) {
+  VisitOMPReductionClause(Node);
+}
+
 void OMPClausePrinter::VisitOMPLastPrivateClause(OMPLastPrivateClause *Node) {
   if (!Node->varlist_empty()) {
     OS << "lastprivate";
@@ -786,8 +795,12 @@ void OMPClausePrinter::VisitOMPFromClause(OMPFromClause *Node) {
 }
 
 void OMPClausePrinter::VisitOMPScheduleClause(OMPScheduleClause *Node) {
-  OS << "schedule("
-     << getOpenMPSimpleClauseTypeName(OMPC_schedule, Node->getScheduleKind());
+  OS << "schedule(";
+  if (Node->getScheduleModifier() != OMPC_SCHEDULE_MODIFIER_unknown)
+    OS << getOpenMPSimpleClauseTypeName(OMPC_schedule,
+                                        Node->getScheduleModifier())
+       << ": ";
+  OS << getOpenMPSimpleClauseTypeName(OMPC_schedule, Node->getScheduleKind());
   if (Node->getChunkSize()) {
     OS << ", ";
     Node->getChunkSize()->printPretty(OS, 0, Policy, 0);
@@ -808,6 +821,11 @@ void OMPClausePrinter::VisitOMPDistScheduleClause(OMPDistScheduleClause *Node) {
 
 void OMPClausePrinter::VisitOMPOrderedClause(OMPOrderedClause *Node) {
   OS << "ordered";
+  if (Node->getNumForLoops()) {
+    OS << "(";
+    Node->getNumForLoops()->printPretty(OS, 0, Policy, 0);
+    OS << ")";
+  }
 }
 
 void OMPClausePrinter::VisitOMPNowaitClause(OMPNowaitClause *Node) {
@@ -861,6 +879,10 @@ void OMPClausePrinter::VisitOMPFlushClause(OMPFlushClause *Node) {
 }
 
 void OMPClausePrinter::VisitOMPDependClause(OMPDependClause *Node) {
+  if (Node->getType() == OMPC_DEPEND_source) {
+    OS << "depend(source)";
+    return;
+  }
   if (!Node->varlist_empty()) {
     OS << "depend(";
     OS << getOpenMPSimpleClauseTypeName(OMPC_depend, Node->getType());
@@ -914,6 +936,53 @@ void OMPClausePrinter::VisitOMPThreadLimitClause(OMPThreadLimitClause *Node) {
   OS << ")";
 }
 
+void OMPClausePrinter::VisitOMPGrainsizeClause(OMPGrainsizeClause *Node) {
+  OS << "grainsize(";
+  Node->getGrainsize()->printPretty(OS, 0, Policy, 0);
+  OS << ")";
+}
+
+void OMPClausePrinter::VisitOMPNumTasksClause(OMPNumTasksClause *Node) {
+  OS << "num_tasks(";
+  Node->getNumTasks()->printPretty(OS, 0, Policy, 0);
+  OS << ")";
+}
+
+void OMPClausePrinter::VisitOMPPriorityClause(OMPPriorityClause *Node) {
+  OS << "priority(";
+  Node->getPriority()->printPretty(OS, 0, Policy, 0);
+  OS << ")";
+}
+
+void OMPClausePrinter::VisitOMPHintClause(OMPHintClause *Node) {
+  OS << "hint(";
+  Node->getHint()->printPretty(OS, 0, Policy, 0);
+  OS << ")";
+}
+
+void OMPClausePrinter::VisitOMPIsDevicePtrClause(OMPIsDevicePtrClause *Node) {
+  if (!Node->varlist_empty()) {
+    OS << "is_device_ptr";
+    for (OMPIsDevicePtrClause::varlist_iterator I = Node->varlist_begin(),
+                                                E = Node->varlist_end();
+         I != E; ++I) {
+      OS << (I == Node->varlist_begin() ? '(' : ',')
+         << *cast<NamedDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    }
+    OS << ")";
+  }
+}
+
+void OMPClausePrinter::VisitOMPDefaultmapClause(OMPDefaultmapClause *Node) {
+  OS << "defaultmap("
+     << getOpenMPSimpleClauseTypeName(OMPC_defaultmap,
+                                      Node->getDefaultmapModifier())
+     << ": "
+     << getOpenMPSimpleClauseTypeName(OMPC_defaultmap,
+                                      Node->getDefaultmapKind())
+     << ")";
+}
+
 void OMPClausePrinter::VisitOMPLinearClause(OMPLinearClause *Node) {
   if (!Node->varlist_empty()) {
     OS << "linear";
@@ -1026,6 +1095,17 @@ void StmtPrinter::VisitOMPTaskDirective(OMPTaskDirective *Node) {
   VisitOMPExecutableDirective(Node);
 }
 
+void StmtPrinter::VisitOMPTaskLoopDirective(OMPTaskLoopDirective *Node) {
+  Indent() << "#pragma omp taskloop ";
+  VisitOMPExecutableDirective(Node);
+}
+
+void
+StmtPrinter::VisitOMPTaskLoopSimdDirective(OMPTaskLoopSimdDirective *Node) {
+  Indent() << "#pragma omp taskloop simd ";
+  VisitOMPExecutableDirective(Node);
+}
+
 void StmtPrinter::VisitOMPTaskyieldDirective(OMPTaskyieldDirective *Node) {
   Indent() << "#pragma omp taskyield";
   VisitOMPExecutableDirective(Node);
@@ -1043,6 +1123,8 @@ void StmtPrinter::VisitOMPCriticalDirective(OMPCriticalDirective *Node) {
     Node->getDirectiveName().printName(OS);
     OS << ")";
   }
+  if (Node->getNumClauses() > 0)
+    OS << " ";
   VisitOMPExecutableDirective(Node);
 }
 
@@ -1057,7 +1139,7 @@ void StmtPrinter::VisitOMPTaskwaitDirective(OMPTaskwaitDirective *Node) {
 }
 
 void StmtPrinter::VisitOMPTaskgroupDirective(OMPTaskgroupDirective *Node) {
-  Indent() << "#pragma omp taskgroup";
+  Indent() << "#pragma omp taskgroup ";
   VisitOMPExecutableDirective(Node);
 }
 
@@ -1073,6 +1155,8 @@ void StmtPrinter::VisitOMPFlushDirective(OMPFlushDirective *Node) {
 
 void StmtPrinter::VisitOMPOrderedDirective(OMPOrderedDirective *Node) {
   Indent() << "#pragma omp ordered";
+  if (Node->getNumClauses() > 0)
+    OS << ' ';
   VisitOMPExecutableDirective(Node);
 }
 
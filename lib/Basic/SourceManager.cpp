@@ -79,6 +79,11 @@ void ContentCache::replaceBuffer(llvm::MemoryBuffer *B, bool DoNotFree) {
     delete Buffer.getPointer();
   Buffer.setPointer(B);
   Buffer.setInt(DoNotFree? DoNotFreeFlag : 0);
+
+  // The directive starts were computed for the old contents.
+  DirectiveStartsComputed = false;
+  NumDirectiveStarts = 0;
+  DirectiveStartCache = nullptr;
 }
 
 llvm::MemoryBuffer *ContentCache::getBuffer(DiagnosticsEngine &Diag,
@@ -705,6 +710,44 @@ StringRef SourceManager::getBufferData(FileID FID, bool *Invalid) const {
   return Buf->getBuffer();
 }
 
+Optional<ArrayRef<unsigned>> SourceManager::getDirectiveStarts(
+    FileID FID,
+    llvm::function_ref<bool(StringRef, SmallVectorImpl<unsigned> &)> Scan)
+    const {
+  bool MyInvalid = false;
+  const SLocEntry &SLoc = getSLocEntry(FID, &MyInvalid);
+  if (!SLoc.isFile() || MyInvalid)
+    return None;
+
+  ContentCache *Content =
+      const_cast<ContentCache *>(SLoc.getFile().getContentCache());
+  if (!Content->DirectiveStartsComputed) {
+    Content->DirectiveStartsComputed = true;
+
+    llvm::MemoryBuffer *Buf =
+        Content->getBuffer(Diag, *this, SourceLocation(), &MyInvalid);
+    if (MyInvalid)
+      return None;
+
+    SmallVector<unsigned, 256> Offsets;
+    if (!Scan(Buf->getBuffer(), Offsets))
+      return None;
+
+    // Always allocate storage so that a file without directives can be told
+    // apart from one that could not be scanned.
+    unsigned *Cache = ContentCacheAlloc.Allocate<unsigned>(
+        std::max<size_t>(Offsets.size(), 1));
+    std::copy(Offsets.begin(), Offsets.end(), Cache);
+    Content->DirectiveStartCache = Cache;
+    Content->NumDirectiveStarts = Offsets.size();
+  }
+
+  if (!Content->DirectiveStartCache)
+    return None;
+  return llvm::makeArrayRef(Content->DirectiveStartCache,
+                            Content->NumDirectiveStarts);
+}
+
 //===----------------------------------------------------------------------===//
 // SourceLocation manipulation methods.
 //===----------------------------------------------------------------------===//
@@ -20,6 +20,7 @@
 #include "llvm/Bitcode/BitcodeWriterPass.h"
 #include "llvm/CodeGen/RegAllocRegistry.h"
 #include "llvm/CodeGen/SchedulerRegistry.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/IRPrintingPasses.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -237,7 +238,8 @@ static void addDataFlowSanitizerPass(const PassManagerBuilder &Builder,
 }
 
 static TargetLibraryInfoImpl *createTLII(llvm::Triple &TargetTriple,
-                                         const CodeGenOptions &CodeGenOpts) {
+                                         const CodeGenOptions &CodeGenOpts,
+                                         const Module &M) {
   TargetLibraryInfoImpl *TLII = new TargetLibraryInfoImpl(TargetTriple);
   if (!CodeGenOpts.SimplifyLibCalls)
     TLII->disableAllFunctions();
@@ -249,6 +251,24 @@ static TargetLibraryInfoImpl *createTLII(llvm::Triple &TargetTriple,
   default:
     break;
   }
+
+  // Let the loop vectorizer call the vector variants of 'omp declare simd'
+  // functions, as it does for the vector libraries.  The names are kept by
+  // the MDStrings of the module, which outlive the TLI.
+  if (const NamedMDNode *Dispatch = M.getNamedMetadata("omp.simd.dispatch")) {
+    std::vector<VecDesc> Descs;
+    for (unsigned I = 0, E = Dispatch->getNumOperands(); I != E; ++I) {
+      const MDNode *N = Dispatch->getOperand(I);
+      VecDesc D = {
+        cast<MDString>(N->getOperand(0))->getString().data(),
+        cast<MDString>(N->getOperand(1))->getString().data(),
+        unsigned(mdconst::extract<ConstantInt>(N->getOperand(2))
+                     ->getZExtValue())
+      };
+      Descs.push_back(D);
+    }
+    TLII->addVectorizableFunctions(Descs);
+  }
   return TLII;
 }
 
@@ -356,7 +376,7 @@ void EmitAssemblyHelper::CreatePasses() {
 
   // Figure out TargetLibraryInfo.
   Triple TargetTriple(TheModule->getTargetTriple());
-  PMBuilder.LibraryInfo = createTLII(TargetTriple, CodeGenOpts);
+  PMBuilder.LibraryInfo = createTLII(TargetTriple, CodeGenOpts, *TheModule);
 
   switch (Inlining) {
   case CodeGenOptions::NoInlining: break;
@@ -559,7 +579,7 @@ bool EmitAssemblyHelper::AddEmitPasses(BackendAction Action,
   // Add LibraryInfo.
   llvm::Triple TargetTriple(TheModule->getTargetTriple());
   std::unique_ptr<TargetLibraryInfoImpl> TLII(
-      createTLII(TargetTriple, CodeGenOpts));
+      createTLII(TargetTriple, CodeGenOpts, *TheModule));
   PM->add(new TargetLibraryInfoWrapperPass(*TLII));
 
   // Normal mode, emit a .s or .o file by running the code generator. Note,
@@ -37,6 +37,10 @@ using namespace CodeGen;
 #define OPENMPRTL_FUNC(name) OpenMPRuntime->Get_##name()
 
 void CodeGenModule::EmitOMPThreadPrivate(const VarDecl *VD, const Expr *TPE) {
+  if (OpenMPRuntime->isThreadPrivateTLS(VD)) {
+    EmitOMPThreadPrivateTLS(VD);
+    return;
+  }
   // Create cache memory for threadprivate variable void **Var.cache;
   std::string VarCache = getMangledName(VD).str() + ".cache.";
   llvm::GlobalVariable *GV;
@@ -121,6 +125,120 @@ void CodeGenModule::EmitOMPThreadPrivate(const VarDecl *VD, const Expr *TPE) {
   }
 }
 
+void CodeGenModule::EmitOMPThreadPrivateTLS(const VarDecl *VD) {
+  llvm::Value *Val = OpenMPRuntime->GetAddrOfThreadPrivateTLS(VD);
+  // Do not define the initialization for declarations, it is defined for
+  // definitions.
+  if (!VD->isLocalVarDecl() && !getContext().DeclMustBeEmitted(VD))
+    return;
+  if (!OpenMPRuntime->needsThreadPrivateTLSInit(VD)) {
+    if (OpenMPRuntime->hasThreadPrivateTLSDynamicInit(VD))
+      EmitOMPThreadPrivateTLSDynamicInit(VD, cast<llvm::Constant>(Val));
+    return;
+  }
+  llvm::Function *TLSInit = OpenMPRuntime->GetThreadPrivateTLSInit(VD);
+  if (!TLSInit->isDeclaration())
+    return;
+  bool isArray = false;
+  const Type *TypePtr = VD->getType().getCanonicalType().getTypePtr();
+  while (TypePtr->isArrayType()) {
+    isArray = true;
+    TypePtr = TypePtr->getArrayElementTypeNoTypeQual();
+  }
+  CXXRecordDecl *Ty = TypePtr->getAsCXXRecordDecl();
+  llvm::Value *Ctor, *CCtor, *Dtor;
+  llvm::Function *InitFn;
+  if (isArray)
+    CreateOpenMPArrCXXInit(VD, Ty, InitFn, Ctor, CCtor, Dtor);
+  else
+    CreateOpenMPCXXInit(VD, Ty, InitFn, Ctor, CCtor, Dtor);
+  llvm::GlobalVariable *Guard = OpenMPRuntime->GetThreadPrivateTLSGuard(VD);
+
+  // The copies of the other threads are constructed on their first touch.
+  // void Var.tls.init.() {
+  //   Var.tls.guard. = 1;
+  //   ctor(&Var);
+  //   __cxa_thread_atexit(dtor, &Var, &__dso_handle);
+  // }
+  {
+    TLSInit->setLinkage(getLLVMLinkageVarDefinition(VD, false));
+    CodeGenFunction CGF(*this);
+    FunctionArgList ArgList;
+    CGF.StartFunction(GlobalDecl(), getContext().VoidTy, TLSInit,
+                      getTypes().arrangeNullaryFunction(), ArgList,
+                      SourceLocation());
+    CGF.Builder.CreateStore(CGF.Builder.getInt8(1), Guard);
+    llvm::Value *Arg = CGF.Builder.CreateBitCast(Val, Int8PtrTy);
+    if (dyn_cast_or_null<llvm::Function>(Ctor))
+      CGF.EmitRuntimeCall(Ctor, Arg);
+    if (dyn_cast_or_null<llvm::Function>(Dtor)) {
+      llvm::Type *DtorTy =
+          llvm::FunctionType::get(VoidTy, Int8PtrTy, false)->getPointerTo();
+      llvm::Type *AtExitArgs[] = {DtorTy, Int8PtrTy, Int8PtrTy};
+      llvm::FunctionType *AtExitTy =
+          llvm::FunctionType::get(IntTy, AtExitArgs, false);
+      llvm::Value *Args[] = {
+          CGF.Builder.CreateBitCast(Dtor, DtorTy), Arg,
+          CreateRuntimeVariable(Int8Ty, "__dso_handle")};
+      CGF.EmitNounwindRuntimeCall(
+          CreateRuntimeFunction(AtExitTy, "__cxa_thread_atexit"), Args);
+    }
+    CGF.FinishFunction();
+  }
+
+  // The copy of the initial thread is constructed with the variable itself.
+  if (InitFn) {
+    CodeGenFunction CGF(*this);
+    FunctionArgList ArgList;
+    CGF.StartFunction(GlobalDecl(), getContext().VoidTy, InitFn,
+                      getTypes().arrangeNullaryFunction(), ArgList,
+                      SourceLocation());
+    CGF.Builder.CreateStore(CGF.Builder.getInt8(1), Guard);
+    CGF.FinishFunction();
+    CXXGlobalInits.push_back(InitFn);
+  }
+}
+
+void CodeGenModule::EmitOMPThreadPrivateTLSDynamicInit(const VarDecl *VD,
+                                                       llvm::Constant *Addr) {
+  llvm::Function *TLSInit = OpenMPRuntime->GetThreadPrivateTLSInit(VD);
+  if (!TLSInit->isDeclaration())
+    return;
+  const VarDecl *InitVD;
+  VD->getAnyInitializer(InitVD);
+  llvm::GlobalVariable *Guard = OpenMPRuntime->GetThreadPrivateTLSGuard(VD);
+
+  // The copies of the other threads run the initializer on their first touch.
+  // void Var.tls.init.() {
+  //   Var.tls.guard. = 1;
+  //   Var = <init>;
+  // }
+  {
+    TLSInit->setLinkage(getLLVMLinkageVarDefinition(VD, false));
+    CodeGenFunction CGF(*this);
+    FunctionArgList ArgList;
+    CGF.StartFunction(GlobalDecl(), getContext().VoidTy, TLSInit,
+                      getTypes().arrangeNullaryFunction(), ArgList,
+                      SourceLocation());
+    CGF.Builder.CreateStore(CGF.Builder.getInt8(1), Guard);
+    CGF.EmitCXXGlobalVarDeclInit(*InitVD, Addr, /*PerformInit=*/true);
+    CGF.FinishFunction();
+  }
+
+  // The copy of the initial thread is initialized with the variable itself.
+  llvm::FunctionType *FTy = llvm::FunctionType::get(VoidTy, false);
+  llvm::Function *InitFn = CreateGlobalInitOrDestructFunction(
+      FTy, getMangledName(VD) + ".tls.guard.init.", VD->getLocation());
+  CodeGenFunction CGF(*this);
+  FunctionArgList ArgList;
+  CGF.StartFunction(GlobalDecl(), getContext().VoidTy, InitFn,
+                    getTypes().arrangeNullaryFunction(), ArgList,
+                    SourceLocation());
+  CGF.Builder.CreateStore(CGF.Builder.getInt8(1), Guard);
+  CGF.FinishFunction();
+  CXXGlobalInits.push_back(InitFn);
+}
+
 void CodeGenModule::EmitOMPThreadPrivate(const OMPThreadPrivateDecl *D) {
   for (OMPThreadPrivateDecl::varlist_const_iterator I = D->varlist_begin(),
                                                     E = D->varlist_end();
@@ -320,6 +320,9 @@ void CodeGenModule::EmitVectorVariantsMetadata(const CGFunctionInfo &FnInfo,
 //                ElementalVariantInfo(&FnInfo, FD, Fn, KernelMD));
 //          }
         }
+
+        // Emit the vector function ABI variants for this characteristic type.
+        EmitVectorVariants(FD, Fn, G, *TI, ParameterNameNode, StepNode);
       }
   }
 }
@@ -408,11 +411,16 @@ static llvm::Value *buildLinearArg(llvm::IRBuilder<> &B, unsigned VLen,
   if (Ty->isPointerTy())
     return B.CreateGEP(Base, Offset);
   assert(Ty->isIntegerTy() && "expected an integer type");
-  return B.CreateAdd(Base, B.CreateIntCast(Offset, Base->getType(), false));
+  return B.CreateAdd(Base, B.CreateIntCast(Offset, Base->getType(), true));
 }
 
 static llvm::Value *buildMask(llvm::IRBuilder<> &B, unsigned VL,
                               llvm::Value *Mask) {
+  // An AVX-512 mask holds one bit per lane, as in a k register.
+  if (Mask->getType()->isIntegerTy())
+    return B.CreateBitCast(B.CreateTrunc(Mask, B.getIntNTy(VL)),
+                           llvm::VectorType::get(B.getInt1Ty(), VL));
+
   llvm::Type *Ty = Mask->getType()->getVectorElementType();
   if (Ty->isFloatTy())
     Mask = B.CreateBitCast(Mask, llvm::VectorType::get(B.getInt32Ty(), VL));
@@ -429,6 +437,7 @@ static llvm::FunctionType *encodeParameters(llvm::Function *Func,
                                             llvm::MDNode *ArgStep,
                                             bool Mask,
                                             llvm::Type *VectorDataTy,
+                                            llvm::Type *MaskTy,
                                             SmallVectorImpl<ParamInfo> &Info,
                                      llvm::raw_svector_ostream &MangledParams) {
   assert(Func && "Func is null");
@@ -460,7 +469,9 @@ static llvm::FunctionType *encodeParameters(llvm::Function *Func,
         Info.push_back(ParamInfo(PK_Uniform));
       } else {
         MangledParams << "l";
-        if (!C->isOne())
+        if (C->isNegative())
+          MangledParams << "n" << -C->getSExtValue();
+        else if (!C->isOne())
           MangledParams << C->getZExtValue();
         Tys.push_back(Arg->getType());
         Info.push_back(ParamInfo(PK_LinearConst, Step));
@@ -489,7 +500,7 @@ static llvm::FunctionType *encodeParameters(llvm::Function *Func,
   }
 
   if (Mask)
-    Tys.push_back(VectorDataTy);
+    Tys.push_back(MaskTy);
 
   llvm::Type *RetTy = Func->getReturnType();
   RetTy = RetTy->isVoidTy() ? RetTy : VectorDataTy;
@@ -793,7 +804,8 @@ static bool createVectorVariant(llvm::MDNode *Root,
   llvm::raw_svector_ostream MangledParams(ParamStr);
   llvm::FunctionType *NewFuncTy = encodeParameters(Func, ArgName, ArgStep,
                                                    IsMasked, VectorDataTy,
-                                                   Info, MangledParams);
+                                                   VectorDataTy, Info,
+                                                   MangledParams);
   if (!NewFuncTy)
     return false;
 
@@ -844,3 +856,133 @@ void CodeGenModule::EmitCilkElementalVariants() {
       E = ElementalVariantToEmit.end(); I != E; ++I)
     createVectorVariant(I->KernelMD, I->FD, I->Fn);
 }
+
+namespace {
+/// \brief An x86 ISA class of the vector function ABI for
+/// '#pragma omp declare simd'.
+struct VectorVariantISA {
+  /// \brief The ISA letter of the mangled variant name.
+  char Mangling;
+  /// \brief The target feature the variant is compiled for.
+  const char *Feature;
+  /// \brief Vector register width for floating point characteristic types.
+  unsigned FPRegisterBits;
+  /// \brief Vector register width for other characteristic types.
+  unsigned IntRegisterBits;
+  /// \brief True if the mask is passed as an integer with one bit per lane,
+  /// as in the k registers, rather than as a vector.
+  bool IntegerMask;
+};
+} // end anonymous namespace
+
+static const VectorVariantISA VectorVariantISAs[] = {
+  { 'b', "sse2", 128, 128, false },
+  { 'c', "avx", 256, 128, false },
+  { 'd', "avx2", 256, 256, false },
+  { 'e', "avx512f", 512, 512, true }
+};
+
+void CodeGenModule::EmitVectorVariants(const FunctionDecl *FD,
+                                       llvm::Function *Fn,
+                                       const CilkElementalGroup &G,
+                                       QualType CharacteristicType,
+                                       llvm::MDNode *ArgName,
+                                       llvm::MDNode *ArgStep) {
+  llvm::Triple::ArchType Arch = getTarget().getTriple().getArch();
+  if (Arch != llvm::Triple::x86 && Arch != llvm::Triple::x86_64)
+    return;
+
+  llvm::Type *ElemTy = getTypes().ConvertType(CharacteristicType);
+  if (!llvm::VectorType::isValidElementType(ElemTy))
+    return;
+  uint64_t ElemBits = getContext().getTypeSize(CharacteristicType);
+
+  // If neither 'inbranch' nor 'notinbranch' is specified, both the masked and
+  // the unmasked variants are generated.
+  SmallVector<unsigned, 2> Masks(G.Mask.begin(), G.Mask.end());
+  if (Masks.empty()) {
+    Masks.push_back(0);
+    Masks.push_back(1);
+  }
+
+  // Calls in simd loops are dispatched to the variants of the widest ISA
+  // this translation unit is compiled for.
+  unsigned NativeISA = llvm::array_lengthof(VectorVariantISAs);
+  for (unsigned I = 0; I < llvm::array_lengthof(VectorVariantISAs); ++I)
+    if (getTarget().hasFeature(VectorVariantISAs[I].Feature))
+      NativeISA = I;
+
+  for (unsigned I = 0; I < llvm::array_lengthof(VectorVariantISAs); ++I) {
+    const VectorVariantISA &ISA = VectorVariantISAs[I];
+    for (CilkElementalGroup::VecLengthVector::const_iterator
+             LI = G.VecLength.begin(), LE = G.VecLength.end();
+         LI != LE; ++LI) {
+      unsigned RegisterBits = CharacteristicType->isRealFloatingType()
+                                  ? ISA.FPRegisterBits
+                                  : ISA.IntRegisterBits;
+      uint64_t VLen = *LI ? *LI : RegisterBits / ElemBits;
+      if (VLen < 2 || !llvm::isPowerOf2_64(VLen))
+        continue;
+      llvm::Type *VectorDataTy = llvm::VectorType::get(ElemTy, VLen);
+      // The k registers hold at least 8 lanes.
+      llvm::Type *MaskTy =
+          ISA.IntegerMask ? llvm::IntegerType::get(getLLVMContext(),
+                                                   std::max<uint64_t>(VLen, 8))
+                          : VectorDataTy;
+
+      for (SmallVectorImpl<unsigned>::iterator MI = Masks.begin(),
+                                               ME = Masks.end();
+           MI != ME; ++MI) {
+        bool IsMasked = *MI != 0;
+        SmallVector<ParamInfo, 4> Info;
+        SmallString<16> ParamStr;
+        llvm::raw_svector_ostream MangledParams(ParamStr);
+        llvm::FunctionType *NewFuncTy =
+            encodeParameters(Fn, ArgName, ArgStep, IsMasked, VectorDataTy,
+                             MaskTy, Info, MangledParams);
+
+        SmallString<32> NameStr;
+        llvm::raw_svector_ostream MangledName(NameStr);
+        MangledName << "_ZGV" << ISA.Mangling << (IsMasked ? 'M' : 'N')
+                    << VLen << MangledParams.str() << "_" << Fn->getName();
+
+        // Let the vectorizer find the variant from the scalar function.
+        Fn->addFnAttr(MangledName.str());
+
+        // The vectorizer widens every argument of a call, so it can only use
+        // the unmasked variants that take all of them as vectors.
+        bool AllVector = true;
+        for (SmallVectorImpl<ParamInfo>::iterator PI = Info.begin(),
+                                                  PE = Info.end();
+             PI != PE; ++PI)
+          AllVector = AllVector && PI->Kind == PK_Vector;
+        if (I == NativeISA && !IsMasked && AllVector &&
+            !NewFuncTy->getReturnType()->isVoidTy()) {
+          llvm::LLVMContext &Context = getLLVMContext();
+          llvm::Metadata *DispatchMDArgs[] = {
+            llvm::MDString::get(Context, Fn->getName()),
+            llvm::MDString::get(Context, MangledName.str()),
+            llvm::ConstantAsMetadata::get(
+                llvm::ConstantInt::get(Int32Ty, VLen))
+          };
+          getModule().getOrInsertNamedMetadata("omp.simd.dispatch")
+              ->addOperand(llvm::MDNode::get(Context, DispatchMDArgs));
+        }
+
+        // The variants are defined along with the scalar function, other
+        // translation units only refer to them.
+        if (!FD->hasBody())
+          continue;
+        llvm::Function *NewFunc = dyn_cast<llvm::Function>(
+            getModule().getOrInsertFunction(MangledName.str(), NewFuncTy));
+        if (!NewFunc || !NewFunc->empty())
+          continue;
+        NewFunc->setLinkage(getFunctionLinkage(FD));
+        NewFunc->addFnAttr(llvm::Attribute::NoUnwind);
+        NewFunc->addFnAttr("target-features",
+                           std::string("+") + ISA.Feature);
+        createVectorVariantWrapper(Fn, NewFunc, VLen, Info);
+      }
+    }
+  }
+}
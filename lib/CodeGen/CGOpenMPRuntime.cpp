@@ -18,6 +18,7 @@
 #include "CodeGenFunction.h"
 #include "clang/AST/Decl.h"
 #include "clang/AST/StmtOpenMP.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
@@ -35,7 +36,9 @@
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
@@ -60,6 +63,10 @@ bool CGOpenMPRuntime::hasTargetGlobalInitializers(){
 
 // Start sharing region. This will initialize a new set of shared variables
 void CGOpenMPRuntime::startSharedRegion(unsigned NestingLevel) {
+  // In SPMD mode every thread has its own copy of the data.
+  if (isSPMDExecutionMode())
+    return;
+
   // If the current target region doesn't have any entry yet, create one. We may
   // need to create more than one entry if there were target regions with no
   // data sharing processed since the last one that does.
@@ -79,6 +86,9 @@ void CGOpenMPRuntime::startSharedRegion(unsigned NestingLevel) {
 
 // Mark value as requiring to be moved to global memory
 void CGOpenMPRuntime::addToSharedRegion(llvm::Value *V, unsigned NestingLevel) {
+  if (isSPMDExecutionMode())
+    return;
+
 
   // Make sure this value is not already shared.
   auto &Levels = ValuesToBeInSharedMemory[NumTargetRegions - 1];
@@ -413,8 +423,13 @@ DEFAULT_EMIT_OPENMP_FUNC(single)
 DEFAULT_EMIT_OPENMP_FUNC(end_single)
 DEFAULT_EMIT_OPENMP_FUNC(critical)
 DEFAULT_EMIT_OPENMP_FUNC(end_critical)
+DEFAULT_EMIT_OPENMP_FUNC(critical_with_hint)
 DEFAULT_EMIT_OPENMP_FUNC(ordered)
 DEFAULT_EMIT_OPENMP_FUNC(end_ordered)
+DEFAULT_EMIT_OPENMP_FUNC(doacross_init)
+DEFAULT_EMIT_OPENMP_FUNC(doacross_wait)
+DEFAULT_EMIT_OPENMP_FUNC(doacross_post)
+DEFAULT_EMIT_OPENMP_FUNC(doacross_fini)
 DEFAULT_EMIT_OPENMP_FUNC(end_reduce_nowait)
 DEFAULT_EMIT_OPENMP_FUNC(end_reduce)
 DEFAULT_EMIT_OPENMP_FUNC(atomic_start)
@@ -441,16 +456,25 @@ DEFAULT_EMIT_OPENMP_FUNC(omp_task_complete_if0)
 DEFAULT_EMIT_OPENMP_FUNC(omp_task_parts)
 DEFAULT_EMIT_OPENMP_FUNC(taskgroup)
 DEFAULT_EMIT_OPENMP_FUNC(end_taskgroup)
+DEFAULT_EMIT_OPENMP_FUNC(task_reduction_init)
+DEFAULT_EMIT_OPENMP_FUNC(task_reduction_get_th_data)
+DEFAULT_EMIT_OPENMP_FUNC(instr_region_begin)
+DEFAULT_EMIT_OPENMP_FUNC(instr_region_acquired)
+DEFAULT_EMIT_OPENMP_FUNC(instr_region_end)
 DEFAULT_EMIT_OPENMP_FUNC_TARGET(register_lib)
 DEFAULT_EMIT_OPENMP_FUNC_TARGET(unregister_lib)
 
 DEFAULT_EMIT_OPENMP_FUNC(threadprivate_register)
 DEFAULT_EMIT_OPENMP_FUNC(global_thread_num)
+DEFAULT_EMIT_OPENMP_FUNC(bound_thread_num)
+DEFAULT_EMIT_OPENMP_FUNC(bound_num_threads)
 
 DEFAULT_EMIT_OPENMP_FUNC(kernel_init)
 DEFAULT_EMIT_OPENMP_FUNC(kernel_prepare_parallel)
 DEFAULT_EMIT_OPENMP_FUNC(kernel_parallel)
 DEFAULT_EMIT_OPENMP_FUNC(kernel_end_parallel)
+DEFAULT_EMIT_OPENMP_FUNC(spmd_kernel_init)
+DEFAULT_EMIT_OPENMP_FUNC(spmd_kernel_deinit)
 
 DEFAULT_EMIT_OPENMP_FUNC(serialized_parallel)
 DEFAULT_EMIT_OPENMP_FUNC(end_serialized_parallel)
@@ -1090,6 +1114,24 @@ static void StoreField(CGBuilderTy &B, llvm::Value *Val, llvm::Value *Dst,
   B.CreateStore(Val, GEP(B, Dst, field));
 }
 
+/// \brief Returns the ";file;func;line;col;;" string describing \a Loc.
+static std::string GetOpenMPSourceLocString(CodeGenModule &CGM,
+                                            SourceLocation Loc,
+                                            CodeGenFunction &CGF) {
+  PresumedLoc PLoc = CGM.getContext().getSourceManager().getPresumedLoc(Loc);
+  std::string Res = ";";
+  Res += PLoc.getFilename();
+  Res += ";";
+  if (const FunctionDecl *FD = dyn_cast_or_null<FunctionDecl>(
+      CGF.CurFuncDecl)) {
+    Res += FD->getQualifiedNameAsString();
+  }
+  Res += ";";
+  Res += llvm::utostr(PLoc.getLine()) + ";" + llvm::utostr(PLoc.getColumn())
+      + ";;";
+  return Res;
+}
+
 llvm::Value *CGOpenMPRuntime::CreateIntelOpenMPRTLLoc(SourceLocation Loc,
     CodeGenFunction &CGF, unsigned Flags) {
   llvm::Value *Tmp;
@@ -1139,17 +1181,7 @@ llvm::Value *CGOpenMPRuntime::CreateIntelOpenMPRTLLoc(SourceLocation Loc,
   Tmp = AI;
   if (CGM.getCodeGenOpts().getDebugInfo() != CodeGenOptions::NoDebugInfo
       && Loc.isValid()) {
-    PresumedLoc PLoc = CGM.getContext().getSourceManager().getPresumedLoc(Loc);
-    std::string Res = ";";
-    Res += PLoc.getFilename();
-    Res += ";";
-    if (const FunctionDecl *FD = dyn_cast_or_null<FunctionDecl>(
-        CGF.CurFuncDecl)) {
-      Res += FD->getQualifiedNameAsString();
-    }
-    Res += ";";
-    Res += llvm::utostr(PLoc.getLine()) + ";" + llvm::utostr(PLoc.getColumn())
-        + ";;";
+    std::string Res = GetOpenMPSourceLocString(CGM, Loc, CGF);
     // tmp.psource = ";file;func;line;col;;";
     StoreField(CGF.Builder, CGF.Builder.CreateGlobalStringPtr(Res), Tmp,
         llvm::IdentTBuilder::psource);
@@ -1163,6 +1195,43 @@ llvm::Value *CGOpenMPRuntime::CreateIntelOpenMPRTLLoc(SourceLocation Loc,
   return Tmp;
 }
 
+llvm::Constant *CGOpenMPRuntime::CreateOpenMPRegionDescriptor(
+    SourceLocation Loc, CodeGenFunction &CGF, unsigned Kind) {
+  // The ident_t built above lives on the stack of the current function, so
+  // the descriptor carries its own copy of the location string. Regions are
+  // identified by their kind and full location string, and the id is a hash
+  // of them, so that it does not change with the other regions of the module
+  // and differs between translation units. Colliding ids are bumped.
+  std::string Res = Loc.isValid() ? GetOpenMPSourceLocString(CGM, Loc, CGF)
+                                  : ";unknown;unknown;0;0;;";
+  std::string Key = llvm::utostr(Kind) + Res;
+  llvm::Constant *&Desc = OpenMPRegionDescMap[Key];
+  if (!Desc) {
+    llvm::MD5 Hash;
+    Hash.update(Key);
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    using namespace llvm::support;
+    uint32_t Id = endian::read<uint32_t, little, unaligned>(Result);
+    while (!OpenMPRegionDescIds.insert(Id).second)
+      ++Id;
+    // struct { int32_t id; int32_t kind; const char *psource; };
+    llvm::Type *Elts[] = { CGM.Int32Ty, CGM.Int32Ty, CGM.Int8PtrTy };
+    llvm::StructType *StTy =
+        llvm::StructType::get(CGM.getLLVMContext(), Elts);
+    llvm::Constant *Values[] = {
+        llvm::ConstantInt::get(CGM.Int32Ty, Id),
+        llvm::ConstantInt::get(CGM.Int32Ty, Kind),
+        llvm::ConstantExpr::getBitCast(CGM.GetAddrOfConstantCString(Res),
+                                       CGM.Int8PtrTy) };
+    Desc = new llvm::GlobalVariable(CGM.getModule(), StTy, true,
+        llvm::GlobalValue::PrivateLinkage,
+        llvm::ConstantStruct::get(StTy, Values),
+        ".omp.region.desc." + llvm::utostr(Id) + ".");
+  }
+  return llvm::ConstantExpr::getBitCast(Desc, CGM.VoidPtrTy);
+}
+
 llvm::Value *CGOpenMPRuntime::CreateOpenMPGlobalThreadNum(SourceLocation Loc,
     CodeGenFunction &CGF) {
   llvm::BasicBlock &EntryBB = CGF.CurFn->getEntryBlock();
@@ -1184,6 +1253,46 @@ llvm::Value *CGOpenMPRuntime::CreateOpenMPGlobalThreadNum(SourceLocation Loc,
   return CGF.Builder.CreateLoad(AI, ".gtid.");
 }
 
+/// \brief Emits a call to the runtime query \a Fn in the entry block of the
+/// current function and caches its result in the entry-block temporary
+/// \a Name, so that the query is made only once per outlined region.
+static llvm::Value *CreateCachedRuntimeQuery(CGOpenMPRuntime &RT,
+                                             SourceLocation Loc,
+                                             CodeGenFunction &CGF,
+                                             llvm::Constant *Fn,
+                                             StringRef Name) {
+  llvm::BasicBlock &EntryBB = CGF.CurFn->getEntryBlock();
+  for (llvm::BasicBlock::iterator I = EntryBB.begin(), E = EntryBB.end();
+      I != E; ++I)
+    if (I->getName().startswith(Name))
+      return CGF.Builder.CreateLoad(I);
+  llvm::AllocaInst *AI = CGF.CreateTempAlloca(CGF.Int32Ty, Name);
+  AI->setAlignment(4);
+  CGBuilderTy::InsertPoint SavedIP = CGF.Builder.saveIP();
+  assert(SavedIP.isSet() && "No insertion point is set!");
+  CGF.Builder.SetInsertPoint(CGF.AllocaInsertPt);
+  llvm::Value *IdentT = RT.CreateIntelOpenMPRTLLoc(Loc, CGF);
+  llvm::Value *Res =
+      CGF.EmitRuntimeCall(Fn, llvm::makeArrayRef<llvm::Value *>(&IdentT, 1));
+  CGF.Builder.CreateStore(Res, AI);
+  CGF.Builder.restoreIP(SavedIP);
+  return CGF.Builder.CreateLoad(AI);
+}
+
+llvm::Value *CGOpenMPRuntime::CreateOpenMPBoundThreadNum(SourceLocation Loc,
+    CodeGenFunction &CGF) {
+  return CreateCachedRuntimeQuery(*this, Loc, CGF,
+                                  OPENMPRTL_FUNC(bound_thread_num),
+                                  ".__kmpc_bound_thread_num.");
+}
+
+llvm::Value *CGOpenMPRuntime::CreateOpenMPBoundNumThreads(SourceLocation Loc,
+    CodeGenFunction &CGF) {
+  return CreateCachedRuntimeQuery(*this, Loc, CGF,
+                                  OPENMPRTL_FUNC(bound_num_threads),
+                                  ".__kmpc_bound_num_threads.");
+}
+
 llvm::Value *CGOpenMPRuntime::CreateOpenMPThreadPrivateCached(const VarDecl *VD,
     SourceLocation Loc, CodeGenFunction &CGF, bool NoCast) {
   if (CGM.OpenMPSupport.hasThreadPrivateVar(VD)) {
@@ -1191,6 +1300,35 @@ llvm::Value *CGOpenMPRuntime::CreateOpenMPThreadPrivateCached(const VarDecl *VD,
     llvm::PointerType *PTy = llvm::PointerType::get(VDTy,
         CGM.getContext().getTargetAddressSpace(VD->getType()));
     CharUnits SZ = CGM.GetTargetTypeStoreSize(VDTy);
+    if (isThreadPrivateTLS(VD)) {
+      bool MayHaveInit = mayHaveThreadPrivateTLSDynamicInit(VD);
+      if (needsThreadPrivateTLSInit(VD) || hasThreadPrivateTLSDynamicInit(VD) ||
+          MayHaveInit) {
+        // if (!<var>.tls.guard.) <var>.tls.init.();
+        llvm::Value *Guard =
+            CGF.Builder.CreateLoad(GetThreadPrivateTLSGuard(VD));
+        llvm::BasicBlock *InitBB = CGF.createBasicBlock("omp.tls.init");
+        llvm::BasicBlock *ContBB = CGF.createBasicBlock("omp.tls.cont");
+        CGF.Builder.CreateCondBr(CGF.Builder.CreateIsNull(Guard), InitBB,
+                                 ContBB);
+        CGF.EmitBlock(InitBB);
+        llvm::Function *Init = GetThreadPrivateTLSInit(VD);
+        if (MayHaveInit) {
+          // The translation unit defining the variable defines the function
+          // only if the initializer of the variable is dynamic.
+          if (Init->isDeclaration())
+            Init->setLinkage(llvm::GlobalValue::ExternalWeakLinkage);
+          llvm::BasicBlock *CallBB = CGF.createBasicBlock("omp.tls.call");
+          CGF.Builder.CreateCondBr(CGF.Builder.CreateIsNotNull(Init), CallBB,
+                                   ContBB);
+          CGF.EmitBlock(CallBB);
+        }
+        CGF.EmitRuntimeCall(Init);
+        CGF.EmitBlock(ContBB);
+      }
+      return CGF.Builder.CreateBitCast(GetAddrOfThreadPrivateTLS(VD),
+                                       NoCast ? CGM.Int8PtrTy : PTy);
+    }
     std::string VarCache = CGM.getMangledName(VD).str() + ".cache.";
 
     llvm::Value *Args[] = { CreateIntelOpenMPRTLLoc(Loc, CGF),
@@ -1208,6 +1346,79 @@ llvm::Value *CGOpenMPRuntime::CreateOpenMPThreadPrivateCached(const VarDecl *VD,
   return 0;
 }
 
+bool CGOpenMPRuntime::isThreadPrivateTLS(const VarDecl *VD) {
+  const LangOptions &LangOpts = CGM.getLangOpts();
+  if (!LangOpts.OpenMPUseTLS || LangOpts.OpenMPTargetMode ||
+      !CGM.getTarget().getTriple().isOSBinFormatELF() ||
+      !CGM.getTarget().isTLSSupported())
+    return false;
+  // Static locals of class types, or with a dynamic initializer, are
+  // initialized under a guard shared by all the threads, they are left to the
+  // runtime.
+  return !VD->isStaticLocal() ||
+         (!needsThreadPrivateTLSInit(VD) && !hasThreadPrivateTLSDynamicInit(VD));
+}
+
+bool CGOpenMPRuntime::needsThreadPrivateTLSInit(const VarDecl *VD) {
+  // The decision depends on the type only, so that all the translation units
+  // agree on it whether they see the definition of the variable or not.
+  const Type *Ty = VD->getType().getCanonicalType().getTypePtr();
+  while (Ty->isArrayType())
+    Ty = Ty->getArrayElementTypeNoTypeQual();
+  return Ty->getAsCXXRecordDecl() != 0;
+}
+
+bool CGOpenMPRuntime::hasThreadPrivateTLSDynamicInit(const VarDecl *VD) {
+  if (!CGM.getLangOpts().CPlusPlus || needsThreadPrivateTLSInit(VD))
+    return false;
+  const VarDecl *InitVD;
+  const Expr *Init = VD->getAnyInitializer(InitVD);
+  return Init && !Init->isConstantInitializer(CGM.getContext(), false);
+}
+
+bool CGOpenMPRuntime::mayHaveThreadPrivateTLSDynamicInit(const VarDecl *VD) {
+  // Only C++ allows dynamic initializers for variables of static storage.
+  return CGM.getLangOpts().CPlusPlus && !needsThreadPrivateTLSInit(VD) &&
+         VD->isExternallyVisible() && !VD->getDefinition();
+}
+
+llvm::Value *CGOpenMPRuntime::GetAddrOfThreadPrivateTLS(const VarDecl *VD) {
+  llvm::Value *Addr = VD->isStaticLocal() ? CGM.getStaticLocalDeclAddress(VD)
+                                          : CGM.GetAddrOfGlobal(VD);
+  // The global may have been created before the threadprivate directive was
+  // seen, or replaced by its definition.
+  if (llvm::GlobalVariable *GV =
+          dyn_cast<llvm::GlobalVariable>(Addr->stripPointerCasts()))
+    if (!GV->isThreadLocal())
+      CGM.setTLSMode(GV, *VD);
+  return Addr;
+}
+
+llvm::GlobalVariable *
+CGOpenMPRuntime::GetThreadPrivateTLSGuard(const VarDecl *VD) {
+  std::string Name = CGM.getMangledName(VD).str() + ".tls.guard.";
+  if (llvm::GlobalVariable *GV = CGM.getModule().getNamedGlobal(Name))
+    return GV;
+  // Every translation unit accessing the variable defines the guard.
+  llvm::GlobalVariable *GV = new llvm::GlobalVariable(
+      CGM.getModule(), CGM.Int8Ty, false,
+      VD->isExternallyVisible() ? llvm::GlobalValue::LinkOnceODRLinkage
+                                : llvm::GlobalValue::InternalLinkage,
+      llvm::ConstantInt::get(CGM.Int8Ty, 0), Name);
+  CGM.setTLSMode(GV, *VD);
+  return GV;
+}
+
+llvm::Function *CGOpenMPRuntime::GetThreadPrivateTLSInit(const VarDecl *VD) {
+  std::string Name = CGM.getMangledName(VD).str() + ".tls.init.";
+  if (llvm::Function *Fn = CGM.getModule().getFunction(Name))
+    return Fn;
+  // The translation unit defining the variable defines the function.
+  llvm::FunctionType *FTy = llvm::FunctionType::get(CGM.VoidTy, false);
+  return llvm::Function::Create(FTy, llvm::GlobalValue::ExternalLinkage, Name,
+                                &CGM.getModule());
+}
+
 /// Remove dashes and other strange characters from the target triple
 /// as they may cause some problems for the external symbols
 static std::string LegalizeTripleString(llvm::Triple TargetTriple) {
@@ -1248,6 +1459,24 @@ void CGOpenMPRuntime::EmitOMPBarrier(SourceLocation L, unsigned Flags,
   CGF.EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(barrier), L, Flags);
 }
 
+// default flush emit
+void CGOpenMPRuntime::EmitOMPFlush(SourceLocation L,
+                                   ArrayRef<llvm::Value *> Vars,
+                                   CodeGenFunction &CGF) {
+  if (!CGM.getLangOpts().OpenMPRuntimeFlush &&
+      !CGM.getLangOpts().OpenMPTargetMode) {
+    // There is no fence restricted to a set of locations, so a flush with a
+    // list orders all the memory accesses as well.
+    CGF.Builder.CreateFence(llvm::SequentiallyConsistent);
+    return;
+  }
+  // __kmpc_flush(&loc, ...);
+  SmallVector<llvm::Value *, 4> Args;
+  Args.push_back(CreateIntelOpenMPRTLLoc(L, CGF));
+  Args.append(Vars.begin(), Vars.end());
+  CGF.EmitRuntimeCall(OPENMPRTL_FUNC(flush), Args);
+}
+
 // These are hooks for NVPTX backend: nothing is generated for other backends
 void CGOpenMPRuntime::EnterTargetControlLoop(SourceLocation Loc,
                                              CodeGenFunction &CGF,
@@ -1314,7 +1543,7 @@ bool CGOpenMPRuntime::IsNestedParallel () {
 
 unsigned CGOpenMPRuntime::CalculateParallelNestingLevel() { return 0; }
 
-void CGOpenMPRuntime::StartNewTargetRegion() {
+void CGOpenMPRuntime::StartNewTargetRegion(const OMPExecutableDirective &S) {
 }
 
 void CGOpenMPRuntime::StartTeamsRegion() {}
@@ -2059,6 +2288,16 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
   // initial value for SimdNumLanes
   int WARP_SIZE = 32; // should obtain from parameters of target function
 
+  // maximum number of CUDA threads in a team (block)
+  int MAX_THREADS_PER_TEAM = 1024;
+
+  // maximum size in bytes of the static shared memory of a team (block)
+  uint64_t MAX_SHARED_MEMORY_PER_TEAM = 48 * 1024;
+
+  // maximum number of teams (blocks) whose sharing stacks are stored in global
+  // memory, as implied by the default sharing sizes per team and per kernel
+  uint64_t MAX_NUM_TEAMS = 2048;
+
   // Identifier of CUDA thread as a lane
   llvm::AllocaInst *SimdLaneNum;
 
@@ -2073,6 +2312,10 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
 
   llvm::GlobalVariable *ThreadLimitGlobal;
 
+  // true if the current target region is executed in SPMD mode: all the CUDA
+  // threads execute the region from the start and there is no control loop
+  bool SPMDMode;
+
   llvm::GlobalVariable *getMasterLabelShared() const {
     return MasterLabelShared;
   }
@@ -2308,6 +2551,12 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
   // region and have all threads synchronize at the single control loop barrier
   void EmitOMPBarrier(SourceLocation L, unsigned Flags, CodeGenFunction &CGF) {
     CGBuilderTy &Bld = CGF.Builder;
+
+    // in SPMD mode all the threads are active: a native barrier is enough
+    if (SPMDMode) {
+      Bld.CreateCall(Get_syncthreads(), {});
+      return;
+    }
     // generate new switch case, then look at region stack and generate thread
     // exclusion code
 
@@ -2369,12 +2618,32 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
              "Number of OMP parallel regions cannot be a negative number");
   }
 
+  // Add global for thread_limit that is kept updated by the CUDA offloading
+  // RTL (one per kernel)
+  // init to value (0) that will provoke default being used
+  void CreateThreadLimitGlobal(CodeGenFunction &CGF, StringRef TgtFunName) {
+    ThreadLimitGlobal = new llvm::GlobalVariable(
+        CGF.CGM.getModule(), CGF.Builder.getInt32Ty(), false,
+        llvm::GlobalValue::ExternalLinkage, CGF.Builder.getInt32(0),
+        TgtFunName + Twine("_thread_limit"));
+  }
+
   // For NVTPX the control loop is generated when a target construct is found
   void EnterTargetControlLoop(SourceLocation Loc, CodeGenFunction &CGF,
                               StringRef TgtFunName) {
 
     CGBuilderTy &Bld = CGF.Builder;
 
+    // in SPMD mode every thread starts executing the region: only initialize
+    // the state of the OpenMP rt library on the GPU
+    if (SPMDMode) {
+      CreateThreadLimitGlobal(CGF, TgtFunName);
+      llvm::Value *InitArg[] = {Bld.CreateLoad(ThreadLimitGlobal)};
+      CGF.EmitRuntimeCall(OPENMPRTL_FUNC(spmd_kernel_init),
+                          makeArrayRef(InitArg));
+      return;
+    }
+
     // 32 bits should be enough to represent the number of basic
     // blocks in a target region
     llvm::IntegerType *VarTy = CGM.Int32Ty;
@@ -2573,13 +2842,7 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
     // start codegening content of target pragma
     Bld.SetInsertPoint(FirstSequentialContent);
 
-    // Add global for thread_limit that is kept updated by the CUDA offloading
-    // RTL (one per kernel)
-    // init to value (0) that will provoke default being used
-    ThreadLimitGlobal = new llvm::GlobalVariable(
-        CGF.CGM.getModule(), Bld.getInt32Ty(), false,
-        llvm::GlobalValue::ExternalLinkage, Bld.getInt32(0),
-        TgtFunName + Twine("_thread_limit"));
+    CreateThreadLimitGlobal(CGF, TgtFunName);
 
     // first thing of sequential region:
     // initialize the state of the OpenMP rt library on the GPU
@@ -2594,6 +2857,14 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
                              bool prevIsParallel, StringRef TgtFunName) {
     CGBuilderTy &Bld = CGF.Builder;
 
+    if (SPMDMode) {
+      CGF.EmitRuntimeCall(OPENMPRTL_FUNC(spmd_kernel_deinit));
+      EmitTargetLaunchInfo(CGF, TgtFunName);
+      // code outside target regions is never SPMD
+      SPMDMode = false;
+      return;
+    }
+
     // Master selects the next labels for everyone
     // only need to exclude others if we are in a parallel region
     if (prevIsParallel) {
@@ -2620,6 +2891,14 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
 
     Bld.SetInsertPoint(EndTarget);
 
+    EmitTargetLaunchInfo(CGF, TgtFunName);
+  }
+
+  // \brief Emit the globals that tell the RTL on the host how to launch the
+  // kernel of the current target region
+  void EmitTargetLaunchInfo(CodeGenFunction &CGF, StringRef TgtFunName) {
+    CGBuilderTy &Bld = CGF.Builder;
+
     // After codegen of an entire target region, we can decide the number
     // of lanes to be used and thus set a global variable that communicates
     // to the RTL on the host the exact number of CUDA threads to launch
@@ -2628,11 +2907,24 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
                              llvm::GlobalValue::ExternalLinkage,
                              Bld.getInt8(GetNumSimdLanesPerTargetRegion()),
                              TgtFunName + Twine("_simd_info"));
+
+    // How the plugin must launch the kernel, with the encoding of the
+    // offloading runtime: 0 for SPMD, 1 for the control loop (generic).
+    // Kernels without it are launched as generic ones.
+    if (CGM.getLangOpts().OpenMPNVPTXSPMD)
+      new llvm::GlobalVariable(CGF.CGM.getModule(), Bld.getInt8Ty(), true,
+                               llvm::GlobalValue::ExternalLinkage,
+                               Bld.getInt8(SPMDMode ? 0 : 1),
+                               TgtFunName + Twine("_exec_mode"));
   }
 
   void GenerateNextLabel(CodeGenFunction &CGF, bool PrevIsParallel,
                          bool NextIsParallel, const char *CaseBBName) {
 
+    // there are no region labels without control loop
+    if (SPMDMode)
+      return;
+
     // WARNING: the code generation for if-clause will emit first
     // the else branch (sequential) then the then branch (parallel).
     // This will provoke closure of the #parallel region in else on the
@@ -2995,6 +3287,71 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
      return false;
    }
 
+   // \brief scan a region looking for any nested OpenMP directive.
+   // return true when one is found, false otherwise
+   bool RegionHasNestedDirective(const Stmt *S) {
+
+     if (!S)
+       return false;
+
+     for (Stmt::const_child_iterator ii = S->child_begin(), ie = S->child_end();
+          ii != ie; ++ii) {
+       if (*ii && isa<OMPExecutableDirective>(*ii))
+         return true;
+       if (RegionHasNestedDirective(*ii))
+         return true;
+     }
+
+     return false;
+   }
+
+   // \brief Return true if target region \a S can be executed in SPMD mode.
+   // The combined #target teams distribute parallel for leaves no code between
+   // the constructs: every CUDA thread can run the distribute loop (all the
+   // threads of a team get the same chunk) and then its share of the #for
+   // loop. Regions that need the team master alone, nested parallelism or
+   // simd lanes keep the control loop.
+   // SPMD kernels need __kmpc_spmd_kernel_init/deinit in the device runtime
+   // and a plugin that reads '<kernel>_exec_mode', so they are only emitted
+   // under -fopenmp-nvptx-spmd.
+   bool CanUseSPMDMode(const OMPExecutableDirective &S) {
+     if (!CGM.getLangOpts().OpenMPNVPTXSPMD ||
+         S.getDirectiveKind() != OMPD_target_teams_distribute_parallel_for)
+       return false;
+
+     // reductions, copies from the master thread, conditional and sized
+     // parallel regions rely on the control loop
+     for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                          E = S.clauses().end();
+          I != E; ++I) {
+       if (!*I)
+         continue;
+       switch ((*I)->getClauseKind()) {
+       case OMPC_reduction:
+       case OMPC_lastprivate:
+       case OMPC_copyin:
+       case OMPC_if:
+       case OMPC_num_threads:
+       case OMPC_ordered:
+         return false;
+       case OMPC_schedule:
+         // dynamic schedules hand out chunks through the team state that the
+         // control loop sets up
+         if (cast<OMPScheduleClause>(*I)->getScheduleKind() !=
+             OMPC_SCHEDULE_static)
+           return false;
+         break;
+       default:
+         break;
+       }
+     }
+
+     const CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+     return !RegionHasNestedDirective(CS->getCapturedStmt());
+   }
+
+   bool isSPMDExecutionMode() { return SPMDMode; }
+
    // \brief Scan an OpenMP #parallel region looking for #for, #simd, #for simd,
    // etc. and decide amount of lanes that can be dedicated to execute #simd
    // regions
@@ -3265,6 +3622,12 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
 
      OMPRegionTypesStack.push_back(OMP_Parallel);
 
+     // in SPMD mode the threads of the team are already running the region
+     if (SPMDMode) {
+       PushNewParallelRegion(true);
+       return;
+     }
+
      if (!NestedParallelStack.back()) { // not already in a parallel region
 
        // clear up the data structure that will be used to determine the
@@ -3351,6 +3714,15 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
 
    void ExitParallelRegionInTarget(CodeGenFunction &CGF) {
      CGBuilderTy &Bld = CGF.Builder;
+
+     if (SPMDMode) {
+       assert((OMPRegionTypesStack.back() == OMP_Parallel) &&
+              "Exiting a parallel region does not match stack state");
+       OMPRegionTypesStack.pop_back();
+       PopParallelRegion();
+       return;
+     }
+
      // Decrement the nesting level
      Bld.CreateStore(
          Bld.CreateSub(Bld.CreateLoad(ParallelNesting), Bld.getInt32(1)),
@@ -3495,7 +3867,10 @@ class CGOpenMPRuntime_NVPTX: public CGOpenMPRuntime {
      Builder.CreateStore(NewLoopIndexValue, LoopIndex);
    }
 
-   void StartNewTargetRegion() {
+   void StartNewTargetRegion(const OMPExecutableDirective &S) {
+     // decide how the kernel is executed before generating any code for it
+     SPMDMode = CanUseSPMDMode(S);
+
      // reset some class instance variables for a new target region
      MasterLabelShared = 0;
      OthersLabelShared = 0;
@@ -3561,7 +3936,7 @@ public:
          ParallelNesting(0), NextState(0), ControlState(0),
          ControlStateIndex(0), CudaThreadsInParallel(0), SimdNumLanes(0),
          SimdLaneNum(0), ControlSwitch(0), SimdHasReduction(false),
-         ThreadLimitGlobal(0) {
+         ThreadLimitGlobal(0), SPMDMode(false) {
 
      SimdAndWorksharingNesting.resize(EXPECTED_WS_NESTS);
 
@@ -3987,12 +4362,85 @@ public:
     return nullptr;
   }
 
+  /// Compute the sizes of the sharing stack from the values that escape to
+  /// other threads in all the target regions of the module. If a variable
+  /// length array is shared the sizes given by the user are kept, as its
+  /// storage is only known at runtime. Return false if there is nothing to
+  /// share.
+  bool ComputeSharedStackSizes(CodeGenModule &CGM) {
+    const llvm::DataLayout &DL = CGM.getModule().getDataLayout();
+    uint64_t LevelSizes[2] = {0, 0};
+
+    for (auto &Region : ValuesToBeInSharedMemory)
+      for (unsigned LevelIdx = 0; LevelIdx < 2 && LevelIdx < Region.size();
+           ++LevelIdx) {
+        // Build the types in the same order they are laid out when the
+        // sharing struct of the level is created.
+        llvm::SmallVector<llvm::Type *, 32> Tys;
+        for (auto &Vars : Region[LevelIdx])
+          for (auto V : Vars) {
+            if (isa<llvm::LoadInst>(V))
+              continue;
+
+            llvm::AllocaInst *AI = cast<llvm::AllocaInst>(V);
+            llvm::ConstantInt *CI =
+                dyn_cast<llvm::ConstantInt>(AI->getArraySize());
+            if (!CI)
+              return true;
+
+            if (SharedStackDynamicAlloc)
+              Tys.push_back(AI->getType());
+            else if (AI->isArrayAllocation())
+              Tys.push_back(llvm::ArrayType::get(AI->getAllocatedType(),
+                                                 CI->getSExtValue()));
+            else
+              Tys.push_back(AI->getAllocatedType());
+          }
+
+        if (Tys.empty())
+          continue;
+
+        llvm::StructType *LevelTy =
+            llvm::StructType::get(CGM.getLLVMContext(), Tys);
+        uint64_t Size = llvm::RoundUpToAlignment(
+            DL.getTypeAllocSize(LevelTy),
+            std::max(8u, DL.getABITypeAlignment(LevelTy)));
+        LevelSizes[LevelIdx] = std::max(LevelSizes[LevelIdx], Size);
+      }
+
+    if (!LevelSizes[0] && !LevelSizes[1])
+      return false;
+
+    SharedStackSizePerThread[0] = LevelSizes[0];
+    SharedStackSizePerThread[1] = LevelSizes[1];
+    SharedStackSizePerTeam =
+        LevelSizes[0] + MAX_THREADS_PER_TEAM * LevelSizes[1];
+
+    // The fast version keeps the stack of a team in static shared memory, so
+    // it has to fit in there. Otherwise use global memory instead.
+    if (SharedStackType == SharedStackType_Fast &&
+        SharedStackSizePerTeam > MAX_SHARED_MEMORY_PER_TEAM) {
+      CGM.getDiags().Report(diag::warn_fe_omp_sharing_stack_too_large)
+          << (unsigned)SharedStackSizePerTeam
+          << (unsigned)MAX_SHARED_MEMORY_PER_TEAM;
+      SharedStackType = SharedStackType_Default;
+    }
+
+    // In global memory the stack of team N starts at N times the size per
+    // team in the storage given by the user, so it has to fit the stacks of
+    // all the teams that may run.
+    if (SharedStackType != SharedStackType_Fast &&
+        SharedStackSize < SharedStackSizePerTeam * MAX_NUM_TEAMS)
+      SharedStackSize = SharedStackSizePerTeam * MAX_NUM_TEAMS;
+    return true;
+  }
+
   /// This is a hook to enable postprocessing of the module. By default this
   /// only does the creation of globals from local variables due to data sharing
   /// constraints
   void PostProcessModule(CodeGenModule &CGM) {
 
-    if (ValuesToBeInSharedMemory.size()){
+    if (ComputeSharedStackSizes(CGM)) {
       // We need to use a shared address space in order to share data between
       // threads. This data is going to be stored in the form of a stack and
       // currently support 2 nesting levels.
@@ -4193,13 +4641,14 @@ public:
             OffsetBlk = Bld.CreateAdd(OffsetBlk, TeamOffset);
           }
 
-          // Add the size of the struct to the stack pointer so we can start
-          // reserving the right size for the VLAs after that.
-          llvm::Value *InitialOffset = llvm::ConstantInt::get(CGM.SizeTy, 0);
-          InitialOffset = Bld.CreateAdd(InitialOffset, OffsetThd);
-          InitialOffset = Bld.CreateAdd(InitialOffset, OffsetBlk);
-          InitialOffset = Bld.CreateAdd(
-              InitialOffset,
+          // The struct lives at the base of the storage of this level. Add
+          // its size to the stack pointer so we can start reserving the right
+          // size for the VLAs after that.
+          llvm::Value *BaseOffset = llvm::ConstantInt::get(CGM.SizeTy, 0);
+          BaseOffset = Bld.CreateAdd(BaseOffset, OffsetThd);
+          BaseOffset = Bld.CreateAdd(BaseOffset, OffsetBlk);
+          llvm::Value *InitialOffset = Bld.CreateAdd(
+              BaseOffset,
               llvm::ConstantInt::get(
                   CGM.SizeTy,
                   CGM.getModule().getDataLayout().getTypeAllocSize(LevelTy)));
@@ -4215,7 +4664,7 @@ public:
 
             if (!LevelIdx) {
               llvm::Value *InitialOffsetIdx[] = {
-                  llvm::ConstantInt::get(CGM.SizeTy, 0), InitialOffset};
+                  llvm::ConstantInt::get(CGM.SizeTy, 0), BaseOffset};
               llvm::Value *SharedStructPtr =
                   Bld.CreateGEP(SharedData, InitialOffsetIdx);
               return Bld.CreateBitCast(SharedStructPtr, LevelTyPtr);
@@ -20,6 +20,7 @@
 #include "clang/Basic/OpenMPKinds.h"
 #include "clang/Basic/SourceLocation.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallSet.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 #include "CodeGenModule.h"
@@ -156,6 +157,13 @@ protected:
   /// \brief Map of local gtid and functions.
   typedef llvm::DenseMap<llvm::Function *, llvm::Value *> OpenMPGtidMapTy;
   OpenMPGtidMapTy OpenMPGtidMap;
+  /// \brief Map of the region kind and location string of the regions
+  /// profiled under -fopenmp-instrument to their descriptors.
+  typedef llvm::StringMap<llvm::Constant *> OpenMPRegionDescMapTy;
+  OpenMPRegionDescMapTy OpenMPRegionDescMap;
+  /// \brief Ids of the region descriptors created so far, used to resolve
+  /// collisions of their hashes.
+  llvm::SmallSet<uint32_t, 16> OpenMPRegionDescIds;
 
   // Number of target regions processed so far
   unsigned NumTargetRegions;
@@ -391,8 +399,13 @@ public:
   DEFAULT_EMIT_OPENMP_DECL(end_single)
   DEFAULT_EMIT_OPENMP_DECL(critical)
   DEFAULT_EMIT_OPENMP_DECL(end_critical)
+  DEFAULT_EMIT_OPENMP_DECL(critical_with_hint)
   DEFAULT_EMIT_OPENMP_DECL(ordered)
   DEFAULT_EMIT_OPENMP_DECL(end_ordered)
+  DEFAULT_EMIT_OPENMP_DECL(doacross_init)
+  DEFAULT_EMIT_OPENMP_DECL(doacross_wait)
+  DEFAULT_EMIT_OPENMP_DECL(doacross_post)
+  DEFAULT_EMIT_OPENMP_DECL(doacross_fini)
   DEFAULT_EMIT_OPENMP_DECL(end_reduce_nowait)
   DEFAULT_EMIT_OPENMP_DECL(end_reduce)
   DEFAULT_EMIT_OPENMP_DECL(atomic_start)
@@ -419,16 +432,25 @@ public:
   DEFAULT_EMIT_OPENMP_DECL(omp_task_parts)
   DEFAULT_EMIT_OPENMP_DECL(taskgroup)
   DEFAULT_EMIT_OPENMP_DECL(end_taskgroup)
+  DEFAULT_EMIT_OPENMP_DECL(task_reduction_init)
+  DEFAULT_EMIT_OPENMP_DECL(task_reduction_get_th_data)
+  DEFAULT_EMIT_OPENMP_DECL(instr_region_begin)
+  DEFAULT_EMIT_OPENMP_DECL(instr_region_acquired)
+  DEFAULT_EMIT_OPENMP_DECL(instr_region_end)
   DEFAULT_EMIT_OPENMP_DECL(register_lib)
   DEFAULT_EMIT_OPENMP_DECL(unregister_lib)
 
   DEFAULT_EMIT_OPENMP_DECL(threadprivate_register)
   DEFAULT_EMIT_OPENMP_DECL(global_thread_num)
+  DEFAULT_EMIT_OPENMP_DECL(bound_thread_num)
+  DEFAULT_EMIT_OPENMP_DECL(bound_num_threads)
 
   DEFAULT_EMIT_OPENMP_DECL(kernel_init)
   DEFAULT_EMIT_OPENMP_DECL(kernel_prepare_parallel)
   DEFAULT_EMIT_OPENMP_DECL(kernel_parallel)
   DEFAULT_EMIT_OPENMP_DECL(kernel_end_parallel)
+  DEFAULT_EMIT_OPENMP_DECL(spmd_kernel_init)
+  DEFAULT_EMIT_OPENMP_DECL(spmd_kernel_deinit)
 
   DEFAULT_EMIT_OPENMP_DECL(serialized_parallel)
   DEFAULT_EMIT_OPENMP_DECL(end_serialized_parallel)
@@ -506,10 +528,24 @@ public:
   /// \brief Creates a structure with the location info for Intel OpenMP RTL.
   virtual llvm::Value *CreateIntelOpenMPRTLLoc(SourceLocation Loc,
       CodeGenFunction &CGF, unsigned Flags = 0x02);
+  /// \brief Creates the constant descriptor of a region of kind \a Kind
+  /// passed to the profiling hooks emitted under -fopenmp-instrument.
+  virtual llvm::Constant *CreateOpenMPRegionDescriptor(SourceLocation Loc,
+      CodeGenFunction &CGF, unsigned Kind);
   /// \brief Creates call to "__kmpc_global_thread_num(ident_t *loc)" OpenMP
   /// RTL function.
   virtual llvm::Value *CreateOpenMPGlobalThreadNum(SourceLocation Loc,
       CodeGenFunction &CGF);
+  /// \brief Creates call to "__kmpc_bound_thread_num(ident_t *loc)" OpenMP
+  /// RTL function. The result is computed once in the entry block of the
+  /// current function.
+  virtual llvm::Value *CreateOpenMPBoundThreadNum(SourceLocation Loc,
+      CodeGenFunction &CGF);
+  /// \brief Creates call to "__kmpc_bound_num_threads(ident_t *loc)" OpenMP
+  /// RTL function. The result is computed once in the entry block of the
+  /// current function.
+  virtual llvm::Value *CreateOpenMPBoundNumThreads(SourceLocation Loc,
+      CodeGenFunction &CGF);
   /// \brief Checks if the variable is OpenMP threadprivate and generates code
   /// for threadprivate variables.
   /// \return 0 if the variable is not threadprivate, or new address otherwise.
@@ -517,6 +553,29 @@ public:
                                                SourceLocation Loc,
                                                CodeGenFunction &CGF,
                                                bool NoCast = false);
+  /// \brief Returns true if the threadprivate variable \a VD is emitted as a
+  /// thread_local global (-fopenmp-use-tls on ELF targets) rather than
+  /// through __kmpc_threadprivate_cached.
+  virtual bool isThreadPrivateTLS(const VarDecl *VD);
+  /// \brief Returns true if the copies of the thread_local threadprivate
+  /// variable \a VD are constructed on first touch.
+  bool needsThreadPrivateTLSInit(const VarDecl *VD);
+  /// \brief Returns true if \a VD is not constructed on first touch but has
+  /// a dynamic initializer, which is run again for the copy of each thread.
+  bool hasThreadPrivateTLSDynamicInit(const VarDecl *VD);
+  /// \brief Returns true if \a VD is not constructed on first touch and is
+  /// defined in another translation unit, where it may have a dynamic
+  /// initializer.
+  bool mayHaveThreadPrivateTLSDynamicInit(const VarDecl *VD);
+  /// \brief Returns the address of the thread_local threadprivate variable
+  /// \a VD.
+  llvm::Value *GetAddrOfThreadPrivateTLS(const VarDecl *VD);
+  /// \brief Returns the thread_local flag set once the copy of \a VD of the
+  /// current thread is constructed.
+  llvm::GlobalVariable *GetThreadPrivateTLSGuard(const VarDecl *VD);
+  /// \brief Returns the function constructing or initializing the copy of
+  /// \a VD of the current thread.
+  llvm::Function *GetThreadPrivateTLSInit(const VarDecl *VD);
 
   /// \brief  Return a string with the mangled name of a target region or global
   /// entry point. The client can choose to invalidate the used order entry.
@@ -555,8 +614,9 @@ public:
   ///
   llvm::Constant* GetDeviceImageEndPointer(llvm::Triple TargetTriple);
 
-  // \brief If needed, re-initialize part of the state
-  virtual void StartNewTargetRegion();
+  // \brief If needed, re-initialize part of the state for the target region
+  // of directive \a S
+  virtual void StartNewTargetRegion(const OMPExecutableDirective &S);
 
   // \brief if needed, record that codegen hit teams construct
   virtual void StartTeamsRegion();
@@ -566,6 +626,13 @@ public:
   virtual void EmitOMPBarrier(SourceLocation L, unsigned Flags,
                               CodeGenFunction &CGF);
 
+  /// \brief Emits a flush of the variables at the addresses \a Vars, or of
+  /// all the variables if \a Vars is empty. By default it is a sequentially
+  /// consistent fence, the runtime is called on devices and under
+  /// -fopenmp-runtime-flush.
+  virtual void EmitOMPFlush(SourceLocation L, ArrayRef<llvm::Value *> Vars,
+                            CodeGenFunction &CGF);
+
   /// \brief Code generation helper in target regions. Create a control-loop
   //  with inspector/executor for special back-ends (e.g. nvptx)
   virtual void EnterTargetControlLoop(SourceLocation Loc, CodeGenFunction &CGF,
@@ -626,6 +693,11 @@ public:
 
   virtual bool RequireFirstprivateSynchronization() { return true; }
 
+  // \brief Return true if all the threads of the current target region run
+  // its code from the start (SPMD), so no control loop is generated and no
+  // data has to be shared between threads
+  virtual bool isSPMDExecutionMode() { return false; }
+
   virtual void EnterParallelRegionInTarget(CodeGenFunction &CGF,
                                            OpenMPDirectiveKind DKind,
                                            ArrayRef<OpenMPDirectiveKind> SKinds,
@@ -72,8 +72,23 @@ typedef void(__kmpc_critical)(ident_t *loc, int32_t global_tid,
                               kmp_critical_name *lck);
 typedef void(__kmpc_end_critical)(ident_t *loc, int32_t global_tid,
                                   kmp_critical_name *lck);
+typedef void(__kmpc_critical_with_hint)(ident_t *loc, int32_t global_tid,
+                                        kmp_critical_name *lck, uint32_t hint);
+// Lock hints, in the encoding of omp_lock_hint_t.
+const int KMP_LOCK_HINT_UNCONTENDED = 1;
+const int KMP_LOCK_HINT_CONTENDED = 2;
+const int KMP_LOCK_HINT_NONSPECULATIVE = 4;
+const int KMP_LOCK_HINT_SPECULATIVE = 8;
 typedef void(__kmpc_ordered)(ident_t *loc, int32_t global_tid);
 typedef void(__kmpc_end_ordered)(ident_t *loc, int32_t global_tid);
+// Doacross loops; dims points to num_dims triples of {lo, up, st} (kmp_dim).
+typedef void(__kmpc_doacross_init)(ident_t *loc, int32_t global_tid,
+                                   int32_t num_dims, int64_t *dims);
+typedef void(__kmpc_doacross_wait)(ident_t *loc, int32_t global_tid,
+                                   int64_t *vec);
+typedef void(__kmpc_doacross_post)(ident_t *loc, int32_t global_tid,
+                                   int64_t *vec);
+typedef void(__kmpc_doacross_fini)(ident_t *loc, int32_t global_tid);
 typedef void (*kmp_copy_func)(void *lhs_data, void *rhs_data);
 typedef void(__kmpc_copyprivate)(ident_t *loc, int32_t global_tid,
                                  target_size_t cpy_size, void *cpy_data,
@@ -149,6 +164,7 @@ const int KMP_SCH_DYNAMIC_CHUNKED = 35;
 const int KMP_SCH_GUIDED_CHUNKED = 36;
 const int KMP_SCH_RUNTIME = 37;
 const int KMP_SCH_AUTO = 38;
+const int KMP_SCH_STATIC_STEAL = 44;
 const int KMP_ORD_STATIC_CHUNKED = 65;
 // const int KMP_ORD_STATIC = 66;
 // const int KMP_ORD_DYNAMIC_CHUNKED = 67;
@@ -180,6 +196,8 @@ const int OMP_TASK_TIED = 1;
 const int OMP_TASK_FINAL = 2;
 const int OMP_TASK_DESTRUCTORS_THUNK = 8;
 const int OMP_TASK_CURRENT_QUEUED = 1;
+// Number of tasks generated by 'taskloop' without grainsize/num_tasks.
+const int OMP_TASKLOOP_DEFAULT_NUM_TASKS = 64;
 struct kmp_depend_info_t {};
 const unsigned char IN = 1;
 const unsigned char OUT = 2;
@@ -206,6 +224,23 @@ typedef int32_t(__kmpc_omp_task_parts)(ident_t *loc, int32_t gtid,
                                        kmp_task_t *task);
 typedef void(__kmpc_taskgroup)(ident_t *loc, int32_t global_tid);
 typedef void(__kmpc_end_taskgroup)(ident_t *loc, int32_t global_tid);
+// Description of a task reduction item, data points to num of them.
+struct kmp_task_red_input_t {};
+typedef void *(__kmpc_task_reduction_init)(int32_t gtid, int32_t num,
+                                           void *data);
+typedef void *(__kmpc_task_reduction_get_th_data)(int32_t gtid, void *tg,
+                                                  void *d);
+// Region profiling hooks emitted under -fopenmp-instrument. The descriptor
+// is a constant { int32_t id; int32_t kind; const char *psource; }.
+const int KMP_INSTR_REGION_PARALLEL = 0;
+const int KMP_INSTR_REGION_LOOP = 1;
+const int KMP_INSTR_REGION_BARRIER = 2;
+const int KMP_INSTR_REGION_CRITICAL = 3;
+const int KMP_INSTR_REGION_TASK = 4;
+typedef void(__kmpc_instr_region_begin)(void *desc, int32_t gtid);
+typedef void(__kmpc_instr_region_acquired)(void *desc, int32_t gtid);
+typedef void(__kmpc_instr_region_end)(void *desc, int32_t gtid,
+                                      int64_t iterations);
 
 // TO BE REMOVED
 typedef void(___kmpc_print_int)(int32_t data);
@@ -222,6 +257,8 @@ typedef int(__kmpc_kernel_prepare_parallel)(int32_t num_threads,
                                             int32_t num_simd_lanes);
 typedef void(__kmpc_kernel_parallel)(int32_t num_simd_lanes);
 typedef void(__kmpc_kernel_end_parallel)();
+typedef void(__kmpc_spmd_kernel_init)(int32_t thread_limit);
+typedef void(__kmpc_spmd_kernel_deinit)();
 typedef void(__kmpc_serialized_parallel)(ident_t *loc, int32_t global_tid);
 typedef void(__kmpc_end_serialized_parallel)(ident_t *loc, int32_t global_tid);
 
@@ -233,6 +270,8 @@ typedef void(__kmpc_threadprivate_register)(ident_t *loc, void *data,
                                             kmpc_ctor ctor, kmpc_cctor cctor,
                                             kmpc_dtor dtor);
 typedef int32_t(__kmpc_global_thread_num)(ident_t *loc);
+typedef int32_t(__kmpc_bound_thread_num)(ident_t *loc);
+typedef int32_t(__kmpc_bound_num_threads)(ident_t *loc);
 typedef void *(__kmpc_threadprivate_cached)(ident_t *loc, int32_t global_tid,
                                             void *data, target_size_t size,
                                             void ***cache);
@@ -325,6 +364,21 @@ public:
   }
   enum { shareds, routine, part_id, destructors, firstprivate_locker };
 };
+///   kmp_task_red_input_t, whose size has the width of size_t on the target
+template <bool X> class TypeBuilder<kmp_task_red_input_t, X> {
+public:
+  static StructType *get(LLVMContext &C, IntegerType *SizeTy) {
+    return StructType::get(
+        TypeBuilder<void *, X>::get(C),             // shar
+        SizeTy,                                     // size
+        TypeBuilder<void *, X>::get(C),             // init
+        TypeBuilder<void *, X>::get(C),             // fini
+        TypeBuilder<void *, X>::get(C),             // comb
+        TypeBuilder<llvm::types::i<32>, X>::get(C), // flags
+        NULL);
+  }
+  enum { shar, size, init, fini, comb, flags };
+};
 template <typename R, typename A1, typename A2, typename A3, typename A4,
           typename A5, typename A6, typename A7, bool cross>
 class TypeBuilder<R(A1, A2, A3, A4, A5, A6, A7), cross> {
@@ -423,6 +477,7 @@ public:
 typedef llvm::TypeBuilder<kmp_task_t, false> TaskTBuilder;
 typedef llvm::TypeBuilder<kmp_proc_bind_t, false> ProcBindTBuilder;
 typedef llvm::TypeBuilder<ident_t, false> IdentTBuilder;
+typedef llvm::TypeBuilder<kmp_task_red_input_t, false> TaskRedInputTBuilder;
 
 ///// Specializations of llvm::TypeBuilder for:
 /////   ident_t
@@ -289,6 +289,12 @@ void CodeGenFunction::EmitStmt(const Stmt *S) {
   case Stmt::OMPTaskDirectiveClass:
     EmitOMPTaskDirective(cast<OMPTaskDirective>(*S));
     break;
+  case Stmt::OMPTaskLoopDirectiveClass:
+    EmitOMPTaskLoopDirective(cast<OMPTaskLoopDirective>(*S));
+    break;
+  case Stmt::OMPTaskLoopSimdDirectiveClass:
+    EmitOMPTaskLoopSimdDirective(cast<OMPTaskLoopSimdDirective>(*S));
+    break;
   case Stmt::OMPTaskyieldDirectiveClass:
     EmitOMPTaskyieldDirective(cast<OMPTaskyieldDirective>(*S));
     break;
@@ -356,8 +362,16 @@ CodeGenFunction::EmitCompoundStmtWithoutScope(const CompoundStmt &S,
                                               AggValueSlot AggSlot) {
 
   for (CompoundStmt::const_body_iterator I = S.body_begin(),
-       E = S.body_end()-GetLast; I != E; ++I)
+       E = S.body_end()-GetLast; I != E; ++I) {
+    // Adjacent OpenMP parallel regions may be emitted as a single fork.
+    if (getLangOpts().OpenMPMergeParallel && isa<OMPParallelDirective>(*I))
+      if (unsigned NumMerged =
+              EmitOMPMergedParallelDirectives(ArrayRef<Stmt *>(I, E))) {
+        I += NumMerged - 1;
+        continue;
+      }
     EmitStmt(*I);
+  }
 
   llvm::Value *RetAlloca = nullptr;
   if (GetLast) {
@@ -2172,6 +2186,18 @@ CodeGenFunction::GenerateCapturedStmtFunction(const CapturedStmt &S) {
   ASTContext &Ctx = CGM.getContext();
   FunctionArgList Args;
   Args.append(CD->param_begin(), CD->param_end());
+  // Bodies of OpenMP simd loops are called on every iteration. They get the
+  // global thread id of the enclosing region as a trailing argument instead
+  // of querying the runtime on each call.
+  ImplicitParamDecl *GTidParam = 0;
+  if (CGSIMDForStmtInfo *Info = dyn_cast<CGSIMDForStmtInfo>(CapturedStmtInfo))
+    if (Info->isOmp() && CGM.getLangOpts().OpenMP &&
+        !CGM.getLangOpts().OpenMPTargetMode) {
+      GTidParam = ImplicitParamDecl::Create(
+          Ctx, const_cast<CapturedDecl *>(CD), Loc, &Ctx.Idents.get("gtid"),
+          Ctx.getIntTypeForBitwidth(32, 1));
+      Args.push_back(GTidParam);
+    }
 
   // Create the function declaration.
   FunctionType::ExtInfo ExtInfo;
@@ -2189,6 +2215,14 @@ CodeGenFunction::GenerateCapturedStmtFunction(const CapturedStmt &S) {
   StartFunction(CD, Ctx.VoidTy, F, FuncInfo, Args,
                 CD->getLocation(),
                 CD->getBody()->getLocStart());
+  // Make the passed thread id visible to the OpenMP runtime codegen.
+  llvm::AllocaInst *GTidTemp = 0;
+  if (GTidParam) {
+    GTidTemp =
+        CreateMemTemp(GTidParam->getType(), ".__kmpc_global_thread_num.");
+    Builder.CreateStore(Builder.CreateLoad(GetAddrOfLocalVar(GTidParam)),
+                        GTidTemp);
+  }
   // Set the context parameter in CapturedStmtInfo.
   llvm::Value *DeclPtr = LocalDeclMap[CD->getContextParam()];
   assert(DeclPtr && "missing context parameter for CapturedStmt");
@@ -2225,6 +2259,13 @@ CodeGenFunction::GenerateCapturedStmtFunction(const CapturedStmt &S) {
   CapturedStmtInfo->EmitBody(*this, CD->getBody());
   FinishFunction(CD->getBodyRBrace());
 
+  // If the body did not need the thread id, drop the temporary so that the
+  // callers know they do not have to compute it.
+  if (GTidTemp && GTidTemp->hasOneUse()) {
+    cast<llvm::Instruction>(GTidTemp->user_back())->eraseFromParent();
+    GTidTemp->eraseFromParent();
+  }
+
   CGM.OpenMPSupport.endOpenMPRegion();
 
   return F;
@@ -2235,7 +2276,7 @@ void CodeGenFunction::EmitSIMDForHelperCall(llvm::Function *BodyFunc,
                                             llvm::Value *LoopIndex,
                                             bool IsLastIter) {
   // Emit call to the helper function.
-  SmallVector<llvm::Value *, 3> HelperArgs;
+  SmallVector<llvm::Value *, 4> HelperArgs;
   HelperArgs.push_back(CapStruct.getAddress());
   HelperArgs.push_back(Builder.CreateLoad(LoopIndex));
 
@@ -2246,6 +2287,21 @@ void CodeGenFunction::EmitSIMDForHelperCall(llvm::Function *BodyFunc,
     LastIter = llvm::ConstantInt::getFalse(BodyFunc->getContext());
   HelperArgs.push_back(LastIter);
 
+  // OpenMP simd helpers take the global thread id as a trailing argument
+  // (see GenerateCapturedStmtFunction). It is computed only if the helper
+  // really uses it.
+  if (BodyFunc->arg_size() > HelperArgs.size()) {
+    bool UsesGTid = false;
+    llvm::BasicBlock &EntryBB = BodyFunc->getEntryBlock();
+    for (llvm::BasicBlock::iterator I = EntryBB.begin(), E = EntryBB.end();
+         I != E && !UsesGTid; ++I)
+      UsesGTid = I->getName().startswith(".__kmpc_global_thread_num.");
+    HelperArgs.push_back(
+        UsesGTid ? CGM.getOpenMPRuntime().CreateOpenMPGlobalThreadNum(
+                       SourceLocation(), *this)
+                 : llvm::UndefValue::get(Int32Ty));
+  }
+
   disableExceptions();
   EmitCallOrInvoke(BodyFunc, HelperArgs);
   enableExceptions();
@@ -2639,6 +2695,45 @@ void CodeGenFunction::InitOpenMPTargetFunction(const OMPExecutableDirective &D,
   }
 }
 
+/// \brief Returns the initial value of the local scalar \a VD if it is a
+/// constant that is never changed in the scope of the variable, or null
+/// otherwise. Such a variable does not escape to the threads of an enclosed
+/// region, each of them can hold its own copy.
+static llvm::Constant *getOMPInvariantLocalValue(CodeGenModule &CGM,
+                                                 CodeGenFunction &CGF,
+                                                 const VarDecl *VD) {
+  if (isa<ParmVarDecl>(VD) || !VD->hasLocalStorage() || !VD->getInit())
+    return nullptr;
+  QualType Ty = VD->getType();
+  if (!Ty->isScalarType() || Ty.isVolatileQualified())
+    return nullptr;
+
+  const Stmt *Scope =
+      Decl::castFromDeclContext(VD->getDeclContext())->getBody();
+  if (!Scope || !CodeGenFunction::isOMPReadOnlyVar(Scope, VD))
+    return nullptr;
+
+  return CGM.EmitConstantInit(*VD, &CGF);
+}
+
+/// \brief Store the invariant value \a Init in \a AI right after the allocas
+/// of the function. Every thread runs the entry block, so all the copies of
+/// the variable are initialized before any region is entered.
+static void emitOMPInvariantLocalInit(llvm::Instruction *AllocaInsertPt,
+                                      llvm::AllocaInst *AI,
+                                      llvm::Constant *Init, CharUnits Align) {
+  // The variable may be captured by more than one region.
+  llvm::BasicBlock *EntryBB = AllocaInsertPt->getParent();
+  for (llvm::User *U : AI->users())
+    if (auto *SI = dyn_cast<llvm::StoreInst>(U))
+      if (SI->getParent() == EntryBB && SI->getValueOperand() == Init)
+        return;
+
+  llvm::StoreInst *SI = new llvm::StoreInst(Init, AI);
+  SI->setAlignment(Align.getQuantity());
+  SI->insertAfter(AllocaInsertPt);
+}
+
 void CodeGenFunction::InitOpenMPSharedizeParameters(
 		const CapturedStmt &S,
 		SmallVector<const VarDecl *, 8> &MappingDecls,
@@ -2727,10 +2822,17 @@ void CodeGenFunction::InitOpenMPSharedizeParameters(
 	      continue;
 
             // We only need to force it to be shared if it is a local var
-            // (alloc in in the stack).
-            if (isa<llvm::AllocaInst>(GblCandidate)) {
-              CGM.getOpenMPRuntime().addToSharedRegion(GblCandidate,
-                                                       NestingLevel);
+            // (alloc in in the stack) that escapes to the other threads.
+            if (auto *AI = dyn_cast<llvm::AllocaInst>(GblCandidate)) {
+              llvm::Constant *Init = nullptr;
+              if (!IsPrivateCandidate)
+                Init = getOMPInvariantLocalValue(CGM, *this, VD);
+              if (Init && Init->getType() == AI->getAllocatedType())
+                emitOMPInvariantLocalInit(AllocaInsertPt, AI, Init,
+                                          getContext().getDeclAlign(VD));
+              else
+                CGM.getOpenMPRuntime().addToSharedRegion(GblCandidate,
+                                                         NestingLevel);
             }
 	    else if (!IsPrivateCandidate) {
 	      continue;
@@ -29,6 +29,8 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/GlobalVariable.h"
@@ -89,7 +91,8 @@ static bool isLoopDirective(const OMPExecutableDirective *ED) {
          isa<OMPTeamsDistributeDirective>(ED) ||
          isa<OMPTeamsDistributeSimdDirective>(ED) ||
          isa<OMPTargetTeamsDistributeDirective>(ED) ||
-         isa<OMPTargetTeamsDistributeSimdDirective>(ED);
+         isa<OMPTargetTeamsDistributeSimdDirective>(ED) ||
+         isa<OMPTaskLoopDirective>(ED) || isa<OMPTaskLoopSimdDirective>(ED);
 }
 
 static bool isParallelDirective(const OMPExecutableDirective *ED) {
@@ -163,6 +166,13 @@ static const Expr *getInitFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getInit();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getInit();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getInit();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -232,6 +242,13 @@ static const Expr *getFinalFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getFinal();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getFinal();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getFinal();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -302,6 +319,13 @@ getNewIterVarFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getNewIterVar();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getNewIterVar();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getNewIterVar();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -372,6 +396,13 @@ getNewIterEndFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getNewIterEnd();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getNewIterEnd();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getNewIterEnd();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -402,6 +433,13 @@ getLowerBoundFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeParallelForSimdDirective>(ED)) {
     return D->getLowerBound();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getLowerBound();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getLowerBound();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -432,6 +470,13 @@ getUpperBoundFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeParallelForSimdDirective>(ED)) {
     return D->getUpperBound();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getUpperBound();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getUpperBound();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -502,6 +547,13 @@ getCountersFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getCounters();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getCounters();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getCounters();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -572,6 +624,13 @@ getCollapsedNumberFromLoopDirective(const OMPExecutableDirective *ED) {
           dyn_cast<OMPTargetTeamsDistributeSimdDirective>(ED)) {
     return D->getCollapsedNumber();
   }
+  if (const OMPTaskLoopDirective *D = dyn_cast<OMPTaskLoopDirective>(ED)) {
+    return D->getCollapsedNumber();
+  }
+  if (const OMPTaskLoopSimdDirective *D =
+          dyn_cast<OMPTaskLoopSimdDirective>(ED)) {
+    return D->getCollapsedNumber();
+  }
   assert(0 && "bad loop directive");
   return 0;
 }
@@ -780,12 +839,16 @@ public:
   }
 };
 
-static void SetFirstprivateInsertPt(CodeGenFunction &CGF) {
+static void ClearFirstprivateInsertPt(CodeGenFunction &CGF) {
   if (CGF.FirstprivateInsertPt) {
     llvm::Instruction *Ptr = CGF.FirstprivateInsertPt;
     CGF.FirstprivateInsertPt = 0;
     Ptr->eraseFromParent();
   }
+}
+
+static void SetFirstprivateInsertPt(CodeGenFunction &CGF) {
+  ClearFirstprivateInsertPt(CGF);
   llvm::Value *Undef = llvm::UndefValue::get(CGF.Int32Ty);
   CGF.FirstprivateInsertPt = new llvm::BitCastInst(
       Undef, CGF.Int32Ty, "", CGF.Builder.GetInsertBlock());
@@ -854,10 +917,65 @@ bool CodeGenFunction::IsCombinedDirectiveLoopBoundCapture(
 }
 
 
+/// \brief Emits the call to the profiling hook entering the region of kind
+/// \a Kind at \a L under -fopenmp-instrument. Returns the descriptor of the
+/// region, or null if the regions are not instrumented.
+llvm::Value *CodeGenFunction::EmitOMPInstrRegionBegin(unsigned Kind,
+                                                      SourceLocation L) {
+  // The collector runs on the host only.
+  if (!CGM.getLangOpts().OpenMPInstrument ||
+      CGM.getLangOpts().OpenMPTargetMode)
+    return 0;
+  llvm::Value *Desc =
+      CGM.getOpenMPRuntime().CreateOpenMPRegionDescriptor(L, *this, Kind);
+  llvm::Value *RealArgs[] = {Desc, OPENMPRTL_THREADNUM(L, *this)};
+  EmitRuntimeCall(OPENMPRTL_FUNC(instr_region_begin), RealArgs);
+  return Desc;
+}
+
+/// \brief Emits the call to the profiling hook marking the end of the wait
+/// at the entry of the region \a Desc (e.g. the lock of a critical region).
+void CodeGenFunction::EmitOMPInstrRegionAcquired(llvm::Value *Desc,
+                                                 SourceLocation L) {
+  if (!Desc)
+    return;
+  llvm::Value *RealArgs[] = {Desc, OPENMPRTL_THREADNUM(L, *this)};
+  EmitRuntimeCall(OPENMPRTL_FUNC(instr_region_acquired), RealArgs);
+}
+
+/// \brief Emits the call to the profiling hook leaving the region \a Desc.
+/// \a Iterations is the number of loop iterations executed by the thread.
+void CodeGenFunction::EmitOMPInstrRegionEnd(llvm::Value *Desc,
+                                            SourceLocation L,
+                                            llvm::Value *Iterations) {
+  if (!Desc)
+    return;
+  llvm::Value *RealArgs[] = {
+      Desc, OPENMPRTL_THREADNUM(L, *this),
+      Iterations ? Iterations : llvm::ConstantInt::get(Int64Ty, 0)};
+  EmitRuntimeCall(OPENMPRTL_FUNC(instr_region_end), RealArgs);
+}
+
+namespace {
+/// \brief Calls the profiling hook leaving an instrumented region on every
+/// exit from it, including the branches taken on cancellation.
+struct CallOMPInstrRegionEnd final : EHScopeStack::Cleanup {
+  llvm::Value *Desc;
+  SourceLocation Loc;
+  CallOMPInstrRegionEnd(llvm::Value *Desc, SourceLocation Loc)
+      : Desc(Desc), Loc(Loc) {}
+  void Emit(CodeGenFunction &CGF, Flags flags) override {
+    CGF.EmitOMPInstrRegionEnd(Desc, Loc);
+  }
+};
+} // namespace
+
 void CodeGenFunction::EmitOMPBarrier(SourceLocation L, unsigned Flags) {
+  llvm::Value *InstrDesc = EmitOMPInstrRegionBegin(KMP_INSTR_REGION_BARRIER, L);
   // specialized as part of the runtime, as specific devices may
   // require specialized support
   CGM.getOpenMPRuntime().EmitOMPBarrier(L, Flags, *this);
+  EmitOMPInstrRegionEnd(InstrDesc, L);
 }
 
 void CodeGenFunction::EmitOMPCancelBarrier(SourceLocation L, unsigned Flags,
@@ -865,8 +983,11 @@ void CodeGenFunction::EmitOMPCancelBarrier(SourceLocation L, unsigned Flags,
   if (OMPCancelMap.empty()) {
     EmitOMPBarrier(L, Flags);
   } else {
+    llvm::Value *InstrDesc =
+        EmitOMPInstrRegionBegin(KMP_INSTR_REGION_BARRIER, L);
     llvm::Value *CallRes = EmitOMPCallWithLocAndTidHelper(
         OPENMPRTL_FUNC(cancel_barrier), L, Flags);
+    EmitOMPInstrRegionEnd(InstrDesc, L);
     if (!IgnoreResult) {
       JumpDest FinalBB;
       if (OMPCancelMap.count(OMPD_for))
@@ -1103,6 +1224,13 @@ void CodeGenFunction::EmitOMPDirectiveWithParallelMicrotask(
   CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(Arg1),
                          ".__kmpc_global_thread_num.");
 
+  // Cancellation of an instrumented region leaves it through the exit hook.
+  llvm::Value *InstrDesc =
+      CGF.EmitOMPInstrRegionBegin(KMP_INSTR_REGION_PARALLEL, S.getLocStart());
+  if (InstrDesc)
+    CGF.EHStack.pushCleanup<CallOMPInstrRegionEnd>(NormalCleanup, InstrDesc,
+                                                   S.getLocEnd());
+
   // Emit call to the helper function.
   llvm::Value *Arg3Val =
       CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(Arg3), "arg3");
@@ -1161,6 +1289,8 @@ void CodeGenFunction::EmitOMPDirectiveWithParallelMicrotask(
   if (DKind == OMPD_parallel) {
     CGF.EmitOMPCancelBarrier(S.getLocEnd(), KMP_IDENT_BARRIER_IMPL);
   }
+  if (InstrDesc)
+    CGF.PopCleanupBlock();
 
   EmitFirstprivateInsert(CGF, S.getLocStart());
 
@@ -1192,6 +1322,366 @@ void CodeGenFunction::EmitOMPDirectiveWithParallelMicrotask(
   CGM.OpenMPSupport.endOpenMPRegion();
 }
 
+/// \brief Returns true if \a S contains a 'cancel' or 'cancellation point'
+/// construct, including in the bodies of nested regions.
+static bool HasOMPCancel(const Stmt *S) {
+  if (!S)
+    return false;
+  if (isa<OMPCancelDirective>(S) || isa<OMPCancellationPointDirective>(S))
+    return true;
+  SmallVector<const Stmt *, 8> Children;
+  CodeGenFunction::getOMPNestedStmts(S, Children);
+  for (const Stmt *Child : Children)
+    if (HasOMPCancel(Child))
+      return true;
+  return false;
+}
+
+/// \brief Returns true if \a S is a '#pragma omp parallel' directive that can
+/// share its team with the adjacent regions: its clauses may only describe
+/// the data environment of the region, so that all the merged regions fork
+/// the same number of threads.
+static bool IsMergeableParallelRegion(const Stmt *S) {
+  const auto *D = dyn_cast<OMPParallelDirective>(S);
+  if (!D)
+    return false;
+  for (const OMPClause *C : D->clauses()) {
+    if (!C)
+      continue;
+    switch (C->getClauseKind()) {
+    case OMPC_default:
+    case OMPC_shared:
+    case OMPC_private:
+    case OMPC_firstprivate:
+    case OMPC_copyin:
+      break;
+    default:
+      return false;
+    }
+  }
+  return !HasOMPCancel(
+      cast<CapturedStmt>(D->getAssociatedStmt())->getCapturedStmt());
+}
+
+/// \brief Returns true if the serial statement \a S may be moved into the
+/// outlined function of merged parallel regions and executed by the master
+/// thread. The local variables of the enclosing function that \a S refers
+/// to are added to \a Captures.
+static bool IsMergeableSerialCode(const ASTContext &Ctx, const Stmt *S,
+                                  bool TopLevel, bool InLoop, bool InSwitch,
+                                  llvm::SmallPtrSetImpl<const VarDecl *> &Locals,
+                                  llvm::SetVector<const VarDecl *> &Captures) {
+  if (!S)
+    return true;
+  // The serial code runs on the master thread of the team instead of the
+  // thread that encountered it, so it may only call functions whose result
+  // does not depend on the calling thread and that have no side effects: an
+  // arbitrary call could query the thread or team, start other parallel
+  // regions, or rely on thread-local state.  Nothing may escape the outlined
+  // function either: exceptions would terminate the program instead of
+  // unwinding the enclosing function.
+  if (const auto *CE = dyn_cast<CallExpr>(S)) {
+    const FunctionDecl *FD = CE->getDirectCallee();
+    if (!FD || !(FD->hasAttr<ConstAttr>() || FD->hasAttr<PureAttr>()))
+      return false;
+    const auto *FPT = FD->getType()->getAs<FunctionProtoType>();
+    if (Ctx.getLangOpts().Exceptions &&
+        !(FD->hasAttr<NoThrowAttr>() || (FPT && FPT->isNothrow(Ctx))))
+      return false;
+  } else if (isa<CXXConstructExpr>(S) || isa<CXXNewExpr>(S) ||
+             isa<CXXDeleteExpr>(S) || isa<CXXBindTemporaryExpr>(S))
+    return false;
+  switch (S->getStmtClass()) {
+  default:
+    break;
+  case Stmt::DeclStmtClass:
+    // Declarations at the top level are visible after the merged regions.
+    if (TopLevel)
+      return false;
+    for (const Decl *D : cast<DeclStmt>(S)->decls())
+      if (const auto *VD = dyn_cast<VarDecl>(D)) {
+        if (VD->getType()->isVariablyModifiedType())
+          return false;
+        Locals.insert(VD);
+      }
+    break;
+  case Stmt::DeclRefExprClass: {
+    const auto *DRE = cast<DeclRefExpr>(S);
+    const auto *VD = dyn_cast<VarDecl>(DRE->getDecl());
+    if (!VD || !VD->hasLocalStorage() || Locals.count(VD))
+      break;
+    if (DRE->refersToEnclosingVariableOrCapture() ||
+        VD->hasAttr<BlocksAttr>() || VD->getType()->isVariablyModifiedType())
+      return false;
+    Captures.insert(VD);
+    break;
+  }
+  case Stmt::ForStmtClass:
+  case Stmt::WhileStmtClass:
+  case Stmt::DoStmtClass:
+  case Stmt::CXXForRangeStmtClass:
+    InLoop = true;
+    break;
+  case Stmt::SwitchStmtClass:
+    InSwitch = true;
+    break;
+  case Stmt::BreakStmtClass:
+    return InLoop || InSwitch;
+  case Stmt::ContinueStmtClass:
+    return InLoop;
+  case Stmt::ReturnStmtClass:
+  case Stmt::GotoStmtClass:
+  case Stmt::IndirectGotoStmtClass:
+  case Stmt::LabelStmtClass:
+  case Stmt::GCCAsmStmtClass:
+  case Stmt::MSAsmStmtClass:
+  case Stmt::CXXTryStmtClass:
+  case Stmt::CXXThrowExprClass:
+  case Stmt::CXXThisExprClass:
+  case Stmt::LambdaExprClass:
+  case Stmt::BlockExprClass:
+  case Stmt::StmtExprClass:
+  case Stmt::CapturedStmtClass:
+    return false;
+  }
+  // OpenMP constructs in the serial code would bind to the merged team.
+  if (isa<OMPExecutableDirective>(S))
+    return false;
+  for (const Stmt *Child : S->children())
+    if (!IsMergeableSerialCode(Ctx, Child, /*TopLevel=*/false, InLoop,
+                               InSwitch, Locals, Captures))
+      return false;
+  return true;
+}
+
+/// Emits a run of adjacent '#pragma omp parallel' directives as a single
+/// fork (-fopenmp-merge-parallel):
+///
+/// void .omp_microtask.(int32_t *, int32_t *, void **args) {
+///   <region 1>(args[0]); barrier;
+///   if (__kmpc_master()) { <serial code>; __kmpc_end_master(); } barrier;
+///   <region 2>(args[1]); barrier;
+///   ...
+/// }
+/// __kmpc_fork_call(&loc, 2, .omp_microtask., args);
+///
+/// The captured records of the regions are followed in 'args' by the
+/// addresses of the locals the serial code refers to. Returns the number of
+/// statements from the beginning of \a Stmts that were emitted, 0 if there is
+/// nothing to merge.
+unsigned
+CodeGenFunction::EmitOMPMergedParallelDirectives(ArrayRef<Stmt *> Stmts) {
+  if (!CGM.getLangOpts().OpenMPMergeParallel ||
+      CGM.getLangOpts().OpenMPTargetMode ||
+      !CGM.getOpenMPRuntime().requiresMicroTaskForParallel() || OpenMPRoot ||
+      CapturedStmtInfo || BlockInfo || !HaveInsertPoint() || Stmts.empty() ||
+      !IsMergeableParallelRegion(Stmts.front()))
+    return 0;
+
+  SmallVector<const OMPParallelDirective *, 4> Regions;
+  // Serial code to be executed before each of the regions but the first one.
+  SmallVector<ArrayRef<Stmt *>, 4> Serial;
+  llvm::SmallPtrSet<const VarDecl *, 8> Locals;
+  llvm::SetVector<const VarDecl *> Captures;
+  llvm::SetVector<const VarDecl *> Pending;
+  Regions.push_back(cast<OMPParallelDirective>(Stmts.front()));
+  unsigned NumStmts = 1;
+  for (unsigned I = 1, E = Stmts.size(); I < E; ++I) {
+    if (IsMergeableParallelRegion(Stmts[I])) {
+      Regions.push_back(cast<OMPParallelDirective>(Stmts[I]));
+      ArrayRef<Stmt *> Code = Stmts.slice(NumStmts, I - NumStmts);
+      if (std::all_of(Code.begin(), Code.end(),
+                      [](const Stmt *S) { return isa<NullStmt>(S); }))
+        Code = None;
+      Serial.push_back(Code);
+      Captures.insert(Pending.begin(), Pending.end());
+      Pending.clear();
+      NumStmts = I + 1;
+      continue;
+    }
+    if (!IsMergeableSerialCode(getContext(), Stmts[I], /*TopLevel=*/true,
+                               /*InLoop=*/false, /*InSwitch=*/false, Locals,
+                               Pending))
+      break;
+    bool AllMapped = true;
+    for (const VarDecl *VD : Pending)
+      AllMapped = AllMapped && LocalDeclMap.count(VD);
+    if (!AllMapped)
+      break;
+  }
+  if (Regions.size() < 2)
+    return 0;
+
+  // Generate shared args for the captured statements and pack them with the
+  // addresses of the locals used by the serial code.
+  SmallVector<llvm::Value *, 8> Slots;
+  for (const OMPParallelDirective *S : Regions)
+    Slots.push_back(GenerateCapturedStmtArgument(
+        *cast<CapturedStmt>(S->getAssociatedStmt())));
+  for (const VarDecl *VD : Captures)
+    Slots.push_back(LocalDeclMap.lookup(VD));
+  llvm::ArrayType *SlotsTy = llvm::ArrayType::get(VoidPtrTy, Slots.size());
+  llvm::AllocaInst *Args = CreateTempAlloca(SlotsTy, ".omp.merged.args.");
+  for (unsigned I = 0, E = Slots.size(); I < E; ++I)
+    Builder.CreateStore(
+        Builder.CreateBitCast(Slots[I], VoidPtrTy),
+        Builder.CreateConstInBoundsGEP2_32(SlotsTy, Args, 0, I));
+
+  // Generate microtask.
+  IdentifierInfo *Id = &getContext().Idents.get(".omp_microtask.");
+  QualType PtrIntTy = getContext().getPointerType(getContext().IntTy);
+  SmallVector<QualType, 4> FnArgTypes;
+  FnArgTypes.push_back(PtrIntTy);
+  FnArgTypes.push_back(PtrIntTy);
+  FnArgTypes.push_back(getContext().VoidPtrTy);
+  FunctionProtoType::ExtProtoInfo EPI;
+  EPI.ExceptionSpec.Type = EST_BasicNoexcept;
+  QualType FnTy =
+      getContext().getFunctionType(getContext().VoidTy, FnArgTypes, EPI);
+  TypeSourceInfo *TI =
+      getContext().getTrivialTypeSourceInfo(FnTy, SourceLocation());
+  FunctionDecl *FD = FunctionDecl::Create(
+      getContext(), getContext().getTranslationUnitDecl(),
+      Regions.front()->getLocStart(), SourceLocation(), Id, FnTy, TI,
+      SC_Static, false, false, false);
+  TypeSourceInfo *PtrIntTI =
+      getContext().getTrivialTypeSourceInfo(PtrIntTy, SourceLocation());
+  TypeSourceInfo *PtrVoidTI = getContext().getTrivialTypeSourceInfo(
+      getContext().VoidPtrTy, SourceLocation());
+  ParmVarDecl *Arg1 =
+      ParmVarDecl::Create(getContext(), FD, SourceLocation(), SourceLocation(),
+                          0, PtrIntTy, PtrIntTI, SC_Auto, 0);
+  ParmVarDecl *Arg2 =
+      ParmVarDecl::Create(getContext(), FD, SourceLocation(), SourceLocation(),
+                          0, PtrIntTy, PtrIntTI, SC_Auto, 0);
+  ParmVarDecl *Arg3 =
+      ParmVarDecl::Create(getContext(), FD, SourceLocation(), SourceLocation(),
+                          0, getContext().VoidPtrTy, PtrVoidTI, SC_Auto, 0);
+  CodeGenFunction CGF(CGM, true);
+  const CGFunctionInfo &FI = getTypes().arrangeFunctionDeclaration(FD);
+  llvm::Function *Fn = llvm::Function::Create(getTypes().GetFunctionType(FI),
+                                              llvm::GlobalValue::PrivateLinkage,
+                                              FD->getName(), &CGM.getModule());
+  CGM.SetInternalFunctionAttributes(CurFuncDecl, Fn, FI);
+  FunctionArgList FnArgs;
+  FnArgs.push_back(Arg1);
+  FnArgs.push_back(Arg2);
+  FnArgs.push_back(Arg3);
+  CGF.OpenMPRoot = this;
+  CGF.StartFunction(FD, getContext().VoidTy, Fn, FI, FnArgs, SourceLocation());
+
+  CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(Arg1),
+                         ".__kmpc_global_thread_num.");
+
+  llvm::Value *Arg3Val =
+      CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(Arg3), "arg3");
+  llvm::Value *SlotsPtr = CGF.Builder.CreatePointerCast(
+      Arg3Val, VoidPtrTy->getPointerTo(), "(void **)arg3");
+  auto LoadSlot = [&](unsigned I, llvm::Type *Ty) -> llvm::Value * {
+    llvm::Value *Slot = CGF.Builder.CreateLoad(
+        CGF.Builder.CreateConstGEP1_32(SlotsPtr, I));
+    return CGF.Builder.CreatePointerCast(Slot, Ty);
+  };
+
+  for (unsigned R = 0, NumRegions = Regions.size(); R < NumRegions; ++R) {
+    const OMPParallelDirective &S = *Regions[R];
+
+    // The serial code before the region is executed by the master thread, with
+    // the locals of the enclosing function mapped to their original addresses.
+    if (R > 0 && !Serial[R - 1].empty()) {
+      SourceLocation Loc = Serial[R - 1].front()->getLocStart();
+      for (unsigned I = 0, E = Captures.size(); I < E; ++I)
+        CGF.LocalDeclMap[Captures[I]] = LoadSlot(
+            NumRegions + I, LocalDeclMap.lookup(Captures[I])->getType());
+      llvm::CallInst *Call =
+          CGF.EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(master), Loc);
+      llvm::BasicBlock *ThenBlock = CGF.createBasicBlock("omp.master.then");
+      llvm::BasicBlock *ContBlock = CGF.createBasicBlock("omp.master.end");
+      CGF.Builder.CreateCondBr(CGF.Builder.CreateIsNotNull(Call), ThenBlock,
+                               ContBlock);
+      CGF.EmitBlock(ThenBlock);
+      {
+        RunCleanupsScope SerialScope(CGF);
+        for (Stmt *SerialStmt : Serial[R - 1])
+          CGF.EmitStmt(SerialStmt);
+      }
+      CGF.EnsureInsertPoint();
+      CGF.EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(end_master), Loc);
+      CGF.EmitBranch(ContBlock);
+      CGF.EmitBlock(ContBlock, true);
+      CGF.EmitOMPBarrier(Loc, KMP_IDENT_BARRIER_IMPL);
+      for (const VarDecl *VD : Captures)
+        CGF.LocalDeclMap.erase(VD);
+    }
+
+    CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+    QualType QTy = getContext().getRecordType(CS->getCapturedRecordDecl());
+    llvm::Value *RecArg =
+        LoadSlot(R, CGF.getTypes().ConvertTypeForMem(QTy)->getPointerTo());
+
+    // Init list of private globals in the stack.
+    CGM.OpenMPSupport.startOpenMPRegion(true);
+    CGM.OpenMPSupport.setMergeable(false);
+    CGM.OpenMPSupport.setOrdered(false);
+    CGM.OpenMPSupport.setScheduleChunkSize(KMP_SCH_DEFAULT, 0);
+
+    llvm::Value *InstrDesc =
+        CGF.EmitOMPInstrRegionBegin(KMP_INSTR_REGION_PARALLEL, S.getLocStart());
+    {
+      OpenMPRegionRAII OMPRegion(CGF, S, *CS, RecArg);
+      for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                           E = S.clauses().end();
+           I != E; ++I)
+        if (*I)
+          CGF.EmitPreOMPClause(*(*I), S);
+
+      CGF.EmitStmt(CS->getCapturedStmt());
+      CGF.EnsureInsertPoint();
+
+      for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                           E = S.clauses().end();
+           I != E; ++I)
+        if (*I)
+          CGF.EmitPostOMPClause(*(*I), S);
+      for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                           E = S.clauses().end();
+           I != E; ++I)
+        if (*I)
+          CGF.EmitCloseOMPClause(*(*I), S);
+    }
+
+    CGF.EnsureInsertPoint();
+    // Implicit barrier at the end of each of the merged regions.
+    CGF.EmitOMPBarrier(S.getLocEnd(), KMP_IDENT_BARRIER_IMPL);
+    CGF.EmitOMPInstrRegionEnd(InstrDesc, S.getLocEnd());
+    EmitFirstprivateInsert(CGF, S.getLocStart());
+    // The insert point belongs to this region only, the next regions must not
+    // add their barriers to it.
+    ClearFirstprivateInsertPt(CGF);
+
+    // Remove list of private globals from the stack.
+    CGM.OpenMPSupport.endOpenMPRegion();
+  }
+
+  CGF.FinishFunction();
+
+  {
+    RunCleanupsScope MainBlock(*this);
+
+    llvm::Value *Loc = OPENMPRTL_LOC(Regions.front()->getLocStart(), *this);
+    llvm::Type *KmpcMicroTy =
+        llvm::TypeBuilder<kmpc_micro, false>::get(getLLVMContext());
+    llvm::Value *RealArgs[] = {
+        Loc, Builder.getInt32(2),
+        Builder.CreateBitCast(Fn, KmpcMicroTy, "(kmpc_micro_ty)helper"),
+        Builder.CreateBitCast(Args, CGM.VoidPtrTy)};
+    // __kmpc_fork_call(&loc, argc/*2*/, microtask, args);
+    EmitRuntimeCall(OPENMPRTL_FUNC(fork_call), makeArrayRef(RealArgs));
+  }
+
+  return NumStmts;
+}
+
 /// Generate an instructions for '#pragma omp parallel' directive.
 void CodeGenFunction::EmitOMPParallelDirective(const OMPParallelDirective &S) {
   EmitOMPDirectiveWithParallel(OMPD_parallel, OMPD_unknown, S);
@@ -1215,6 +1705,218 @@ void CodeGenFunction::EmitOMPParallelSectionsDirective(
   EmitOMPDirectiveWithParallel(OMPD_parallel_sections, OMPD_sections, S);
 }
 
+/// \brief Computes the iteration range of the current thread for a 'static'
+/// schedule without calling __kmpc_for_static_init. The partitioning is the
+/// same as the one of the runtime library for unit increment:
+///   static:        the first (trip % nthreads) threads get one extra
+///                  iteration each;
+///   static, chunk: chunks are assigned round-robin, the stride is
+///                  nthreads * chunk.
+/// The thread number and team size are queried once per outlined function,
+/// so the bounds are plain arithmetic visible to the optimizer.
+static void EmitOMPInlineStaticInit(CodeGenFunction &CGF, SourceLocation Loc,
+                                    bool IsChunked, bool IsSigned,
+                                    llvm::Type *VarTy, llvm::Value *Chunk,
+                                    llvm::Value *PLast, llvm::Value *PLB,
+                                    llvm::Value *PUB, llvm::Value *PSt) {
+  CGBuilderTy &Builder = CGF.Builder;
+  CGOpenMPRuntime &RT = CGF.CGM.getOpenMPRuntime();
+  llvm::Value *Tid = Builder.CreateIntCast(
+      RT.CreateOpenMPBoundThreadNum(Loc, CGF), VarTy, false, ".omp.tid.");
+  llvm::Value *NThreads = Builder.CreateIntCast(
+      RT.CreateOpenMPBoundNumThreads(Loc, CGF), VarTy, false, ".omp.nth.");
+  llvm::Value *One = llvm::ConstantInt::get(VarTy, 1);
+  llvm::Value *LB = Builder.CreateLoad(PLB);
+  llvm::Value *UB = Builder.CreateLoad(PUB);
+  // The loop is known to execute at least once here.
+  llvm::Value *Trip = Builder.CreateAdd(Builder.CreateSub(UB, LB), One);
+  llvm::Value *IsLast;
+  if (IsChunked) {
+    // lb = lb + tid * chunk; ub = lb + chunk - 1; st = nthreads * chunk;
+    // last = tid == ((trip - 1) / chunk) % nthreads;
+    llvm::Value *MyLB = Builder.CreateAdd(LB, Builder.CreateMul(Tid, Chunk));
+    llvm::Value *MyUB = Builder.CreateSub(Builder.CreateAdd(MyLB, Chunk), One);
+    Builder.CreateStore(MyLB, PLB);
+    Builder.CreateStore(MyUB, PUB);
+    Builder.CreateStore(Builder.CreateMul(NThreads, Chunk), PSt);
+    llvm::Value *LastChunk = Builder.CreateURem(
+        Builder.CreateUDiv(Builder.CreateSub(Trip, One), Chunk), NThreads);
+    IsLast = Builder.CreateICmpEQ(Tid, LastChunk);
+  } else {
+    // Same split as the greedy kmp_sch_static of the runtime, so that the
+    // iterations a thread gets do not depend on whether the schedule is
+    // computed inline or not (e.g. for the 'nowait' loops that rely on it):
+    // chunk = trip / nthreads + (trip % nthreads != 0);
+    // lb = lb + tid * chunk; ub = min(lb + chunk - 1, global ub);
+    // last = lb <= global ub && ub == global ub;
+    llvm::Value *Zero = llvm::ConstantInt::get(VarTy, 0);
+    llvm::Value *BigChunk = Builder.CreateAdd(
+        Builder.CreateUDiv(Trip, NThreads),
+        Builder.CreateZExt(
+            Builder.CreateICmpNE(Builder.CreateURem(Trip, NThreads), Zero),
+            VarTy));
+    llvm::Value *MyLB = Builder.CreateAdd(LB, Builder.CreateMul(Tid, BigChunk));
+    llvm::Value *MyUB =
+        Builder.CreateSub(Builder.CreateAdd(MyLB, BigChunk), One);
+    // An upper bound that wrapped around is past the global one.
+    llvm::Value *Wrapped = IsSigned ? Builder.CreateICmpSLT(MyUB, MyLB)
+                                    : Builder.CreateICmpULT(MyUB, MyLB);
+    llvm::Value *PastUB = IsSigned ? Builder.CreateICmpSGT(MyUB, UB)
+                                   : Builder.CreateICmpUGT(MyUB, UB);
+    MyUB = Builder.CreateSelect(Builder.CreateOr(Wrapped, PastUB), UB, MyUB);
+    Builder.CreateStore(MyLB, PLB);
+    Builder.CreateStore(MyUB, PUB);
+    Builder.CreateStore(Trip, PSt);
+    IsLast = Builder.CreateAnd(
+        IsSigned ? Builder.CreateICmpSLE(MyLB, UB)
+                 : Builder.CreateICmpULE(MyLB, UB),
+        Builder.CreateICmpEQ(MyUB, UB));
+  }
+  Builder.CreateStore(Builder.CreateZExt(IsLast, CGF.Int32Ty), PLast);
+}
+
+namespace {
+/// \brief One loop of a collapsed nest, as recovered from the counter
+/// update built by Sema:
+///   Counter = Init, Counter += (Idx / Div % End) * Step
+/// The outermost loop has no 'End' because its position never wraps.
+struct OMPCollapsedLoop {
+  const BinaryOperator *Reset;
+  const CompoundAssignOperator *Update;
+  const BinaryOperator *Pos;
+  const BinaryOperator *Offset;
+  llvm::Value *End;
+  llvm::Value *Step;
+  llvm::Value *PosAddr;
+};
+} // namespace
+
+/// \brief Splits the counter update of a collapsed loop nest into the loops
+/// of the nest, from the innermost to the outermost. Returns false if the
+/// update does not have the expected shape or if a counter is not a plain
+/// integer, in which case the counters are recomputed on every iteration.
+static bool
+getOMPCollapsedLoops(const Expr *Init,
+                     SmallVectorImpl<OMPCollapsedLoop> &Loops) {
+  SmallVector<const Expr *, 8> Parts;
+  const Expr *E = Init;
+  if (const ExprWithCleanups *EWC = dyn_cast<ExprWithCleanups>(E))
+    E = EWC->getSubExpr();
+  E = E->IgnoreParenImpCasts();
+  while (const BinaryOperator *BO = dyn_cast<BinaryOperator>(E)) {
+    if (BO->getOpcode() != BO_Comma)
+      break;
+    Parts.push_back(BO->getRHS()->IgnoreParenImpCasts());
+    E = BO->getLHS()->IgnoreParenImpCasts();
+  }
+  Parts.push_back(E);
+  if (Parts.size() < 4 || Parts.size() % 2 != 0)
+    return false;
+  // The parts were collected from the last one.
+  for (unsigned I = Parts.size(); I > 0; I -= 2) {
+    const BinaryOperator *Reset = dyn_cast<BinaryOperator>(Parts[I - 1]);
+    const CompoundAssignOperator *Update =
+        dyn_cast<CompoundAssignOperator>(Parts[I - 2]);
+    if (!Reset || Reset->getOpcode() != BO_Assign || !Update ||
+        (Update->getOpcode() != BO_AddAssign &&
+         Update->getOpcode() != BO_SubAssign) ||
+        !Update->getType()->isIntegerType() ||
+        !Update->getComputationResultType()->isIntegerType())
+      return false;
+    const DeclRefExpr *ResetVar =
+        dyn_cast<DeclRefExpr>(Reset->getLHS()->IgnoreParenImpCasts());
+    const DeclRefExpr *UpdateVar =
+        dyn_cast<DeclRefExpr>(Update->getLHS()->IgnoreParenImpCasts());
+    if (!ResetVar || !UpdateVar || ResetVar->getDecl() != UpdateVar->getDecl())
+      return false;
+    const BinaryOperator *Offset =
+        dyn_cast<BinaryOperator>(Update->getRHS()->IgnoreParenImpCasts());
+    if (!Offset || Offset->getOpcode() != BO_Mul ||
+        !Offset->getType()->isIntegerType())
+      return false;
+    const BinaryOperator *Pos =
+        dyn_cast<BinaryOperator>(Offset->getLHS()->IgnoreParenImpCasts());
+    if (!Pos || (Pos->getOpcode() != BO_Rem && Pos->getOpcode() != BO_Div))
+      return false;
+    // Only the outermost loop may go without the wrap-around.
+    if ((Pos->getOpcode() == BO_Div) != (I == 2))
+      return false;
+    OMPCollapsedLoop Loop = {Reset, Update, Pos, Offset, 0, 0, 0};
+    Loops.push_back(Loop);
+  }
+  return true;
+}
+
+/// \brief Computes the counters of a collapsed loop nest for the first
+/// iteration of a chunk and remembers the position of the thread in each
+/// loop of the nest.
+static void EmitOMPCollapsedLoopsStart(CodeGenFunction &CGF, const Expr *Init,
+                                       MutableArrayRef<OMPCollapsedLoop> Loops) {
+  for (MutableArrayRef<OMPCollapsedLoop>::iterator I = Loops.begin(),
+                                                   E = Loops.end();
+       I != E; ++I) {
+    I->Step = CGF.EmitScalarExpr(I->Offset->getRHS());
+    if (I->Pos->getOpcode() != BO_Rem)
+      continue;
+    I->End = CGF.EmitScalarExpr(I->Pos->getRHS());
+    I->PosAddr = CGF.CreateMemTemp(I->Pos->getType(), ".omp.collapse.pos.");
+    CGF.Builder.CreateStore(CGF.EmitScalarExpr(I->Pos), I->PosAddr);
+  }
+  CGF.EmitIgnoredExpr(Init);
+}
+
+/// \brief Moves the counters of a collapsed loop nest to the next iteration:
+/// the innermost counter is stepped and, when it wraps around, it is reset
+/// and the carry goes to the enclosing loop.
+static void EmitOMPCollapsedLoopsNext(CodeGenFunction &CGF,
+                                      ArrayRef<OMPCollapsedLoop> Loops) {
+  CGBuilderTy &Builder = CGF.Builder;
+  llvm::BasicBlock *DoneBB = CGF.createBasicBlock("omp.collapse.next.end");
+  for (ArrayRef<OMPCollapsedLoop>::iterator I = Loops.begin(),
+                                            E = Loops.end();
+       I != E; ++I) {
+    llvm::BasicBlock *WrapBB = 0;
+    if (I->End) {
+      QualType PosTy = I->Pos->getType();
+      llvm::Value *Pos = Builder.CreateAdd(
+          Builder.CreateLoad(I->PosAddr),
+          llvm::ConstantInt::get(I->End->getType(), 1));
+      llvm::Value *InRange =
+          PosTy->hasSignedIntegerRepresentation()
+              ? Builder.CreateICmpSLT(Pos, I->End)
+              : Builder.CreateICmpULT(Pos, I->End);
+      llvm::BasicBlock *StepBB = CGF.createBasicBlock("omp.collapse.step");
+      WrapBB = CGF.createBasicBlock("omp.collapse.wrap");
+      Builder.CreateCondBr(InRange, StepBB, WrapBB);
+      CGF.EmitBlock(StepBB);
+      Builder.CreateStore(Pos, I->PosAddr);
+    }
+    // Counter op= Step, in the computation type of the original update.
+    const CompoundAssignOperator *Update = I->Update;
+    QualType CntTy = Update->getLHS()->getType();
+    QualType CompTy = Update->getComputationResultType();
+    LValue Cnt = CGF.EmitLValue(Update->getLHS());
+    llvm::Value *Val = CGF.EmitScalarConversion(
+        CGF.EmitLoadOfScalar(Cnt, Update->getExprLoc()), CntTy, CompTy,
+        Update->getExprLoc());
+    llvm::Value *Step = CGF.EmitScalarConversion(
+        I->Step, I->Offset->getType(), CompTy, Update->getExprLoc());
+    Val = Update->getOpcode() == BO_AddAssign ? Builder.CreateAdd(Val, Step)
+                                              : Builder.CreateSub(Val, Step);
+    CGF.EmitStoreOfScalar(
+        CGF.EmitScalarConversion(Val, CompTy, CntTy, Update->getExprLoc()),
+        Cnt);
+    CGF.EmitBranch(DoneBB);
+    if (!WrapBB)
+      break;
+    CGF.EmitBlock(WrapBB);
+    Builder.CreateStore(llvm::ConstantInt::get(I->End->getType(), 0),
+                        I->PosAddr);
+    CGF.EmitIgnoredExpr(I->Reset);
+  }
+  CGF.EmitBlock(DoneBB);
+}
+
 /// Generate instruction for OpenMP loop-like directives.
 void
 CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
@@ -1357,6 +2059,13 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
       } else {
         Chunk = llvm::Constant::getNullValue(VarTy);
       }
+      // Static schedules with no chunk or with a constant one may be
+      // partitioned without the runtime calls.
+      bool IsInlineStatic =
+          CGM.getLangOpts().OpenMPInlineStaticSchedule &&
+          !CGM.getLangOpts().OpenMPTargetMode &&
+          (Schedule == KMP_SCH_STATIC || Schedule == KMP_SCH_STATIC_CHUNKED) &&
+          (!ChunkSize || ChunkSize->isIntegerConstantExpr(getContext()));
       llvm::BasicBlock *EndBB = createBasicBlock("omp.loop.end");
       llvm::BasicBlock *OMPLoopBB = 0; // createBasicBlock("omp.loop.begin");
       llvm::AllocaInst *PLast = CreateTempAlloca(Int32Ty, "last");
@@ -1421,25 +2130,40 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
         EmitBlock(PrecondBB);
       }
 
+      // The profile gets the number of iterations executed by the thread.
+      llvm::Value *InstrDesc =
+          EmitOMPInstrRegionBegin(KMP_INSTR_REGION_LOOP, S.getLocStart());
+      llvm::AllocaInst *InstrIters = 0;
+      if (InstrDesc) {
+        InstrIters = CreateTempAlloca(Int64Ty, ".omp.instr.iters.");
+        Builder.CreateStore(Builder.getInt64(0), InstrIters);
+      }
+
       if (IsStaticSchedule) {
-        llvm::Value *RealArgs[] = {
-            Loc,
-            GTid,
-            Builder.getInt32(Schedule),
-            PLast,
-            PLB,
-            PUB,
-            PSt,
-            TypeSize == 32 ? Builder.getInt32(1) : Builder.getInt64(1),
-            Chunk};
-        if (TypeSize == 32 && isSigned)
-          EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_4), RealArgs);
-        else if (TypeSize == 32 && !isSigned)
-          EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_4u), RealArgs);
-        else if (TypeSize == 64 && isSigned)
-          EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_8), RealArgs);
-        else
-          EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_8u), RealArgs);
+        if (IsInlineStatic) {
+          EmitOMPInlineStaticInit(*this, S.getLocStart(), ChunkSize != 0,
+                                  isSigned, VarTy, Chunk, PLast, PLB, PUB,
+                                  PSt);
+        } else {
+          llvm::Value *RealArgs[] = {
+              Loc,
+              GTid,
+              Builder.getInt32(Schedule),
+              PLast,
+              PLB,
+              PUB,
+              PSt,
+              TypeSize == 32 ? Builder.getInt32(1) : Builder.getInt64(1),
+              Chunk};
+          if (TypeSize == 32 && isSigned)
+            EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_4), RealArgs);
+          else if (TypeSize == 32 && !isSigned)
+            EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_4u), RealArgs);
+          else if (TypeSize == 64 && isSigned)
+            EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_8), RealArgs);
+          else
+            EmitRuntimeCall(OPENMPRTL_FUNC(for_static_init_8u), RealArgs);
+        }
         OMPLoopBB = createBasicBlock("omp.loop.begin");
         EmitBlock(OMPLoopBB);
         LB = Builder.CreateLoad(PLB);
@@ -1537,6 +2261,17 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
         CapStruct = InitCapturedStruct(*SimdWrapper.getAssociatedStmt());
       }
 
+      // With collapse(n) the counters are recovered from the flat index with
+      // divisions only at the start of a chunk and then stepped with carry
+      // propagation, as the indexes of a chunk are consecutive.
+      SmallVector<OMPCollapsedLoop, 4> CollapsedLoops;
+      if (!HasSimd && !CGM.getLangOpts().OpenMPTargetMode &&
+          (IsInnerLoopGen || !IsComplexParallelLoop) &&
+          getCollapsedNumberFromLoopDirective(&S) > 1 &&
+          getOMPCollapsedLoops(getInitFromLoopDirective(&S), CollapsedLoops))
+        EmitOMPCollapsedLoopsStart(*this, getInitFromLoopDirective(&S),
+                                   CollapsedLoops);
+
       EmitBranch(MainBB);
       EmitBlock(MainBB);
 
@@ -1558,7 +2293,8 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
 
       {
         RunCleanupsScope ThenScope(*this);
-        EmitStmt(getInitFromLoopDirective(&S));
+        if (CollapsedLoops.empty())
+          EmitStmt(getInitFromLoopDirective(&S));
 #ifdef DEBUG
         // CodeGen for clauses (call start).
         for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
@@ -1640,6 +2376,11 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
         EnsureInsertPoint();
         EmitBranch(ContBlock);
         EmitBlock(ContBlock);
+        if (InstrIters)
+          Builder.CreateStore(
+              Builder.CreateAdd(Builder.CreateLoad(InstrIters),
+                                Builder.getInt64(1)),
+              InstrIters);
         Idx = Builder.CreateLoad(Private, ".idx.");
 
         llvm::Value *NextIdx;
@@ -1647,6 +2388,8 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
             *this, IsStaticSchedule, ChunkSize, Chunk, IdxTy, QTy, Idx, Kind,
             SKind, PSt);
         Builder.CreateStore(NextIdx, Private);
+        if (!CollapsedLoops.empty())
+          EmitOMPCollapsedLoopsNext(*this, CollapsedLoops);
         if (!IsStaticSchedule && CGM.OpenMPSupport.getOrdered()) {
           // Emit _dispatch_fini for ordered loops
           llvm::Value *RealArgsFini[] = {Loc, GTid};
@@ -1686,6 +2429,11 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
           //   call __simd_helper(cs, idx, 1)
           //
           EmitSIMDForHelperCall(BodyFunction, CapStruct, Private, true);
+          if (InstrIters)
+            Builder.CreateStore(
+                Builder.CreateAdd(Builder.CreateLoad(InstrIters),
+                                  Builder.getInt64(1)),
+                InstrIters);
         }
         EmitBranch(!IsStaticSchedule || ChunkSize != 0 ? OMPLoopBB : EndBB);
         // EmitStmt(getInitFromLoopDirective(&S));
@@ -1700,13 +2448,16 @@ CodeGenFunction::EmitOMPDirectiveWithLoop(OpenMPDirectiveKind DKind,
         // Builder.CreateCondBr(UBLBCheck, UBLBCheckBB, OMPLoopBB);
       }
       EmitBlock(EndBB, true);
-      if (IsStaticSchedule) {
+      if (IsStaticSchedule && !IsInlineStatic) {
     	  llvm::Value *GTidReload =
     	        OPENMPRTL_THREADNUM(S.getLocStart(), *this);
 
     	  llvm::Value *RealArgsFini[] = { Loc, GTidReload };
         EmitRuntimeCall(OPENMPRTL_FUNC(for_static_fini), RealArgsFini);
       }
+      if (InstrIters)
+        EmitOMPInstrRegionEnd(InstrDesc, S.getLocStart(),
+                              Builder.CreateLoad(InstrIters));
       CGM.OpenMPSupport.setLastIterVar(PLast);
     }
 
@@ -2226,6 +2977,68 @@ ProcessDependAddresses(CodeGenFunction &CGF, const OMPExecutableDirective &S) {
   return std::make_pair(DependenceAddresses, ArraySize);
 }
 
+/// \brief Get the device of directive \a S if it is known at compile time,
+/// i.e. if \a S has a 'device' clause with a constant value. The default
+/// device is not known: omp_set_default_device may change it between two
+/// constructs.
+static bool getOMPConstantDevice(CodeGenFunction &CGF,
+                                 const OMPExecutableDirective &S,
+                                 int64_t &Device) {
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end(); I != E; ++I) {
+    if (!*I || (*I)->getClauseKind() != OMPC_device)
+      continue;
+    llvm::APSInt Val;
+    if (!cast<OMPDeviceClause>(*I)->getDevice()->EvaluateAsInt(
+            Val, CGF.getContext()))
+      return false;
+    Device = Val.getSExtValue();
+    return true;
+  }
+  return false;
+}
+
+/// \brief Return true if the maps of directive \a S do not need to transfer
+/// the variables an enclosing 'target data' region made present on \a Device.
+static bool canSkipOMPPresentTransfers(CodeGenFunction &CGF,
+                                       const OMPExecutableDirective &S,
+                                       int64_t &Device) {
+  // Standalone data directives transfer or release data explicitly.
+  switch (S.getDirectiveKind()) {
+  case OMPD_target_enter_data:
+  case OMPD_target_exit_data:
+  case OMPD_target_update:
+    return false;
+  default:
+    break;
+  }
+  // A deferred target task may outlive the enclosing data region.
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end(); I != E; ++I)
+    if (*I && ((*I)->getClauseKind() == OMPC_depend ||
+               (*I)->getClauseKind() == OMPC_nowait))
+      return false;
+  return getOMPConstantDevice(CGF, S, Device);
+}
+
+/// \brief Returns true if \a VD is listed in an 'is_device_ptr' clause of
+/// directive \a S.
+static bool IsOMPDevicePtr(const OMPExecutableDirective &S,
+                           const ValueDecl *VD) {
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end(); I != E; ++I) {
+    const auto *C = dyn_cast_or_null<OMPIsDevicePtrClause>(*I);
+    if (!C)
+      continue;
+    for (OMPIsDevicePtrClause::varlist_const_iterator VI = C->varlist_begin(),
+                                                      VE = C->varlist_end();
+         VI != VE; ++VI)
+      if (cast<DeclRefExpr>(*VI)->getDecl() == VD)
+        return true;
+  }
+  return false;
+}
+
 /// Generate instructions for directive with 'target' region.
 void CodeGenFunction::EmitOMPDirectiveWithTarget(OpenMPDirectiveKind DKind,
     OpenMPDirectiveKind SKind, const OMPExecutableDirective &S) {
@@ -2287,7 +3100,7 @@ void CodeGenFunction::EmitOMPDirectiveWithTarget(OpenMPDirectiveKind DKind,
     CGM.OpenMPSupport.setTeams(false);
 
     if (isTargetMode)
-      CGM.getOpenMPRuntime().StartNewTargetRegion();
+      CGM.getOpenMPRuntime().StartNewTargetRegion(S);
 
     // Create the target function
     std::string TargetRegionName;
@@ -2478,6 +3291,19 @@ void CodeGenFunction::EmitOMPDirectiveWithTarget(OpenMPDirectiveKind DKind,
           MapClauseBasePointersArray, MapClausePointersArray, MapClauseSizesArray,
           MapClauseTypesArray);
 
+      // Captured variables an enclosing 'target data' region made present on
+      // the device are not transferred again.
+      int64_t Device;
+      bool SkipPresent = canSkipOMPPresentTransfers(*this, S, Device);
+
+      // Scalars are copied back from the device only if the region writes
+      // them, or if 'defaultmap(tofrom: scalar)' asks for it.
+      bool TofromScalars = false;
+      for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                           E = S.clauses().end(); I != E; ++I)
+        if (*I && (*I)->getClauseKind() == OMPC_defaultmap)
+          TofromScalars = true;
+
       // Scan the captured declarations
       unsigned EFidx = 0;
       for (CapturedStmt::capture_init_iterator ci = CS->capture_init_begin(),
@@ -2542,6 +3368,18 @@ void CodeGenFunction::EmitOMPDirectiveWithTarget(OpenMPDirectiveKind DKind,
             CGM.getTypes().ConvertTypeForMem(MapType)) / 8;
 
         unsigned DefaultType = OMP_TGT_MAPTYPE_TO | OMP_TGT_MAPTYPE_FROM;
+        if (DE && IsOMPDevicePtr(S, DE->getDecl())) {
+          // The pointer already holds a device address, only its value is
+          // passed to the region.
+          DefaultType = OMP_TGT_MAPTYPE_TO;
+        } else if (SkipPresent && DE && isOMPPresentOnDevice(DE, Device)) {
+          DefaultType = OMP_TGT_MAPTYPE_ALLOC;
+        } else if (DE && !TofromScalars && MapType->isScalarType() &&
+                   !DE->getDecl()->getType()->isReferenceType() &&
+                   isOMPReadOnlyVar(CS->getCapturedStmt(),
+                                    cast<VarDecl>(DE->getDecl()))) {
+          DefaultType = OMP_TGT_MAPTYPE_TO;
+        }
 
         RealArgBasePointerValues.push_back(Arg);
         RealArgPointerValues.push_back(Arg);
@@ -2822,11 +3660,126 @@ static void EmitUntiedTaskSwitch(CodeGenFunction &CGF, bool EmitBranch) {
   }
 }
 
-/// Generate an instructions for '#pragma omp task' directive.
-void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
-  // Generate shared args for captured stmt.
-  CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
-  llvm::Value *Arg = GenerateCapturedStmtArgument(*CS);
+/// \brief Returns true if \a S generates tasks or waits for child tasks. A
+/// merged task has no task descriptor of its own, so these would be attached
+/// to the generating task and wait for its other children too.
+static bool HasOMPTaskSync(const Stmt *S) {
+  if (!S)
+    return false;
+  if (isa<OMPTaskDirective>(S) || isa<OMPTaskLoopDirective>(S) ||
+      isa<OMPTaskLoopSimdDirective>(S) || isa<OMPTaskwaitDirective>(S) ||
+      isa<OMPTaskgroupDirective>(S))
+    return true;
+  SmallVector<const Stmt *, 8> Children;
+  CodeGenFunction::getOMPNestedStmts(S, Children);
+  for (const Stmt *Child : Children)
+    if (HasOMPTaskSync(Child))
+      return true;
+  return false;
+}
+
+/// \brief Returns the 'if' clause of a 'mergeable' task that may be executed
+/// as a merged task when the condition is false, or null.
+static const OMPIfClause *getMergeableTaskIfClause(CodeGenModule &CGM,
+                                                   const OMPTaskDirective &S) {
+  if (CGM.getLangOpts().OpenMPTargetMode)
+    return nullptr;
+  const OMPIfClause *IfClause = nullptr;
+  bool IsMergeable = false;
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I) {
+    if (const OMPIfClause *C = dyn_cast_or_null<OMPIfClause>(*I))
+      IfClause = C;
+    else if (*I && isa<OMPMergeableClause>(*I))
+      IsMergeable = true;
+  }
+  if (!IsMergeable)
+    return nullptr;
+  const Stmt *Body =
+      cast<CapturedStmt>(S.getAssociatedStmt())->getCapturedStmt();
+  if (HasOMPCancel(Body) || HasOMPTaskSync(Body))
+    return nullptr;
+  return IfClause;
+}
+
+/// \brief Generates an undeferred task as a merged task: the encountering
+/// thread executes the body in place, in the data environment of the
+/// generating task, once the dependences of the task are satisfied. Neither
+/// the task descriptor nor the block of privates are allocated.
+static void EmitOMPMergedTask(CodeGenFunction &CGF, const OMPTaskDirective &S) {
+  CodeGenModule &CGM = CGF.CGM;
+  CodeGenFunction::RunCleanupsScope ExecutedScope(CGF);
+
+  llvm::Value *DependenceAddresses = 0;
+  unsigned ArraySize = 0;
+  std::tie(DependenceAddresses, ArraySize) = ProcessDependAddresses(CGF, S);
+  if (ArraySize > 0) {
+    // __kmpc_omp_wait_deps(&loc, gtid, ndeps, dep_list, 0, null);
+    llvm::Type *PtrDepTy = OPENMPRTL_DINFOTY->getPointerTo();
+    llvm::Value *WaitDepsArgs[] = {
+        OPENMPRTL_LOC(S.getLocStart(), CGF),
+        OPENMPRTL_THREADNUM(S.getLocStart(), CGF),
+        llvm::ConstantInt::get(CGF.Int32Ty, ArraySize),
+        DependenceAddresses,
+        llvm::ConstantInt::get(CGF.Int32Ty, 0),
+        llvm::Constant::getNullValue(PtrDepTy)};
+    CGF.EmitRuntimeCall(OPENMPRTL_FUNC(omp_wait_deps), WaitDepsArgs);
+  }
+
+  // Init list of private globals in the stack.
+  CGM.OpenMPSupport.startOpenMPRegion(true);
+  CGM.OpenMPSupport.setMergeable(false);
+  CGM.OpenMPSupport.setOrdered(false);
+  CGM.OpenMPSupport.setUntied(false);
+  CGM.OpenMPSupport.setScheduleChunkSize(KMP_SCH_DEFAULT, 0);
+
+  // Private copies are allocated on the stack of the encountering thread,
+  // 'in_reduction' items use its copy of the taskgroup reduction.
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I)
+    if (*I && (isa<OMPPrivateClause>(*I) || isa<OMPFirstPrivateClause>(*I) ||
+               isa<OMPInReductionClause>(*I)))
+      CGF.EmitPreOMPClause(*(*I), S);
+
+  llvm::Value *InstrDesc =
+      CGF.EmitOMPInstrRegionBegin(KMP_INSTR_REGION_TASK, S.getLocStart());
+  CGF.EmitOMPCapturedBodyHelper(S);
+  CGF.EmitOMPInstrRegionEnd(InstrDesc, S.getLocStart());
+
+  // Remove list of private globals from the stack.
+  CGM.OpenMPSupport.endOpenMPRegion();
+}
+
+/// Generate an instructions for '#pragma omp task' directive.
+void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
+  // An undeferred 'mergeable' task does not need a task descriptor:
+  //   if (cond) { <deferred task> } else { <merged task> }
+  const OMPIfClause *MergedIf = getMergeableTaskIfClause(CGM, S);
+  llvm::BasicBlock *MergedContBlock = nullptr;
+  if (MergedIf) {
+    bool CondConstant;
+    if (!ConstantFoldsToSimpleInteger(MergedIf->getCondition(),
+                                      CondConstant)) {
+      llvm::BasicBlock *ThenBlock = createBasicBlock("omp.if.then");
+      llvm::BasicBlock *ElseBlock = createBasicBlock("omp.if.else");
+      MergedContBlock = createBasicBlock("omp.if.end");
+      EmitBranchOnBoolExpr(MergedIf->getCondition(), ThenBlock, ElseBlock, 0);
+      EmitBlock(ElseBlock);
+      EmitOMPMergedTask(*this, S);
+      EmitBranch(MergedContBlock);
+      EmitBlock(ThenBlock);
+    } else if (!CondConstant) {
+      EmitOMPMergedTask(*this, S);
+      return;
+    } else
+      MergedIf = nullptr;
+  }
+
+  // Generate shared args for captured stmt.
+  CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  llvm::Value *Arg = GenerateCapturedStmtArgument(*CS);
 
   // Init list of private globals in the stack.
   CGM.OpenMPSupport.startOpenMPRegion(true);
@@ -3063,6 +4016,16 @@ void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
       if (*I)
         CGF.EmitPreOMPClause(*(*I), S);
 
+    // The parts of untied tasks may run on different threads, so only tied
+    // tasks are instrumented.
+    llvm::Value *InstrDesc = 0;
+    if (!CGM.OpenMPSupport.getUntied())
+      InstrDesc =
+          CGF.EmitOMPInstrRegionBegin(KMP_INSTR_REGION_TASK, S.getLocStart());
+    if (InstrDesc)
+      CGF.EHStack.pushCleanup<CallOMPInstrRegionEnd>(NormalCleanup, InstrDesc,
+                                                     S.getLocStart());
+
     llvm::BasicBlock *UntiedEnd = 0;
     if (CGM.OpenMPSupport.getUntied()) {
       llvm::Value *Addr = CGF.Builder.CreateConstInBoundsGEP2_32(
@@ -3096,6 +4059,9 @@ void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
          I != E; ++I)
       if (*I)
         CGF.EmitCloseOMPClause(*(*I), S);
+
+    if (InstrDesc)
+      CGF.PopCleanupBlock();
   }
 
   CGF.FinishFunction();
@@ -3161,7 +4127,7 @@ void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
       for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
                                            E = S.clauses().end();
            I != E; ++I)
-        if (*I)
+        if (*I && *I != MergedIf)
           EmitAfterInitOMPClause(*(*I), S);
 
       if (CGM.OpenMPSupport.getUntied()) {
@@ -3200,6 +4166,539 @@ void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
     }
   }
 
+  // CodeGen for clauses (task finalize).
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I)
+    if (*I && *I != MergedIf)
+      EmitFinalOMPClause(*(*I), S);
+
+  // Remove list of private globals from the stack.
+  CGM.OpenMPSupport.endOpenMPRegion();
+
+  if (MergedContBlock) {
+    EmitBranch(MergedContBlock);
+    EmitBlock(MergedContBlock, true);
+  }
+}
+
+/// Skip attributed statements and single-statement compound statements
+/// around the next loop of the loop nest associated with a loop directive.
+static const ForStmt *getNextForStmtInLoopNest(const Stmt *Body) {
+  bool SkippedContainers = false;
+  while (!SkippedContainers) {
+    if (const AttributedStmt *AS = dyn_cast_or_null<AttributedStmt>(Body))
+      Body = AS->getSubStmt();
+    else if (const CompoundStmt *CS = dyn_cast_or_null<CompoundStmt>(Body)) {
+      if (CS->size() != 1) {
+        SkippedContainers = true;
+      } else {
+        Body = CS->body_back();
+      }
+    } else
+      SkippedContainers = true;
+  }
+  return cast<ForStmt>(Body);
+}
+
+/// Generate instructions for '#pragma omp taskloop' and
+/// '#pragma omp taskloop simd' directives.
+///
+/// The iteration space of the associated loop nest is split into chunks of
+/// 'grainsize' iterations. All the tasks are allocated by the encountering
+/// thread in one batch inside an implicit taskgroup region, one task per
+/// chunk. The bounds of a chunk are passed to its task in the private part
+/// of the kmp_task_t and the outlined task function runs the loop over them.
+void CodeGenFunction::EmitOMPDirectiveWithTaskLoop(
+    OpenMPDirectiveKind DKind, const OMPExecutableDirective &S) {
+  bool HasSimd = DKind == OMPD_taskloop_simd;
+  // Generate shared args for captured stmt.
+  CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  const VarDecl *LBVD = cast<VarDecl>(
+      cast<DeclRefExpr>(getLowerBoundFromLoopDirective(&S))->getDecl());
+  const VarDecl *UBVD = cast<VarDecl>(
+      cast<DeclRefExpr>(getUpperBoundFromLoopDirective(&S))->getDecl());
+  // Chunk bounds are captured by the associated statement, so they need
+  // storage in the current function, though tasks never read it.
+  EmitAutoVarDecl(*LBVD);
+  EmitAutoVarDecl(*UBVD);
+  llvm::Value *Arg = GenerateCapturedStmtArgument(*CS);
+
+  // Init list of private globals in the stack.
+  CGM.OpenMPSupport.startOpenMPRegion(true);
+  CGM.OpenMPSupport.setMergeable(false);
+  CGM.OpenMPSupport.setOrdered(false);
+  CGM.OpenMPSupport.setUntied(false);
+  CGM.OpenMPSupport.setScheduleChunkSize(KMP_SCH_DEFAULT, 0);
+
+  RecordDecl *RD;
+  if (!getContext().getLangOpts().CPlusPlus)
+    RD = RecordDecl::Create(getContext(), TTK_Struct,
+                            getContext().getTranslationUnitDecl(),
+                            SourceLocation(), SourceLocation(),
+                            &getContext().Idents.get(".omp.taskloop.priv."));
+  else
+    RD = CXXRecordDecl::Create(getContext(), TTK_Struct,
+                               getContext().getTranslationUnitDecl(),
+                               SourceLocation(), SourceLocation(),
+                               &getContext().Idents.get(".omp.taskloop.priv."));
+  RD->startDefinition();
+  // Bounds of the chunk executed by the task.
+  FieldDecl *LBField = FieldDecl::Create(
+      getContext(), RD, SourceLocation(), SourceLocation(), 0,
+      LBVD->getType(), 0, 0, false, ICIS_NoInit);
+  LBField->setAccess(AS_public);
+  RD->addDecl(LBField);
+  FieldDecl *UBField = FieldDecl::Create(
+      getContext(), RD, SourceLocation(), SourceLocation(), 0,
+      UBVD->getType(), 0, 0, false, ICIS_NoInit);
+  UBField->setAccess(AS_public);
+  RD->addDecl(UBField);
+  SmallVector<FieldDecl *, 16> FieldsWithDestructors;
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I) {
+    ArrayRef<const Expr *> Vars;
+    if (const OMPPrivateClause *C = dyn_cast_or_null<OMPPrivateClause>(*I))
+      Vars = C->getVars();
+    else if (const OMPFirstPrivateClause *C =
+                 dyn_cast_or_null<OMPFirstPrivateClause>(*I))
+      Vars = C->getVars();
+    for (ArrayRef<const Expr *>::iterator II = Vars.begin(), EE = Vars.end();
+         II != EE; ++II) {
+      const ValueDecl *D = cast<DeclRefExpr>(*II)->getDecl();
+      FieldDecl *FD = FieldDecl::Create(
+          getContext(), RD, SourceLocation(), SourceLocation(),
+          D->getIdentifier(), (*II)->getType(), 0, 0, false, ICIS_NoInit);
+      FD->setAccess(AS_public);
+      RD->addDecl(FD);
+      CGM.OpenMPSupport.getTaskFields()[D] = FD;
+      QualType ASTType = D->getType();
+      if (CXXRecordDecl *RD =
+              ASTType->getBaseElementTypeUnsafe()->getAsCXXRecordDecl()) {
+        if (!RD->hasTrivialDestructor())
+          FieldsWithDestructors.push_back(FD);
+      }
+    }
+  }
+  RD->completeDefinition();
+  QualType PrivateRecord = getContext().getRecordType(RD);
+  llvm::Type *LPrivateTy = getTypes().ConvertTypeForMem(PrivateRecord);
+
+  llvm::Function *Destructors = 0;
+  if (!FieldsWithDestructors.empty()) {
+    IdentifierInfo *Id = &getContext().Idents.get(".omp_ptask_destructors.");
+    SmallVector<QualType, 2> FnArgTypes;
+    FnArgTypes.push_back(getContext().getIntTypeForBitwidth(32, 1));
+    FnArgTypes.push_back(getContext().VoidPtrTy);
+    FunctionProtoType::ExtProtoInfo EPI;
+    EPI.ExceptionSpec.Type = EST_BasicNoexcept;
+    QualType FnTy = getContext().getFunctionType(
+        getContext().getIntTypeForBitwidth(32, 1), FnArgTypes, EPI);
+    TypeSourceInfo *TI =
+        getContext().getTrivialTypeSourceInfo(FnTy, SourceLocation());
+    FunctionDecl *FD = FunctionDecl::Create(
+        getContext(), getContext().getTranslationUnitDecl(), CS->getLocStart(),
+        SourceLocation(), Id, FnTy, TI, SC_Static, false, false, false);
+    TypeSourceInfo *IntTI = getContext().getTrivialTypeSourceInfo(
+        getContext().getIntTypeForBitwidth(32, 1), SourceLocation());
+    TypeSourceInfo *PtrVoidTI = getContext().getTrivialTypeSourceInfo(
+        getContext().VoidPtrTy, SourceLocation());
+    ParmVarDecl *Arg1 = ParmVarDecl::Create(
+        getContext(), FD, SourceLocation(), SourceLocation(), 0,
+        getContext().getIntTypeForBitwidth(32, 1), IntTI, SC_Auto, 0);
+    ParmVarDecl *Arg2 = ParmVarDecl::Create(
+        getContext(), FD, SourceLocation(), SourceLocation(), 0,
+        getContext().VoidPtrTy, PtrVoidTI, SC_Auto, 0);
+    CodeGenFunction CGF(CGM);
+    const CGFunctionInfo &FI = getTypes().arrangeFunctionDeclaration(FD);
+    Destructors = llvm::Function::Create(getTypes().GetFunctionType(FI),
+                                         llvm::GlobalValue::PrivateLinkage,
+                                         FD->getName(), &CGM.getModule());
+    FunctionArgList FnArgs;
+    FnArgs.push_back(Arg1);
+    FnArgs.push_back(Arg2);
+    CGF.StartFunction(FD, getContext().getIntTypeForBitwidth(32, 1),
+                      Destructors, FI, FnArgs, SourceLocation());
+    llvm::Type *TaskTTy = llvm::TaskTBuilder::get(getLLVMContext());
+    llvm::Value *TaskTPtr = CGF.Builder.CreatePointerCast(
+        CGF.GetAddrOfLocalVar(Arg2), TaskTTy->getPointerTo()->getPointerTo());
+    llvm::Value *Locker =
+        CGF.Builder.CreateConstGEP1_32(CGF.Builder.CreateLoad(TaskTPtr), 1);
+    Locker = CGF.Builder.CreatePointerCast(Locker, LPrivateTy->getPointerTo());
+    for (ArrayRef<FieldDecl *>::iterator I = FieldsWithDestructors.begin(),
+                                         E = FieldsWithDestructors.end();
+         I != E; ++I) {
+      QualType ASTType = (*I)->getType();
+      llvm::Value *Private =
+          CGF.EmitLValueForField(
+                  CGF.MakeNaturalAlignAddrLValue(Locker, PrivateRecord), *I)
+              .getAddress();
+      QualType::DestructionKind DtorKind = ASTType.isDestructedType();
+      CGF.emitDestroy(Private, ASTType, CGF.getDestroyer(DtorKind),
+                      CGF.needsEHCleanup(DtorKind));
+    }
+    CGF.FinishFunction(SourceLocation());
+  }
+
+  // CodeGen for clauses (task init).
+  llvm::AllocaInst *Flags =
+      CreateMemTemp(getContext().getIntTypeForBitwidth(32, 1), ".flags.addr");
+  CGM.OpenMPSupport.setTaskFlags(Flags);
+
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I)
+    if (*I)
+      EmitInitOMPClause(*(*I), S);
+
+  // 'untied' only permits the runtime to resume a task on another thread;
+  // chunks have no task scheduling points of their own, so they are always
+  // generated as tied tasks.
+  CGM.OpenMPSupport.setUntied(false);
+  uint64_t InitFlags = OMP_TASK_TIED;
+  if (Destructors) {
+    InitFlags |= OMP_TASK_DESTRUCTORS_THUNK;
+  }
+  InitTempAlloca(Flags, Builder.getInt32(InitFlags));
+
+  // Generate microtask.
+  // int32 .omp_ptask.(int32_t arg1, void */*kmp_task_t **/arg2) {
+  //  for (.idx. = arg2->lb; .idx. <= arg2->ub; ++.idx.)
+  //    captured_stmt(arg2->shareds);
+  // }
+  bool isTargetMode = CGM.getLangOpts().OpenMPTargetMode;
+  std::string pTaskName;
+  if (isTargetMode)
+    pTaskName = "omp_ptask";
+  else
+    pTaskName = ".omp_ptask.";
+  IdentifierInfo *Id = &getContext().Idents.get(pTaskName);
+  SmallVector<QualType, 2> FnArgTypes;
+  FnArgTypes.push_back(getContext().getIntTypeForBitwidth(32, 1));
+  FnArgTypes.push_back(getContext().VoidPtrTy);
+  FunctionProtoType::ExtProtoInfo EPI;
+  EPI.ExceptionSpec.Type = EST_BasicNoexcept;
+  QualType FnTy = getContext().getFunctionType(
+      getContext().getIntTypeForBitwidth(32, 1), FnArgTypes, EPI);
+  TypeSourceInfo *TI =
+      getContext().getTrivialTypeSourceInfo(FnTy, SourceLocation());
+  FunctionDecl *FD = FunctionDecl::Create(
+      getContext(), getContext().getTranslationUnitDecl(), CS->getLocStart(),
+      SourceLocation(), Id, FnTy, TI, SC_Static, false, false, false);
+  TypeSourceInfo *IntTI = getContext().getTrivialTypeSourceInfo(
+      getContext().getIntTypeForBitwidth(32, 1), SourceLocation());
+  TypeSourceInfo *PtrVoidTI = getContext().getTrivialTypeSourceInfo(
+      getContext().VoidPtrTy, SourceLocation());
+  ParmVarDecl *Arg1 = ParmVarDecl::Create(
+      getContext(), FD, SourceLocation(), SourceLocation(), 0,
+      getContext().getIntTypeForBitwidth(32, 1), IntTI, SC_Auto, 0);
+  ParmVarDecl *Arg2 =
+      ParmVarDecl::Create(getContext(), FD, SourceLocation(), SourceLocation(),
+                          0, getContext().VoidPtrTy, PtrVoidTI, SC_Auto, 0);
+  CodeGenFunction CGF(CGM, true);
+  const CGFunctionInfo &FI = getTypes().arrangeFunctionDeclaration(FD);
+  llvm::Function *Fn = llvm::Function::Create(getTypes().GetFunctionType(FI),
+                                              llvm::GlobalValue::PrivateLinkage,
+                                              FD->getName(), &CGM.getModule());
+  CGM.SetInternalFunctionAttributes(CurFuncDecl, Fn, FI);
+  FunctionArgList FnArgs;
+  FnArgs.push_back(Arg1);
+  FnArgs.push_back(Arg2);
+  CGF.OpenMPRoot = OpenMPRoot ? OpenMPRoot : this;
+  CGF.StartFunction(FD, getContext().getIntTypeForBitwidth(32, 1), Fn, FI,
+                    FnArgs, SourceLocation());
+
+  CGF.OMPCancelMap[OMPD_taskgroup] = CGF.ReturnBlock;
+
+  llvm::AllocaInst *GTid = CGF.CreateMemTemp(
+      getContext().getIntTypeForBitwidth(32, 1), ".__kmpc_global_thread_num.");
+  CGF.EmitStoreOfScalar(CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(Arg1)),
+                        MakeNaturalAlignAddrLValue(
+                            GTid, getContext().getIntTypeForBitwidth(32, 1)),
+                        false);
+  llvm::Type *TaskTTy = llvm::TaskTBuilder::get(getLLVMContext());
+  llvm::Value *TaskTPtr = CGF.Builder.CreatePointerCast(
+      CGF.GetAddrOfLocalVar(Arg2), TaskTTy->getPointerTo()->getPointerTo());
+
+  llvm::Value *Addr = CGF.Builder.CreateConstInBoundsGEP2_32(
+      TaskTTy,
+      CGF.Builder.CreateLoad(TaskTPtr, ".arg2.shareds"), 0,
+      llvm::TaskTBuilder::shareds, ".arg2.shareds.addr");
+  llvm::Value *Arg2Val = CGF.Builder.CreateLoad(Addr, ".arg2.shareds.");
+  QualType QTy = getContext().getRecordType(CS->getCapturedRecordDecl());
+  llvm::Type *ConvertedType =
+      CGF.getTypes().ConvertTypeForMem(QTy)->getPointerTo();
+  llvm::Value *RecArg =
+      CGF.Builder.CreatePointerCast(Arg2Val, ConvertedType, "(anon)shared");
+
+  llvm::Value *Locker =
+      CGF.Builder.CreateConstGEP1_32(CGF.Builder.CreateLoad(TaskTPtr), 1);
+  CGM.OpenMPSupport.setPTask(Fn, Arg2Val, LPrivateTy, PrivateRecord, Locker);
+
+  const Expr *IterVar = getNewIterVarFromLoopDirective(&S);
+  QualType IterQTy = IterVar->getType();
+  bool isSigned = IterQTy->isSignedIntegerOrEnumerationType();
+
+  // CodeGen for clauses (call start).
+  {
+    OpenMPRegionRAII OMPRegion(CGF, S, *CS, RecArg);
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I)
+      if (*I)
+        CGF.EmitPreOMPClause(*(*I), S);
+
+    // Chunk bounds live in the private part of the task.
+    LValue PrivatesLV = CGF.MakeNaturalAlignAddrLValue(
+        CGF.Builder.CreatePointerCast(Locker, LPrivateTy->getPointerTo()),
+        PrivateRecord);
+    llvm::Value *LB = CGF.EmitLoadOfScalar(
+        CGF.EmitLValueForField(PrivatesLV, LBField), S.getLocStart());
+    llvm::Value *UB = CGF.EmitLoadOfScalar(
+        CGF.EmitLValueForField(PrivatesLV, UBField), S.getLocStart());
+
+    llvm::AllocaInst *Private = CGF.CreateMemTemp(IterQTy, ".idx.");
+    llvm::Type *IdxTy =
+        cast<llvm::PointerType>(Private->getType())->getElementType();
+    CGM.OpenMPSupport.addOpenMPPrivateVar(
+        cast<VarDecl>(cast<DeclRefExpr>(IterVar)->getDecl()), Private);
+    LB = CGF.Builder.CreateIntCast(LB, IdxTy, true);
+    UB = CGF.Builder.CreateIntCast(UB, IdxTy, true);
+
+    // Loop counters are private to the task; their values are recomputed
+    // from the iteration index in each iteration.
+    const Stmt *Body = CS->getCapturedStmt();
+    ArrayRef<Expr *> Arr = getCountersFromLoopDirective(&S);
+    for (unsigned I = 0; I < getCollapsedNumberFromLoopDirective(&S); ++I) {
+      const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(Arr[I])->getDecl());
+      Body = getNextForStmtInLoopNest(Body)->getBody();
+      if (CGM.OpenMPSupport.getTopOpenMPPrivateVar(VD))
+        continue;
+      CGM.OpenMPSupport.addOpenMPPrivateVar(
+          VD, CGF.CreateMemTemp(Arr[I]->getType(),
+                                CGM.getMangledName(VD) + ".private."));
+    }
+
+    llvm::BasicBlock *CondBB = CGF.createBasicBlock("omp.taskloop.cond");
+    llvm::BasicBlock *BodyBB = CGF.createBasicBlock("omp.taskloop.body");
+    llvm::BasicBlock *ContBB = CGF.createBasicBlock("omp.taskloop.cont");
+    llvm::BasicBlock *EndBB = CGF.createBasicBlock("omp.taskloop.end");
+    CGF.Builder.CreateStore(LB, Private);
+    CGPragmaOmpSimd SimdWrapper(&S);
+    if (HasSimd) {
+      // Update vectorizer width on the loop stack.
+      SimdWrapper.emitSafelen(&CGF);
+    }
+    CGF.EmitBlock(CondBB);
+    if (HasSimd) {
+      // Push current LoopInfo onto the LoopStack.
+      CGF.LoopStack.push(CondBB);
+    }
+    llvm::Value *Idx = CGF.Builder.CreateLoad(Private, ".idx.");
+    CGF.Builder.CreateCondBr(
+        CGF.Builder.CreateICmp(isSigned ? llvm::CmpInst::ICMP_SLE
+                                        : llvm::CmpInst::ICMP_ULE,
+                               Idx, UB),
+        BodyBB, EndBB);
+    CGF.EmitBlock(BodyBB);
+    {
+      RunCleanupsScope ThenScope(CGF);
+      CGF.EmitStmt(getInitFromLoopDirective(&S));
+      CGF.BreakContinueStack.push_back(
+          BreakContinue(CGF.getJumpDestInCurrentScope(EndBB),
+                        CGF.getJumpDestInCurrentScope(ContBB)));
+      CGF.EmitStmt(Body);
+      CGF.BreakContinueStack.pop_back();
+    }
+    CGF.EnsureInsertPoint();
+    CGF.EmitBranch(ContBB);
+    CGF.EmitBlock(ContBB);
+    Idx = CGF.Builder.CreateLoad(Private, ".idx.");
+    CGF.Builder.CreateStore(
+        CGF.Builder.CreateAdd(Idx, llvm::ConstantInt::get(IdxTy, 1)), Private);
+    CGF.EmitBranch(CondBB);
+    if (HasSimd) {
+      // Pop the LoopInfo off the LoopStack.
+      CGF.LoopStack.pop();
+    }
+    CGF.EmitBlock(EndBB, true);
+
+    // CodeGen for clauses (call end).
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I)
+      if (*I)
+        CGF.EmitPostOMPClause(*(*I), S);
+
+    // CodeGen for clauses (closing steps).
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I)
+      if (*I)
+        CGF.EmitCloseOMPClause(*(*I), S);
+  }
+
+  CGF.FinishFunction();
+
+  llvm::DenseMap<const ValueDecl *, FieldDecl *> SavedFields =
+      CGM.OpenMPSupport.getTaskFields();
+  CGM.OpenMPSupport.endOpenMPRegion();
+
+  // CodeGen for "omp taskloop {Associated statement}".
+  CGM.OpenMPSupport.startOpenMPRegion(false);
+  CGM.OpenMPSupport.getTaskFields() = SavedFields;
+  {
+    RunCleanupsScope MainBlock(*this);
+
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I)
+      if (*I)
+        EmitAfterInitOMPClause(*(*I), S);
+
+    // Check that the loop nest has at least one iteration.
+    llvm::BasicBlock *PrecondEndBB = createBasicBlock("omp.loop.precond_end");
+    {
+      RunCleanupsScope PrecondScope(*this);
+      const Stmt *Body = CS->getCapturedStmt();
+      ArrayRef<Expr *> Arr = getCountersFromLoopDirective(&S);
+      for (unsigned I = 0; I < getCollapsedNumberFromLoopDirective(&S); ++I) {
+        RunCleanupsScope InitScope(*this);
+        const VarDecl *VD =
+            cast<VarDecl>(cast<DeclRefExpr>(Arr[I])->getDecl());
+        const ForStmt *For = getNextForStmtInLoopNest(Body);
+        Body = For->getBody();
+        if (CGM.OpenMPSupport.getTopOpenMPPrivateVar(VD))
+          continue;
+        QualType QTy = Arr[I]->getType();
+        llvm::AllocaInst *Private =
+            CreateMemTemp(QTy, CGM.getMangledName(VD) + ".private.");
+        CGM.OpenMPSupport.addOpenMPPrivateVar(VD, Private);
+        llvm::BasicBlock *PrecondBB = createBasicBlock("omp.loop.precond");
+        if (isa<DeclStmt>(For->getInit()))
+          EmitAnyExprToMem(VD->getAnyInitializer(), Private,
+                           VD->getType().getQualifiers(),
+                           /*IsInitializer=*/true);
+        else
+          EmitStmt(For->getInit());
+        EmitBranchOnBoolExpr(For->getCond(), PrecondBB, PrecondEndBB, 0);
+        EmitBlock(PrecondBB);
+      }
+    }
+
+    // Number of iterations and size of a chunk.
+    llvm::Type *VarTy = ConvertTypeForMem(LBVD->getType());
+    llvm::Value *NumIters = Builder.CreateIntCast(
+        EmitScalarExpr(getNewIterEndFromLoopDirective(&S)), VarTy, isSigned);
+    NumIters = Builder.CreateAdd(NumIters, llvm::ConstantInt::get(VarTy, 1));
+    llvm::Value *Grainsize = 0;
+    llvm::Value *NumTasks = llvm::ConstantInt::get(
+        VarTy, OMP_TASKLOOP_DEFAULT_NUM_TASKS);
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I) {
+      if (OMPGrainsizeClause *C = dyn_cast_or_null<OMPGrainsizeClause>(*I))
+        Grainsize = Builder.CreateIntCast(EmitScalarExpr(C->getGrainsize()),
+                                          VarTy, true);
+      else if (OMPNumTasksClause *C = dyn_cast_or_null<OMPNumTasksClause>(*I))
+        NumTasks = Builder.CreateIntCast(EmitScalarExpr(C->getNumTasks()),
+                                         VarTy, true);
+    }
+    llvm::Value *One = llvm::ConstantInt::get(VarTy, 1);
+    if (!Grainsize) {
+      // grainsize = (num_iters + num_tasks - 1) / num_tasks
+      Grainsize = Builder.CreateUDiv(
+          Builder.CreateSub(Builder.CreateAdd(NumIters, NumTasks), One),
+          NumTasks);
+    }
+    Grainsize = Builder.CreateSelect(Builder.CreateICmpULT(Grainsize, One),
+                                     One, Grainsize);
+
+    llvm::Value *Loc = OPENMPRTL_LOC(S.getLocStart(), *this);
+    llvm::Value *GTid = OPENMPRTL_THREADNUM(S.getLocStart(), *this);
+    EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(taskgroup), S.getLocStart());
+
+    // for (lb = 0; lb < num_iters; lb += grainsize)
+    //   generate task for [lb, min(lb + grainsize, num_iters) - 1];
+    llvm::AllocaInst *PLB = CreateTempAlloca(VarTy, ".taskloop.lb.");
+    PLB->setAlignment(CGM.getDataLayout().getPrefTypeAlignment(VarTy));
+    Builder.CreateStore(llvm::Constant::getNullValue(VarTy), PLB);
+    llvm::BasicBlock *CondBB = createBasicBlock("omp.taskloop.chunk.cond");
+    llvm::BasicBlock *BodyBB = createBasicBlock("omp.taskloop.chunk.body");
+    llvm::BasicBlock *EndBB = createBasicBlock("omp.taskloop.chunk.end");
+    EmitBlock(CondBB);
+    llvm::Value *LB = Builder.CreateLoad(PLB, ".lb.");
+    Builder.CreateCondBr(Builder.CreateICmpULT(LB, NumIters), BodyBB, EndBB);
+    EmitBlock(BodyBB);
+    llvm::Value *NextLB = Builder.CreateAdd(LB, Grainsize);
+    llvm::Value *UB = Builder.CreateSub(
+        Builder.CreateSelect(Builder.CreateICmpULT(NextLB, NumIters), NextLB,
+                             NumIters),
+        One, ".ub.");
+    llvm::Value *RealArgs[] = {
+        Loc, GTid, Builder.CreateLoad(Flags, ".flags."),
+        Builder.CreateAdd(
+            Builder.CreateIntCast(llvm::ConstantExpr::getSizeOf(TaskTTy),
+                                  SizeTy, false),
+            llvm::ConstantInt::get(
+                SizeTy,
+                getContext().getTypeSizeInChars(PrivateRecord).getQuantity())),
+        llvm::ConstantInt::get(
+            SizeTy, getContext().getTypeSizeInChars(QTy).getQuantity()),
+        Fn};
+    // kmpc_task_t val = __kmpc_omp_task_alloc(&loc, gtid, flags,
+    // sizeof(kmpc_task_t), sizeof(shareds), task_entry);
+    llvm::Value *TaskTVal =
+        EmitRuntimeCall(OPENMPRTL_FUNC(omp_task_alloc), makeArrayRef(RealArgs),
+                        ".task_t.val.addr");
+    llvm::Value *SharedAddr = Builder.CreateConstInBoundsGEP2_32(
+        TaskTTy,
+        TaskTVal, 0, llvm::TaskTBuilder::shareds, ".shared.addr");
+    EmitAggregateAssign(Builder.CreateLoad(SharedAddr), Arg, QTy);
+    if (Destructors) {
+      llvm::Value *DestructorsAddr = Builder.CreateConstInBoundsGEP2_32(
+          TaskTTy,
+          TaskTVal, 0, llvm::TaskTBuilder::destructors, ".destructors.addr");
+      Builder.CreateStore(Destructors, DestructorsAddr);
+    }
+    llvm::Value *Locker = Builder.CreateConstGEP1_32(TaskTVal, 1);
+    CGM.OpenMPSupport.setPTask(Fn, TaskTVal, LPrivateTy, PrivateRecord, Locker);
+    {
+      RunCleanupsScope ExecutedScope(*this);
+      // Skip firstprivate sync for tasks.
+      for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                           E = S.clauses().end();
+           I != E; ++I)
+        if (*I && (isa<OMPPrivateClause>(*I) || isa<OMPFirstPrivateClause>(*I)))
+          EmitPreOMPClause(*(*I), S);
+
+      LValue PrivatesLV = MakeNaturalAlignAddrLValue(
+          Builder.CreatePointerCast(Locker, LPrivateTy->getPointerTo()),
+          PrivateRecord);
+      EmitStoreOfScalar(LB, EmitLValueForField(PrivatesLV, LBField));
+      EmitStoreOfScalar(UB, EmitLValueForField(PrivatesLV, UBField));
+
+      llvm::Type *PtrDepTy = OPENMPRTL_DINFOTY->getPointerTo();
+      llvm::Value *RealArgs1[] = {Loc,
+                                  GTid,
+                                  TaskTVal,
+                                  llvm::ConstantInt::get(Int32Ty, 0),
+                                  llvm::Constant::getNullValue(PtrDepTy),
+                                  llvm::ConstantInt::get(Int32Ty, 0),
+                                  llvm::Constant::getNullValue(PtrDepTy)};
+      EmitRuntimeCall(OPENMPRTL_FUNC(omp_task_with_deps), RealArgs1,
+                      ".task.res.");
+    }
+    Builder.CreateStore(NextLB, PLB);
+    EmitBranch(CondBB);
+    EmitBlock(EndBB);
+
+    EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(end_taskgroup),
+                                   S.getLocStart());
+    EmitBlock(PrecondEndBB);
+  }
+
   // CodeGen for clauses (task finalize).
   for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
                                        E = S.clauses().end();
@@ -3211,6 +4710,17 @@ void CodeGenFunction::EmitOMPTaskDirective(const OMPTaskDirective &S) {
   CGM.OpenMPSupport.endOpenMPRegion();
 }
 
+/// Generate an instructions for '#pragma omp taskloop' directive.
+void CodeGenFunction::EmitOMPTaskLoopDirective(const OMPTaskLoopDirective &S) {
+  EmitOMPDirectiveWithTaskLoop(OMPD_taskloop, S);
+}
+
+/// Generate an instructions for '#pragma omp taskloop simd' directive.
+void CodeGenFunction::EmitOMPTaskLoopSimdDirective(
+    const OMPTaskLoopSimdDirective &S) {
+  EmitOMPDirectiveWithTaskLoop(OMPD_taskloop_simd, S);
+}
+
 /// Generate an instructions for '#pragma omp sections' directive.
 void
 CodeGenFunction::EmitOMPSectionsDirective(OpenMPDirectiveKind,
@@ -3478,6 +4988,15 @@ void CodeGenFunction::EmitInitOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
     break;
   }
 }
@@ -3524,6 +5043,15 @@ void CodeGenFunction::EmitAfterInitOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
     break;
   }
 }
@@ -3543,7 +5071,6 @@ void CodeGenFunction::EmitPreOMPClause(const OMPClause &C,
   case OMPC_shared:
   case OMPC_collapse:
   case OMPC_nowait:
-  case OMPC_ordered:
   case OMPC_copyprivate:
   case OMPC_untied:
   case OMPC_final:
@@ -3557,6 +5084,17 @@ void CodeGenFunction::EmitPreOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+    break;
+  case OMPC_ordered:
+    EmitPreOMPOrderedClause(cast<OMPOrderedClause>(C), S);
     break;
   case OMPC_map:
     EmitPreOMPMapClause(cast<OMPMapClause>(C), S);
@@ -3576,6 +5114,9 @@ void CodeGenFunction::EmitPreOMPClause(const OMPClause &C,
   case OMPC_reduction:
     EmitPreOMPReductionClause(cast<OMPReductionClause>(C), S);
     break;
+  case OMPC_in_reduction:
+    EmitPreOMPInReductionClause(cast<OMPInReductionClause>(C), S);
+    break;
   case OMPC_schedule:
     EmitPreOMPScheduleClause(cast<OMPScheduleClause>(C), S);
     break;
@@ -3602,7 +5143,6 @@ void CodeGenFunction::EmitPostOMPClause(const OMPClause &C,
   case OMPC_shared:
   case OMPC_collapse:
   case OMPC_nowait:
-  case OMPC_ordered:
   case OMPC_schedule:
   case OMPC_dist_schedule:
   case OMPC_untied:
@@ -3617,9 +5157,21 @@ void CodeGenFunction::EmitPostOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
   case OMPC_private:
   case OMPC_firstprivate:
     break;
+  case OMPC_ordered:
+    EmitPostOMPOrderedClause(cast<OMPOrderedClause>(C), S);
+    break;
   case OMPC_map:
     EmitPostOMPMapClause(cast<OMPMapClause>(C), S);
     break;
@@ -3666,6 +5218,15 @@ void CodeGenFunction::EmitCloseOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
   case OMPC_map:
     break;
   case OMPC_lastprivate:
@@ -3712,6 +5273,15 @@ void CodeGenFunction::EmitFinalOMPClause(const OMPClause &C,
   case OMPC_linear:
   case OMPC_aligned:
   case OMPC_safelen:
+  case OMPC_simdlen:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
+  case OMPC_is_device_ptr:
+  case OMPC_defaultmap:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
   case OMPC_to:
   case OMPC_from:
     break;
@@ -3730,9 +5300,57 @@ void CodeGenFunction::EmitInitOMPNowaitClause(const OMPNowaitClause &,
 }
 
 void
-CodeGenFunction::EmitInitOMPOrderedClause(const OMPOrderedClause &,
-                                          const OMPExecutableDirective &) {
-  CGM.OpenMPSupport.setOrdered(true);
+CodeGenFunction::EmitInitOMPOrderedClause(const OMPOrderedClause &C,
+                                          const OMPExecutableDirective &S) {
+  if (C.getNumLoops() == 0) {
+    CGM.OpenMPSupport.setOrdered(true);
+    return;
+  }
+  // Doacross loop: iterations are synchronized point-to-point by the
+  // 'ordered depend(...)' directives in the body, so the schedule stays
+  // unordered. Remember the counters of the doacross loops, collapsed or
+  // not, to build the iteration vectors.
+  SmallVector<const Expr *, 4> DoacrossCounters;
+  for (unsigned I = 0, E = C.getNumLoops(); I < E; ++I)
+    DoacrossCounters.push_back(C.getLoopCounter(I));
+  CGM.OpenMPSupport.setDoacrossCounters(DoacrossCounters);
+}
+
+void
+CodeGenFunction::EmitPreOMPOrderedClause(const OMPOrderedClause &C,
+                                         const OMPExecutableDirective &S) {
+  if (C.getNumLoops() == 0)
+    return;
+  // struct kmp_dim { int64 lo; int64 up; int64 st; } dims[n];
+  // __kmpc_doacross_init(&loc, gtid, n, dims);
+  unsigned NumLoops = C.getNumLoops();
+  llvm::Type *DimsTy = llvm::ArrayType::get(Int64Ty, 3 * NumLoops);
+  llvm::AllocaInst *Dims = CreateTempAlloca(DimsTy, ".doacross.dims.");
+  Dims->setAlignment(CGM.getDataLayout().getPrefTypeAlignment(Int64Ty));
+  for (unsigned I = 0; I < NumLoops; ++I) {
+    const Expr *Dim[] = {C.getLoopLowerBound(I), C.getLoopUpperBound(I),
+                         C.getLoopStep(I)};
+    for (unsigned J = 0; J < 3; ++J)
+      Builder.CreateStore(
+          EmitScalarExpr(Dim[J]),
+          Builder.CreateConstInBoundsGEP2_32(DimsTy, Dims, 0, 3 * I + J));
+  }
+  llvm::Value *RealArgs[] = {
+      OPENMPRTL_LOC(S.getLocStart(), *this),
+      OPENMPRTL_THREADNUM(S.getLocStart(), *this),
+      Builder.getInt32(NumLoops),
+      Builder.CreateConstInBoundsGEP2_32(DimsTy, Dims, 0, 0)};
+  EmitRuntimeCall(OPENMPRTL_FUNC(doacross_init), RealArgs);
+}
+
+void
+CodeGenFunction::EmitPostOMPOrderedClause(const OMPOrderedClause &C,
+                                          const OMPExecutableDirective &S) {
+  if (C.getNumLoops() == 0)
+    return;
+  // __kmpc_doacross_fini(&loc, gtid);
+  EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(doacross_fini),
+                                 S.getLocEnd());
 }
 
 void CodeGenFunction::EmitInitOMPUntiedClause(const OMPUntiedClause &,
@@ -3832,7 +5450,56 @@ CodeGenFunction::EmitInitOMPDeviceClause(const OMPDeviceClause &C,
   CGM.OpenMPSupport.setOffloadingDevice(DeviceID);
 }
 
-void CodeGenFunction::AppendOpenMPStackWithMapInfo(const OMPClause &C){
+/// \brief Returns true if \a E1 and \a E2 are known to be equal integer
+/// constants.
+static bool isSameOMPConstant(const ASTContext &Ctx, const Expr *E1,
+                              const Expr *E2) {
+  llvm::APSInt V1, V2;
+  if (!E1 || !E2 || !E1->EvaluateAsInt(V1, Ctx) || !E2->EvaluateAsInt(V2, Ctx))
+    return false;
+  return llvm::APSInt::isSameValue(V1, V2);
+}
+
+/// \brief Returns true if the map list items \a E1 and \a E2 designate the
+/// same storage: the same variable, or array sections of the same variable
+/// with the same constant bounds.
+static bool isSameOMPMapItem(const ASTContext &Ctx, const Expr *E1,
+                             const Expr *E2) {
+  E1 = E1->IgnoreParenImpCasts();
+  E2 = E2->IgnoreParenImpCasts();
+  if (const auto *DE1 = dyn_cast<DeclRefExpr>(E1)) {
+    const auto *DE2 = dyn_cast<DeclRefExpr>(E2);
+    return DE2 && DE1->getDecl() == DE2->getDecl();
+  }
+  const auto *ASE1 = dyn_cast<ArraySubscriptExpr>(E1);
+  const auto *ASE2 = dyn_cast<ArraySubscriptExpr>(E2);
+  if (!ASE1 || !ASE2 || !isSameOMPMapItem(Ctx, ASE1->getBase(),
+                                          ASE2->getBase()))
+    return false;
+  const Expr *Idx1 = ASE1->getIdx()->IgnoreParenImpCasts();
+  const Expr *Idx2 = ASE2->getIdx()->IgnoreParenImpCasts();
+  const auto *Sec1 = dyn_cast<CEANIndexExpr>(Idx1);
+  const auto *Sec2 = dyn_cast<CEANIndexExpr>(Idx2);
+  if (Sec1 && Sec2)
+    return isSameOMPConstant(Ctx, Sec1->getLowerBound(),
+                             Sec2->getLowerBound()) &&
+           isSameOMPConstant(Ctx, Sec1->getLength(), Sec2->getLength());
+  return !Sec1 && !Sec2 && isSameOMPConstant(Ctx, Idx1, Idx2);
+}
+
+bool CodeGenFunction::isOMPPresentOnDevice(const Expr *E,
+                                           int64_t Device) const {
+  // A different section of the same variable may not be present, or only
+  // in part, so only the exact same map list item is.
+  for (unsigned i = 0; i < OMPDevicePresentVars.size(); ++i)
+    if (OMPDevicePresentVars[i].Device == Device &&
+        isSameOMPMapItem(getContext(), OMPDevicePresentVars[i].E, E))
+      return true;
+  return false;
+}
+
+void CodeGenFunction::AppendOpenMPStackWithMapInfo(
+    const OMPClause &C, const OMPExecutableDirective &S) {
 
   // Here we add information about the maps to the OpenMP stack so the runtime
   // calls can be easily generated.
@@ -3902,6 +5569,13 @@ void CodeGenFunction::AppendOpenMPStackWithMapInfo(const OMPClause &C){
       BaseAddrs.size() == Vars.size() && BaseAddrs.size() == Addrs.size()
           && BaseAddrs.size() == Sizes.size() && "Vars addresses mismatch!");
 
+  // Data already present on the device from an enclosing 'target data' region
+  // is not transferred again by a map clause, only its device address is
+  // looked up.
+  int64_t Device;
+  bool SkipPresent = C.getClauseKind() == OMPC_map &&
+                     canSkipOMPPresentTransfers(*this, S, Device);
+
   for (unsigned i = 0; i < BaseAddrs.size(); ++i) {
     const Expr * Var = Vars[i];
     llvm::Value * VB = EmitAnyExprToTemp(BaseAddrs[i]).getScalarVal();
@@ -3961,6 +5635,10 @@ void CodeGenFunction::AppendOpenMPStackWithMapInfo(const OMPClause &C){
     //if (hasRange && CGM.OpenMPSupport.locateInPreviousOffloadingMap(VarDecl))
     //  continue;
 
+    unsigned EntryType = MapType;
+    if (SkipPresent && isOMPPresentOnDevice(Var, Device))
+      EntryType &= ~(OMP_TGT_MAPTYPE_TO | OMP_TGT_MAPTYPE_FROM);
+
     // Is this a pointer with a range?
     if (VarDecl->getType()->isPointerType() && hasRange){
       llvm::Value *P = EmitDeclRefLValue(VarDecl).getAddress();
@@ -3970,12 +5648,12 @@ void CodeGenFunction::AppendOpenMPStackWithMapInfo(const OMPClause &C){
 //          OMP_TGT_MAPTYPE_ALLOC | OMP_TGT_MAPTYPE_POINTER);
 
       CGM.OpenMPSupport.addOffloadingMap(VarDecl, P, VP, VS,
-          MapType | OMP_TGT_MAPTYPE_POINTER);
+          EntryType | OMP_TGT_MAPTYPE_POINTER);
 
       continue;
     }
 
-    CGM.OpenMPSupport.addOffloadingMap(VarDecl, VB, VP, VS, MapType);
+    CGM.OpenMPSupport.addOffloadingMap(VarDecl, VB, VP, VS, EntryType);
   }
 
 }
@@ -4107,8 +5785,8 @@ void CodeGenFunction::EmitAfterOMPMapClause(const OMPMapClause &C,
 }
 
 void CodeGenFunction::EmitInitOMPMapClause(const OMPMapClause &C,
-    const OMPExecutableDirective &) {
-  AppendOpenMPStackWithMapInfo(C);
+    const OMPExecutableDirective &S) {
+  AppendOpenMPStackWithMapInfo(C, S);
 }
 
 void CodeGenFunction::EmitPreOMPMapClause(const OMPMapClause &C,
@@ -4155,13 +5833,13 @@ void CodeGenFunction::EmitPostOMPMapClause(const OMPMapClause &C,
 }
 
 void CodeGenFunction::EmitInitOMPToClause(const OMPToClause &C,
-    const OMPExecutableDirective &) {
-  AppendOpenMPStackWithMapInfo(C);
+    const OMPExecutableDirective &S) {
+  AppendOpenMPStackWithMapInfo(C, S);
 }
 
 void CodeGenFunction::EmitInitOMPFromClause(const OMPFromClause &C,
-    const OMPExecutableDirective &) {
-  AppendOpenMPStackWithMapInfo(C);
+    const OMPExecutableDirective &S) {
+  AppendOpenMPStackWithMapInfo(C, S);
 }
 
 void CodeGenFunction::EmitAfterInitOMPIfClause(const OMPIfClause &C,
@@ -4317,7 +5995,13 @@ CodeGenFunction::EmitPreOMPScheduleClause(const OMPScheduleClause &C,
     Schedule = ChunkSize ? KMP_SCH_STATIC_CHUNKED : KMP_SCH_STATIC;
     break;
   case OMPC_SCHEDULE_dynamic:
-    Schedule = KMP_SCH_DYNAMIC_CHUNKED;
+    // Nonmonotonic dynamic schedule does not require the chunks to be handed
+    // out in increasing order, so use the work-stealing schedule: every
+    // thread starts with its own static range and steals from the others
+    // when it runs out of work instead of contending on a shared counter.
+    Schedule = C.getScheduleModifier() == OMPC_SCHEDULE_MODIFIER_nonmonotonic
+                   ? KMP_SCH_STATIC_STEAL
+                   : KMP_SCH_DYNAMIC_CHUNKED;
     break;
   case OMPC_SCHEDULE_guided:
     Schedule = KMP_SCH_GUIDED_CHUNKED;
@@ -4480,6 +6164,100 @@ CodeGenFunction::EmitCopyAssignment(ArrayRef<const Expr *>::iterator I,
   }
 }
 
+/// \brief Copies the thread_local threadprivate variables of the copyin
+/// clause \a C from the master thread. The copy of the master is reachable
+/// from its own thread only, so its address is broadcast to the team by
+/// __kmpc_copyprivate.
+static void EmitOMPCopyinTLS(CodeGenFunction &CGF, const OMPCopyinClause &C) {
+  CodeGenModule &CGM = CGF.CGM;
+  ASTContext &Ctx = CGF.getContext();
+  CGOpenMPRuntime &RT = CGM.getOpenMPRuntime();
+
+  // Generate the record of the addresses of the copies - cpy.var
+  llvm::SmallVector<llvm::Type *, 4> CpyFieldTypes;
+  for (OMPCopyinClause::varlist_const_iterator I = C.varlist_begin(),
+                                               E = C.varlist_end();
+       I != E; ++I) {
+    const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    if (RT.isThreadPrivateTLS(VD))
+      CpyFieldTypes.push_back(
+          CGF.ConvertType(Ctx.getPointerType((*I)->getType())));
+  }
+  llvm::StructType *CpyType =
+      llvm::StructType::get(CGM.getLLVMContext(), CpyFieldTypes);
+  llvm::AllocaInst *CpyVar = CGF.CreateTempAlloca(CpyType, "cpy.var");
+  CpyVar->setAlignment(CGM.PointerAlignInBytes);
+
+  // Start a copy-function.
+  CodeGenFunction CopyCGF(CGM, true);
+  CopyCGF.CurFn = 0;
+  FunctionArgList Args;
+  ImplicitParamDecl Arg1(Ctx, 0, SourceLocation(), 0, Ctx.VoidPtrTy);
+  ImplicitParamDecl Arg2(Ctx, 0, SourceLocation(), 0, Ctx.VoidPtrTy);
+  Args.push_back(&Arg1);
+  Args.push_back(&Arg2);
+  const CGFunctionInfo &FI = CGF.getTypes().arrangeFreeFunctionDeclaration(
+      Ctx.VoidTy, Args, FunctionType::ExtInfo(), false);
+  llvm::FunctionType *FTy = CGF.getTypes().GetFunctionType(FI);
+  llvm::Function *Fn =
+      llvm::Function::Create(FTy, llvm::GlobalValue::InternalLinkage,
+                             StringRef(".omp_copyin_func."), &CGM.getModule());
+  CGM.SetInternalFunctionAttributes(CGF.CurFuncDecl, Fn, FI);
+  CopyCGF.StartFunction(GlobalDecl(), Ctx.VoidTy, Fn, FI, Args,
+                        SourceLocation());
+  llvm::Function::arg_iterator ArgIt = Fn->arg_begin();
+  llvm::Value *DstPtr = ArgIt;
+  llvm::Value *SrcPtr = ++ArgIt;
+  llvm::Value *DstBase = CopyCGF.Builder.CreatePointerCast(
+      DstPtr, CpyType->getPointerTo(), "cpy.dst");
+  llvm::Value *SrcBase = CopyCGF.Builder.CreatePointerCast(
+      SrcPtr, CpyType->getPointerTo(), "cpy.src");
+
+  // Store the addresses of the copies of the current thread into the record
+  // and copy the fields in the copy-function.
+  ArrayRef<const Expr *>::iterator AssignIter = C.getAssignments().begin();
+  ArrayRef<const Expr *>::iterator VarIter1 = C.getPseudoVars1().begin();
+  ArrayRef<const Expr *>::iterator VarIter2 = C.getPseudoVars2().begin();
+  unsigned FieldNum = 0;
+  for (OMPCopyinClause::varlist_const_iterator I = C.varlist_begin(),
+                                               E = C.varlist_end();
+       I != E; ++I, ++AssignIter, ++VarIter1, ++VarIter2) {
+    const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    if (!RT.isThreadPrivateTLS(VD))
+      continue;
+    CGF.Builder.CreateStore(
+        CGF.EmitLValue(*I).getAddress(),
+        CGF.Builder.CreateConstGEP2_32(CpyType, CpyVar, 0, FieldNum));
+    QualType PtrQTy = Ctx.getPointerType((*I)->getType());
+    unsigned Align = CGM.getDataLayout().getPrefTypeAlignment(
+        CGF.ConvertType(PtrQTy));
+    llvm::Value *Dst = CopyCGF.EmitLoadOfScalar(
+        CopyCGF.Builder.CreateConstGEP2_32(CpyType, DstBase, 0, FieldNum),
+        false, Align, PtrQTy, SourceLocation());
+    llvm::Value *Src = CopyCGF.EmitLoadOfScalar(
+        CopyCGF.Builder.CreateConstGEP2_32(CpyType, SrcBase, 0, FieldNum),
+        false, Align, PtrQTy, SourceLocation());
+    CopyCGF.EmitCopyAssignment(I, AssignIter, VarIter1, VarIter2, Dst, Src);
+    ++FieldNum;
+  }
+  CopyCGF.FinishFunction();
+
+  // __kmpc_copyprivate(&loc, global_tid, sizeof(cpy.var), &cpy.var,
+  //                    copy_func, __kmpc_bound_thread_num(&loc) == 0);
+  llvm::Value *DidIt = CGF.Builder.CreateZExt(
+      CGF.Builder.CreateIsNull(
+          RT.CreateOpenMPBoundThreadNum(C.getLocStart(), CGF)),
+      CGF.Int32Ty);
+  llvm::Value *RealArgs[] = {
+      RT.CreateIntelOpenMPRTLLoc(C.getLocStart(), CGF),
+      RT.CreateOpenMPGlobalThreadNum(C.getLocStart(), CGF),
+      llvm::ConstantInt::get(CGF.SizeTy,
+                             CGM.getDataLayout().getTypeAllocSize(CpyType)),
+      CGF.Builder.CreateBitCast(CpyVar, CGF.VoidPtrTy, "(void*)cpyrec"), Fn,
+      DidIt};
+  CGF.EmitRuntimeCall(RT.Get_copyprivate(), RealArgs);
+}
+
 void CodeGenFunction::EmitPreOMPCopyinClause(const OMPCopyinClause &C,
                                              const OMPExecutableDirective &) {
   // copy_data(var1);
@@ -4490,16 +6268,23 @@ void CodeGenFunction::EmitPreOMPCopyinClause(const OMPCopyinClause &C,
   ArrayRef<const Expr *>::iterator VarIter1 = C.getPseudoVars1().begin();
   ArrayRef<const Expr *>::iterator VarIter2 = C.getPseudoVars2().begin();
 
+  bool HasTLSVars = false;
   for (OMPCopyinClause::varlist_const_iterator I = C.varlist_begin(),
                                                E = C.varlist_end();
        I != E; ++I, ++AssignIter, ++VarIter1, ++VarIter2) {
     const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    if (CGM.getOpenMPRuntime().isThreadPrivateTLS(VD)) {
+      HasTLSVars = true;
+      continue;
+    }
     EmitCopyAssignment(I, AssignIter, VarIter1, VarIter2,
                        OPENMPRTL_THREADPVTCACHED(
                            VD, (*I)->getExprLoc(), *this, true),
                        VD->isStaticLocal() ? CGM.getStaticLocalDeclAddress(VD)
                                            : CGM.GetAddrOfGlobal(VD));
   }
+  if (HasTLSVars)
+    EmitOMPCopyinTLS(*this, C);
   SetFirstprivateInsertPt(*this);
 }
 
@@ -4606,9 +6391,123 @@ void CodeGenFunction::EmitPreOMPPrivateClause(const OMPPrivateClause &C,
   }
 }
 
+/// \brief Returns the variable whose storage is accessed by \a E through
+/// member accesses and array subscripts, or null. The subscript expressions
+/// are added to \a Indices.
+static const VarDecl *
+getOMPAccessedVar(const Expr *E, SmallVectorImpl<const Expr *> &Indices) {
+  E = E->IgnoreParenImpCasts();
+  while (true) {
+    if (const auto *ME = dyn_cast<MemberExpr>(E)) {
+      E = ME->getBase()->IgnoreParenImpCasts();
+    } else if (const auto *ASE = dyn_cast<ArraySubscriptExpr>(E)) {
+      Indices.push_back(ASE->getIdx());
+      E = ASE->getBase()->IgnoreParenImpCasts();
+    } else
+      break;
+  }
+  if (const auto *DE = dyn_cast<DeclRefExpr>(E))
+    return dyn_cast<VarDecl>(DE->getDecl());
+  return nullptr;
+}
+
+void CodeGenFunction::getOMPNestedStmts(
+    const Stmt *S, SmallVectorImpl<const Stmt *> &Children) {
+  // The children of a captured statement are the capture initializers.
+  if (const auto *CS = dyn_cast<CapturedStmt>(S)) {
+    Children.push_back(CS->getCapturedStmt());
+    return;
+  }
+  if (const auto *D = dyn_cast<OMPExecutableDirective>(S))
+    for (const OMPClause *C : D->clauses())
+      if (C)
+        for (const Stmt *Child : C->children())
+          Children.push_back(Child);
+  for (const Stmt *Child : S->children())
+    Children.push_back(Child);
+}
+
+bool CodeGenFunction::isOMPReadOnlyVar(const Stmt *S, const VarDecl *VD,
+                                       bool AllowStores) {
+  if (!S)
+    return true;
+
+  const Expr *Access = nullptr;
+  const Expr *Value = nullptr;
+  if (const auto *ICE = dyn_cast<ImplicitCastExpr>(S)) {
+    if (ICE->getCastKind() == CK_LValueToRValue)
+      Access = ICE->getSubExpr();
+  } else if (const auto *BO = dyn_cast<BinaryOperator>(S)) {
+    if (AllowStores && BO->isAssignmentOp()) {
+      Access = BO->getLHS();
+      Value = BO->getRHS();
+    }
+  } else if (const auto *UO = dyn_cast<UnaryOperator>(S)) {
+    if (AllowStores && UO->isIncrementDecrementOp())
+      Access = UO->getSubExpr();
+  }
+  if (Access) {
+    SmallVector<const Expr *, 4> Indices;
+    if (getOMPAccessedVar(Access, Indices) == VD) {
+      for (const Expr *Idx : Indices)
+        if (!isOMPReadOnlyVar(Idx, VD, AllowStores))
+          return false;
+      return isOMPReadOnlyVar(Value, VD, AllowStores);
+    }
+  }
+
+  if (const auto *DE = dyn_cast<DeclRefExpr>(S))
+    return DE->getDecl() != VD;
+  // Stores from the threads of a nested region are never allowed.
+  if (isa<CapturedStmt>(S))
+    AllowStores = false;
+  SmallVector<const Stmt *, 8> Children;
+  getOMPNestedStmts(S, Children);
+  for (const Stmt *Child : Children)
+    if (!isOMPReadOnlyVar(Child, VD, AllowStores))
+      return false;
+  return true;
+}
+
+/// \brief Returns true if the threads executing \a S can read the firstprivate
+/// variable \a VD from its original storage instead of from a private copy.
+/// This is the case for aggregates larger than a register whose copy has no
+/// side effects, that are never written in the region and whose address does
+/// not escape in their scope, so they cannot be changed while the region runs.
+static bool IsOMPSharedFirstPrivateVar(CodeGenFunction &CGF,
+                                       const OMPExecutableDirective &S,
+                                       const VarDecl *VD, QualType QTy) {
+  ASTContext &Ctx = CGF.getContext();
+  if (QTy->isScalarType() || QTy->isReferenceType() ||
+      QTy->isVariablyModifiedType() || QTy.isVolatileQualified() ||
+      !QTy.isTriviallyCopyableType(Ctx))
+    return false;
+  // Values that fit in a register are cheaper to copy.
+  if (Ctx.getTypeSize(QTy) <= Ctx.getTypeSize(Ctx.VoidPtrTy))
+    return false;
+  if (!VD->hasLocalStorage() || isa<ParmVarDecl>(VD))
+    return false;
+
+  // The final value of a lastprivate variable is the one of the private copy.
+  for (const OMPClause *C : S.clauses())
+    if (const auto *LC = dyn_cast_or_null<OMPLastPrivateClause>(C))
+      for (const Expr *E : LC->varlists())
+        if (cast<DeclRefExpr>(E)->getDecl() == VD)
+          return false;
+
+  const auto *CS = cast<CapturedStmt>(S.getAssociatedStmt());
+  if (!CodeGenFunction::isOMPReadOnlyVar(CS->getCapturedStmt(), VD))
+    return false;
+
+  const Stmt *Scope =
+      Decl::castFromDeclContext(VD->getDeclContext())->getBody();
+  return Scope && CodeGenFunction::isOMPReadOnlyVar(Scope, VD,
+                                                    /*AllowStores=*/true);
+}
+
 void
 CodeGenFunction::EmitPreOMPFirstPrivateClause(const OMPFirstPrivateClause &C,
-                                              const OMPExecutableDirective &) {
+                                              const OMPExecutableDirective &S) {
   // Type1 tmp1(var1);
   // anon.field1 = &tmp1;
   // Type2 tmp2(var2);
@@ -4654,6 +6553,13 @@ CodeGenFunction::EmitPreOMPFirstPrivateClause(const OMPFirstPrivateClause &C,
         continue;
       }
     }
+    // Read-only aggregates are accessed in place, they cannot change while
+    // the threads run. Deferred tasks may outlive them, so they always copy.
+    if (!PTask && !CGM.OpenMPSupport.isNewTask() &&
+        IsOMPSharedFirstPrivateVar(*this, S, VD, QTy)) {
+      CGM.OpenMPSupport.addOpenMPPrivateVar(VD, EmitLValue(*I).getAddress());
+      continue;
+    }
     if (PTask) {
       Base = Builder.CreatePointerCast(Base, PrivateTy->getPointerTo());
       Private = EmitLValueForField(MakeNaturalAlignAddrLValue(Base, PrivateQTy),
@@ -5011,6 +6917,102 @@ void CodeGenFunction::EmitCloseOMPLastPrivateClause(
   }
 }
 
+/// \brief Returns the kind used to pack the reduction item \a VD into the
+/// reduction record by value, or -1 if the item must be passed by pointer.
+/// Items with the same pack kind and type are combined with vector operations
+/// by the reduction function.
+static int getReductionPackKind(CodeGenModule &CGM, const VarDecl *VD,
+                                QualType QTy,
+                                OpenMPReductionClauseOperator Op) {
+  if (CGM.getTarget().getTriple().getArch() == llvm::Triple::nvptx ||
+      CGM.getTarget().getTriple().getArch() == llvm::Triple::nvptx64)
+    return -1;
+  if (VD->getType()->isReferenceType() || QTy.isVolatileQualified() ||
+      QTy->isBooleanType())
+    return -1;
+  if (QTy->isRealFloatingType()) {
+    llvm::Type *Ty = CGM.getTypes().ConvertTypeForMem(QTy);
+    if (!Ty->isFloatTy() && !Ty->isDoubleTy())
+      return -1;
+  } else if (!QTy->isIntegerType())
+    return -1;
+  switch (Op) {
+  case OMPC_REDUCTION_sub:
+    // Partial results of '-' are combined with '+'.
+    Op = OMPC_REDUCTION_add;
+    // Fall through.
+  case OMPC_REDUCTION_add:
+  case OMPC_REDUCTION_mult:
+  case OMPC_REDUCTION_bitand:
+  case OMPC_REDUCTION_bitor:
+  case OMPC_REDUCTION_bitxor:
+  case OMPC_REDUCTION_min:
+  case OMPC_REDUCTION_max:
+    return Op * 2 + (QTy->isUnsignedIntegerOrEnumerationType() ? 1 : 0);
+  case OMPC_REDUCTION_and:
+  case OMPC_REDUCTION_or:
+  case OMPC_REDUCTION_custom:
+  case OMPC_REDUCTION_unknown:
+  case NUM_OPENMP_REDUCTION_OPERATORS:
+    break;
+  }
+  return -1;
+}
+
+/// \brief Combines \a NumElts adjacent fields of type \a EltTy of two
+/// reduction records, packed by value with the kind \a PackKind.
+static void EmitPackedReductionCombine(CodeGenFunction &CGF,
+                                       llvm::Value *LHSAddr,
+                                       llvm::Value *RHSAddr, llvm::Type *EltTy,
+                                       unsigned NumElts, int PackKind) {
+  CGBuilderTy &Builder = CGF.Builder;
+  unsigned Align = CGF.CGM.getDataLayout().getABITypeAlignment(EltTy);
+  if (NumElts > 1) {
+    llvm::Type *VecTy = llvm::VectorType::get(EltTy, NumElts);
+    LHSAddr = Builder.CreateBitCast(LHSAddr, VecTy->getPointerTo());
+    RHSAddr = Builder.CreateBitCast(RHSAddr, VecTy->getPointerTo());
+  }
+  llvm::Value *LHS = Builder.CreateAlignedLoad(LHSAddr, Align, ".red.lhs.");
+  llvm::Value *RHS = Builder.CreateAlignedLoad(RHSAddr, Align, ".red.rhs.");
+  bool IsFloat = EltTy->isFloatingPointTy();
+  bool IsUnsigned = PackKind % 2;
+  llvm::Value *Res = 0;
+  switch (static_cast<OpenMPReductionClauseOperator>(PackKind / 2)) {
+  case OMPC_REDUCTION_add:
+    Res = IsFloat ? Builder.CreateFAdd(LHS, RHS) : Builder.CreateAdd(LHS, RHS);
+    break;
+  case OMPC_REDUCTION_mult:
+    Res = IsFloat ? Builder.CreateFMul(LHS, RHS) : Builder.CreateMul(LHS, RHS);
+    break;
+  case OMPC_REDUCTION_bitand:
+    Res = Builder.CreateAnd(LHS, RHS);
+    break;
+  case OMPC_REDUCTION_bitor:
+    Res = Builder.CreateOr(LHS, RHS);
+    break;
+  case OMPC_REDUCTION_bitxor:
+    Res = Builder.CreateXor(LHS, RHS);
+    break;
+  case OMPC_REDUCTION_min:
+    Res = Builder.CreateSelect(
+        IsFloat ? Builder.CreateFCmpOLT(LHS, RHS)
+                : IsUnsigned ? Builder.CreateICmpULT(LHS, RHS)
+                             : Builder.CreateICmpSLT(LHS, RHS),
+        LHS, RHS);
+    break;
+  case OMPC_REDUCTION_max:
+    Res = Builder.CreateSelect(
+        IsFloat ? Builder.CreateFCmpOGT(LHS, RHS)
+                : IsUnsigned ? Builder.CreateICmpUGT(LHS, RHS)
+                             : Builder.CreateICmpSGT(LHS, RHS),
+        LHS, RHS);
+    break;
+  default:
+    llvm_unreachable("Reduction operator cannot be packed.");
+  }
+  Builder.CreateAlignedStore(Res, LHSAddr, Align);
+}
+
 void
 CodeGenFunction::EmitInitOMPReductionClause(const OMPReductionClause &C,
                                             const OMPExecutableDirective &S) {
@@ -5063,8 +7065,239 @@ CodeGenFunction::EmitInitOMPReductionClause(const OMPReductionClause &C,
     // if (!QTy->isScalarType())
     //  llvm_unreachable("Reduction variables with aggregate"
     //                   "types are not supported yet!");
-    llvm::Type *PtrType = ConvertType(getContext().getPointerType(QTy));
-    CGM.OpenMPSupport.registerReductionVar(VD, PtrType);
+    // Scalar items with builtin operators are stored in the reduction record
+    // by value, all the others as pointers to their private copies.
+    int PackKind = getReductionPackKind(CGM, VD, QTy, C.getOperator());
+    if (PackKind >= 0) {
+      CGM.OpenMPSupport.registerReductionVar(VD, ConvertTypeForMem(QTy),
+                                             PackKind);
+    } else {
+      llvm::Type *PtrType = ConvertType(getContext().getPointerType(QTy));
+      CGM.OpenMPSupport.registerReductionVar(VD, PtrType);
+    }
+  }
+}
+
+/// \brief Initializes the private copy \a Private of a reduction item of type
+/// \a QTy with the identity value of the reduction operator \a Op.
+void CodeGenFunction::EmitOMPReductionIdentityInit(
+    OpenMPReductionClauseOperator Op, QualType QTy, const Expr *Init,
+    llvm::AllocaInst *Private) {
+  if (Init) {
+    switch (Op) {
+    case OMPC_REDUCTION_or:
+    case OMPC_REDUCTION_bitxor:
+    case OMPC_REDUCTION_bitor:
+    case OMPC_REDUCTION_sub:
+    case OMPC_REDUCTION_add: {
+      llvm::Value *Zero =
+          llvm::Constant::getNullValue(Private->getAllocatedType());
+      InitTempAlloca(Private, Zero);
+      break;
+    }
+    case OMPC_REDUCTION_and:
+    case OMPC_REDUCTION_mult:
+    case OMPC_REDUCTION_bitand: {
+      llvm::Value *AllOnes =
+          llvm::Constant::getAllOnesValue(Private->getAllocatedType());
+      InitTempAlloca(Private, AllOnes);
+      break;
+    }
+    case OMPC_REDUCTION_min:
+    case OMPC_REDUCTION_max:
+    case OMPC_REDUCTION_custom:
+      llvm_unreachable("Operator kind not allowed.");
+    case OMPC_REDUCTION_unknown:
+    case NUM_OPENMP_REDUCTION_OPERATORS:
+      llvm_unreachable("Unknown operator kind.");
+    }
+  } else {
+    llvm::Type *Ty = ConvertTypeForMem(QTy);
+    switch (Op) {
+    case OMPC_REDUCTION_or:
+    case OMPC_REDUCTION_bitxor:
+    case OMPC_REDUCTION_bitor:
+    case OMPC_REDUCTION_sub:
+    case OMPC_REDUCTION_add: {
+      if (QTy->isIntegralOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getNullValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isRealFloatingType()) {
+        const llvm::fltSemantics &FS = Ty->getFltSemantics();
+        llvm::APFloat InitVal = llvm::APFloat::getZero(FS);
+        llvm::Value *Init =
+            llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isPointerType()) {
+        InitTempAlloca(Private, llvm::ConstantPointerNull::get(
+                                    cast<llvm::PointerType>(Ty)));
+      } else if (QTy->isAnyComplexType()) {
+        const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
+        QualType ElTy = CmplxTy->getElementType();
+        Ty = ConvertTypeForMem(ElTy);
+        llvm::Value *Init;
+        if (ElTy->isIntegralOrEnumerationType()) {
+          llvm::APInt InitVal = llvm::APInt::getNullValue(
+              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+          Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        } else {
+          const llvm::fltSemantics &FS = Ty->getFltSemantics();
+          llvm::APFloat InitVal = llvm::APFloat::getZero(FS);
+          Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        }
+        ComplexPairTy Value(Init, Init);
+        LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
+        EmitStoreOfComplex(Value, Dst, true);
+      }
+      break;
+    }
+    case OMPC_REDUCTION_and:
+    case OMPC_REDUCTION_mult: {
+      if (QTy->isIntegralOrEnumerationType()) {
+        llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
+                            1);
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isRealFloatingType()) {
+        const llvm::fltSemantics &FS = Ty->getFltSemantics();
+        llvm::APFloat InitVal(FS, 1);
+        llvm::Value *Init =
+            llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isPointerType()) {
+        llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
+                            1);
+        llvm::Constant *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
+                                           Ty);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isAnyComplexType()) {
+        const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
+        QualType ElTy = CmplxTy->getElementType();
+        Ty = ConvertTypeForMem(ElTy);
+        llvm::Value *Init;
+        if (ElTy->isIntegralOrEnumerationType()) {
+          llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
+                              1);
+          Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        } else {
+          const llvm::fltSemantics &FS = Ty->getFltSemantics();
+          llvm::APFloat InitVal(FS, 1);
+          Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        }
+        ComplexPairTy Value(Init, Init);
+        LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
+        EmitStoreOfComplex(Value, Dst, true);
+      }
+      break;
+    }
+    case OMPC_REDUCTION_bitand: {
+      if (QTy->isIntegralOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getAllOnesValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isRealFloatingType()) {
+        llvm::APFloat InitVal = llvm::APFloat::getAllOnesValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isPointerType()) {
+        llvm::Value *Init = llvm::Constant::getAllOnesValue(Ty);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isAnyComplexType()) {
+        const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
+        QualType ElTy = CmplxTy->getElementType();
+        Ty = ConvertTypeForMem(ElTy);
+        llvm::Value *Init;
+        if (ElTy->isIntegralOrEnumerationType()) {
+          llvm::APInt InitVal = llvm::APInt::getAllOnesValue(
+              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+          Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        } else {
+          llvm::APFloat InitVal = llvm::APFloat::getAllOnesValue(
+              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+          Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        }
+        ComplexPairTy Value(Init, Init);
+        LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
+        EmitStoreOfComplex(Value, Dst, true);
+      }
+      break;
+    }
+    case OMPC_REDUCTION_min: {
+      if (QTy->isSignedIntegerOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getSignedMaxValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isUnsignedIntegerOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getMaxValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isRealFloatingType()) {
+        const llvm::fltSemantics &FS = Ty->getFltSemantics();
+        llvm::APFloat InitVal = llvm::APFloat::getLargest(FS);
+        llvm::Value *Init =
+            llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isPointerType()) {
+        llvm::APInt InitVal = llvm::APInt::getMaxValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Constant *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
+                                           Ty);
+        InitTempAlloca(Private, Init);
+      }
+      break;
+    }
+    case OMPC_REDUCTION_max: {
+      if (QTy->isSignedIntegerOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getSignedMinValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isUnsignedIntegerOrEnumerationType()) {
+        llvm::APInt InitVal = llvm::APInt::getMinValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Value *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isRealFloatingType()) {
+        const llvm::fltSemantics &FS = Ty->getFltSemantics();
+        llvm::APFloat InitVal = llvm::APFloat::getLargest(FS, true);
+        llvm::Value *Init =
+            llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
+        InitTempAlloca(Private, Init);
+      } else if (QTy->isPointerType()) {
+        llvm::APInt InitVal = llvm::APInt::getMinValue(
+            CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
+        llvm::Constant *Init =
+            llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
+        Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
+                                           Ty);
+        InitTempAlloca(Private, Init);
+      }
+      break;
+    }
+    case OMPC_REDUCTION_custom:
+      llvm_unreachable("Custom initialization cannot be NULLed.");
+    case OMPC_REDUCTION_unknown:
+    case NUM_OPENMP_REDUCTION_OPERATORS:
+      llvm_unreachable("Unkonwn operator kind.");
+    }
   }
 }
 
@@ -5120,232 +7353,417 @@ CodeGenFunction::EmitPreOMPReductionClause(const OMPReductionClause &C,
         EmitAnyExprToMem(*InitIter, Private,
                          (*InitIter)->getType().getQualifiers(), false);
       }
-    } else if (*InitIter) {
-      switch (C.getOperator()) {
-      case OMPC_REDUCTION_or:
-      case OMPC_REDUCTION_bitxor:
-      case OMPC_REDUCTION_bitor:
-      case OMPC_REDUCTION_sub:
-      case OMPC_REDUCTION_add: {
-        llvm::Value *Zero =
-            llvm::Constant::getNullValue(Private->getAllocatedType());
-        InitTempAlloca(Private, Zero);
-        break;
-      }
-      case OMPC_REDUCTION_and:
-      case OMPC_REDUCTION_mult:
-      case OMPC_REDUCTION_bitand: {
-        llvm::Value *AllOnes =
-            llvm::Constant::getAllOnesValue(Private->getAllocatedType());
-        InitTempAlloca(Private, AllOnes);
-        break;
-      }
-      case OMPC_REDUCTION_min:
-      case OMPC_REDUCTION_max:
-      case OMPC_REDUCTION_custom:
-        llvm_unreachable("Operator kind not allowed.");
-      case OMPC_REDUCTION_unknown:
-      case NUM_OPENMP_REDUCTION_OPERATORS:
-        llvm_unreachable("Unknown operator kind.");
-      }
-    } else {
-      llvm::Type *Ty = ConvertTypeForMem(QTy);
-      switch (C.getOperator()) {
-      case OMPC_REDUCTION_or:
-      case OMPC_REDUCTION_bitxor:
-      case OMPC_REDUCTION_bitor:
-      case OMPC_REDUCTION_sub:
-      case OMPC_REDUCTION_add: {
-        if (QTy->isIntegralOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getNullValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isRealFloatingType()) {
-          const llvm::fltSemantics &FS = Ty->getFltSemantics();
-          llvm::APFloat InitVal = llvm::APFloat::getZero(FS);
-          llvm::Value *Init =
-              llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isPointerType()) {
-          InitTempAlloca(Private, llvm::ConstantPointerNull::get(
-                                      cast<llvm::PointerType>(Ty)));
-        } else if (QTy->isAnyComplexType()) {
-          const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
-          QualType ElTy = CmplxTy->getElementType();
-          Ty = ConvertTypeForMem(ElTy);
-          llvm::Value *Init;
-          if (ElTy->isIntegralOrEnumerationType()) {
-            llvm::APInt InitVal = llvm::APInt::getNullValue(
-                CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-            Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          } else {
-            const llvm::fltSemantics &FS = Ty->getFltSemantics();
-            llvm::APFloat InitVal = llvm::APFloat::getZero(FS);
-            Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          }
-          ComplexPairTy Value(Init, Init);
-          LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
-          EmitStoreOfComplex(Value, Dst, true);
-        }
-        break;
-      }
-      case OMPC_REDUCTION_and:
-      case OMPC_REDUCTION_mult: {
-        if (QTy->isIntegralOrEnumerationType()) {
-          llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
-                              1);
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isRealFloatingType()) {
-          const llvm::fltSemantics &FS = Ty->getFltSemantics();
-          llvm::APFloat InitVal(FS, 1);
-          llvm::Value *Init =
-              llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isPointerType()) {
-          llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
-                              1);
-          llvm::Constant *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
-                                             Ty);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isAnyComplexType()) {
-          const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
-          QualType ElTy = CmplxTy->getElementType();
-          Ty = ConvertTypeForMem(ElTy);
-          llvm::Value *Init;
-          if (ElTy->isIntegralOrEnumerationType()) {
-            llvm::APInt InitVal(CGM.getDataLayout().getTypeStoreSizeInBits(Ty),
-                                1);
-            Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          } else {
-            const llvm::fltSemantics &FS = Ty->getFltSemantics();
-            llvm::APFloat InitVal(FS, 1);
-            Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          }
-          ComplexPairTy Value(Init, Init);
-          LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
-          EmitStoreOfComplex(Value, Dst, true);
-        }
-        break;
-      }
-      case OMPC_REDUCTION_bitand: {
-        if (QTy->isIntegralOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getAllOnesValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isRealFloatingType()) {
-          llvm::APFloat InitVal = llvm::APFloat::getAllOnesValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isPointerType()) {
-          llvm::Value *Init = llvm::Constant::getAllOnesValue(Ty);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isAnyComplexType()) {
-          const ComplexType *CmplxTy = QTy->castAs<ComplexType>();
-          QualType ElTy = CmplxTy->getElementType();
-          Ty = ConvertTypeForMem(ElTy);
-          llvm::Value *Init;
-          if (ElTy->isIntegralOrEnumerationType()) {
-            llvm::APInt InitVal = llvm::APInt::getAllOnesValue(
-                CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-            Init = llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          } else {
-            llvm::APFloat InitVal = llvm::APFloat::getAllOnesValue(
-                CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-            Init = llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          }
-          ComplexPairTy Value(Init, Init);
-          LValue Dst = MakeNaturalAlignAddrLValue(Private, QTy);
-          EmitStoreOfComplex(Value, Dst, true);
-        }
-        break;
-      }
-      case OMPC_REDUCTION_min: {
-        if (QTy->isSignedIntegerOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getSignedMaxValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isUnsignedIntegerOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getMaxValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isRealFloatingType()) {
-          const llvm::fltSemantics &FS = Ty->getFltSemantics();
-          llvm::APFloat InitVal = llvm::APFloat::getLargest(FS);
-          llvm::Value *Init =
-              llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isPointerType()) {
-          llvm::APInt InitVal = llvm::APInt::getMaxValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Constant *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
-                                             Ty);
-          InitTempAlloca(Private, Init);
-        }
-        break;
-      }
-      case OMPC_REDUCTION_max: {
-        if (QTy->isSignedIntegerOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getSignedMinValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isUnsignedIntegerOrEnumerationType()) {
-          llvm::APInt InitVal = llvm::APInt::getMinValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Value *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isRealFloatingType()) {
-          const llvm::fltSemantics &FS = Ty->getFltSemantics();
-          llvm::APFloat InitVal = llvm::APFloat::getLargest(FS, true);
-          llvm::Value *Init =
-              llvm::ConstantFP::get(CGM.getLLVMContext(), InitVal);
-          InitTempAlloca(Private, Init);
-        } else if (QTy->isPointerType()) {
-          llvm::APInt InitVal = llvm::APInt::getMinValue(
-              CGM.getDataLayout().getTypeStoreSizeInBits(Ty));
-          llvm::Constant *Init =
-              llvm::ConstantInt::get(CGM.getLLVMContext(), InitVal);
-          Init = llvm::ConstantExpr::getCast(llvm::Instruction::IntToPtr, Init,
-                                             Ty);
-          InitTempAlloca(Private, Init);
-        }
-        break;
-      }
-      case OMPC_REDUCTION_custom:
-        llvm_unreachable("Custom initialization cannot be NULLed.");
-      case OMPC_REDUCTION_unknown:
-      case NUM_OPENMP_REDUCTION_OPERATORS:
-        llvm_unreachable("Unkonwn operator kind.");
-      }
+    } else
+      EmitOMPReductionIdentityInit(C.getOperator(), QTy, *InitIter, Private);
+
+    // Items packed by value are copied to the reduction record right before
+    // the reduction.
+    if (CGM.OpenMPSupport.getReductionVarPackKind(VD) < 0) {
+      llvm::Value *Addr = Builder.CreateConstGEP2_32(
+          ReductionRecVar->getType()->getPointerElementType(),
+          ReductionRecVar, 0, CGM.OpenMPSupport.getReductionVarIdx(VD),
+          CGM.getMangledName(VD) + ".addr");
+      Builder.CreateStore(Private, Addr);
     }
-    llvm::Value *Addr = Builder.CreateConstGEP2_32(
-        ReductionRecVar->getType()->getPointerElementType(),
-        ReductionRecVar, 0, CGM.OpenMPSupport.getReductionVarIdx(VD),
-        CGM.getMangledName(VD) + ".addr");
-    Builder.CreateStore(Private, Addr);
     // llvm::Value *Var = Builder.CreateLoad(Addr, CGM.getMangledName(VD));
     CGM.OpenMPSupport.addOpenMPPrivateVar(VD, Private);
   }
 }
 
+/// \brief Returns true if 'omp atomic' operations on a scalar of type \a QTy
+/// may be emitted as native atomic instructions. Long double, complex and
+/// pointer types are left to the runtime, as are all the atomic operations on
+/// target devices.
+static bool isOMPAtomicNativeType(CodeGenFunction &CGF, QualType QTy) {
+  if (CGF.CGM.getLangOpts().OpenMPTargetMode)
+    return false;
+  QTy = QTy.getCanonicalType();
+  if (QTy->isRealFloatingType())
+    return QTy->isSpecificBuiltinType(BuiltinType::Float) ||
+           QTy->isSpecificBuiltinType(BuiltinType::Double);
+  if (!QTy->isIntegralOrEnumerationType())
+    return false;
+  int64_t Size = CGF.getContext().getTypeSizeInChars(QTy).getQuantity();
+  return Size == 1 || Size == 2 || Size == 4 || Size == 8;
+}
+
+/// \brief Returns true if \a X of type \a QTy may be accessed with native
+/// atomic instructions.
+static bool isOMPAtomicNativeLValue(CodeGenFunction &CGF, LValue X,
+                                    QualType QTy) {
+  if (!X.isSimple() || !isOMPAtomicNativeType(CGF, QTy))
+    return false;
+  CharUnits Size = CGF.getContext().getTypeSizeInChars(QTy);
+  return X.getAlignment().isZero() || X.getAlignment() >= Size;
+}
+
+/// \brief Returns true if \a QTy is a scalar type that may be an operand of
+/// a native atomic operation.
+static bool isOMPAtomicNativeOperandType(QualType QTy) {
+  QTy = QTy.getCanonicalType();
+  return QTy->isRealFloatingType() || QTy->isIntegralOrEnumerationType();
+}
+
+/// \brief Returns true if the 'omp atomic' update 'x binop= expr' may be
+/// emitted as native atomic instructions.
+static bool isOMPAtomicNativeOp(BinaryOperatorKind Op) {
+  switch (Op) {
+  case BO_Add:
+  case BO_Sub:
+  case BO_Mul:
+  case BO_Div:
+  case BO_And:
+  case BO_Or:
+  case BO_Xor:
+  case BO_Shl:
+  case BO_Shr:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+/// \brief Returns \a QTy after the integral promotions.
+static QualType getOMPAtomicPromotedType(ASTContext &C, QualType QTy) {
+  QTy = QTy.getCanonicalType().getUnqualifiedType();
+  if (const EnumType *ET = QTy->getAs<EnumType>())
+    QTy = ET->getDecl()->getIntegerType().getCanonicalType();
+  if (QTy->isPromotableIntegerType())
+    return C.getPromotedIntegerType(QTy);
+  return QTy;
+}
+
+/// \brief Returns the type in which 'LHS op RHS' is computed, following the
+/// usual arithmetic conversions.
+static QualType getOMPAtomicComputationType(ASTContext &C, QualType LHS,
+                                            QualType RHS) {
+  LHS = getOMPAtomicPromotedType(C, LHS);
+  RHS = getOMPAtomicPromotedType(C, RHS);
+  if (LHS->isRealFloatingType() || RHS->isRealFloatingType()) {
+    if (!RHS->isRealFloatingType())
+      return LHS;
+    if (!LHS->isRealFloatingType())
+      return RHS;
+    return C.getFloatingTypeOrder(LHS, RHS) < 0 ? RHS : LHS;
+  }
+  if (C.hasSameType(LHS, RHS))
+    return LHS;
+  bool LHSSigned = LHS->hasSignedIntegerRepresentation();
+  if (LHSSigned == RHS->hasSignedIntegerRepresentation())
+    return C.getIntegerTypeOrder(LHS, RHS) < 0 ? RHS : LHS;
+  QualType Unsigned = LHSSigned ? RHS : LHS;
+  QualType Signed = LHSSigned ? LHS : RHS;
+  if (C.getIntegerTypeOrder(Unsigned, Signed) >= 0)
+    return Unsigned;
+  if (C.getTypeSize(Signed) > C.getTypeSize(Unsigned))
+    return Signed;
+  return C.getCorrespondingUnsignedType(Signed);
+}
+
+/// \brief Computes 'x op e' (or 'e op x' if \a Reversed) converted back to
+/// the type \a XTy of x. BO_LT and BO_GT stand for the 'min' and 'max'
+/// reduction operators.
+static llvm::Value *EmitOMPAtomicUpdateValue(CodeGenFunction &CGF,
+                                             BinaryOperatorKind Op,
+                                             llvm::Value *XVal, QualType XTy,
+                                             llvm::Value *EVal, QualType ETy,
+                                             bool Reversed) {
+  CGBuilderTy &Builder = CGF.Builder;
+  ASTContext &C = CGF.getContext();
+  SourceLocation Loc;
+  if (Op == BO_LAnd || Op == BO_LOr) {
+    llvm::Value *L = CGF.EmitScalarConversion(XVal, XTy, C.BoolTy, Loc);
+    llvm::Value *R = CGF.EmitScalarConversion(EVal, ETy, C.BoolTy, Loc);
+    llvm::Value *Res =
+        Op == BO_LAnd ? Builder.CreateAnd(L, R) : Builder.CreateOr(L, R);
+    return CGF.EmitScalarConversion(Res, C.BoolTy, XTy, Loc);
+  }
+  llvm::Value *LVal = Reversed ? EVal : XVal;
+  llvm::Value *RVal = Reversed ? XVal : EVal;
+  QualType LTy = Reversed ? ETy : XTy;
+  QualType RTy = Reversed ? XTy : ETy;
+  if (Op == BO_Shl || Op == BO_Shr) {
+    // The result has the promoted type of the left operand.
+    QualType ResTy = getOMPAtomicPromotedType(C, LTy);
+    llvm::Value *L = CGF.EmitScalarConversion(LVal, LTy, ResTy, Loc);
+    QualType RPromTy = getOMPAtomicPromotedType(C, RTy);
+    llvm::Value *R = Builder.CreateIntCast(
+        CGF.EmitScalarConversion(RVal, RTy, RPromTy, Loc), L->getType(),
+        false);
+    llvm::Value *Res;
+    if (Op == BO_Shl)
+      Res = Builder.CreateShl(L, R);
+    else if (ResTy->hasSignedIntegerRepresentation())
+      Res = Builder.CreateAShr(L, R);
+    else
+      Res = Builder.CreateLShr(L, R);
+    return CGF.EmitScalarConversion(Res, ResTy, XTy, Loc);
+  }
+  QualType ResTy = getOMPAtomicComputationType(C, LTy, RTy);
+  llvm::Value *L = CGF.EmitScalarConversion(LVal, LTy, ResTy, Loc);
+  llvm::Value *R = CGF.EmitScalarConversion(RVal, RTy, ResTy, Loc);
+  bool IsFP = ResTy->isRealFloatingType();
+  bool IsSigned = ResTy->hasSignedIntegerRepresentation();
+  llvm::Value *Res;
+  switch (Op) {
+  case BO_Add:
+    Res = IsFP ? Builder.CreateFAdd(L, R) : Builder.CreateAdd(L, R);
+    break;
+  case BO_Sub:
+    Res = IsFP ? Builder.CreateFSub(L, R) : Builder.CreateSub(L, R);
+    break;
+  case BO_Mul:
+    Res = IsFP ? Builder.CreateFMul(L, R) : Builder.CreateMul(L, R);
+    break;
+  case BO_Div:
+    if (IsFP)
+      Res = Builder.CreateFDiv(L, R);
+    else if (IsSigned)
+      Res = Builder.CreateSDiv(L, R);
+    else
+      Res = Builder.CreateUDiv(L, R);
+    break;
+  case BO_And:
+    Res = Builder.CreateAnd(L, R);
+    break;
+  case BO_Or:
+    Res = Builder.CreateOr(L, R);
+    break;
+  case BO_Xor:
+    Res = Builder.CreateXor(L, R);
+    break;
+  case BO_LT:
+  case BO_GT: {
+    llvm::Value *Cmp;
+    if (IsFP)
+      Cmp = Op == BO_LT ? Builder.CreateFCmpOLT(L, R)
+                        : Builder.CreateFCmpOGT(L, R);
+    else if (IsSigned)
+      Cmp = Op == BO_LT ? Builder.CreateICmpSLT(L, R)
+                        : Builder.CreateICmpSGT(L, R);
+    else
+      Cmp = Op == BO_LT ? Builder.CreateICmpULT(L, R)
+                        : Builder.CreateICmpUGT(L, R);
+    Res = Builder.CreateSelect(Cmp, L, R);
+    break;
+  }
+  default:
+    llvm_unreachable("Unexpected atomic operation.");
+  }
+  return CGF.EmitScalarConversion(Res, ResTy, XTy, Loc);
+}
+
+/// \brief Returns the integer type of the same size as \a QTy, in which the
+/// native atomic instructions operate on scalars of type \a QTy.
+static llvm::IntegerType *getOMPAtomicIntType(CodeGenFunction &CGF,
+                                              QualType QTy) {
+  return llvm::IntegerType::get(CGF.getLLVMContext(),
+                                CGF.getContext().getTypeSize(QTy));
+}
+
+/// \brief Converts the scalar \a Val of type \a QTy to its bits.
+static llvm::Value *EmitOMPAtomicToInt(CodeGenFunction &CGF, llvm::Value *Val,
+                                       QualType QTy) {
+  return CGF.Builder.CreateBitCast(CGF.EmitToMemory(Val, QTy),
+                                   getOMPAtomicIntType(CGF, QTy));
+}
+
+/// \brief Converts the bits \a Val back to a scalar of type \a QTy.
+static llvm::Value *EmitOMPAtomicFromInt(CodeGenFunction &CGF,
+                                         llvm::Value *Val, QualType QTy) {
+  return CGF.EmitFromMemory(
+      CGF.Builder.CreateBitCast(Val, CGF.ConvertTypeForMem(QTy)), QTy);
+}
+
+/// \brief Returns the address of \a X as a pointer to the integer type of
+/// the same size and its alignment.
+static llvm::Value *getOMPAtomicIntAddr(CodeGenFunction &CGF, LValue X,
+                                        QualType QTy, unsigned &Align) {
+  Align = X.getAlignment().getQuantity();
+  if (!Align)
+    Align = CGF.getContext().getTypeSizeInChars(QTy).getQuantity();
+  return CGF.Builder.CreatePointerCast(
+      X.getAddress(), getOMPAtomicIntType(CGF, QTy)->getPointerTo(
+                          X.getAddress()->getType()->getPointerAddressSpace()));
+}
+
+/// \brief Emits 'load atomic' of \a X of type \a QTy.
+static llvm::Value *EmitOMPAtomicNativeLoad(CodeGenFunction &CGF, LValue X,
+                                            QualType QTy,
+                                            llvm::AtomicOrdering AO) {
+  unsigned Align;
+  llvm::Value *Addr = getOMPAtomicIntAddr(CGF, X, QTy, Align);
+  llvm::LoadInst *Load = CGF.Builder.CreateLoad(Addr);
+  Load->setAtomic(AO);
+  Load->setAlignment(Align);
+  Load->setVolatile(X.isVolatileQualified());
+  return EmitOMPAtomicFromInt(CGF, Load, QTy);
+}
+
+/// \brief Emits 'store atomic' of \a Val into \a X of type \a QTy.
+static void EmitOMPAtomicNativeStore(CodeGenFunction &CGF, LValue X,
+                                     QualType QTy, llvm::Value *Val,
+                                     llvm::AtomicOrdering AO) {
+  unsigned Align;
+  llvm::Value *Addr = getOMPAtomicIntAddr(CGF, X, QTy, Align);
+  llvm::StoreInst *Store =
+      CGF.Builder.CreateStore(EmitOMPAtomicToInt(CGF, Val, QTy), Addr);
+  Store->setAtomic(AO);
+  Store->setAlignment(Align);
+  Store->setVolatile(X.isVolatileQualified());
+}
+
+/// \brief Emits the atomic exchange of \a X of type \a QTy with \a Val and
+/// returns the old value of \a X.
+static llvm::Value *EmitOMPAtomicNativeExchange(CodeGenFunction &CGF,
+                                                LValue X, QualType QTy,
+                                                llvm::Value *Val,
+                                                llvm::AtomicOrdering AO) {
+  unsigned Align;
+  llvm::Value *Addr = getOMPAtomicIntAddr(CGF, X, QTy, Align);
+  llvm::AtomicRMWInst *RMW = CGF.Builder.CreateAtomicRMW(
+      llvm::AtomicRMWInst::Xchg, Addr, EmitOMPAtomicToInt(CGF, Val, QTy), AO);
+  RMW->setVolatile(X.isVolatileQualified());
+  return EmitOMPAtomicFromInt(CGF, RMW, QTy);
+}
+
+/// \brief Emits the atomic update 'x = x op e' (or 'x = e op x' if
+/// \a Reversed) of \a X of type \a XTy and returns the old value of x. If
+/// \a New is not null, it is set to the new value of x.
+/// Integer add, sub, and, or, xor, min and max are emitted as a single
+/// 'atomicrmw', all other updates as a 'cmpxchg' loop.
+static llvm::Value *EmitOMPAtomicNativeUpdate(
+    CodeGenFunction &CGF, LValue X, QualType XTy, BinaryOperatorKind Op,
+    llvm::Value *EVal, QualType ETy, bool Reversed, llvm::AtomicOrdering AO,
+    llvm::Value **New) {
+  CGBuilderTy &Builder = CGF.Builder;
+  unsigned Align;
+  llvm::Value *Addr = getOMPAtomicIntAddr(CGF, X, XTy, Align);
+
+  llvm::AtomicRMWInst::BinOp RMWOp = llvm::AtomicRMWInst::BAD_BINOP;
+  if (XTy->isIntegralOrEnumerationType() && !XTy->isBooleanType() &&
+      ETy->isIntegralOrEnumerationType()) {
+    bool IsSigned = XTy->hasSignedIntegerRepresentation();
+    switch (Op) {
+    case BO_Add:
+      RMWOp = llvm::AtomicRMWInst::Add;
+      break;
+    case BO_Sub:
+      if (!Reversed)
+        RMWOp = llvm::AtomicRMWInst::Sub;
+      break;
+    case BO_And:
+      RMWOp = llvm::AtomicRMWInst::And;
+      break;
+    case BO_Or:
+      RMWOp = llvm::AtomicRMWInst::Or;
+      break;
+    case BO_Xor:
+      RMWOp = llvm::AtomicRMWInst::Xor;
+      break;
+    case BO_LT:
+      // min and max are computed in the type of x only if e has it as well.
+      if (CGF.getContext().hasSameUnqualifiedType(XTy, ETy))
+        RMWOp = IsSigned ? llvm::AtomicRMWInst::Min
+                         : llvm::AtomicRMWInst::UMin;
+      break;
+    case BO_GT:
+      if (CGF.getContext().hasSameUnqualifiedType(XTy, ETy))
+        RMWOp = IsSigned ? llvm::AtomicRMWInst::Max
+                         : llvm::AtomicRMWInst::UMax;
+      break;
+    default:
+      break;
+    }
+  }
+
+  llvm::Value *Old;
+  if (RMWOp != llvm::AtomicRMWInst::BAD_BINOP) {
+    // The low bits of the results of these operations do not depend on the
+    // width of the operands, so e may be converted to the type of x.
+    llvm::Value *Val = EmitOMPAtomicToInt(
+        CGF, CGF.EmitScalarConversion(EVal, ETy, XTy, SourceLocation()), XTy);
+    llvm::AtomicRMWInst *RMW = Builder.CreateAtomicRMW(RMWOp, Addr, Val, AO);
+    RMW->setVolatile(X.isVolatileQualified());
+    Old = EmitOMPAtomicFromInt(CGF, RMW, XTy);
+    if (New)
+      *New = EmitOMPAtomicUpdateValue(CGF, Op, Old, XTy, EVal, ETy, Reversed);
+    return Old;
+  }
+
+  // old = x;
+  // do {
+  //   new = old op e;
+  // } while (!cmpxchg(&x, old, new));
+  llvm::LoadInst *Init = Builder.CreateLoad(Addr);
+  Init->setAtomic(llvm::Monotonic);
+  Init->setAlignment(Align);
+  Init->setVolatile(X.isVolatileQualified());
+  llvm::BasicBlock *EntryBB = Builder.GetInsertBlock();
+  llvm::BasicBlock *ContBB = CGF.createBasicBlock("omp.atomic.cont");
+  llvm::BasicBlock *ExitBB = CGF.createBasicBlock("omp.atomic.exit");
+  CGF.EmitBlock(ContBB);
+  llvm::PHINode *OldInt = Builder.CreatePHI(Init->getType(), 2);
+  OldInt->addIncoming(Init, EntryBB);
+  Old = EmitOMPAtomicFromInt(CGF, OldInt, XTy);
+  llvm::Value *NewVal =
+      EmitOMPAtomicUpdateValue(CGF, Op, Old, XTy, EVal, ETy, Reversed);
+  llvm::AtomicCmpXchgInst *Pair = Builder.CreateAtomicCmpXchg(
+      Addr, OldInt, EmitOMPAtomicToInt(CGF, NewVal, XTy), AO,
+      llvm::AtomicCmpXchgInst::getStrongestFailureOrdering(AO));
+  Pair->setVolatile(X.isVolatileQualified());
+  OldInt->addIncoming(Builder.CreateExtractValue(Pair, 0),
+                      Builder.GetInsertBlock());
+  Builder.CreateCondBr(Builder.CreateExtractValue(Pair, 1), ExitBB, ContBB);
+  CGF.EmitBlock(ExitBB);
+  if (New)
+    *New = NewVal;
+  return Old;
+}
+
+/// \brief Returns the binary operator combining the partial results of the
+/// reduction operator \a Op natively: BO_LT and BO_GT stand for 'min' and
+/// 'max'. Returns false for user-defined reductions.
+static bool getOMPAtomicReductionOp(OpenMPReductionClauseOperator Op,
+                                    BinaryOperatorKind &BOp) {
+  switch (Op) {
+  case OMPC_REDUCTION_add:
+  case OMPC_REDUCTION_sub:
+    BOp = BO_Add;
+    return true;
+  case OMPC_REDUCTION_mult:
+    BOp = BO_Mul;
+    return true;
+  case OMPC_REDUCTION_bitand:
+    BOp = BO_And;
+    return true;
+  case OMPC_REDUCTION_bitor:
+    BOp = BO_Or;
+    return true;
+  case OMPC_REDUCTION_bitxor:
+    BOp = BO_Xor;
+    return true;
+  case OMPC_REDUCTION_and:
+    BOp = BO_LAnd;
+    return true;
+  case OMPC_REDUCTION_or:
+    BOp = BO_LOr;
+    return true;
+  case OMPC_REDUCTION_min:
+    BOp = BO_LT;
+    return true;
+  case OMPC_REDUCTION_max:
+    BOp = BO_GT;
+    return true;
+  case OMPC_REDUCTION_custom:
+  case OMPC_REDUCTION_unknown:
+  case NUM_OPENMP_REDUCTION_OPERATORS:
+    break;
+  }
+  return false;
+}
+
 void
 CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
                                             const OMPExecutableDirective &S) {
@@ -5385,6 +7803,30 @@ CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
       EmitBlock(EndBB, true);
     }
 
+    // Copy the private values of the items packed by value to the reduction
+    // record.
+    llvm::Value *RecVar = CGM.OpenMPSupport.getReductionRecVar(*this);
+    for (ArrayRef<OMPClause *>::iterator CI = S.clauses().begin(),
+                                         CE = S.clauses().end();
+         CI != CE; ++CI) {
+      const OMPReductionClause *RC = dyn_cast_or_null<OMPReductionClause>(*CI);
+      if (!RC)
+        continue;
+      for (OMPReductionClause::varlist_const_iterator I = RC->varlist_begin(),
+                                                      E = RC->varlist_end();
+           I != E; ++I) {
+        const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+        llvm::Value *Private = CGM.OpenMPSupport.getTopOpenMPPrivateVar(VD);
+        if (!Private || CGM.OpenMPSupport.getReductionVarPackKind(VD) < 0)
+          continue;
+        llvm::Value *Addr = Builder.CreateConstGEP2_32(
+            RecVar->getType()->getPointerElementType(), RecVar, 0,
+            CGM.OpenMPSupport.getReductionVarIdx(VD),
+            CGM.getMangledName(VD) + ".addr");
+        Builder.CreateStore(Builder.CreateLoad(Private), Addr);
+      }
+    }
+
     // __kmpc_reduce[_nowait](ident_t *loc, int32_t global_tid, int32_t
     // num_vars,
     //                      size_t reduce_size, void *reduce_data,
@@ -5463,6 +7905,13 @@ CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
         ReductionRecVar->getType()->getPointerElementType(),
         ReductionRecVar, 0, CGM.OpenMPSupport.getReductionVarIdx(VD),
         CGM.getMangledName(VD) + ".addr.rhs");
+    bool IsPacked = CGM.OpenMPSupport.getReductionVarPackKind(VD) >= 0;
+    if (IsPacked) {
+      llvm::AllocaInst *RHS =
+          CreateMemTemp(PtrQTy, CGM.getMangledName(VD) + ".addr.rhs.");
+      Builder.CreateStore(Addr2, RHS);
+      Addr2 = RHS;
+    }
     CGM.OpenMPSupport.addOpenMPPrivateVar(Par1, AI);
     CGM.OpenMPSupport.addOpenMPPrivateVar(Par2, Addr2);
     EmitIgnoredExpr(*OpI);
@@ -5471,6 +7920,29 @@ CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
     IP1 = Builder.GetInsertPoint();
     RedBB1 = Builder.GetInsertBlock();
     Builder.SetInsertPoint(RedBB2, IP2);
+    BinaryOperatorKind BOp;
+    if (getOMPAtomicReductionOp(C.getOperator(), BOp) &&
+        isOMPAtomicNativeType(*this, QTy)) {
+      // The partial results are combined with native atomic instructions.
+      LValue Glob = MakeNaturalAlignAddrLValue(EmitScalarExpr(&UOp), QTy);
+      Addr2 = Builder.CreateConstGEP2_32(
+          ReductionRecVar->getType()->getPointerElementType(),
+          ReductionRecVar, 0, CGM.OpenMPSupport.getReductionVarIdx(VD),
+          CGM.getMangledName(VD) + ".addr.rhs");
+      llvm::Value *RHS =
+          IsPacked ? Addr2
+                   : Builder.CreateLoad(Addr2, CGM.getMangledName(VD) + ".rhs");
+      RHS = Builder.CreatePointerCast(
+          RHS, ConvertTypeForMem(QTy)->getPointerTo());
+      llvm::Value *Val = EmitLoadOfScalar(
+          MakeNaturalAlignAddrLValue(RHS, QTy), C.getLocStart());
+      EmitOMPAtomicNativeUpdate(*this, Glob, QTy, BOp, Val, QTy, false,
+                                llvm::Monotonic, 0);
+      IP2 = Builder.GetInsertPoint();
+      RedBB2 = Builder.GetInsertBlock();
+      Builder.restoreIP(SavedIP);
+      continue;
+    }
     llvm::Value *AtomicFunc = OPENMPRTL_ATOMIC_FUNC(QTy, C.getOperator());
     if (isa<BinaryOperator>((*OpI)->IgnoreImpCasts()) && AtomicFunc) {
       // __kmpc_atomic_...(&loc, global_tid, &glob, &reduction);
@@ -5485,11 +7957,12 @@ CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
           CGM.getMangledName(VD) + ".addr.rhs");
       llvm::Type *ArgTy = ConvertTypeForMem(OPENMPRTL_ATOMICTYPE(*this, QTy));
       llvm::Type *PtrArgTy = ArgTy->getPointerTo();
+      llvm::Value *RHS =
+          IsPacked ? Addr2
+                   : Builder.CreateLoad(Addr2, CGM.getMangledName(VD) + ".rhs");
       llvm::Value *RealArgs[] = {
           Loc, GTid, Builder.CreatePointerCast(EmitScalarExpr(&UOp), PtrArgTy),
-          Builder.CreateLoad(Builder.CreatePointerCast(
-              Builder.CreateLoad(Addr2, CGM.getMangledName(VD) + ".rhs"),
-              PtrArgTy))};
+          Builder.CreateLoad(Builder.CreatePointerCast(RHS, PtrArgTy))};
       EmitRuntimeCall(AtomicFunc, RealArgs);
     } else {
       // __kmpc_atomic_start();
@@ -5502,6 +7975,12 @@ CodeGenFunction::EmitPostOMPReductionClause(const OMPReductionClause &C,
           ReductionRecVar->getType()->getPointerElementType(),
           ReductionRecVar, 0, CGM.OpenMPSupport.getReductionVarIdx(VD),
           CGM.getMangledName(VD) + "addr.rhs");
+      if (IsPacked) {
+        llvm::AllocaInst *RHS =
+            CreateMemTemp(PtrQTy, CGM.getMangledName(VD) + ".addr.rhs.");
+        Builder.CreateStore(Addr2, RHS);
+        Addr2 = RHS;
+      }
       CGM.OpenMPSupport.addOpenMPPrivateVar(Par1, AI);
       CGM.OpenMPSupport.addOpenMPPrivateVar(Par2, Addr2);
       EmitIgnoredExpr(*OpI);
@@ -5656,7 +8135,6 @@ void CodeGenFunction::EmitOMPTaskwaitDirective(const OMPTaskwaitDirective &S) {
 /// '#pragma omp flush' directive.
 void CodeGenFunction::EmitOMPFlushDirective(const OMPFlushDirective &S) {
   SmallVector<llvm::Value *, 4> Args;
-  Args.push_back(OPENMPRTL_LOC(S.getLocStart(), *this));
   for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
                                        E = S.clauses().end();
        I != E; ++I) {
@@ -5672,7 +8150,7 @@ void CodeGenFunction::EmitOMPFlushDirective(const OMPFlushDirective &S) {
       Args.push_back(Val);
     }
   }
-  EmitRuntimeCall(OPENMPRTL_FUNC(flush), Args);
+  CGM.getOpenMPRuntime().EmitOMPFlush(S.getLocStart(), Args, *this);
 }
 
 /// '#pragma omp cancel' directive.
@@ -5733,22 +8211,40 @@ void CodeGenFunction::EmitOMPCancellationPointDirective(
 void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
   CGM.OpenMPSupport.startOpenMPRegion(false);
   bool IsSeqCst = false;
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I)
+    if ((*I)->getClauseKind() == OMPC_seq_cst)
+      IsSeqCst = true;
+  // Scalars of the natively supported types are accessed with atomic
+  // instructions, everything else goes through the runtime.
+  llvm::AtomicOrdering AO =
+      IsSeqCst ? llvm::SequentiallyConsistent : llvm::Monotonic;
+  bool IsNative = false;
   bool AtLeastOneLoopTaken = false;
   OpenMPClauseKind Kind = OMPC_update;
   for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
                                        E = S.clauses().end();
        I != E || !AtLeastOneLoopTaken; ++I) {
     if (I != S.clauses().end()) {
-      if ((*I)->getClauseKind() == OMPC_seq_cst) {
-        IsSeqCst = true;
+      if ((*I)->getClauseKind() == OMPC_seq_cst)
         continue;
-      }
       Kind = (*I)->getClauseKind();
     }
     LValue X = EmitLValue(S.getX()->IgnoreParenLValueCasts());
     switch (Kind) {
     case OMPC_read: {
       QualType QTy = S.getX()->getType();
+      QualType VTy = S.getV()->getType();
+      if (isOMPAtomicNativeLValue(*this, X, QTy) &&
+          isOMPAtomicNativeOperandType(VTy)) {
+        // v = load atomic x;
+        llvm::Value *Res = EmitOMPAtomicNativeLoad(*this, X, QTy, AO);
+        Res = EmitScalarConversion(Res, QTy, VTy, SourceLocation());
+        EmitStoreOfScalar(Res, EmitLValue(S.getV()));
+        IsNative = true;
+        break;
+      }
       QualType AQTy = OPENMPRTL_ATOMICTYPE(*this, QTy);
       llvm::Value *AtomicFunc =
           AQTy.isNull() ? 0 : OPENMPRTL_ATOMIC_FUNC_GENERAL(
@@ -5781,8 +8277,18 @@ void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
     } break;
     case OMPC_write: {
       QualType QTy = S.getX()->getType();
-      QualType AQTy = OPENMPRTL_ATOMICTYPE(*this, QTy);
       QualType QTyIn = S.getExpr()->getType();
+      if (isOMPAtomicNativeLValue(*this, X, QTy) &&
+          isOMPAtomicNativeOperandType(QTyIn)) {
+        // store atomic expr, x;
+        llvm::Value *Val =
+            EmitScalarConversion(EmitScalarExpr(S.getExpr()), QTyIn, QTy,
+                                 SourceLocation());
+        EmitOMPAtomicNativeStore(*this, X, QTy, Val, AO);
+        IsNative = true;
+        break;
+      }
+      QualType AQTy = OPENMPRTL_ATOMICTYPE(*this, QTy);
       llvm::Value *AtomicFunc =
           AQTy.isNull() ? 0 : OPENMPRTL_ATOMIC_FUNC_GENERAL(
                                   AQTy, AQTy, CGOpenMPRuntime::OMP_Atomic_wr, 
@@ -5814,8 +8320,18 @@ void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
     } break;
     case OMPC_update: {
       QualType QTyRes = S.getX()->getType();
-      QualType AQTyRes = OPENMPRTL_ATOMICTYPE(*this, QTyRes);
       QualType QTyIn = S.getExpr()->getType();
+      if (isOMPAtomicNativeLValue(*this, X, QTyRes) &&
+          isOMPAtomicNativeOperandType(QTyIn) &&
+          isOMPAtomicNativeOp(S.getOperator())) {
+        // x = x op expr; or x = expr op x;
+        EmitOMPAtomicNativeUpdate(*this, X, QTyRes, S.getOperator(),
+                                  EmitScalarExpr(S.getExpr()), QTyIn,
+                                  S.isReversed(), AO, 0);
+        IsNative = true;
+        break;
+      }
+      QualType AQTyRes = OPENMPRTL_ATOMICTYPE(*this, QTyRes);
       QualType AQTyIn = OPENMPRTL_ATOMICTYPE(*this, QTyIn);
       CGOpenMPRuntime::EAtomicOperation Aop;
       switch (S.getOperator()) {
@@ -5879,8 +8395,31 @@ void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
     } break;
     case OMPC_capture: {
       QualType QTyRes = S.getX()->getType();
-      QualType AQTyRes = OPENMPRTL_ATOMICTYPE(*this, QTyRes);
       QualType QTyIn = S.getExpr()->getType();
+      QualType VTy = S.getV()->getType();
+      if (isOMPAtomicNativeLValue(*this, X, QTyRes) &&
+          isOMPAtomicNativeOperandType(QTyIn) &&
+          isOMPAtomicNativeOperandType(VTy) &&
+          (S.getOperator() == BO_Assign ||
+           isOMPAtomicNativeOp(S.getOperator()))) {
+        // v = x; x = x op expr; or x = x op expr; v = x;
+        llvm::Value *EVal = EmitScalarExpr(S.getExpr());
+        llvm::Value *Old;
+        llvm::Value *New;
+        if (S.getOperator() == BO_Assign) {
+          New = EmitScalarConversion(EVal, QTyIn, QTyRes, SourceLocation());
+          Old = EmitOMPAtomicNativeExchange(*this, X, QTyRes, New, AO);
+        } else
+          Old = EmitOMPAtomicNativeUpdate(*this, X, QTyRes, S.getOperator(),
+                                          EVal, QTyIn, S.isReversed(), AO,
+                                          &New);
+        llvm::Value *Res = EmitScalarConversion(
+            S.isCaptureAfter() ? New : Old, QTyRes, VTy, SourceLocation());
+        EmitStoreOfScalar(Res, EmitLValue(S.getV()));
+        IsNative = true;
+        break;
+      }
+      QualType AQTyRes = OPENMPRTL_ATOMICTYPE(*this, QTyRes);
       QualType AQTyIn = OPENMPRTL_ATOMICTYPE(*this, QTyIn);
       CGOpenMPRuntime::EAtomicOperation Aop;
       switch (S.getOperator()) {
@@ -5960,11 +8499,9 @@ void CodeGenFunction::EmitOMPAtomicDirective(const OMPAtomicDirective &S) {
       break;
     AtLeastOneLoopTaken = true;
   }
-  if (IsSeqCst) {
-    SmallVector<llvm::Value *, 1> Args;
-    Args.push_back(OPENMPRTL_LOC(S.getLocStart(), *this));
-    EmitRuntimeCall(OPENMPRTL_FUNC(flush), Args);
-  }
+  // Native seq_cst atomics need no separate flush.
+  if (IsSeqCst && !IsNative)
+    CGM.getOpenMPRuntime().EmitOMPFlush(S.getLocStart(), None, *this);
   CGM.OpenMPSupport.endOpenMPRegion();
 }
 
@@ -6171,6 +8708,28 @@ void CodeGenFunction::EmitOMPSingleDirective(const OMPSingleDirective &S) {
   CGM.OpenMPSupport.endOpenMPRegion();
 }
 
+/// \brief Acquires the inline spin lock \a LckWord: spins on a relaxed load
+/// until the lock looks free and only then tries to take it, so that waiting
+/// threads do not keep the cache line in exclusive state.
+static void EmitOMPInlineLockAcquire(CodeGenFunction &CGF,
+                                     llvm::Value *LckWord) {
+  llvm::BasicBlock *SpinBB = CGF.createBasicBlock("omp.critical.spin");
+  llvm::BasicBlock *TryBB = CGF.createBasicBlock("omp.critical.try");
+  llvm::BasicBlock *AcquiredBB = CGF.createBasicBlock("omp.critical.acquired");
+  CGF.EmitBlock(SpinBB);
+  llvm::LoadInst *Cur = CGF.Builder.CreateLoad(LckWord);
+  Cur->setAtomic(llvm::Monotonic);
+  Cur->setAlignment(4);
+  CGF.Builder.CreateCondBr(CGF.Builder.CreateIsNull(Cur), TryBB, SpinBB);
+  CGF.EmitBlock(TryBB);
+  llvm::Value *Pair = CGF.Builder.CreateAtomicCmpXchg(
+      LckWord, CGF.Builder.getInt32(0), CGF.Builder.getInt32(1), llvm::Acquire,
+      llvm::Monotonic);
+  CGF.Builder.CreateCondBr(CGF.Builder.CreateExtractValue(Pair, 1),
+                           AcquiredBB, SpinBB);
+  CGF.EmitBlock(AcquiredBB);
+}
+
 /// '#pragma omp critical' directive.
 void CodeGenFunction::EmitOMPCriticalDirective(const OMPCriticalDirective &S) {
   // __kmpc_critical();
@@ -6204,14 +8763,100 @@ void CodeGenFunction::EmitOMPCriticalDirective(const OMPCriticalDirective &S) {
     CGM.getOpenMPRuntime().SupportCritical(S, *this, CurFn, Lck);
   }
   else {
-    EmitRuntimeCall(OPENMPRTL_FUNC(critical), RealArgs);
-    EmitOMPCapturedBodyHelper(S);
-    EmitRuntimeCall(OPENMPRTL_FUNC(end_critical), RealArgs);
+    uint64_t Hint = 0;
+    ArrayRef<OMPClause *> Clauses = S.clauses();
+    for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(),
+                                         E = Clauses.end();
+         I != E; ++I)
+      if (const OMPHintClause *C = dyn_cast_or_null<OMPHintClause>(*I))
+        Hint = C->getHint()->EvaluateKnownConstInt(getContext()).getZExtValue();
+    llvm::Value *InstrDesc =
+        EmitOMPInstrRegionBegin(KMP_INSTR_REGION_CRITICAL, S.getLocStart());
+    // Sections that are expected to be uncontended or to be speculated by
+    // the runtime are short: take an inline test-and-test-and-set lock on
+    // the name instead of going through the runtime. The inline lock spins
+    // without backing off, so contended sections, even speculative ones, keep
+    // the runtime lock. All the sections with this name have the same hint,
+    // so they all use the same lock.
+    bool InlineLock =
+        getLangOpts().OpenMPInlineLocks &&
+        (Hint & (KMP_LOCK_HINT_UNCONTENDED | KMP_LOCK_HINT_SPECULATIVE)) &&
+        !(Hint & KMP_LOCK_HINT_CONTENDED);
+    if (InlineLock) {
+      llvm::Value *LckWord = Builder.CreateConstGEP2_32(LckTy, Lck, 0, 0);
+      EmitOMPInlineLockAcquire(*this, LckWord);
+      EmitOMPInstrRegionAcquired(InstrDesc, S.getLocStart());
+      EmitOMPCapturedBodyHelper(S);
+      llvm::StoreInst *Release =
+          Builder.CreateStore(Builder.getInt32(0), LckWord);
+      Release->setAtomic(llvm::Release);
+      Release->setAlignment(4);
+    } else {
+      if (Hint) {
+        llvm::Value *HintArgs[] = {Loc, GTid, Lck, Builder.getInt32(Hint)};
+        EmitRuntimeCall(OPENMPRTL_FUNC(critical_with_hint), HintArgs);
+      } else
+        EmitRuntimeCall(OPENMPRTL_FUNC(critical), RealArgs);
+      EmitOMPInstrRegionAcquired(InstrDesc, S.getLocStart());
+      EmitOMPCapturedBodyHelper(S);
+      EmitRuntimeCall(OPENMPRTL_FUNC(end_critical), RealArgs);
+    }
+    EmitOMPInstrRegionEnd(InstrDesc, S.getLocStart());
   }
 }
 
+/// \brief Stores the iteration vector \a Vec into a temporary array of 64-bit
+/// integers and returns the pointer to its first element.
+static llvm::Value *EmitDoacrossVector(CodeGenFunction &CGF,
+                                       ArrayRef<llvm::Value *> Vec) {
+  llvm::Type *VecTy = llvm::ArrayType::get(CGF.Int64Ty, Vec.size());
+  llvm::AllocaInst *Addr = CGF.CreateTempAlloca(VecTy, ".doacross.vec.");
+  Addr->setAlignment(
+      CGF.CGM.getDataLayout().getPrefTypeAlignment(CGF.Int64Ty));
+  for (unsigned I = 0, E = Vec.size(); I < E; ++I)
+    CGF.Builder.CreateStore(
+        Vec[I], CGF.Builder.CreateConstInBoundsGEP2_32(VecTy, Addr, 0, I));
+  return CGF.Builder.CreateConstInBoundsGEP2_32(VecTy, Addr, 0, 0);
+}
+
 /// '#pragma omp ordered' directive.
 void CodeGenFunction::EmitOMPOrderedDirective(const OMPOrderedDirective &S) {
+  if (!S.hasAssociatedStmt()) {
+    // Stand-alone ordered construct in doacross loop:
+    // depend(sink : vec) -> __kmpc_doacross_wait(&loc, gtid, vec);
+    // depend(source)     -> __kmpc_doacross_post(&loc, gtid, <counters>);
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end();
+         I != E; ++I) {
+      const OMPDependClause *C = dyn_cast_or_null<OMPDependClause>(*I);
+      if (!C)
+        continue;
+      SmallVector<llvm::Value *, 4> Vec;
+      llvm::Value *Func;
+      if (C->getType() == OMPC_DEPEND_source) {
+        ArrayRef<const Expr *> Counters =
+            CGM.OpenMPSupport.getDoacrossCounters();
+        for (unsigned J = 0, N = Counters.size(); J < N; ++J) {
+          QualType QTy = Counters[J]->getType();
+          Vec.push_back(Builder.CreateIntCast(
+              EmitScalarExpr(Counters[J]), Int64Ty,
+              !QTy->hasUnsignedIntegerRepresentation()));
+        }
+        Func = OPENMPRTL_FUNC(doacross_post);
+      } else {
+        for (unsigned J = 0, N = C->varlist_size(); J < N; ++J)
+          Vec.push_back(EmitScalarExpr(C->getBegins(J)));
+        Func = OPENMPRTL_FUNC(doacross_wait);
+      }
+      if (Vec.empty())
+        continue;
+      llvm::Value *RealArgs[] = {OPENMPRTL_LOC(S.getLocStart(), *this),
+                                 OPENMPRTL_THREADNUM(S.getLocStart(), *this),
+                                 EmitDoacrossVector(*this, Vec)};
+      EmitRuntimeCall(Func, RealArgs);
+    }
+    return;
+  }
   // __kmpc_ordered();
   //   <captured_body>
   // __kmpc_enc_ordered();
@@ -6221,14 +8866,222 @@ void CodeGenFunction::EmitOMPOrderedDirective(const OMPOrderedDirective &S) {
   EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(end_ordered), S.getLocStart());
 }
 
+/// \brief Creates and starts an internal 'void (void *[, void *])' helper
+/// function of a task reduction item.
+static llvm::Function *StartOMPTaskReductionFunction(CodeGenFunction &CGF,
+                                                     StringRef Name,
+                                                     FunctionArgList &Args) {
+  CodeGenModule &CGM = CGF.CGM;
+  const CGFunctionInfo &FI = CGF.getTypes().arrangeFreeFunctionDeclaration(
+      CGM.getContext().VoidTy, Args, FunctionType::ExtInfo(), false);
+  llvm::FunctionType *FTy = CGF.getTypes().GetFunctionType(FI);
+  llvm::Function *Fn = llvm::Function::Create(
+      FTy, llvm::GlobalValue::InternalLinkage, Name, &CGM.getModule());
+  CGM.SetInternalFunctionAttributes(0, Fn, FI);
+  CGF.StartFunction(GlobalDecl(), CGM.getContext().VoidTy, Fn, FI, Args,
+                    SourceLocation());
+  return Fn;
+}
+
+void
+CodeGenFunction::EmitOMPTaskReductionInit(const OMPTaskgroupDirective &S) {
+  // struct kmp_task_red_input_t {
+  //   void *shar;
+  //   size_t size;
+  //   void *init;
+  //   void *fini;
+  //   void *comb;
+  //   kmp_int32 flags;
+  // } red_data[n] = {{&var1, sizeof(var1), init1, fini1, comb1, 0}, ...};
+  // __kmpc_task_reduction_init(gtid, n, red_data);
+  //
+  // All the items of the taskgroup are registered by a single call, the
+  // runtime keeps one reduction descriptor per taskgroup.
+  SmallVector<const OMPTaskReductionClause *, 2> Clauses;
+  unsigned NumItems = 0;
+  for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                       E = S.clauses().end();
+       I != E; ++I)
+    if (const OMPTaskReductionClause *C =
+            dyn_cast_or_null<OMPTaskReductionClause>(*I)) {
+      Clauses.push_back(C);
+      NumItems += C->varlist_size();
+    }
+  if (NumItems == 0)
+    return;
+
+  llvm::StructType *RedTy =
+      llvm::TaskRedInputTBuilder::get(getLLVMContext(), SizeTy);
+  llvm::ArrayType *RedArrTy = llvm::ArrayType::get(RedTy, NumItems);
+  llvm::Value *RedData = CreateTempAlloca(RedArrTy, ".task_red_data.");
+  unsigned Idx = 0;
+  for (SmallVectorImpl<const OMPTaskReductionClause *>::iterator
+           CI = Clauses.begin(),
+           CE = Clauses.end();
+       CI != CE; ++CI) {
+    const OMPTaskReductionClause *C = *CI;
+    ArrayRef<const Expr *>::iterator InitI = C->getDefaultInits().begin();
+    ArrayRef<const Expr *>::iterator Par1I =
+        C->getHelperParameters1st().begin();
+    ArrayRef<const Expr *>::iterator Par2I =
+        C->getHelperParameters2nd().begin();
+    ArrayRef<const Expr *>::iterator OpI = C->getOpExprs().begin();
+    for (OMPTaskReductionClause::varlist_const_iterator I = C->varlist_begin(),
+                                                        E = C->varlist_end();
+         I != E; ++I, ++InitI, ++Par1I, ++Par2I, ++OpI, ++Idx) {
+      const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+      QualType QTy = (*I)->getType();
+      llvm::Type *PtrTy = ConvertTypeForMem(QTy)->getPointerTo();
+
+      // void .omp_task_red_init.(void *priv);
+      llvm::Function *InitFn;
+      {
+        CodeGenFunction CGF(CGM, true);
+        FunctionArgList Args;
+        ImplicitParamDecl Arg(getContext(), 0, SourceLocation(), 0,
+                              getContext().VoidPtrTy);
+        Args.push_back(&Arg);
+        InitFn = StartOMPTaskReductionFunction(CGF, ".omp_task_red_init.",
+                                               Args);
+        llvm::Value *Priv = CGF.Builder.CreateBitCast(
+            CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(&Arg)), PtrTy);
+        if (!isTrivialInitializer(*InitI)) {
+          CGF.EmitAnyExprToMem(*InitI, Priv,
+                               (*InitI)->getType().getQualifiers(), false);
+        } else {
+          llvm::AllocaInst *Tmp = CGF.CreateMemTemp(QTy);
+          CGF.EmitOMPReductionIdentityInit(C->getOperator(), QTy, *InitI, Tmp);
+          CGF.Builder.CreateStore(CGF.Builder.CreateLoad(Tmp), Priv);
+        }
+        CGF.FinishFunction();
+      }
+
+      // void .omp_task_red_comb.(void *shar, void *priv);
+      llvm::Function *CombFn;
+      {
+        CodeGenFunction CGF(CGM, true);
+        FunctionArgList Args;
+        ImplicitParamDecl Arg1(getContext(), 0, SourceLocation(), 0,
+                               getContext().VoidPtrTy);
+        ImplicitParamDecl Arg2(getContext(), 0, SourceLocation(), 0,
+                               getContext().VoidPtrTy);
+        Args.push_back(&Arg1);
+        Args.push_back(&Arg2);
+        CombFn = StartOMPTaskReductionFunction(CGF, ".omp_task_red_comb.",
+                                               Args);
+        const VarDecl *Par1 =
+            cast<VarDecl>(cast<DeclRefExpr>(*Par1I)->getDecl());
+        const VarDecl *Par2 =
+            cast<VarDecl>(cast<DeclRefExpr>(*Par2I)->getDecl());
+        QualType PtrQTy = getContext().getPointerType(QTy);
+        llvm::AllocaInst *LHS = CGF.CreateMemTemp(PtrQTy, ".addr.lhs.");
+        llvm::AllocaInst *RHS = CGF.CreateMemTemp(PtrQTy, ".addr.rhs.");
+        CGF.Builder.CreateStore(
+            CGF.Builder.CreateBitCast(
+                CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(&Arg1)), PtrTy),
+            LHS);
+        CGF.Builder.CreateStore(
+            CGF.Builder.CreateBitCast(
+                CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(&Arg2)), PtrTy),
+            RHS);
+        CGM.OpenMPSupport.startOpenMPRegion(true);
+        CGM.OpenMPSupport.addOpenMPPrivateVar(Par1, LHS);
+        CGM.OpenMPSupport.addOpenMPPrivateVar(Par2, RHS);
+        CGF.EmitIgnoredExpr(*OpI);
+        CGM.OpenMPSupport.endOpenMPRegion();
+        CGF.FinishFunction();
+      }
+
+      // void .omp_task_red_fini.(void *priv);
+      llvm::Constant *FiniFn = llvm::ConstantPointerNull::get(VoidPtrTy);
+      if (QualType::DestructionKind DtorKind = QTy.isDestructedType()) {
+        CodeGenFunction CGF(CGM, true);
+        FunctionArgList Args;
+        ImplicitParamDecl Arg(getContext(), 0, SourceLocation(), 0,
+                              getContext().VoidPtrTy);
+        Args.push_back(&Arg);
+        llvm::Function *Fn = StartOMPTaskReductionFunction(
+            CGF, ".omp_task_red_fini.", Args);
+        llvm::Value *Priv = CGF.Builder.CreateBitCast(
+            CGF.Builder.CreateLoad(CGF.GetAddrOfLocalVar(&Arg)), PtrTy);
+        CGF.emitDestroy(Priv, QTy, CGF.getDestroyer(DtorKind),
+                        CGF.needsEHCleanup(DtorKind));
+        CGF.FinishFunction();
+        FiniFn = llvm::ConstantExpr::getBitCast(Fn, VoidPtrTy);
+      }
+
+      llvm::Value *Elem = Builder.CreateConstGEP2_32(RedArrTy, RedData, 0, Idx);
+      llvm::Value *Shar = EmitLValue(*I).getAddress();
+      Builder.CreateStore(
+          Builder.CreateBitCast(Shar, VoidPtrTy),
+          Builder.CreateConstGEP2_32(RedTy, Elem, 0,
+                                     llvm::TaskRedInputTBuilder::shar,
+                                     CGM.getMangledName(VD) + ".red.shar"));
+      Builder.CreateStore(
+          llvm::ConstantInt::get(
+              SizeTy, getContext().getTypeSizeInChars(QTy).getQuantity()),
+          Builder.CreateConstGEP2_32(RedTy, Elem, 0,
+                                     llvm::TaskRedInputTBuilder::size));
+      Builder.CreateStore(llvm::ConstantExpr::getBitCast(InitFn, VoidPtrTy),
+                          Builder.CreateConstGEP2_32(
+                              RedTy, Elem, 0,
+                              llvm::TaskRedInputTBuilder::init));
+      Builder.CreateStore(FiniFn,
+                          Builder.CreateConstGEP2_32(
+                              RedTy, Elem, 0,
+                              llvm::TaskRedInputTBuilder::fini));
+      Builder.CreateStore(llvm::ConstantExpr::getBitCast(CombFn, VoidPtrTy),
+                          Builder.CreateConstGEP2_32(
+                              RedTy, Elem, 0,
+                              llvm::TaskRedInputTBuilder::comb));
+      Builder.CreateStore(llvm::ConstantInt::get(Int32Ty, 0),
+                          Builder.CreateConstGEP2_32(
+                              RedTy, Elem, 0,
+                              llvm::TaskRedInputTBuilder::flags));
+    }
+  }
+  llvm::Value *Args[] = {OPENMPRTL_THREADNUM(S.getLocStart(), *this),
+                         llvm::ConstantInt::get(Int32Ty, NumItems),
+                         Builder.CreateBitCast(RedData, VoidPtrTy)};
+  EmitRuntimeCall(OPENMPRTL_FUNC(task_reduction_init), Args);
+}
+
+void CodeGenFunction::EmitPreOMPInReductionClause(
+    const OMPInReductionClause &C, const OMPExecutableDirective &) {
+  // Type1 *priv1 = (Type1 *)__kmpc_task_reduction_get_th_data(gtid, 0, &var1);
+  // Type2 *priv2 = (Type2 *)__kmpc_task_reduction_get_th_data(gtid, 0, &var2);
+  // ...
+  //
+  // The runtime finds the copy of the innermost enclosing taskgroup that
+  // registered the item and combines it into the original at its end.
+  for (OMPInReductionClause::varlist_const_iterator I = C.varlist_begin(),
+                                                    E = C.varlist_end();
+       I != E; ++I) {
+    const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    QualType QTy = (*I)->getType();
+    llvm::Value *Orig = EmitLValue(*I).getAddress();
+    llvm::Value *Args[] = {OPENMPRTL_THREADNUM(C.getLocStart(), *this),
+                           llvm::ConstantPointerNull::get(VoidPtrTy),
+                           Builder.CreateBitCast(Orig, VoidPtrTy)};
+    llvm::Value *Priv =
+        EmitRuntimeCall(OPENMPRTL_FUNC(task_reduction_get_th_data), Args);
+    Priv = Builder.CreateBitCast(Priv,
+                                 ConvertTypeForMem(QTy)->getPointerTo(),
+                                 CGM.getMangledName(VD) + ".in_reduction.");
+    CGM.OpenMPSupport.addOpenMPPrivateVar(VD, Priv);
+  }
+}
+
 /// '#pragma omp taskgroup' directive.
 void
 CodeGenFunction::EmitOMPTaskgroupDirective(const OMPTaskgroupDirective &S) {
   // __kmpc_taskgroup();
+  // __kmpc_task_reduction_init(gtid, n, red_data);
   //   <captured_body>
   // __kmpc_enc_taskgroup();
   //
   EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(taskgroup), S.getLocStart());
+  EmitOMPTaskReductionInit(S);
   EmitOMPCapturedBodyHelper(S);
   EmitOMPCallWithLocAndTidHelper(OPENMPRTL_FUNC(end_taskgroup), S.getLocEnd());
 
@@ -6473,6 +9326,25 @@ CodeGenFunction::EmitCloseOMPReductionClause(const OMPReductionClause &C,
         // end of if
         CGF.Builder.SetInsertPoint(FinalMergeEndIf);
       }
+    } else if (CGM.OpenMPSupport.getReductionVarPackKind(VD) >= 0) {
+      // Items packed by value are combined by runs of adjacent fields of the
+      // same type and pack kind; the whole run is emitted for its first field.
+      unsigned Idx = CGM.OpenMPSupport.getReductionVarIdx(VD);
+      int PackKind = CGM.OpenMPSupport.getReductionVarPackKind(VD);
+      llvm::StructType *RecTy =
+          cast<llvm::StructType>(CGM.OpenMPSupport.getReductionRec());
+      llvm::Type *EltTy = RecTy->getElementType(Idx);
+      if (Idx == 0 ||
+          CGM.OpenMPSupport.getReductionFieldPackKind(Idx - 1) != PackKind ||
+          RecTy->getElementType(Idx - 1) != EltTy) {
+        unsigned End = Idx + 1;
+        while (End < RecTy->getNumElements() &&
+               CGM.OpenMPSupport.getReductionFieldPackKind(End) == PackKind &&
+               RecTy->getElementType(End) == EltTy)
+          ++End;
+        EmitPackedReductionCombine(CGF, Addr1, Addr2, EltTy, End - Idx,
+                                   PackKind);
+      }
     } else {
       CGM.OpenMPSupport.addOpenMPPrivateVar(Par1, Addr1);
       CGM.OpenMPSupport.addOpenMPPrivateVar(Par2, Addr2);
@@ -6623,6 +9495,8 @@ static void EmitOMPAlignedClause(CodeGenFunction &CGF, CodeGenModule &CGM,
 // Simd wrappers implementation for '#pragma omp simd'.
 bool CodeGenFunction::CGPragmaOmpSimd::emitSafelen(CodeGenFunction *CGF) const {
   bool SeparateLastIter = false;
+  unsigned Safelen = 0;
+  unsigned Simdlen = 0;
   CGF->LoopStack.setParallel();
   CGF->LoopStack.setVectorizeEnable(true);
   for (ArrayRef<OMPClause *>::iterator I = SimdOmp->clauses().begin(),
@@ -6635,13 +9509,21 @@ bool CodeGenFunction::CGPragmaOmpSimd::emitSafelen(CodeGenFunction *CGF) const {
                                     AggValueSlot::ignored(), true);
       llvm::ConstantInt *Val = dyn_cast<llvm::ConstantInt>(Len.getScalarVal());
       assert(Val);
-      CGF->LoopStack.setVectorizeWidth(Val->getZExtValue());
+      Safelen = Val->getZExtValue();
       // In presence of finite 'safelen', it may be unsafe to mark all
       // the memory instructions parallel, because loop-carried
       // dependences of 'safelen' iterations are possible.
       CGF->LoopStack.setParallel(false);
       break;
     }
+    case OMPC_simdlen: {
+      RValue Len = CGF->EmitAnyExpr(cast<OMPSimdlenClause>(C)->getSimdlen(),
+                                    AggValueSlot::ignored(), true);
+      llvm::ConstantInt *Val = dyn_cast<llvm::ConstantInt>(Len.getScalarVal());
+      assert(Val);
+      Simdlen = Val->getZExtValue();
+      break;
+    }
     case OMPC_lastprivate: {
       SeparateLastIter = true;
       break;
@@ -6654,6 +9536,12 @@ bool CodeGenFunction::CGPragmaOmpSimd::emitSafelen(CodeGenFunction *CGF) const {
       ;
     }
   }
+  // 'simdlen' is the preferred number of concurrent iterations, 'safelen'
+  // only bounds it (Sema checks that simdlen <= safelen).
+  if (Simdlen != 0)
+    CGF->LoopStack.setVectorizeWidth(Simdlen);
+  else if (Safelen != 0)
+    CGF->LoopStack.setVectorizeWidth(Safelen);
   return SeparateLastIter;
 }
 
@@ -6732,23 +9620,29 @@ bool CodeGenFunction::CGPragmaOmpSimd::walkLocalVariablesToEmit(
         llvm::Value *Private =
             CGF->CreateMemTemp(QTy, CGF->CGM.getMangledName(VD) + ".linear.");
 
-        // Generate "Private = Index * Step + Start"
+        // Generate "Private = Index * Step + Start". The index never wraps
+        // inside the loop, so the value is emitted with no-wrap flags to let
+        // it be recognized as an induction variable of the loop rather than
+        // as a value carried through memory.
         llvm::Value *Start = CGF->EmitAnyExprToTemp(*J).getScalarVal();
         llvm::Value *Index = CGF->Builder.CreateLoad(LoopIndex);
+        QualType IndexTy = CD->getParam(1)->getType();
+        bool IsSignedIndex = IndexTy->hasSignedIntegerRepresentation();
         llvm::Value *Result = 0;
         if (const Expr *StepExpr = L->getStep()) {
           Result = CGF->EmitAnyExpr(StepExpr).getScalarVal();
-          QualType IndexTy = CD->getParam(1)->getType();
           Result = CGF->Builder.CreateIntCast(
               Result, Index->getType(),
-              IndexTy->hasSignedIntegerRepresentation());
+              StepExpr->getType()->hasSignedIntegerRepresentation());
         } else
           Result = llvm::ConstantInt::get(Index->getType(), 1);
-        Result = CGF->Builder.CreateMul(Index, Result);
+        Result = CGF->Builder.CreateMul(Index, Result, "", false,
+                                        IsSignedIndex);
         if (Start->getType()->isPointerTy()) {
-          Result = CGF->Builder.CreateGEP(Start, Result);
+          Result = CGF->Builder.CreateInBoundsGEP(Start, Result);
         } else {
-          Result = CGF->Builder.CreateIntCast(Result, Start->getType(), false);
+          Result = CGF->Builder.CreateIntCast(Result, Start->getType(),
+                                              IsSignedIndex);
           Result =
               CGF->Builder.CreateAdd(Start, Result, "add", false,
                                      QTy->isSignedIntegerOrEnumerationType());
@@ -6765,7 +9659,9 @@ bool CodeGenFunction::CGPragmaOmpSimd::walkLocalVariablesToEmit(
   }
 
   // Mark 'aligned' variables -- do this after all private variables are
-  // made 'omp-private' in CGM.OpenMPSupport.
+  // made 'omp-private' in CGM.OpenMPSupport. The assumptions emitted before
+  // the loop only cover the values loaded there, so they are repeated on the
+  // pointers the loop body actually uses.
   for (ArrayRef<OMPClause *>::iterator I = SimdOmp->clauses().begin(),
                                        E = SimdOmp->clauses().end();
        I != E; ++I) {
@@ -6773,6 +9669,7 @@ bool CodeGenFunction::CGPragmaOmpSimd::walkLocalVariablesToEmit(
     switch (C->getClauseKind()) {
     case OMPC_aligned: {
       OMPAlignedClause *A = cast<OMPAlignedClause>(C);
+      EmitOMPAlignedClause(*CGF, CGF->CGM, *A);
       // Prepare alignment expression for using it below.
       llvm::ConstantInt *AVal = emitClauseTail(CGF, A->getAlignment());
       // Walk the list and push each var's alignment into metadata.
@@ -7058,6 +9955,26 @@ void CodeGenFunction::EmitOMPTargetDataDirective(
     EmitBlock(ContBlock);
   }
 
+  // Unless the data environment is created conditionally, the mapped
+  // variables are present on the device for the whole region.
+  unsigned NumPresentVars = OMPDevicePresentVars.size();
+  int64_t Device;
+  if (!CGM.OpenMPSupport.getIfClauseCondition() &&
+      getOMPConstantDevice(*this, S, Device)) {
+    for (ArrayRef<OMPClause *>::iterator I = S.clauses().begin(),
+                                         E = S.clauses().end(); I != E; ++I) {
+      const OMPMapClause *C = dyn_cast_or_null<OMPMapClause>(*I);
+      if (!C || C->getKind() == OMPC_MAP_release ||
+          C->getKind() == OMPC_MAP_delete)
+        continue;
+      ArrayRef<const Expr *> Vars = C->getVars();
+      for (unsigned i = 0; i < Vars.size(); ++i) {
+        OMPDevicePresentVar Var = {Vars[i], Device};
+        OMPDevicePresentVars.push_back(Var);
+      }
+    }
+  }
+
   // FIXME: Currently we are replicating all the code captured by the directive
   // in case we have an if-clause. It would be enough to guard the map runtime
   // calls with the if-clause conditional.
@@ -7065,6 +9982,8 @@ void CodeGenFunction::EmitOMPTargetDataDirective(
   CapturedStmt *CS = cast<CapturedStmt>(S.getAssociatedStmt());
   EmitStmt(CS->getCapturedStmt());
 
+  OMPDevicePresentVars.resize(NumPresentVars);
+
   // Wrap the call to target_data_end in the if-clause condition
   if (CGM.OpenMPSupport.getIfClauseCondition()) {
     ThenBlock = createBasicBlock("omp.if.then");
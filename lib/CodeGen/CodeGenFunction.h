@@ -1009,6 +1009,19 @@ private:
   SmallVector<BreakContinue, 8> BreakContinueStack;
   llvm::DenseMap<unsigned, JumpDest> OMPCancelMap;
 
+  /// \brief A variable mapped by an enclosing 'target data' region of this
+  /// function. It stays present on the device for the whole region, so the
+  /// maps of nested target constructs do not transfer it again.
+  struct OMPDevicePresentVar {
+    /// \brief The map list item: a variable or an array section of it.
+    const Expr *E;
+    /// \brief Device the variable was mapped to, from a constant 'device'
+    /// clause.
+    int64_t Device;
+  };
+  SmallVector<OMPDevicePresentVar, 8> OMPDevicePresentVars;
+  bool isOMPPresentOnDevice(const Expr *E, int64_t Device) const;
+
   CodeGenPGO PGO;
 
   /// Calculate branch weights appropriate for PGO data
@@ -2261,6 +2274,8 @@ public:
   void EmitOMPTargetTeamsDistributeParallelForSimdDirective(
       const OMPTargetTeamsDistributeParallelForSimdDirective &S);
   void EmitOMPTaskDirective(const OMPTaskDirective &S);
+  void EmitOMPTaskLoopDirective(const OMPTaskLoopDirective &S);
+  void EmitOMPTaskLoopSimdDirective(const OMPTaskLoopSimdDirective &S);
   void EmitOMPSectionsDirective(const OMPSectionsDirective &S);
   void EmitOMPParallelSectionsDirective(const OMPParallelSectionsDirective &S);
   void EmitOMPSectionDirective(const OMPSectionDirective &S);
@@ -2299,7 +2314,8 @@ public:
                                  const OMPExecutableDirective &S);
   void EmitInitOMPDeviceClause(const OMPDeviceClause &C,
                             const OMPExecutableDirective &S);
-  void AppendOpenMPStackWithMapInfo(const OMPClause &C);
+  void AppendOpenMPStackWithMapInfo(const OMPClause &C,
+                                    const OMPExecutableDirective &S);
   void EmitInitOMPMapClause(const OMPMapClause &C,
                             const OMPExecutableDirective &S);
   void EmitAfterOMPMapClause(const OMPMapClause &C,
@@ -2320,6 +2336,10 @@ public:
                                const OMPExecutableDirective &S);
   void EmitInitOMPOrderedClause(const OMPOrderedClause &C,
                                 const OMPExecutableDirective &S);
+  void EmitPreOMPOrderedClause(const OMPOrderedClause &C,
+                               const OMPExecutableDirective &S);
+  void EmitPostOMPOrderedClause(const OMPOrderedClause &C,
+                                const OMPExecutableDirective &S);
   void EmitInitOMPUntiedClause(const OMPUntiedClause &C,
                                const OMPExecutableDirective &S);
   void EmitInitOMPFinalClause(const OMPFinalClause &C,
@@ -2352,6 +2372,12 @@ public:
                                    const OMPExecutableDirective &S);
   void EmitFinalOMPReductionClause(const OMPReductionClause &C,
                                    const OMPExecutableDirective &S);
+  void EmitOMPReductionIdentityInit(OpenMPReductionClauseOperator Op,
+                                    QualType QTy, const Expr *Init,
+                                    llvm::AllocaInst *Private);
+  void EmitPreOMPInReductionClause(const OMPInReductionClause &C,
+                                   const OMPExecutableDirective &S);
+  void EmitOMPTaskReductionInit(const OMPTaskgroupDirective &S);
   void EmitOMPBarrierDirective(const OMPBarrierDirective &S);
   void EmitOMPTaskyieldDirective(const OMPTaskyieldDirective &S);
   void EmitOMPTaskwaitDirective(const OMPTaskwaitDirective &S);
@@ -2384,6 +2410,8 @@ public:
                                 OpenMPDirectiveKind SKind,
                                 const OMPExecutableDirective &S,
                                 bool IsDistribute = false);
+  void EmitOMPDirectiveWithTaskLoop(OpenMPDirectiveKind DKind,
+                                    const OMPExecutableDirective &S);
   void EmitOMPSectionsDirective(
     OpenMPDirectiveKind DKind,
     OpenMPDirectiveKind SKind,
@@ -2400,6 +2428,7 @@ public:
     OpenMPDirectiveKind DKind,
     ArrayRef<OpenMPDirectiveKind> SKinds,
     const OMPExecutableDirective &S);
+  unsigned EmitOMPMergedParallelDirectives(ArrayRef<Stmt *> Stmts);
   void EmitOMPDirectiveWithTeams(OpenMPDirectiveKind DKind,
                                  OpenMPDirectiveKind SKind,
                                  const OMPExecutableDirective &S);
@@ -2415,6 +2444,10 @@ public:
   void EmitOMPBarrier(SourceLocation L, unsigned Flags);
   void EmitOMPCancelBarrier(SourceLocation L, unsigned Flags,
                             bool IgnoreResult = false);
+  llvm::Value *EmitOMPInstrRegionBegin(unsigned Kind, SourceLocation L);
+  void EmitOMPInstrRegionAcquired(llvm::Value *Desc, SourceLocation L);
+  void EmitOMPInstrRegionEnd(llvm::Value *Desc, SourceLocation L,
+                             llvm::Value *Iterations = 0);
 
   //===--------------------------------------------------------------------===//
   //                         LValue Expression Emission
@@ -3004,6 +3037,22 @@ public:
   /// If the statement (recursively) contains a switch or loop with a break
   /// inside of it, this is fine.
   static bool containsBreak(const Stmt *S);
+
+  /// \brief Adds to \a Children the statements nested in \a S that a walker
+  /// looking at what OpenMP regions do must visit: the body of a captured
+  /// statement instead of its capture initializers, and the expressions in
+  /// the clauses of a directive as well as its associated statement.
+  static void getOMPNestedStmts(const Stmt *S,
+                                SmallVectorImpl<const Stmt *> &Children);
+
+  /// \brief Returns true if the storage of \a VD is only loaded in \a S, or
+  /// also directly assigned outside of nested regions if \a AllowStores is
+  /// true. The bodies and clauses of nested regions are scanned as well. Any
+  /// other use of the variable (taking its address, binding it to a
+  /// reference, calling its member functions) may let it be modified
+  /// elsewhere and returns false.
+  static bool isOMPReadOnlyVar(const Stmt *S, const VarDecl *VD,
+                               bool AllowStores = false);
   
   /// ConstantFoldsToSimpleInteger - If the specified expression does not fold
   /// to a constant, or if it does but contains a label, return false.  If it
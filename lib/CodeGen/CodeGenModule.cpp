@@ -568,7 +568,8 @@ static llvm::GlobalVariable::ThreadLocalMode GetLLVMTLSModel(
 }
 
 void CodeGenModule::setTLSMode(llvm::GlobalValue *GV, const VarDecl &D) const {
-  assert(D.getTLSKind() && "setting TLS mode on non-TLS var!");
+  assert((D.getTLSKind() || LangOpts.OpenMPUseTLS) &&
+         "setting TLS mode on non-TLS var!");
 
   llvm::GlobalValue::ThreadLocalMode TLM;
   TLM = GetLLVMTLSModel(CodeGenOpts.getDefaultTLSModel());
@@ -3957,13 +3958,15 @@ llvm::Constant *CodeGenModule::EmitUuidofInitializer(StringRef Uuid) {
 CodeGenModule::OpenMPSupportStackTy::OMPStackElemTy::OMPStackElemTy(
     CodeGenModule &CGM)
     : PrivateVars(), IfEnd(0), IfClauseCondition(0), ReductionFunc(0), CGM(CGM),
-      RedCGF(0), ReductionTypes(), ReductionMap(), ReductionRec(0),
+      RedCGF(0), ReductionTypes(), ReductionPackKinds(), ReductionMap(),
+      ReductionRec(0),
       ReductionRecVar(0), RedArg1(0), RedArg2(0), ReduceSwitch(0), BB1(0),
       BB1IP(0), BB2(0), BB2IP(0), LockVar(0), LastprivateBB(0),
       LastprivateIP(0), LastprivateEndBB(0), LastIterVar(0), TaskFlags(0),
       PTaskTValue(0), PTask(0), UntiedPartIdAddr(0), UntiedCounter(0),
       UntiedSwitch(0), UntiedEnd(0), ParentCGF(0), NoWait(true),
-      Mergeable(false), Schedule(0), ChunkSize(0), NewTask(false),
+      Mergeable(false), Ordered(false), DoacrossCounters(), Schedule(0),
+      ChunkSize(0), NewTask(false),
       Untied(false), HasLastPrivate(false), TaskPrivateTy(0), TaskPrivateQTy(),
       TaskPrivateBase(0), NumTeams(0), ThreadLimit(0), WaitDepsArgs(0),
       MapsBegin(0), MapsEnd(0), OffloadingDevice(0),
@@ -3989,17 +3992,59 @@ void CodeGenModule::OpenMPSupportStackTy::endOpenMPRegion() {
   OpenMPStack.pop_back();
 }
 
+/// \brief Registers a field of the reduction record for \a VD. Variables with
+/// non-negative \a PackKind are stored in the record by value, all the others
+/// are stored as pointers to their private copies.
 void CodeGenModule::OpenMPSupportStackTy::registerReductionVar(
                                                   const VarDecl *VD,
-                                                  llvm::Type *Type) {
+                                                  llvm::Type *Type,
+                                                  int PackKind) {
   OpenMPStack.back().ReductionMap[VD] =
                            OpenMPStack.back().ReductionTypes.size();
   OpenMPStack.back().ReductionTypes.push_back(Type);
+  OpenMPStack.back().ReductionPackKinds.push_back(PackKind);
 }
 
 llvm::Value *
 CodeGenModule::OpenMPSupportStackTy::getReductionRecVar(CodeGenFunction &CGF) {
   if (!OpenMPStack.back().ReductionRecVar) {
+    OMPStackElemTy &Elem = OpenMPStack.back();
+    // Lay out the fields stored by value first, with the fields of the same
+    // type and pack kind next to each other, so that the reduction function
+    // can combine them with vector operations.
+    unsigned NumFields = Elem.ReductionTypes.size();
+    llvm::SmallVector<unsigned, 16> Order;
+    llvm::SmallVector<bool, 16> Placed(NumFields, false);
+    for (unsigned I = 0; I < NumFields; ++I) {
+      if (Placed[I] || Elem.ReductionPackKinds[I] < 0)
+        continue;
+      for (unsigned J = I; J < NumFields; ++J) {
+        if (!Placed[J] &&
+            Elem.ReductionPackKinds[J] == Elem.ReductionPackKinds[I] &&
+            Elem.ReductionTypes[J] == Elem.ReductionTypes[I]) {
+          Order.push_back(J);
+          Placed[J] = true;
+        }
+      }
+    }
+    for (unsigned I = 0; I < NumFields; ++I)
+      if (!Placed[I])
+        Order.push_back(I);
+    llvm::SmallVector<unsigned, 16> NewIdx(NumFields);
+    llvm::SmallVector<llvm::Type *, 16> Types;
+    llvm::SmallVector<int, 16> PackKinds;
+    for (unsigned I = 0; I < NumFields; ++I) {
+      NewIdx[Order[I]] = I;
+      Types.push_back(Elem.ReductionTypes[Order[I]]);
+      PackKinds.push_back(Elem.ReductionPackKinds[Order[I]]);
+    }
+    for (llvm::DenseMap<const VarDecl *, unsigned>::iterator
+             I = Elem.ReductionMap.begin(),
+             E = Elem.ReductionMap.end();
+         I != E; ++I)
+      I->second = NewIdx[I->second];
+    Elem.ReductionTypes.swap(Types);
+    Elem.ReductionPackKinds.swap(PackKinds);
     OpenMPStack.back().ReductionRec =
                  llvm::StructType::get(CGM.getLLVMContext(),
                                        OpenMPStack.back().ReductionTypes);
@@ -4042,6 +4087,18 @@ CodeGenModule::OpenMPSupportStackTy::getReductionVarIdx(const VarDecl *VD) {
   return OpenMPStack.back().ReductionMap[VD];
 }
 
+int
+CodeGenModule::OpenMPSupportStackTy::getReductionVarPackKind(const VarDecl *VD) {
+  return getReductionFieldPackKind(getReductionVarIdx(VD));
+}
+
+int
+CodeGenModule::OpenMPSupportStackTy::getReductionFieldPackKind(unsigned Idx) {
+  if (Idx >= OpenMPStack.back().ReductionPackKinds.size())
+    return -1;
+  return OpenMPStack.back().ReductionPackKinds[Idx];
+}
+
 llvm::Value *CodeGenModule::OpenMPSupportStackTy::getReductionSwitch() {
   return OpenMPStack.back().ReduceSwitch;
 }
@@ -4124,6 +4181,16 @@ bool CodeGenModule::OpenMPSupportStackTy::getOrdered() {
   return OpenMPStack.back().Ordered;
 }
 
+void CodeGenModule::OpenMPSupportStackTy::setDoacrossCounters(
+    ArrayRef<const Expr *> Counters) {
+  OpenMPStack.back().DoacrossCounters.assign(Counters.begin(), Counters.end());
+}
+
+ArrayRef<const Expr *>
+CodeGenModule::OpenMPSupportStackTy::getDoacrossCounters() {
+  return OpenMPStack.back().DoacrossCounters;
+}
+
 void CodeGenModule::OpenMPSupportStackTy::setHasLastPrivate(bool Flag) {
   OpenMPStack.back().HasLastPrivate = Flag;
 }
@@ -626,6 +626,14 @@ public:
                                   llvm::Function *Fn,
                                   GroupMap &Groups);
 
+  /// Emit the x86 vector function ABI variants (SSE, AVX, AVX2 and AVX-512,
+  /// masked and unmasked) of an 'omp declare simd' function for one group of
+  /// clauses, and record their names on the scalar function.
+  void EmitVectorVariants(const FunctionDecl *FD, llvm::Function *Fn,
+                          const CilkElementalGroup &G,
+                          QualType CharacteristicType, llvm::MDNode *ArgName,
+                          llvm::MDNode *ArgStep);
+
   /// Add an elemental function metadata node to the named metadata node
   /// 'cilk.functions'.
   void EmitCilkElementalMetadata(const CGFunctionInfo &FnInfo,
@@ -1199,6 +1207,14 @@ public:
   /// \brief Emit a code for threadprivate variable.
   ///
   void EmitOMPThreadPrivate(const VarDecl *VD, const Expr *TPE);
+  /// \brief Emit a threadprivate variable as a thread_local global.
+  ///
+  void EmitOMPThreadPrivateTLS(const VarDecl *VD);
+  /// \brief Emit the per-thread initialization of a thread_local
+  /// threadprivate variable with a dynamic initializer.
+  ///
+  void EmitOMPThreadPrivateTLSDynamicInit(const VarDecl *VD,
+                                          llvm::Constant *Addr);
   /// \brief Emit a code for declare reduction variables.
   ///
   void EmitOMPDeclareReduction(const OMPDeclareReductionDecl *D);
@@ -1223,6 +1239,7 @@ public:
       CodeGenModule &CGM;
       CodeGenFunction *RedCGF;
       llvm::SmallVector<llvm::Type *, 16> ReductionTypes;
+      llvm::SmallVector<int, 16> ReductionPackKinds;
       llvm::DenseMap<const VarDecl *, unsigned> ReductionMap;
       llvm::StructType *ReductionRec;
       llvm::Value *ReductionRecVar;
@@ -1249,6 +1266,7 @@ public:
       bool NoWait;
       bool Mergeable;
       bool Ordered;
+      llvm::SmallVector<const Expr *, 4> DoacrossCounters;
       int Schedule;
       const Expr *ChunkSize;
       bool NewTask;
@@ -1361,7 +1379,8 @@ public:
     }
     CodeGenFunction &getCGFForReductionFunction();
     void getReductionFunctionArgs(llvm::Value *&Arg1, llvm::Value *&Arg2);
-    void registerReductionVar(const VarDecl *VD, llvm::Type *Type);
+    void registerReductionVar(const VarDecl *VD, llvm::Type *Type,
+                              int PackKind = -1);
     llvm::Value *getReductionRecVar(CodeGenFunction &CGF);
     llvm::Type *getReductionRec();
     llvm::Value *getReductionSwitch();
@@ -1377,6 +1396,8 @@ public:
     llvm::Value *getLastIterVar();
     void setLastIterVar(llvm::Value *Var);
     unsigned getReductionVarIdx(const VarDecl *VD);
+    int getReductionVarPackKind(const VarDecl *VD);
+    int getReductionFieldPackKind(unsigned Idx);
     unsigned getNumberOfReductionVars();
     void setNoWait(bool Flag);
     bool getNoWait();
@@ -1386,6 +1407,8 @@ public:
     bool getMergeable();
     void setOrdered(bool Flag);
     bool getOrdered();
+    void setDoacrossCounters(ArrayRef<const Expr *> Counters);
+    ArrayRef<const Expr *> getDoacrossCounters();
     void setUntied(bool Flag);
     bool getUntied();
     void setTargetDeclare(bool Flag);
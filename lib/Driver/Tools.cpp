@@ -4443,6 +4443,27 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     case OMPRT_IOMP5:
       // Clang can generate useful OpenMP code for these two runtime libraries.
       CmdArgs.push_back("-fopenmp");
+      if (Args.hasFlag(options::OPT_fopenmp_inline_static_schedule,
+                       options::OPT_fno_openmp_inline_static_schedule, false))
+        CmdArgs.push_back("-fopenmp-inline-static-schedule");
+      if (Args.hasFlag(options::OPT_fopenmp_merge_parallel,
+                       options::OPT_fno_openmp_merge_parallel, false))
+        CmdArgs.push_back("-fopenmp-merge-parallel");
+      if (Args.hasFlag(options::OPT_fopenmp_instrument,
+                       options::OPT_fno_openmp_instrument, false))
+        CmdArgs.push_back("-fopenmp-instrument");
+      if (Args.hasFlag(options::OPT_fopenmp_runtime_flush,
+                       options::OPT_fno_openmp_runtime_flush, false))
+        CmdArgs.push_back("-fopenmp-runtime-flush");
+      if (Args.hasFlag(options::OPT_fopenmp_use_tls,
+                       options::OPT_fno_openmp_use_tls, false))
+        CmdArgs.push_back("-fopenmp-use-tls");
+      if (Args.hasFlag(options::OPT_fopenmp_inline_locks,
+                       options::OPT_fno_openmp_inline_locks, false))
+        CmdArgs.push_back("-fopenmp-inline-locks");
+      if (Args.hasFlag(options::OPT_fopenmp_nvptx_spmd,
+                       options::OPT_fno_openmp_nvptx_spmd, false))
+        CmdArgs.push_back("-fopenmp-nvptx-spmd");
       {
         // pass the targets we are generating code to
         if (Arg *Tgts = Args.getLastArg(options::OPT_omptargets_EQ)) {
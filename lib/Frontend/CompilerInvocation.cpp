@@ -1117,6 +1117,7 @@ static void ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args) {
   Opts.ResourceDir = Args.getLastArgValue(OPT_resource_dir);
   Opts.ModuleCachePath = Args.getLastArgValue(OPT_fmodules_cache_path);
   Opts.ModuleUserBuildPath = Args.getLastArgValue(OPT_fmodules_user_build_path);
+  Opts.HeaderGuardCachePath = Args.getLastArgValue(OPT_header_guard_cache);
   Opts.DisableModuleHash = Args.hasArg(OPT_fdisable_module_hash);
   Opts.ImplicitModuleMaps = Args.hasArg(OPT_fimplicit_module_maps);
   Opts.ModuleMapFileHomeIsCwd = Args.hasArg(OPT_fmodule_map_file_home_is_cwd);
@@ -1677,6 +1678,14 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
   Opts.OpenMPTargetMode = Args.hasArg(OPT_omp_target_mode);
   Opts.OpenMPHostIRDump = Args.hasArg(OPT_omp_dump_host_ir);
   Opts.OpenMPTargetIRDump = Args.hasArg(OPT_omp_dump_target_ir);
+  Opts.OpenMPInlineStaticSchedule =
+      Args.hasArg(OPT_fopenmp_inline_static_schedule);
+  Opts.OpenMPMergeParallel = Args.hasArg(OPT_fopenmp_merge_parallel);
+  Opts.OpenMPInstrument = Args.hasArg(OPT_fopenmp_instrument);
+  Opts.OpenMPRuntimeFlush = Args.hasArg(OPT_fopenmp_runtime_flush);
+  Opts.OpenMPUseTLS = Args.hasArg(OPT_fopenmp_use_tls);
+  Opts.OpenMPInlineLocks = Args.hasArg(OPT_fopenmp_inline_locks);
+  Opts.OpenMPNVPTXSPMD = Args.hasArg(OPT_fopenmp_nvptx_spmd);
 
   // Get the OpenMP target triples if any
   if ( Arg *A = Args.getLastArg(options::OPT_omptargets_EQ) ){
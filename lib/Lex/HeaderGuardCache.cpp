@@ -0,0 +1,388 @@
+//===--- HeaderGuardCache.cpp - Persistent header guard facts -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the HeaderGuardCache interface.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/HeaderGuardCache.h"
+#include "clang/Basic/FileManager.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/Support/raw_ostream.h"
+using namespace clang;
+
+//===----------------------------------------------------------------------===//
+// On-disk format
+//===----------------------------------------------------------------------===//
+//
+// The file starts with the magic string "cfe-hgc" and a 32-bit version. The
+// entries of the hash table follow, then the table itself, and the file ends
+// with the 32-bit offset of the table.  All integers are little endian.
+
+static const char Magic[] = "cfe-hgc";
+
+enum {
+  HeaderGuardCacheVersion = 2,
+
+  /// \brief The size of the magic string and version.
+  HeaderSize = sizeof(Magic) + 4,
+
+  /// \brief Flag set in the entry data of a \#pragma once header.
+  PragmaOnceFlag = 0x1,
+
+  /// \brief How many seconds must have passed since a header was modified
+  /// before its entry is recorded: one for the resolution of the
+  /// modification time, one for file systems that round it.
+  RacyModTimeWindow = 2
+};
+
+class HeaderGuardCache::Trait {
+public:
+  typedef HeaderGuardCache::Key external_key_type;
+  typedef HeaderGuardCache::Key internal_key_type;
+  typedef HeaderGuardCache::Key key_type;
+  typedef const key_type &key_type_ref;
+  typedef HeaderGuardCache::Entry data_type;
+  typedef const data_type &data_type_ref;
+  typedef uint32_t hash_value_type;
+  typedef uint32_t offset_type;
+
+  static bool EqualKey(const internal_key_type &A,
+                       const internal_key_type &B) {
+    return A.Size == B.Size && A.ModTime == B.ModTime &&
+           A.Filename == B.Filename;
+  }
+
+  static hash_value_type ComputeHash(const internal_key_type &K) {
+    return llvm::HashString(K.Filename);
+  }
+
+  static const internal_key_type &GetInternalKey(const external_key_type &K) {
+    return K;
+  }
+
+  static const external_key_type &GetExternalKey(const internal_key_type &K) {
+    return K;
+  }
+
+  static std::pair<unsigned, unsigned>
+  ReadKeyDataLength(const unsigned char *&D) {
+    using namespace llvm::support;
+    unsigned KeyLen = endian::readNext<uint16_t, little, unaligned>(D);
+    unsigned DataLen = endian::readNext<uint16_t, little, unaligned>(D);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  static internal_key_type ReadKey(const unsigned char *D, unsigned N) {
+    using namespace llvm::support;
+    internal_key_type K;
+    K.Size = endian::readNext<uint64_t, little, unaligned>(D);
+    K.ModTime = endian::readNext<uint64_t, little, unaligned>(D);
+    K.Filename = StringRef((const char *)D, N - 16);
+    return K;
+  }
+
+  static data_type ReadData(const internal_key_type &, const unsigned char *D,
+                            unsigned N) {
+    data_type Data;
+    Data.IsPragmaOnce = *D & PragmaOnceFlag;
+    Data.ControllingMacro = StringRef((const char *)D + 1, N - 1);
+    return Data;
+  }
+
+  std::pair<unsigned, unsigned>
+  EmitKeyDataLength(raw_ostream &Out, key_type_ref K, data_type_ref Data) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    unsigned KeyLen = 8 + 8 + K.Filename.size();
+    unsigned DataLen = 1 + Data.ControllingMacro.size();
+    LE.write<uint16_t>(KeyLen);
+    LE.write<uint16_t>(DataLen);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  void EmitKey(raw_ostream &Out, key_type_ref K, unsigned) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    LE.write<uint64_t>(K.Size);
+    LE.write<uint64_t>(K.ModTime);
+    Out << K.Filename;
+  }
+
+  void EmitData(raw_ostream &Out, key_type_ref, data_type_ref Data, unsigned) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    LE.write<uint8_t>(Data.IsPragmaOnce ? PragmaOnceFlag : 0);
+    Out << Data.ControllingMacro;
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// HeaderGuardCache Implementation
+//===----------------------------------------------------------------------===//
+
+/// \brief Check that the bucket at \p P, which may be corrupt, lies before
+/// \p End and holds entries that the trait can read, and move \p P past it.
+static bool validateBucket(const unsigned char *&P, const unsigned char *End,
+                           unsigned &NumItems) {
+  using namespace llvm::support;
+  if (End - P < 2)
+    return false;
+  NumItems = endian::readNext<uint16_t, little, unaligned>(P);
+  for (unsigned I = 0; I != NumItems; ++I) {
+    // The hash, then the key and data lengths.
+    if (End - P < 8)
+      return false;
+    P += 4;
+    unsigned KeyLen = endian::readNext<uint16_t, little, unaligned>(P);
+    unsigned DataLen = endian::readNext<uint16_t, little, unaligned>(P);
+    if (KeyLen < 16 || DataLen < 1 || unsigned(End - P) < KeyLen + DataLen)
+      return false;
+    P += KeyLen + DataLen;
+  }
+  return true;
+}
+
+HeaderGuardCache::HeaderGuardCache(StringRef Path)
+    : Path(Path), LoadTime(time(nullptr)) {}
+
+HeaderGuardCache::~HeaderGuardCache() {}
+
+std::unique_ptr<HeaderGuardCache> HeaderGuardCache::Create(StringRef Path) {
+  std::unique_ptr<HeaderGuardCache> Cache(new HeaderGuardCache(Path));
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileOrErr =
+      llvm::MemoryBuffer::getFile(Path, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+  if (!FileOrErr)
+    return Cache;
+  std::unique_ptr<llvm::MemoryBuffer> File = std::move(FileOrErr.get());
+
+  // Check the header, and that the table lies within the file.
+  using namespace llvm::support;
+  const unsigned char *BufBeg = (const unsigned char *)File->getBufferStart();
+  const unsigned char *BufEnd = (const unsigned char *)File->getBufferEnd();
+  if (BufEnd - BufBeg < HeaderSize + 4 ||
+      memcmp(BufBeg, Magic, sizeof(Magic)) != 0)
+    return Cache;
+  const unsigned char *P = BufBeg + sizeof(Magic);
+  if (endian::readNext<uint32_t, little, unaligned>(P) !=
+      HeaderGuardCacheVersion)
+    return Cache;
+  P = BufEnd - 4;
+  uint32_t TableOffset = endian::readNext<uint32_t, little, unaligned>(P);
+  if (TableOffset < HeaderSize || TableOffset % 4 != 0 ||
+      TableOffset + 8 > unsigned(BufEnd - BufBeg) - 4)
+    return Cache;
+
+  // The table is read without any bounds checks, so make sure that a corrupt
+  // or truncated file cannot send the reader past the end of the buffer.  The
+  // buckets must fit before the trailing offset, each bucket the lookups can
+  // reach must lie within the entries, and the entries must hold as many
+  // items as the iterators will walk.
+  const unsigned char *EntriesEnd = BufBeg + TableOffset;
+  P = EntriesEnd;
+  uint32_t NumBuckets = endian::readNext<uint32_t, little, unaligned>(P);
+  uint32_t NumEntries = endian::readNext<uint32_t, little, unaligned>(P);
+  if (NumBuckets == 0 || (NumBuckets & (NumBuckets - 1)) != 0 ||
+      NumBuckets > (unsigned(BufEnd - P) - 4) / 4)
+    return Cache;
+  for (uint32_t I = 0; I != NumBuckets; ++I) {
+    uint32_t Offset = endian::readNext<uint32_t, little, unaligned>(P);
+    if (!Offset)
+      continue;
+    unsigned NumItems;
+    const unsigned char *Bucket = BufBeg + Offset;
+    if (Offset < HeaderSize || Offset >= TableOffset ||
+        !validateBucket(Bucket, EntriesEnd, NumItems))
+      return Cache;
+  }
+  P = BufBeg + HeaderSize;
+  for (uint32_t Seen = 0; Seen < NumEntries;) {
+    unsigned NumItems;
+    if (!validateBucket(P, EntriesEnd, NumItems) || !NumItems)
+      return Cache;
+    Seen += NumItems;
+  }
+
+  Cache->Table.reset(TableTy::Create(BufBeg + TableOffset,
+                                     BufBeg + HeaderSize, BufBeg));
+  Cache->Buffer = std::move(File);
+  return Cache;
+}
+
+HeaderGuardCache::Key
+HeaderGuardCache::getKey(const FileEntry *File, FileManager &FileMgr,
+                         SmallVectorImpl<char> &Filename) {
+  Filename.assign(File->getName(), File->getName() + strlen(File->getName()));
+  FileMgr.makeAbsolutePath(Filename);
+
+  Key K;
+  K.Filename = StringRef(Filename.data(), Filename.size());
+  K.Size = File->getSize();
+  K.ModTime = File->getModificationTime();
+  return K;
+}
+
+bool HeaderGuardCache::lookup(const FileEntry *File, FileManager &FileMgr,
+                              Entry &Result) const {
+  if (!Table)
+    return false;
+
+  SmallString<256> Filename;
+  TableTy::iterator I = Table->find(getKey(File, FileMgr, Filename));
+  if (I == Table->end())
+    return false;
+  Result = *I;
+  return true;
+}
+
+void HeaderGuardCache::record(const FileEntry *File, FileManager &FileMgr,
+                              const Entry &Info) {
+  SmallString<256> Filename;
+  Key K = getKey(File, FileMgr, Filename);
+
+  // The header was read after the cache was loaded.  If it was last modified
+  // long enough before that, any later rewrite has a different modification
+  // time; otherwise it may be rewritten within the same second, and the entry
+  // would then match the new contents.
+  if (int64_t(K.ModTime) + RacyModTimeWindow > int64_t(LoadTime))
+    return;
+
+  RecordedEntry &R = Recorded[K.Filename];
+  R.Size = K.Size;
+  R.ModTime = K.ModTime;
+  R.IsPragmaOnce = Info.IsPragmaOnce;
+  R.ControllingMacro = Info.ControllingMacro;
+}
+
+bool HeaderGuardCache::isUpToDate(const TableTy *OnDisk) const {
+  for (llvm::StringMap<RecordedEntry>::const_iterator I = Recorded.begin(),
+                                                      E = Recorded.end();
+       I != E; ++I) {
+    if (!OnDisk)
+      return false;
+
+    Key K;
+    K.Filename = I->getKey();
+    K.Size = I->getValue().Size;
+    K.ModTime = I->getValue().ModTime;
+    TableTy::iterator Found = OnDisk->find(K);
+    if (Found == OnDisk->end())
+      return false;
+    Entry Data = *Found;
+    if (Data.IsPragmaOnce != I->getValue().IsPragmaOnce ||
+        Data.ControllingMacro != I->getValue().ControllingMacro)
+      return false;
+  }
+  return true;
+}
+
+bool HeaderGuardCache::write() {
+  // Most compilations only see headers that are already in the cache; leave
+  // the file alone for those.
+  if (isUpToDate(Table.get()))
+    return false;
+
+  // Serialize the compilations that update the cache, so that none of them
+  // drops the entries written by another one in the meantime.
+  while (true) {
+    llvm::LockFileManager Locked(Path);
+    switch (Locked) {
+    case llvm::LockFileManager::LFS_Error:
+      return true;
+
+    case llvm::LockFileManager::LFS_Owned:
+      return writeLocked();
+
+    case llvm::LockFileManager::LFS_Shared:
+      // Another compilation is updating the cache; wait for it, then take the
+      // lock to merge with what it wrote.
+      if (Locked.waitForUnlock() == llvm::LockFileManager::Res_Timeout)
+        return true;
+      continue;
+    }
+  }
+}
+
+bool HeaderGuardCache::writeLocked() {
+  // Merge with the cache as it is now rather than as it was loaded, since
+  // other compilations may have updated it since.
+  std::unique_ptr<HeaderGuardCache> Current = Create(Path);
+  if (isUpToDate(Current->Table.get()))
+    return false;
+
+  llvm::OnDiskChainedHashTableGenerator<Trait> Generator;
+  for (llvm::StringMap<RecordedEntry>::iterator I = Recorded.begin(),
+                                                E = Recorded.end();
+       I != E; ++I) {
+    Key K;
+    K.Filename = I->getKey();
+    K.Size = I->getValue().Size;
+    K.ModTime = I->getValue().ModTime;
+    Entry Data;
+    Data.IsPragmaOnce = I->getValue().IsPragmaOnce;
+    Data.ControllingMacro = I->getValue().ControllingMacro;
+    Generator.insert(K, Data);
+  }
+
+  // Keep the entries of the headers this compilation did not see.  The ones it
+  // did see are replaced, since the header may have changed since.
+  if (TableTy *OnDisk = Current->Table.get()) {
+    TableTy::key_iterator KI = OnDisk->key_begin(), KE = OnDisk->key_end();
+    TableTy::data_iterator DI = OnDisk->data_begin();
+    for (; KI != KE; ++KI, ++DI) {
+      Key K = *KI;
+      if (!Recorded.count(K.Filename))
+        Generator.insert(K, *DI);
+    }
+  }
+
+  SmallString<4096> Contents;
+  {
+    using namespace llvm::support;
+    llvm::raw_svector_ostream Out(Contents);
+    endian::Writer<little> LE(Out);
+    Out.write(Magic, sizeof(Magic));
+    LE.write<uint32_t>(HeaderGuardCacheVersion);
+    uint32_t TableOffset = Generator.Emit(Out);
+    LE.write<uint32_t>(TableOffset);
+  }
+
+  // Write to a temporary file and rename it over the cache, so that
+  // compilations running at the same time always read a complete cache.
+  SmallString<128> TempPath;
+  TempPath = Path;
+  TempPath += "-%%%%%%%%";
+  int FD;
+  if (llvm::sys::fs::createUniqueFile(TempPath, FD, TempPath))
+    return true;
+
+  llvm::raw_fd_ostream Out(FD, /*shouldClose=*/true);
+  Out << Contents;
+  Out.close();
+  if (Out.has_error()) {
+    Out.clear_error();
+    llvm::sys::fs::remove(TempPath);
+    return true;
+  }
+
+  if (llvm::sys::fs::rename(TempPath, Path)) {
+    llvm::sys::fs::remove(TempPath);
+    return true;
+  }
+
+  return false;
+}
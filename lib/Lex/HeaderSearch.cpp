@@ -16,6 +16,7 @@
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Frontend/PCHContainerOperations.h"
 #include "clang/Lex/ExternalPreprocessorSource.h"
+#include "clang/Lex/HeaderGuardCache.h"
 #include "clang/Lex/HeaderMap.h"
 #include "clang/Lex/HeaderSearchOptions.h"
 #include "clang/Lex/LexDiagnostic.h"
@@ -1094,6 +1095,21 @@ bool HeaderSearch::ShouldEnterIncludeFile(Preprocessor &PP,
       return false;
   }
 
+  // If the file has not been entered yet, an earlier compilation may have
+  // found its guard; use it so that the file need not even be opened.  The
+  // cache is loaded before any header it may record is read, even a module
+  // header, so that it can tell which of them were modified too recently.
+  HeaderGuardCache *Cache = getHeaderGuardCache();
+  if (Cache && !FileInfo.NumIncludes && !FileInfo.ControllingMacro &&
+      !FileInfo.ControllingMacroID && !M &&
+      !PP.getSourceManager().isFileOverridden(File)) {
+    HeaderGuardCache::Entry Entry;
+    if (Cache->lookup(File, FileMgr, Entry) &&
+        !Entry.ControllingMacro.empty())
+      FileInfo.ControllingMacro =
+          PP.getIdentifierInfo(Entry.ControllingMacro);
+  }
+
   // Next, check to see if the file is wrapped with #ifndef guards.  If so, and
   // if the macro that guards it is defined, we know the #include has no effect.
   if (const IdentifierInfo *ControllingMacro
@@ -1114,6 +1130,42 @@ bool HeaderSearch::ShouldEnterIncludeFile(Preprocessor &PP,
   return true;
 }
 
+HeaderGuardCache *HeaderSearch::getHeaderGuardCache() {
+  // The guards of module headers are tracked by the modules themselves.
+  if (!GuardCache && !HSOpts->HeaderGuardCachePath.empty() &&
+      !LangOpts.Modules)
+    GuardCache = HeaderGuardCache::Create(HSOpts->HeaderGuardCachePath);
+  return GuardCache.get();
+}
+
+void HeaderSearch::writeHeaderGuardCache(SourceManager &SourceMgr) {
+  HeaderGuardCache *Cache = getHeaderGuardCache();
+  if (!Cache)
+    return;
+
+  // Only record the headers that were lexed by this compilation; the entries
+  // of the others are kept as they are.
+  SmallVector<const FileEntry *, 16> FilesByUID;
+  FileMgr.GetUniqueIDMapping(FilesByUID);
+  for (unsigned UID = 0, E = std::min(FileInfo.size(), FilesByUID.size());
+       UID != E; ++UID) {
+    const HeaderFileInfo &HFI = FileInfo[UID];
+    const FileEntry *File = FilesByUID[UID];
+    if (!File || !HFI.NumIncludes || SourceMgr.isFileOverridden(File))
+      continue;
+    if (!HFI.isPragmaOnce && !HFI.ControllingMacro)
+      continue;
+
+    HeaderGuardCache::Entry Entry;
+    Entry.IsPragmaOnce = HFI.isPragmaOnce;
+    if (HFI.ControllingMacro)
+      Entry.ControllingMacro = HFI.ControllingMacro->getName();
+    Cache->record(File, FileMgr, Entry);
+  }
+
+  Cache->write();
+}
+
 size_t HeaderSearch::getTotalMemory() const {
   return SearchDirs.capacity()
     + llvm::capacity_in_bytes(FileInfo)
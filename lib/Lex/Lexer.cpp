@@ -1468,9 +1468,102 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
+/// Skip a run of [_A-Za-z0-9] characters starting at \p CurPtr a vector at a
+/// time and return a pointer to the first character that may not be part of
+/// it. Any other character, including backslashes, '?', '$' and non-ASCII
+/// bytes, stops the scan and is left to the caller.
+static const char *skipASCIIIdentifierBody(const char *CurPtr,
+                                           const char *BufferEnd) {
+  // Bytes are compared as signed values, so non-ASCII bytes are never in any
+  // of the ranges.
+#ifdef __AVX2__
+  while (CurPtr + 32 <= BufferEnd) {
+    __m256i V = _mm256_loadu_si256((const __m256i *)CurPtr);
+    __m256i Lower = _mm256_or_si256(V, _mm256_set1_epi8(0x20));
+    __m256i Alpha = _mm256_and_si256(
+        _mm256_cmpgt_epi8(Lower, _mm256_set1_epi8('a' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), Lower));
+    __m256i Digit = _mm256_and_si256(
+        _mm256_cmpgt_epi8(V, _mm256_set1_epi8('0' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), V));
+    __m256i Under = _mm256_cmpeq_epi8(V, _mm256_set1_epi8('_'));
+    unsigned Mask = _mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_or_si256(Alpha, Digit), Under));
+    if (Mask != 0xFFFFFFFFu)
+      return CurPtr + llvm::countTrailingZeros<unsigned>(~Mask);
+    CurPtr += 32;
+  }
+#endif
+#ifdef __SSE2__
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Lower = _mm_or_si128(V, _mm_set1_epi8(0x20));
+    __m128i Alpha =
+        _mm_and_si128(_mm_cmpgt_epi8(Lower, _mm_set1_epi8('a' - 1)),
+                      _mm_cmplt_epi8(Lower, _mm_set1_epi8('z' + 1)));
+    __m128i Digit = _mm_and_si128(_mm_cmpgt_epi8(V, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(V, _mm_set1_epi8('9' + 1)));
+    __m128i Under = _mm_cmpeq_epi8(V, _mm_set1_epi8('_'));
+    unsigned Mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(Alpha, Digit), Under));
+    if (Mask != 0xFFFF)
+      return CurPtr + llvm::countTrailingZeros<unsigned>(~Mask);
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
+/// Skip a run of horizontal whitespace starting at \p CurPtr a vector at a
+/// time and return a pointer to the first character that may not be part of
+/// it.
+static const char *skipHorizontalWhitespace(const char *CurPtr,
+                                            const char *BufferEnd) {
+#ifdef __AVX2__
+  while (CurPtr + 32 <= BufferEnd) {
+    __m256i V = _mm256_loadu_si256((const __m256i *)CurPtr);
+    __m256i Space = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(V, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(V, _mm256_set1_epi8('\t'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(V, _mm256_set1_epi8('\f')),
+                        _mm256_cmpeq_epi8(V, _mm256_set1_epi8('\v'))));
+    unsigned Mask = _mm256_movemask_epi8(Space);
+    if (Mask != 0xFFFFFFFFu)
+      return CurPtr + llvm::countTrailingZeros<unsigned>(~Mask);
+    CurPtr += 32;
+  }
+#endif
+#ifdef __SSE2__
+  while (CurPtr + 16 <= BufferEnd) {
+    __m128i V = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Space =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8(' ')),
+                                  _mm_cmpeq_epi8(V, _mm_set1_epi8('\t'))),
+                     _mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8('\f')),
+                                  _mm_cmpeq_epi8(V, _mm_set1_epi8('\v'))));
+    unsigned Mask = _mm_movemask_epi8(Space);
+    if (Mask != 0xFFFF)
+      return CurPtr + llvm::countTrailingZeros<unsigned>(~Mask);
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
+  CurPtr = skipASCIIIdentifierBody(CurPtr, BufferEnd);
   unsigned char C = *CurPtr++;
   while (isIdentifierBody(C))
     C = *CurPtr++;
@@ -1962,6 +2055,10 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (1) {
     // Skip horizontal whitespace very aggressively.
+    if (isHorizontalWhitespace(Char)) {
+      CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+      Char = *CurPtr;
+    }
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
 
@@ -2233,13 +2330,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -3641,3 +3731,269 @@ HandleDirective:
   // We parsed the directive; lex a token with the new state.
   return false;
 }
+
+//===----------------------------------------------------------------------===//
+// Directive Start Scanning
+//===----------------------------------------------------------------------===//
+
+/// Return a pointer to the first character at or after \p P that may change
+/// the state of a directive start scan: a newline, a character that may start
+/// a comment or a literal, a backslash and, if \p Trigraphs, a '?'. Returns
+/// \p End if there is none.
+static const char *findDirectiveScanStop(const char *P, const char *End,
+                                         bool Trigraphs) {
+#ifdef __SSE2__
+  __m128i Question = _mm_set1_epi8(Trigraphs ? '?' : '\n');
+  while (P + 16 <= End) {
+    __m128i V = _mm_loadu_si128((const __m128i *)P);
+    __m128i Stop = _mm_or_si128(
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8('\n')),
+                                  _mm_cmpeq_epi8(V, _mm_set1_epi8('\r'))),
+                     _mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8('/')),
+                                  _mm_cmpeq_epi8(V, _mm_set1_epi8('\\')))),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(V, _mm_set1_epi8('"')),
+                                  _mm_cmpeq_epi8(V, _mm_set1_epi8('\''))),
+                     _mm_cmpeq_epi8(V, Question)));
+    unsigned Mask = _mm_movemask_epi8(Stop);
+    if (Mask != 0)
+      return P + llvm::countTrailingZeros<unsigned>(Mask);
+    P += 16;
+  }
+#endif
+  for (; P != End; ++P) {
+    switch (*P) {
+    case '\n': case '\r': case '/': case '\\': case '"': case '\'':
+      return P;
+    case '?':
+      if (Trigraphs)
+        return P;
+      break;
+    default:
+      break;
+    }
+  }
+  return End;
+}
+
+/// Return a pointer to the newline that ends the physical line containing
+/// \p P, or \p End.
+static const char *findEndOfPhysicalLine(const char *P, const char *End) {
+  while (P != End && *P != '\n' && *P != '\r')
+    ++P;
+  return P;
+}
+
+/// Return true if the header names on the physical line starting at \p P
+/// would not be lexed the same way as the tokens of a skipped line, i.e. if a
+/// '<' is followed, before the next '>', by something that starts a comment
+/// or a literal, or if the line is continued by an escaped newline.
+static bool hasAmbiguousHeaderName(const char *P, const char *End) {
+  const char *LineEnd = findEndOfPhysicalLine(P, End);
+  if (std::find(P, LineEnd, '<') != LineEnd &&
+      std::find(P, LineEnd, '\\') != LineEnd)
+    return true;
+  for (P = std::find(P, LineEnd, '<'); P != LineEnd;
+       P = std::find(P, LineEnd, '<')) {
+    for (++P; P != LineEnd && *P != '>'; ++P) {
+      if (*P == '"' || *P == '\'' ||
+          (*P == '/' && (P[1] == '*' || P[1] == '/')))
+        return true;
+    }
+  }
+  return false;
+}
+
+/// Check the directive starting with the introducer at \p P. Return false if
+/// the rest of its line is lexed differently when the directive is processed
+/// than when it is skipped, in a way that could change where the following
+/// lines start.
+static bool isScannableDirective(const char *P, const char *End) {
+  P += *P == '#' ? 1 : *P == '%' ? 2 : 3;
+  while (P != End && isHorizontalWhitespace(*P))
+    ++P;
+  if (P == End)
+    return true;
+  // Don't try to read through comments or escaped newlines before the name.
+  if (*P == '/' || *P == '\\')
+    return false;
+
+  const char *NameStart = P;
+  while (P != End && isIdentifierBody(*P))
+    ++P;
+  if (P != End && *P == '\\')
+    return false;
+  StringRef Name(NameStart, P - NameStart);
+
+  // Header names are only formed when the directive is processed.
+  if (Name == "include" || Name == "include_next" || Name == "import" ||
+      Name == "__include_macros" || Name == "pragma")
+    return !hasAmbiguousHeaderName(P, End);
+  if (Name == "if" || Name == "elif") {
+    StringRef Line(P, findEndOfPhysicalLine(P, End) - P);
+    return Line.find("__has_include") == StringRef::npos ||
+           !hasAmbiguousHeaderName(P, End);
+  }
+  // The message of a processed diagnostic directive is not tokenized.
+  if (Name == "error" || Name == "warning") {
+    StringRef Line(P, findEndOfPhysicalLine(P, End) - P);
+    return Line.find("/*") == StringRef::npos &&
+           Line.find('\\') == StringRef::npos;
+  }
+  return true;
+}
+
+bool Lexer::computeDirectiveStarts(StringRef Buffer,
+                                   const LangOptions &LangOpts,
+                                   SmallVectorImpl<unsigned> &Offsets) {
+  if (LangOpts.AsmPreprocessor || LangOpts.TraditionalCPP)
+    return false;
+
+  // The buffer is null terminated, so looking one character past any
+  // character of it is always safe.
+  const char *BufferStart = Buffer.begin();
+  const char *End = Buffer.end();
+  const char *P = BufferStart;
+  bool AtStartOfLine = true;
+  while (true) {
+    if (AtStartOfLine) {
+      AtStartOfLine = false;
+      while (P != End && (isWhitespace(*P) || *P == 0))
+        ++P;
+      if (P == End)
+        break;
+
+      bool IsDirective =
+          *P == '#' || (LangOpts.Digraphs && P[0] == '%' && P[1] == ':') ||
+          (LangOpts.Trigraphs && P[0] == '?' && P[1] == '?' && P[2] == '=');
+      // A comment or an escaped newline may hide the '#' of a directive.
+      if (IsDirective || *P == '\\' || (P[0] == '/' && P[1] == '*'))
+        Offsets.push_back(P - BufferStart);
+      if (IsDirective && !isScannableDirective(P, End))
+        return false;
+    }
+
+    P = findDirectiveScanStop(P, End, LangOpts.Trigraphs);
+    if (P == End)
+      break;
+
+    switch (*P) {
+    case '\n':
+    case '\r':
+      ++P;
+      AtStartOfLine = true;
+      break;
+
+    case '\\':
+      // The line after an escaped newline continues this one.
+      P += Lexer::getEscapedNewLineSize(P + 1) + 1;
+      break;
+
+    case '?':
+      // Trigraph escaped newlines are not worth modeling.
+      if (P[1] == '?' && P[2] == '/')
+        return false;
+      ++P;
+      break;
+
+    case '/':
+      if (P[1] == '/') {
+        // Without line comments '//' may or may not start a comment,
+        // depending on what follows it and on the preprocessor mode.
+        if (!LangOpts.LineComment)
+          return false;
+        // Skip to the first newline that is not escaped.
+        for (P += 2; P != End && *P != '\n' && *P != '\r'; ++P) {
+          if (*P == '\\')
+            P += Lexer::getEscapedNewLineSize(P + 1);
+          else if (*P == '?' && LangOpts.Trigraphs && P[1] == '?' &&
+                   P[2] == '/')
+            return false;
+        }
+        break;
+      }
+      if (P[1] == '*') {
+        // '/*/' does not end the comment.
+        const char *Search = P[2] == '/' ? P + 3 : P + 2;
+        while (true) {
+          const char *Slash = static_cast<const char *>(
+              Search == End ? nullptr : memchr(Search, '/', End - Search));
+          if (!Slash) {
+            // An unterminated comment runs to the end of the buffer.
+            P = End;
+            break;
+          }
+          if (Slash[-1] == '*') {
+            P = Slash + 1;
+            break;
+          }
+          // '*', an escaped newline and '/' also end the comment.
+          if (Slash[-1] == '\n' || Slash[-1] == '\r') {
+            const char *Prev = Slash - 1;
+            if (Prev > BufferStart && Prev[-1] != *Prev &&
+                (Prev[-1] == '\n' || Prev[-1] == '\r'))
+              --Prev;
+            while (Prev > BufferStart && isHorizontalWhitespace(Prev[-1]))
+              --Prev;
+            if (Prev > BufferStart &&
+                (Prev[-1] == '\\' || (Prev[-1] == '/' && LangOpts.Trigraphs)))
+              return false;
+          }
+          Search = Slash + 1;
+        }
+        break;
+      }
+      // A comment may also start after an escaped newline.
+      if (P[1] == '\\' || (P[1] == '?' && LangOpts.Trigraphs))
+        return false;
+      ++P;
+      break;
+
+    case '"':
+    case '\'': {
+      // Raw string literals may contain anything.
+      if (*P == '"' && LangOpts.CPlusPlus11 && P != BufferStart &&
+          P[-1] == 'R')
+        return false;
+      // In C++14 a quote inside a number is a digit separator.
+      if (*P == '\'' && LangOpts.CPlusPlus14) {
+        const char *TokStart = P;
+        while (TokStart != BufferStart &&
+               (isIdentifierBody(TokStart[-1]) || TokStart[-1] == '.' ||
+                TokStart[-1] == '\''))
+          --TokStart;
+        if (TokStart != P && (isDigit(*TokStart) || *TokStart == '.'))
+          return false;
+      }
+
+      // Skip to the closing quote, or to the end of the line if there is
+      // none.
+      char Quote = *P++;
+      while (P != End && *P != Quote && *P != '\n' && *P != '\r') {
+        if (*P == '?' && LangOpts.Trigraphs && P[1] == '?' && P[2] == '/')
+          return false;
+        if (*P != '\\') {
+          ++P;
+          continue;
+        }
+        if (unsigned Size = Lexer::getEscapedNewLineSize(P + 1)) {
+          P += Size + 1;
+          continue;
+        }
+        // An escape; the escaped character may itself follow escaped
+        // newlines.
+        ++P;
+        while (*P == '\\' && Lexer::getEscapedNewLineSize(P + 1))
+          P += Lexer::getEscapedNewLineSize(P + 1) + 1;
+        if (*P == '?' && LangOpts.Trigraphs)
+          return false;
+        if (P != End && *P != '\n' && *P != '\r')
+          ++P;
+      }
+      if (P != End && *P == Quote)
+        ++P;
+      break;
+    }
+    }
+  }
+  return true;
+}
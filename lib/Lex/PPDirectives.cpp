@@ -297,11 +297,37 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation IfTokenLoc,
     return;
   }
 
+  // If the lines of the file that may start a directive are known, jump from
+  // one to the next instead of lexing everything in between.  They are
+  // computed once per file, and reused by every inclusion of it.
+  Optional<ArrayRef<unsigned>> DirectiveStarts;
+  if (!CurLexer->isKeepWhitespaceMode() &&
+      CurLexer->getFileLoc() != CodeCompletionFileLoc) {
+    FileID FID = CurLexer->getFileID();
+    if (FID.isValid() &&
+        CurLexer->getBuffer().data() == SourceMgr.getBufferData(FID).data())
+      DirectiveStarts = SourceMgr.getDirectiveStarts(
+          FID, [&](StringRef Buffer, SmallVectorImpl<unsigned> &Offsets) {
+            return Lexer::computeDirectiveStarts(Buffer, LangOpts, Offsets);
+          });
+  }
+
   // Enter raw mode to disable identifier lookup (and thus macro expansion),
   // disabling warnings, etc.
   CurPPLexer->LexingRawMode = true;
   Token Tok;
   while (1) {
+    if (DirectiveStarts) {
+      unsigned Offset = CurLexer->BufferPtr - CurLexer->BufferStart;
+      const unsigned *Next = std::lower_bound(DirectiveStarts->begin(),
+                                              DirectiveStarts->end(), Offset);
+      unsigned NextOffset = Next == DirectiveStarts->end()
+                                ? CurLexer->getBuffer().size()
+                                : *Next;
+      if (NextOffset > Offset)
+        CurLexer->SkipBytes(NextOffset - Offset, /*StartOfLine=*/true);
+    }
+
     CurLexer->Lex(Tok);
 
     if (Tok.is(tok::code_completion)) {
@@ -526,6 +526,9 @@ void Preprocessor::EndSourceFile() {
   // Notify the client that we reached the end of the source file.
   if (Callbacks)
     Callbacks->EndOfMainFile();
+
+  // Let later compilations reuse the include guards found by this one.
+  HeaderInfo.writeHeaderGuardCache(SourceMgr);
 }
 
 //===----------------------------------------------------------------------===//
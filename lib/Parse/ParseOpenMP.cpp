@@ -59,6 +59,21 @@ OpenMPDirectiveKind Parser::ParseOpenMPDirective() {
     }
     break;
   }
+  case OMPD_taskloop: {
+    // This is to get correct directive name in the error message below.
+    // This whole switch actually should be extracted into a helper routine
+    // and reused in ParseOpenMPDeclarativeOrExecutableDirective below.
+    Token SavedToken = PP.LookAhead(0);
+    if (!SavedToken.isAnnotation()) {
+      OpenMPDirectiveKind SDKind =
+          getOpenMPDirectiveKind(PP.getSpelling(SavedToken));
+      if (SDKind == OMPD_simd) {
+        DKind = OMPD_taskloop_simd;
+        ConsumeAnyToken();
+      }
+    }
+    break;
+  }
   case OMPD_distribute: {
     // This is to get correct directive name in the error message below.
     // This whole switch actually should be extracted into a helper routine
@@ -639,7 +654,7 @@ void Parser::LateParsedOpenMPDeclaration::ParseLexedMethodDeclarations() {
 ///         annot_pragma_openmp 'master' annot_pragma_openmp_end
 ///
 ///       critical-directive:
-///         annot_pragma_openmp 'critical' [ '(' <name> ')' ]
+///         annot_pragma_openmp 'critical' [ '(' <name> ')' ] [hint-clause]
 ///         annot_pragma_openmp_end
 ///
 ///       barrier-directive:
@@ -788,6 +803,8 @@ Parser::ParseOpenMPDeclarativeOrExecutableDirective(bool StandAloneAllowed) {
   case OMPD_section:
   case OMPD_single:
   case OMPD_task:
+  case OMPD_taskloop:
+  case OMPD_taskloop_simd:
   case OMPD_master:
   case OMPD_taskgroup:
   case OMPD_atomic:
@@ -825,10 +842,19 @@ Parser::ParseOpenMPDeclarativeOrExecutableDirective(bool StandAloneAllowed) {
     // Consume final annot_pragma_openmp_end.
     ConsumeAnyToken();
 
+    // OpenMP [2.13.8, ordered Construct, Syntax]
+    //  The ordered construct with depend clause is a stand-alone directive.
+    bool IsStandAloneOrdered =
+        DKind == OMPD_ordered && FirstClauses[OMPC_depend].getInt();
+    if (IsStandAloneOrdered && !StandAloneAllowed) {
+      Diag(Loc, diag::err_omp_immediate_directive)
+          << getOpenMPDirectiveName(DKind);
+    }
+
     StmtResult AssociatedStmt;
     bool CreateDirective = true;
     if (DKind != OMPD_taskyield && DKind != OMPD_barrier &&
-        DKind != OMPD_taskwait) {
+        DKind != OMPD_taskwait && !IsStandAloneOrdered) {
       // Parse statement
       // The body is a block scope like in Lambdas and Blocks.
       Sema::CompoundScopeRAII CompoundScope(Actions);
@@ -840,7 +866,8 @@ Parser::ParseOpenMPDeclarativeOrExecutableDirective(bool StandAloneAllowed) {
                      DKind == OMPD_target_teams_distribute_parallel_for_simd ||
                      DKind == OMPD_distribute_simd ||
                      DKind == OMPD_teams_distribute_simd ||
-                     DKind == OMPD_target_teams_distribute_simd)
+                     DKind == OMPD_target_teams_distribute_simd ||
+                     DKind == OMPD_taskloop_simd)
                         ? 3
                         : 1;
       Actions.ActOnCapturedRegionStart(Loc, getCurScope(), CR_OpenMP, NumArgs);
@@ -1319,7 +1346,10 @@ Decl *Parser::ParseOpenMPDeclareReduction(
 ///       aligned-clause | simdlen-clause | num_teams-clause |
 ///       thread_limit-clause | uniform-clause | inbranch-clause |
 ///       notinbranch-clause | dist_schedule-clause | depend-clause |
-///       device-clause | map-clause | to-clause | from-clause
+///       device-clause | map-clause | to-clause | from-clause |
+///       grainsize-clause | num_tasks-clause | priority-clause |
+///       task_reduction-clause | in_reduction-clause | hint-clause |
+///       is_device_ptr-clause | defaultmap-clause
 ///
 OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
                                      OpenMPClauseKind CKind, bool FirstClause) {
@@ -1342,6 +1372,10 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
   case OMPC_num_teams:
   case OMPC_thread_limit:
   case OMPC_device:
+  case OMPC_grainsize:
+  case OMPC_num_tasks:
+  case OMPC_priority:
+  case OMPC_hint:
     // OpenMP [2.5, Restrictions, p.3]
     //  At most one if clause can appear on the directive.
     // OpenMP [2.5, Restrictions, p.5]
@@ -1360,6 +1394,12 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
     //  At most one thread_limit clause can appear on the directive.
     // OpenMP [2.9.1, Restrictions, p. 2]
     //  At most one device clause can appear on the directive.
+    // OpenMP [2.9.2, Restrictions]
+    //  At most one grainsize clause can appear on the directive.
+    //  At most one num_tasks clause can appear on the directive.
+    //  At most one priority clause can appear on the directive.
+    // OpenMP [2.13.2, Restrictions]
+    //  At most one hint clause can appear on the directive.
     if (!FirstClause) {
       Diag(Tok, diag::err_omp_more_one_clause) << getOpenMPDirectiveName(DKind)
                                                << getOpenMPClauseName(CKind);
@@ -1406,12 +1446,20 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
   // same clause.
   case OMPC_inbranch:
   case OMPC_notinbranch:
-    Clause = ParseOpenMPClause(CKind);
+    // OpenMP [2.7.1, Loop construct, Syntax]
+    //  ordered[(n)]
+    if (CKind == OMPC_ordered && PP.LookAhead(0).is(tok::l_paren))
+      Clause = ParseOpenMPSingleExprClause(CKind);
+    else
+      Clause = ParseOpenMPClause(CKind);
     break;
   case OMPC_schedule:
   case OMPC_dist_schedule:
+  case OMPC_defaultmap:
     // OpenMP [2.7.1, Restrictions, p. 3]
     //  Only one schedule clause can appear on a loop directive.
+    // OpenMP [2.10.4, Restrictions, p. 3]
+    //  At most one defaultmap clause can appear on the directive.
     if (!FirstClause) {
       Diag(Tok, diag::err_omp_more_one_clause) << getOpenMPDirectiveName(DKind)
                                                << getOpenMPClauseName(CKind);
@@ -1426,6 +1474,8 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
   case OMPC_copyin:
   case OMPC_copyprivate:
   case OMPC_reduction:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
   case OMPC_depend:
   case OMPC_linear:
   case OMPC_aligned:
@@ -1433,6 +1483,7 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
   case OMPC_map:
   case OMPC_to:
   case OMPC_from:
+  case OMPC_is_device_ptr:
     Clause = ParseOpenMPVarListClause(CKind);
     break;
   case OMPC_flush:
@@ -1466,6 +1517,9 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
 ///    collapse-clause:
 ///      'collapse' '(' expression ')'
 ///
+///    ordered-clause:
+///      'ordered' '(' expression ')'
+///
 ///    safelen-clause:
 ///      'safelen' '(' expression ')'
 ///
@@ -1481,6 +1535,9 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
 ///    device-clause:
 ///      'device' '(' expression ')'
 ///
+///    hint-clause:
+///      'hint' '(' expression ')'
+///
 OMPClause *Parser::ParseOpenMPSingleExprClause(OpenMPClauseKind Kind) {
   SourceLocation Loc = Tok.getLocation();
   SourceLocation LOpen = ConsumeAnyToken();
@@ -1512,14 +1569,18 @@ OMPClause *Parser::ParseOpenMPSingleExprClause(OpenMPClauseKind Kind) {
 }
 
 /// \brief Parsing of OpenMP clauses with single expressions and some additional
-/// argument like 'schedule' or 'dist_schedule'.
+/// argument like 'schedule' or 'dist_schedule', or with a modifier and a kind
+/// like 'defaultmap'.
 ///
 ///    schedule-clause:
-///      'schedule' '(' kind [',' expression ] ')'
+///      'schedule' '(' [ modifier ':' ] kind [',' expression ] ')'
 ///
 ///    dist_schedule-clause:
 ///      'dist_schedule' '(' kind [',' expression] ')'
 ///
+///    defaultmap-clause:
+///      'defaultmap' '(' modifier ':' kind ')'
+///
 OMPClause *Parser::ParseOpenMPSingleExprWithTypeClause(OpenMPClauseKind Kind) {
   SourceLocation Loc = Tok.getLocation();
   SourceLocation LOpen = ConsumeAnyToken();
@@ -1533,12 +1594,44 @@ OMPClause *Parser::ParseOpenMPSingleExprWithTypeClause(OpenMPClauseKind Kind) {
   unsigned Type = Tok.isAnnotation()
                       ? 0
                       : getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok));
+  unsigned Modifier = Kind == OMPC_defaultmap
+                          ? (unsigned)OMPC_DEFAULTMAP_MODIFIER_unknown
+                          : (unsigned)OMPC_SCHEDULE_MODIFIER_unknown;
+  SourceLocation ModifierLoc;
+  if (Kind == OMPC_schedule && Type > OMPC_SCHEDULE_MODIFIER_unknown &&
+      Type < OMPC_SCHEDULE_MODIFIER_last && PP.LookAhead(0).is(tok::colon)) {
+    // Parse 'modifier :'.
+    Modifier = Type;
+    ModifierLoc = Tok.getLocation();
+    ConsumeAnyToken();
+    ConsumeAnyToken();
+    Type = Tok.isAnnotation()
+               ? 0
+               : getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok));
+  } else if (Kind == OMPC_defaultmap) {
+    // Parse 'modifier :', the modifier is not optional.
+    ModifierLoc = Tok.getLocation();
+    if (Type > OMPC_DEFAULTMAP_MODIFIER_unknown &&
+        Type < OMPC_DEFAULTMAP_MODIFIER_last)
+      Modifier = Type;
+    if (!Tok.isAnnotation() && PP.LookAhead(0).is(tok::colon)) {
+      ConsumeAnyToken();
+      ConsumeAnyToken();
+      Type = Tok.isAnnotation()
+                 ? 0
+                 : getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok));
+    }
+  }
+  if (Kind == OMPC_schedule && Type >= NUM_OPENMP_SCHEDULE_KINDS)
+    Type = OMPC_SCHEDULE_unknown;
+  if (Kind == OMPC_defaultmap && Type >= NUM_OPENMP_DEFAULTMAP_KINDS)
+    Type = OMPC_DEFAULTMAP_unknown;
   SourceLocation TypeLoc = Tok.getLocation();
   ExprResult Val = ExprError();
   if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
       Tok.isNot(tok::annot_pragma_openmp_end))
     ConsumeAnyToken();
-  if (Tok.is(tok::comma)) {
+  if (Kind != OMPC_defaultmap && Tok.is(tok::comma)) {
     ConsumeAnyToken();
     ExprResult LHS(ParseCastExpression(false, false, NotTypeCast));
     Val = ParseRHSOfBinaryExpression(LHS, prec::Conditional);
@@ -1554,7 +1647,8 @@ OMPClause *Parser::ParseOpenMPSingleExprWithTypeClause(OpenMPClauseKind Kind) {
     ConsumeAnyToken();
 
   return Actions.ActOnOpenMPSingleExprWithTypeClause(
-      Kind, Type, TypeLoc, Val.get(), Loc, Tok.getLocation());
+      Kind, Modifier, ModifierLoc, Type, TypeLoc, Val.get(), Loc,
+      Tok.getLocation());
 }
 
 /// \brief Parsing of simple OpenMP clauses like 'default' or 'proc_bind'.
@@ -1615,8 +1709,8 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPClauseKind Kind) {
 }
 
 /// \brief Parsing of OpenMP clause 'private', 'firstprivate',
-/// 'lastprivate', 'shared', 'copyin', 'reduction', 'flush',
-/// 'linear', 'aligned' or 'depend'.
+/// 'lastprivate', 'shared', 'copyin', 'reduction', 'task_reduction',
+/// 'in_reduction', 'flush', 'linear', 'aligned', 'depend' or 'is_device_ptr'.
 ///
 ///    private-clause:
 ///       'private' '(' list ')'
@@ -1639,6 +1733,12 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPClauseKind Kind) {
 ///    reduction-clause:
 ///       'reduction' '(' reduction-identifier ':' list ')'
 ///
+///    task_reduction-clause:
+///       'task_reduction' '(' reduction-identifier ':' list ')'
+///
+///    in_reduction-clause:
+///       'in_reduction' '(' reduction-identifier ':' list ')'
+///
 ///    depend-clause:
 ///       'depend' '(' dependence-type ':' list ')'
 ///
@@ -1660,6 +1760,9 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPClauseKind Kind) {
 ///    from-clause:
 ///       'from' '(' list ')'
 ///
+///    is_device_ptr-clause:
+///       'is_device_ptr' '(' list ')'
+///
 OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
   assert(Kind != OMPC_uniform);
   SourceLocation Loc = Tok.getLocation();
@@ -1674,11 +1777,13 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
     ConsumeAnyToken();
 
   unsigned Op = OMPC_REDUCTION_unknown;
-  // Parsing "reduction-identifier ':'" for reduction clause.
-  if (Kind == OMPC_reduction) {
+  bool IsReduction = Kind == OMPC_reduction || Kind == OMPC_task_reduction ||
+                     Kind == OMPC_in_reduction;
+  // Parsing "reduction-identifier ':'" for reduction clauses.
+  if (IsReduction) {
     Op = Tok.isAnnotation()
              ? (unsigned)OMPC_REDUCTION_unknown
-             : getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok));
+             : getOpenMPSimpleClauseType(OMPC_reduction, PP.getSpelling(Tok));
     switch (Op) {
     case OMPC_REDUCTION_add:
     case OMPC_REDUCTION_mult:
@@ -1691,7 +1796,8 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
     case OMPC_REDUCTION_min:
     case OMPC_REDUCTION_max:
       OpName.setIdentifier(
-          &Actions.Context.Idents.get(getOpenMPSimpleClauseTypeName(Kind, Op)),
+          &Actions.Context.Idents.get(
+              getOpenMPSimpleClauseTypeName(OMPC_reduction, Op)),
           Tok.getLocation());
       if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::annot_pragma_openmp_end)) {
         ConsumeAnyToken();
@@ -1727,6 +1833,8 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
     case OMPC_DEPEND_in:
     case OMPC_DEPEND_out:
     case OMPC_DEPEND_inout:
+    case OMPC_DEPEND_source:
+    case OMPC_DEPEND_sink:
       break;
     case OMPC_DEPEND_unknown:
       Diag(Tok, diag::err_omp_unknown_dependence_type);
@@ -1737,10 +1845,13 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
 
     if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::annot_pragma_openmp_end)) {
       ConsumeAnyToken();
-      if (Tok.isNot(tok::colon))
-        Diag(Tok, diag::err_omp_expected_colon) << getOpenMPClauseName(Kind);
-      else
-        ConsumeAnyToken();
+      // 'depend' '(' 'source' ')' has no list of items.
+      if (Op != OMPC_DEPEND_source) {
+        if (Tok.isNot(tok::colon))
+          Diag(Tok, diag::err_omp_expected_colon) << getOpenMPClauseName(Kind);
+        else
+          ConsumeAnyToken();
+      }
     }
   } else if (Kind == OMPC_map) {
     // Parsing "map-kind ':'" for map clause.
@@ -1773,8 +1884,9 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
   }
 
   SmallVector<Expr *, 4> Vars;
-  bool IsComma = (Kind != OMPC_reduction || Op != OMPC_REDUCTION_unknown) &&
-                 (Kind != OMPC_depend || Op != OMPC_DEPEND_unknown) &&
+  bool IsComma = (!IsReduction || Op != OMPC_REDUCTION_unknown) &&
+                 (Kind != OMPC_depend || (Op != OMPC_DEPEND_unknown &&
+                                          Op != OMPC_DEPEND_source)) &&
                  (Kind != OMPC_map || Op != OMPC_MAP_unknown);
   bool MayHaveTail = (Kind == OMPC_linear) || (Kind == OMPC_aligned);
   while (IsComma ||
@@ -1836,8 +1948,8 @@ OMPClause *Parser::ParseOpenMPVarListClause(OpenMPClauseKind Kind) {
   if (Tok.is(tok::r_paren))
     ConsumeAnyToken();
 
-  if (Vars.empty() ||
-      (Kind == OMPC_reduction && Op == OMPC_REDUCTION_unknown) ||
+  if ((Vars.empty() && (Kind != OMPC_depend || Op != OMPC_DEPEND_source)) ||
+      (IsReduction && Op == OMPC_REDUCTION_unknown) ||
       (Kind == OMPC_depend && Op == OMPC_DEPEND_unknown) ||
       (Kind == OMPC_map && Op == OMPC_MAP_unknown))
     return 0;
@@ -55,29 +55,39 @@ private:
   };
   typedef llvm::SmallDenseMap<VarDecl *, DSAInfo, 64> DeclSAMapTy;
   typedef llvm::SmallDenseMap<VarDecl *, MapInfo, 64> MappedDeclsTy;
+  struct TaskReductionInfo {
+    DeclRefExpr *RefExpr;
+    OpenMPReductionClauseOperator Op;
+  };
+  typedef llvm::SmallDenseMap<VarDecl *, TaskReductionInfo, 8>
+      TaskReductionMapTy;
 
   struct SharingMapTy {
     DeclSAMapTy SharingMap;
     DeclSAMapTy AlignedMap;
+    TaskReductionMapTy TaskReductionMap;
     MappedDeclsTy MappedDecls;
     DefaultDataSharingAttributes DefaultAttr;
     OpenMPDirectiveKind Directive;
     DeclarationNameInfo DirectiveName;
     bool IsOrdered;
+    bool IsDoacross;
+    unsigned DoacrossLoops;
     bool IsNowait;
     bool InCapturedRegion;
     Scope *CurScope;
     SharingMapTy(OpenMPDirectiveKind DKind, const DeclarationNameInfo &Name,
                  Scope *CurScope)
-        : SharingMap(), AlignedMap(), MappedDecls(),
+        : SharingMap(), AlignedMap(), TaskReductionMap(), MappedDecls(),
           DefaultAttr(DSA_unspecified), Directive(DKind), DirectiveName(Name),
-          IsOrdered(false), IsNowait(false), InCapturedRegion(false),
-          CurScope(CurScope) {}
+          IsOrdered(false), IsDoacross(false), DoacrossLoops(0),
+          IsNowait(false), InCapturedRegion(false), CurScope(CurScope) {}
     SharingMapTy()
-        : SharingMap(), AlignedMap(), MappedDecls(),
+        : SharingMap(), AlignedMap(), TaskReductionMap(), MappedDecls(),
           DefaultAttr(DSA_unspecified), Directive(OMPD_unknown),
-          DirectiveName(), IsOrdered(false), IsNowait(false),
-          InCapturedRegion(false),  CurScope(0) {}
+          DirectiveName(), IsOrdered(false), IsDoacross(false),
+          DoacrossLoops(0), IsNowait(false), InCapturedRegion(false),
+          CurScope(0) {}
   };
 
   typedef SmallVector<SharingMapTy, 4> StackTy;
@@ -92,6 +102,13 @@ private:
 
   DeclaredTargetDeclsTy DeclaredTargetDecls;
 
+  typedef llvm::DenseMap<const IdentifierInfo *,
+                         std::pair<OMPCriticalDirective *, uint64_t>>
+      CriticalsWithHintsTy;
+
+  /// \brief Named critical constructs and the values of their hints.
+  CriticalsWithHintsTy CriticalsWithHints;
+
   OpenMPClauseKind getDSA(StackTy::reverse_iterator Iter, VarDecl *D,
                           OpenMPDirectiveKind &Kind, DeclRefExpr *&E);
   /// \brief Checks if the variable is a local for OpenMP region.
@@ -114,6 +131,25 @@ public:
   /// if it already exists, returns false.
   bool addUniqueAligned(VarDecl *D, DeclRefExpr *&E);
 
+  /// \brief Adds unique 'task_reduction' declaration of a given VarDecl, or,
+  /// if it already exists, returns false.
+  bool addUniqueTaskReduction(VarDecl *D, DeclRefExpr *&E,
+                              OpenMPReductionClauseOperator Op);
+
+  /// \brief Returns true if \a D appears in a 'task_reduction' clause of an
+  /// enclosing 'taskgroup' region and sets \a Op to its reduction operator.
+  bool getTaskReduction(VarDecl *D, OpenMPReductionClauseOperator &Op);
+
+  /// \brief Remembers the hint of the first critical construct named \a Name,
+  /// or returns the first construct with this name and its hint.
+  std::pair<OMPCriticalDirective *, uint64_t>
+  addCriticalWithHint(const DeclarationNameInfo &Name, OMPCriticalDirective *D,
+                      uint64_t Hint) {
+    return CriticalsWithHints.insert(
+        std::make_pair(Name.getName().getAsIdentifierInfo(),
+                       std::make_pair(D, Hint))).first->second;
+  }
+
   /// \brief Adds explicit data sharing attribute to the specified declaration.
   void addDSA(VarDecl *D, DeclRefExpr *E, OpenMPClauseKind A);
 
@@ -171,6 +207,29 @@ public:
   /// \brief Marks current regions as ordered.
   void setRegionOrdered() { Stack.back().IsOrdered = true; }
 
+  /// \brief Returns true if parent region is a doacross loop region, i.e. a
+  /// loop region with 'ordered(n)' clause.
+  bool isParentRegionDoacross() const {
+    if (Stack.size() > 2)
+      return Stack[Stack.size() - 2].IsDoacross;
+    return false;
+  }
+
+  /// \brief Returns number of doacross loops of the parent region or 0 if it
+  /// is unknown.
+  unsigned getParentDoacrossLoops() const {
+    if (Stack.size() > 2)
+      return Stack[Stack.size() - 2].DoacrossLoops;
+    return 0;
+  }
+
+  /// \brief Marks current regions as doacross loop region with \a N loops
+  /// (0 if the number of loops is not known yet).
+  void setRegionDoacross(unsigned N) {
+    Stack.back().IsDoacross = true;
+    Stack.back().DoacrossLoops = N;
+  }
+
   /// \brief Returns true if region has nowait clause.
   bool isRegionNowait() const {
     if (Stack.size() > 1)
@@ -311,7 +370,9 @@ OpenMPClauseKind DSAStackTy::getDSA(StackTy::reverse_iterator Iter, VarDecl *D,
     //  In a task construct, if no default clause is present, a variable that in
     //  the enclosing context is determined to be shared by all implicit tasks
     //  bound to the current team is shared.
-    if (Kind == OMPD_task) {
+    if (Kind == OMPD_task || Kind == OMPD_taskloop ||
+        Kind == OMPD_taskloop_simd) {
+      OpenMPDirectiveKind TaskKind = Kind;
       OpenMPClauseKind CKind = OMPC_unknown;
       for (StackTy::reverse_iterator I = Iter + 1, EE = Stack.rend() - 1;
            I != EE; ++I) {
@@ -324,7 +385,7 @@ OpenMPClauseKind DSAStackTy::getDSA(StackTy::reverse_iterator Iter, VarDecl *D,
         CKind = getDSA(I, D, Kind, E);
         if (CKind != OMPC_shared) {
           E = 0;
-          Kind = OMPD_task;
+          Kind = TaskKind;
           return OMPC_firstprivate;
         }
         if (I->Directive == OMPD_parallel ||
@@ -339,7 +400,7 @@ OpenMPClauseKind DSAStackTy::getDSA(StackTy::reverse_iterator Iter, VarDecl *D,
             I->Directive == OMPD_target_teams_distribute_parallel_for_simd)
           break;
       }
-      Kind = OMPD_task;
+      Kind = TaskKind;
       return (CKind == OMPC_unknown) ? OMPC_firstprivate : OMPC_shared;
     }
   }
@@ -365,6 +426,37 @@ bool DSAStackTy::addUniqueAligned(VarDecl *D, DeclRefExpr *&E) {
   }
 }
 
+bool DSAStackTy::addUniqueTaskReduction(VarDecl *D, DeclRefExpr *&E,
+                                        OpenMPReductionClauseOperator Op) {
+  assert(Stack.size() > 1 && "Data sharing attributes stack is empty");
+  TaskReductionMapTy::iterator It = Stack.back().TaskReductionMap.find(D);
+  if (It == Stack.back().TaskReductionMap.end()) {
+    Stack.back().TaskReductionMap[D].RefExpr = E;
+    Stack.back().TaskReductionMap[D].Op = Op;
+    return true;
+  } else {
+    E = It->second.RefExpr;
+    return false;
+  }
+}
+
+bool DSAStackTy::getTaskReduction(VarDecl *D,
+                                  OpenMPReductionClauseOperator &Op) {
+  if (Stack.size() <= 2)
+    return false;
+  for (reverse_iterator I = Stack.rbegin() + 1, E = Stack.rend() - 1; I != E;
+       ++I) {
+    if (I->Directive != OMPD_taskgroup)
+      continue;
+    TaskReductionMapTy::iterator It = I->TaskReductionMap.find(D);
+    if (It != I->TaskReductionMap.end()) {
+      Op = It->second.Op;
+      return true;
+    }
+  }
+  return false;
+}
+
 void DSAStackTy::addDSA(VarDecl *D, DeclRefExpr *E, OpenMPClauseKind A) {
   if (A == OMPC_threadprivate) {
     Stack[0].SharingMap[D].Attributes = A;
@@ -397,7 +489,8 @@ bool DSAStackTy::isOpenMPLocal(VarDecl *D, StackTy::reverse_iterator Iter) {
            I->Directive != OMPD_teams_distribute_parallel_for_simd &&
            I->Directive != OMPD_target_teams_distribute_parallel_for &&
            I->Directive != OMPD_target_teams_distribute_parallel_for_simd &&
-           I->Directive != OMPD_task && I->Directive != OMPD_teams &&
+           I->Directive != OMPD_task && I->Directive != OMPD_taskloop &&
+           I->Directive != OMPD_taskloop_simd && I->Directive != OMPD_teams &&
            I->Directive != OMPD_target_teams &&
            I->Directive != OMPD_teams_distribute &&
            I->Directive != OMPD_teams_distribute_simd &&
@@ -449,7 +542,8 @@ OpenMPClauseKind DSAStackTy::getTopDSA(VarDecl *D, DeclRefExpr *&E) {
       Kind != OMPD_teams_distribute_parallel_for_simd &&
       Kind != OMPD_target_teams_distribute_parallel_for &&
       Kind != OMPD_target_teams_distribute_parallel_for_simd &&
-      Kind != OMPD_task && Kind != OMPD_teams &&
+      Kind != OMPD_task && Kind != OMPD_taskloop &&
+      Kind != OMPD_taskloop_simd && Kind != OMPD_teams &&
       Kind != OMPD_parallel_sections && Kind != OMPD_target_teams &&
       Kind != OMPD_teams_distribute && Kind != OMPD_teams_distribute_simd &&
       Kind != OMPD_target_teams_distribute &&
@@ -586,6 +680,7 @@ DeclContext *DSAStackTy::GetOpenMPFunctionRegion() {
         I->Directive == OMPD_target_teams_distribute_parallel_for ||
         I->Directive == OMPD_target_teams_distribute_parallel_for_simd ||
         I->Directive == OMPD_teams || I->Directive == OMPD_task ||
+        I->Directive == OMPD_taskloop || I->Directive == OMPD_taskloop_simd ||
         I->Directive == OMPD_parallel_sections ||
         I->Directive == OMPD_target_teams ||
         I->Directive == OMPD_teams_distribute ||
@@ -687,7 +782,8 @@ bool Sema::HasOpenMPSimdRegion() {
          HasOpenMPRegion(OMPD_teams_distribute_parallel_for_simd) ||
          HasOpenMPRegion(OMPD_target_teams_distribute_parallel_for_simd) ||
          HasOpenMPRegion(OMPD_teams_distribute_simd) ||
-         HasOpenMPRegion(OMPD_target_teams_distribute_simd);
+         HasOpenMPRegion(OMPD_target_teams_distribute_simd) ||
+         HasOpenMPRegion(OMPD_taskloop_simd);
 }
 
 bool Sema::IsDeclContextInOpenMPTarget(DeclContext *DC) {
@@ -1823,7 +1919,8 @@ public:
            DKind == OMPD_target_teams || DKind == OMPD_teams_distribute ||
            DKind == OMPD_teams_distribute_simd ||
            DKind == OMPD_target_teams_distribute ||
-           DKind == OMPD_target_teams_distribute_simd)) {
+           DKind == OMPD_target_teams_distribute_simd ||
+           DKind == OMPD_taskloop || DKind == OMPD_taskloop_simd)) {
         ErrorFound = true;
         Actions.Diag(ELoc, diag::err_omp_no_dsa_for_variable) << VD;
         return;
@@ -1833,7 +1930,8 @@ public:
       //  A list item that appears in a reduction clause of the innermost
       //  enclosing worksharing or parallel construct may not be accessed in an
       //  explicit task.
-      if (DKind == OMPD_task &&
+      if ((DKind == OMPD_task || DKind == OMPD_taskloop ||
+           DKind == OMPD_taskloop_simd) &&
           (Stack->hasInnermostDSA(VD, OMPC_reduction, OMPD_for, PrevRef) ||
            Stack->hasInnermostDSA(VD, OMPC_reduction, OMPD_for_simd, PrevRef) ||
            Stack->hasInnermostDSA(VD, OMPC_reduction, OMPD_sections, PrevRef) ||
@@ -1880,8 +1978,10 @@ public:
         }
         return;
       }
-      // Define implicit data-sharing attributes for task.
-      if (DKind == OMPD_task && Kind == OMPC_unknown) {
+      // Define implicit data-sharing attributes for task and taskloop.
+      if ((DKind == OMPD_task || DKind == OMPD_taskloop ||
+           DKind == OMPD_taskloop_simd) &&
+          Kind == OMPC_unknown) {
         Kind = Stack->getImplicitDSA(VD, DKind, PrevRef);
         if (Kind != OMPC_shared)
           ImplicitFirstprivate.push_back(E);
@@ -1990,6 +2090,7 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
       Region = "a worksharing";
       break;
     case OMPD_task:
+    case OMPD_taskloop:
       // Task region
       // OpenMP [2.16, Nesting of Regions, p. 1]
       //  A worksharing region may not be closely nested inside a worksharing,
@@ -2097,6 +2198,12 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
       NestingProhibited = true;
       Region = "a target teams distribute parallel for simd";
       break;
+    case OMPD_taskloop_simd:
+      // OpenMP [2.16, Nesting of Regions, p. 8]
+      //  OpenMP constructs may not be nested inside a simd region.
+      NestingProhibited = true;
+      Region = "a taskloop simd";
+      break;
     case OMPD_ordered:
       // OpenMP [2.16, Nesting of Regions, p. 1]
       //  A worksharing region may not be closely nested inside a worksharing,
@@ -2135,7 +2242,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
           Kind == OMPD_teams_distribute_parallel_for ||
           Kind == OMPD_teams_distribute_parallel_for_simd ||
           Kind == OMPD_target_teams_distribute_parallel_for ||
-          Kind == OMPD_target_teams_distribute_parallel_for_simd;
+          Kind == OMPD_target_teams_distribute_parallel_for_simd ||
+          Kind == OMPD_taskloop || Kind == OMPD_taskloop_simd;
       Region = "a teams";
       break;
     case OMPD_teams_distribute:
@@ -2190,7 +2298,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
           Kind == OMPD_teams_distribute_parallel_for ||
           Kind == OMPD_teams_distribute_parallel_for_simd ||
           Kind == OMPD_target_teams_distribute_parallel_for ||
-          Kind == OMPD_target_teams_distribute_parallel_for_simd;
+          Kind == OMPD_target_teams_distribute_parallel_for_simd ||
+          Kind == OMPD_taskloop || Kind == OMPD_taskloop_simd;
       Region = "a target teams";
       break;
     case OMPD_distribute:
@@ -2336,6 +2445,14 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
     Res =
         ActOnOpenMPTaskDirective(ClausesWithImplicit, AStmt, StartLoc, EndLoc);
     break;
+  case OMPD_taskloop:
+    Res = ActOnOpenMPTaskLoopDirective(Kind, ClausesWithImplicit, AStmt,
+                                       StartLoc, EndLoc);
+    break;
+  case OMPD_taskloop_simd:
+    Res = ActOnOpenMPTaskLoopSimdDirective(Kind, ClausesWithImplicit, AStmt,
+                                           StartLoc, EndLoc);
+    break;
   case OMPD_taskyield:
     assert(Clauses.empty() && !AStmt &&
            "Clauses and statement are not allowed for taskyield");
@@ -2346,8 +2463,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
     Res = ActOnOpenMPMasterDirective(AStmt, StartLoc, EndLoc);
     break;
   case OMPD_critical:
-    assert(Clauses.empty() && "Clauses are not allowed for critical");
-    Res = ActOnOpenMPCriticalDirective(DirName, AStmt, StartLoc, EndLoc);
+    Res = ActOnOpenMPCriticalDirective(DirName, Clauses, AStmt, StartLoc,
+                                       EndLoc);
     break;
   case OMPD_barrier:
     assert(Clauses.empty() && !AStmt &&
@@ -2360,8 +2477,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
     Res = ActOnOpenMPTaskwaitDirective(StartLoc, EndLoc);
     break;
   case OMPD_taskgroup:
-    assert(Clauses.empty() && "Clauses are not allowed for taskgroup");
-    Res = ActOnOpenMPTaskgroupDirective(AStmt, StartLoc, EndLoc);
+    Res = ActOnOpenMPTaskgroupDirective(ClausesWithImplicit, AStmt, StartLoc,
+                                        EndLoc);
     break;
   case OMPD_atomic:
     Res = ActOnOpenMPAtomicDirective(ClausesWithImplicit, AStmt, StartLoc,
@@ -2372,8 +2489,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
     Res = ActOnOpenMPFlushDirective(ClausesWithImplicit, StartLoc, EndLoc);
     break;
   case OMPD_ordered:
-    assert(Clauses.empty() && "Clauses are not allowed for ordered");
-    Res = ActOnOpenMPOrderedDirective(AStmt, StartLoc, EndLoc);
+    Res = ActOnOpenMPOrderedDirective(ClausesWithImplicit, AStmt, StartLoc,
+                                      EndLoc);
     break;
   case OMPD_simd:
     Res = ActOnOpenMPSimdDirective(Kind, ClausesWithImplicit, AStmt, StartLoc,
@@ -2496,6 +2613,8 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(
   case OMPD_target_enter_data:
   case OMPD_target_exit_data:
   case OMPD_task:
+  case OMPD_taskloop:
+  case OMPD_taskloop_simd:
     break;
   default: {
     assert(AStmt && isa<CapturedStmt>(AStmt) && "Captured statement expected");
@@ -2619,21 +2738,60 @@ bool Sema::CollapseOpenMPLoop(OpenMPDirectiveKind Kind,
   SmallVector<Expr *, 4> Inits;
   SmallVector<BinaryOperatorKind, 4> OpKinds;
   unsigned StmtCount = 1;
+  unsigned DoacrossCount = 0;
+  OMPOrderedClause *Doacross = 0;
+  OMPOrderedClause *Ordered = 0;
+  OMPScheduleClause *Nonmonotonic = 0;
   for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
        I != E; ++I) {
-    if (OMPCollapseClause *Clause = dyn_cast_or_null<OMPCollapseClause>(*I)) {
+    if (OMPScheduleClause *Clause = dyn_cast_or_null<OMPScheduleClause>(*I)) {
+      if (Clause->getScheduleModifier() == OMPC_SCHEDULE_MODIFIER_nonmonotonic)
+        Nonmonotonic = Clause;
+    } else if (OMPCollapseClause *Clause =
+                   dyn_cast_or_null<OMPCollapseClause>(*I)) {
       IntegerLiteral *IL = cast<IntegerLiteral>(Clause->getNumForLoops());
       StmtCount = IL->getValue().getLimitedValue();
-      break;
+    } else if (OMPOrderedClause *Clause =
+                   dyn_cast_or_null<OMPOrderedClause>(*I)) {
+      Ordered = Clause;
+      // OpenMP [2.7.1, Loop construct, Description]
+      //  The parameter of the ordered clause specifies the number of loops
+      //  of the doacross loop nest. Only the loops associated by the
+      //  collapse clause are distributed among the threads, the remaining
+      //  ones are run in full by each iteration of the collapsed nest.
+      if (Clause->getNumForLoops()) {
+        IntegerLiteral *IL = cast<IntegerLiteral>(Clause->getNumForLoops());
+        DoacrossCount = IL->getValue().getLimitedValue();
+        Doacross = Clause;
+      }
     }
   }
+  // OpenMP [2.7.1, Loop Construct, Restrictions]
+  //  If a schedule clause with the nonmonotonic modifier is specified, an
+  //  ordered clause must not appear on the same construct.
+  if (Nonmonotonic && Ordered) {
+    Diag(Nonmonotonic->getScheduleModifierLoc(),
+         diag::err_omp_schedule_nonmonotonic_ordered);
+    return false;
+  }
+  // OpenMP [2.7.1, Loop Construct, Restrictions]
+  //  If both the collapse and ordered clause with a parameter are specified,
+  //  the parameter of the ordered clause must be greater than or equal to the
+  //  parameter of the collapse clause.
+  if (Doacross && DoacrossCount < StmtCount) {
+    Diag(Doacross->getNumForLoops()->getExprLoc(),
+         diag::err_omp_ordered_less_than_collapse);
+    return false;
+  }
   Stmt *CStmt = AStmt;
   while (CapturedStmt *CS = dyn_cast_or_null<CapturedStmt>(CStmt))
     CStmt = CS->getCapturedStmt();
   while (AttributedStmt *AS = dyn_cast_or_null<AttributedStmt>(CStmt))
     CStmt = AS->getSubStmt();
   bool SkipExprCount = false;
-  for (unsigned Cnt = 0; Cnt < StmtCount; ++Cnt) {
+  Stmt *Body = 0;
+  for (unsigned Cnt = 0, E = std::max(StmtCount, DoacrossCount); Cnt < E;
+       ++Cnt) {
     Expr *NewEnd;
     Expr *NewIncr;
     Expr *Init;
@@ -2647,12 +2805,19 @@ bool Sema::CollapseOpenMPLoop(OpenMPDirectiveKind Kind,
         Init->getType()->isDependentType() ||
         VarCnt->getType()->isDependentType())
       SkipExprCount = true;
+    else if (Doacross && !VarCnt->getType()->isIntegerType()) {
+      Diag(VarCnt->getExprLoc(), diag::err_omp_doacross_counter_not_int)
+          << VarCnt->getSourceRange();
+      return false;
+    }
     Ends.push_back(NewEnd);
     Incrs.push_back(NewIncr);
     Inits.push_back(Init);
     VarCnts.push_back(VarCnt);
     OpKinds.push_back(OpKind);
     CStmt = cast<ForStmt>(CStmt)->getBody();
+    if (Cnt + 1 == StmtCount)
+      Body = CStmt;
     bool SkippedContainers = false;
     while (!SkippedContainers) {
       if (AttributedStmt *AS = dyn_cast_or_null<AttributedStmt>(CStmt))
@@ -2668,6 +2833,11 @@ bool Sema::CollapseOpenMPLoop(OpenMPDirectiveKind Kind,
     }
   }
 
+  // The doacross loops that are not collapsed are run as they are, only the
+  // collapsed loops are rewritten below.
+  SmallVector<Expr *, 4> DoacrossCnts(VarCnts.begin(), VarCnts.end());
+  VarCnts.resize(StmtCount);
+
   ForBreakStmtChecker Check;
   if (CStmt && Check.Visit(CStmt)) {
     Diag(Check.getBreak()->getLocStart(), diag::err_omp_for_cannot_break)
@@ -2681,10 +2851,11 @@ bool Sema::CollapseOpenMPLoop(OpenMPDirectiveKind Kind,
       Kind == OMPD_teams_distribute_simd ||
       Kind == OMPD_target_teams_distribute_simd ||
       Kind == OMPD_teams_distribute_parallel_for_simd ||
-      Kind == OMPD_target_teams_distribute_parallel_for_simd) {
+      Kind == OMPD_target_teams_distribute_parallel_for_simd ||
+      Kind == OMPD_taskloop_simd) {
     // OpenMP [2.8.1] No exception can be raised in the simd region.
     EhChecker Check;
-    if (CStmt && Check.Visit(CStmt)) {
+    if (Body && Check.Visit(Body)) {
       Diag(Check.getBadStmt()->getLocStart(), diag::err_omp_for_cannot_have_eh)
           << getOpenMPDirectiveName(Kind);
       return false;
@@ -2889,6 +3060,51 @@ bool Sema::CollapseOpenMPLoop(OpenMPDirectiveKind Kind,
     NewFinal = ActOnFinishFullExpr(NewFinal).get();
     NewVarCntExpr = ActOnFinishFullExpr(NewVarCntExpr).get();
     NewEnd = ActOnFinishFullExpr(NewEnd).get();
+
+    if (Doacross) {
+      // Build the iteration space of the doacross loop nest in terms of the
+      // original loop counters, including the loops that are not collapsed:
+      // lower bound is the initial value of the counter, upper bound is the
+      // value on the last iteration and the step is signed increment of the
+      // counter. All values are 64-bit as required by the runtime.
+      QualType Int64Ty = Context.getIntTypeForBitwidth(64, true);
+      SmallVector<Expr *, 4> Lowers;
+      SmallVector<Expr *, 4> Uppers;
+      SmallVector<Expr *, 4> Steps;
+      for (unsigned I = 0; I < DoacrossCount; ++I) {
+        Expr *Lower = Inits[I];
+        Expr *Upper = BuildBinOp(
+            DSAStack->getCurScope(), StartLoc, BO_Sub, Ends[I],
+            ActOnIntegerConstant(SourceLocation(), 1).get()).get();
+        if (!Upper)
+          return false;
+        Upper = BuildBinOp(DSAStack->getCurScope(), StartLoc, BO_Mul, Upper,
+                           Incrs[I]).get();
+        if (!Upper)
+          return false;
+        Upper = BuildBinOp(DSAStack->getCurScope(), StartLoc, OpKinds[I],
+                           Inits[I], Upper).get();
+        if (!Upper)
+          return false;
+        Expr *Step = Incrs[I];
+        if (OpKinds[I] == BO_Sub) {
+          Step = BuildUnaryOp(DSAStack->getCurScope(), StartLoc, UO_Minus,
+                              Step).get();
+          if (!Step)
+            return false;
+        }
+        Lower = PerformImplicitConversion(Lower, Int64Ty, AA_Converting).get();
+        Upper = PerformImplicitConversion(Upper, Int64Ty, AA_Converting).get();
+        Step = PerformImplicitConversion(Step, Int64Ty, AA_Converting).get();
+        if (!Lower || !Upper || !Step)
+          return false;
+        Lowers.push_back(ActOnFinishFullExpr(Lower).get());
+        Uppers.push_back(ActOnFinishFullExpr(Upper).get());
+        Steps.push_back(ActOnFinishFullExpr(Step).get());
+      }
+      DoacrossCnts.resize(DoacrossCount);
+      Doacross->setLoopData(Context, DoacrossCnts, Lowers, Uppers, Steps);
+    }
   }
   return true;
 }
@@ -3029,10 +3245,50 @@ Stmt *Sema::AddDistributedParallelArgsIntoCapturedStmt(CapturedStmt *Cap,
   return CapturedBody.get();
 }
 
+/// \brief Checks that the 'simdlen' and 'safelen' clauses of a simd-based
+/// directive agree with each other.
+static bool CheckSimdlenSafelenClauses(Sema &S,
+                                       ArrayRef<OMPClause *> Clauses) {
+  OMPSafelenClause *Safelen = 0;
+  OMPSimdlenClause *Simdlen = 0;
+  for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
+       I != E; ++I) {
+    if (!*I)
+      continue;
+    if (OMPSafelenClause *C = dyn_cast<OMPSafelenClause>(*I))
+      Safelen = C;
+    else if (OMPSimdlenClause *C = dyn_cast<OMPSimdlenClause>(*I))
+      Simdlen = C;
+  }
+  if (!Safelen || !Simdlen)
+    return true;
+  Expr *SafelenLen = Safelen->getSafelen();
+  Expr *SimdlenLen = Simdlen->getSimdlen();
+  if (!SafelenLen || !SimdlenLen || SafelenLen->isValueDependent() ||
+      SimdlenLen->isValueDependent())
+    return true;
+  // OpenMP [2.8.1, simd construct, Restrictions]
+  //  If both simdlen and safelen clauses are specified, the value of the
+  //  simdlen parameter must be less than or equal to the value of the safelen
+  //  parameter.
+  llvm::APSInt SafelenVal = SafelenLen->EvaluateKnownConstInt(S.Context);
+  llvm::APSInt SimdlenVal = SimdlenLen->EvaluateKnownConstInt(S.Context);
+  if (SimdlenVal.getZExtValue() > SafelenVal.getZExtValue()) {
+    S.Diag(SimdlenLen->getExprLoc(),
+           diag::err_omp_wrong_simdlen_safelen_values)
+        << SimdlenLen->getSourceRange() << SafelenLen->getSourceRange();
+    return false;
+  }
+  return true;
+}
+
 StmtResult Sema::ActOnOpenMPSimdDirective(OpenMPDirectiveKind Kind,
                                           ArrayRef<OMPClause *> Clauses,
                                           Stmt *AStmt, SourceLocation StartLoc,
                                           SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3063,6 +3319,9 @@ StmtResult Sema::ActOnOpenMPForSimdDirective(OpenMPDirectiveKind Kind,
                                              Stmt *AStmt,
                                              SourceLocation StartLoc,
                                              SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3091,6 +3350,9 @@ StmtResult Sema::ActOnOpenMPForSimdDirective(OpenMPDirectiveKind Kind,
 StmtResult Sema::ActOnOpenMPParallelForSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3119,6 +3381,9 @@ StmtResult Sema::ActOnOpenMPParallelForSimdDirective(
 StmtResult Sema::ActOnOpenMPDistributeSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3178,6 +3443,9 @@ StmtResult Sema::ActOnOpenMPDistributeParallelForDirective(
 StmtResult Sema::ActOnOpenMPDistributeParallelForSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3245,6 +3513,9 @@ StmtResult Sema::ActOnOpenMPTeamsDistributeParallelForDirective(
 StmtResult Sema::ActOnOpenMPTeamsDistributeParallelForSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3312,6 +3583,9 @@ StmtResult Sema::ActOnOpenMPTargetTeamsDistributeParallelForDirective(
 StmtResult Sema::ActOnOpenMPTargetTeamsDistributeParallelForSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -3459,6 +3733,143 @@ StmtResult Sema::ActOnOpenMPTaskDirective(ArrayRef<OMPClause *> Clauses,
   return OMPTaskDirective::Create(Context, StartLoc, EndLoc, Clauses, AStmt);
 }
 
+/// \brief Checks the clauses and the implicit data-sharing attributes of a
+/// taskloop-based directive after its loops have been collapsed. Loop counters
+/// are already private at this point, so only the remaining captured variables
+/// become implicitly firstprivate, as in a task region.
+static bool CheckTaskLoopClauses(Sema &S, DSAStackTy *Stack,
+                                 OpenMPDirectiveKind Kind,
+                                 ArrayRef<OMPClause *> Clauses,
+                                 CapturedStmt *CS,
+                                 SmallVectorImpl<OMPClause *> &NewClauses) {
+  // OpenMP [2.9.2, Restrictions]
+  //  The grainsize clause and num_tasks clause are mutually exclusive and may
+  //  not appear on the same taskloop directive.
+  OMPClause *Grainsize = 0;
+  OMPClause *NumTasks = 0;
+  for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
+       I != E; ++I) {
+    if (!*I)
+      continue;
+    if ((*I)->getClauseKind() == OMPC_grainsize)
+      Grainsize = *I;
+    else if ((*I)->getClauseKind() == OMPC_num_tasks)
+      NumTasks = *I;
+  }
+  if (Grainsize && NumTasks) {
+    OMPClause *Later =
+        S.getSourceManager().isBeforeInTranslationUnit(
+            Grainsize->getLocStart(), NumTasks->getLocStart())
+            ? NumTasks
+            : Grainsize;
+    OMPClause *Earlier = Later == NumTasks ? Grainsize : NumTasks;
+    S.Diag(Later->getLocStart(),
+           diag::err_omp_grainsize_num_tasks_mutually_exclusive)
+        << getOpenMPDirectiveName(Kind);
+    S.Diag(Earlier->getLocStart(), diag::note_omp_specified);
+    return false;
+  }
+
+  NewClauses.append(Clauses.begin(), Clauses.end());
+  // Check default data sharing attributes for captured variables.
+  DSAAttrChecker DSAChecker(Stack, S, CS);
+  DSAChecker.Visit(CS->getCapturedStmt());
+  if (DSAChecker.isErrorFound())
+    return false;
+  if (DSAChecker.getImplicitFirstprivate().size() > 0) {
+    OMPClause *Implicit = S.ActOnOpenMPFirstPrivateClause(
+        DSAChecker.getImplicitFirstprivate(), SourceLocation(),
+        SourceLocation());
+    if (!Implicit || cast<OMPFirstPrivateClause>(Implicit)->varlist_size() !=
+                         DSAChecker.getImplicitFirstprivate().size())
+      return false;
+    NewClauses.push_back(Implicit);
+  }
+  return true;
+}
+
+StmtResult Sema::ActOnOpenMPTaskLoopDirective(OpenMPDirectiveKind Kind,
+                                              ArrayRef<OMPClause *> Clauses,
+                                              Stmt *AStmt,
+                                              SourceLocation StartLoc,
+                                              SourceLocation EndLoc) {
+  // Prepare the output arguments for routine CollapseOpenMPLoop
+  Expr *NewEnd = 0;
+  Expr *NewVar = 0;
+  Expr *NewVarCntExpr = 0;
+  Expr *NewFinal = 0;
+  SmallVector<Expr *, 4> VarCnts;
+
+  // Do the collapse.
+  if (!CollapseOpenMPLoop(Kind, Clauses, AStmt, StartLoc, EndLoc, NewVar,
+                          NewEnd, NewVarCntExpr, NewFinal, VarCnts)) {
+    return StmtError();
+  }
+
+  SmallVector<OMPClause *, 8> ClausesWithImplicit;
+  if (!CheckTaskLoopClauses(*this, DSAStack, Kind, Clauses,
+                            cast<CapturedStmt>(AStmt), ClausesWithImplicit))
+    return StmtError();
+
+  getCurFunction()->setHasBranchProtectedScope();
+
+  // Create variables for lower/upper bound of the chunk executed by each task.
+  Expr *LowerBound = 0;
+  Expr *UpperBound = 0;
+  if (NewVar && AStmt) {
+    AStmt = AddDistributedParallelArgsIntoCapturedStmt(
+        cast<CapturedStmt>(AStmt), NewVar, LowerBound, UpperBound);
+  }
+  // Rebuild the directive.
+  return OMPTaskLoopDirective::Create(
+      Context, StartLoc, EndLoc, ClausesWithImplicit, AStmt, NewVar, NewEnd,
+      NewVarCntExpr, NewFinal, LowerBound, UpperBound, VarCnts);
+}
+
+StmtResult Sema::ActOnOpenMPTaskLoopSimdDirective(
+    OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
+    SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
+  // Prepare the output arguments for routine CollapseOpenMPLoop
+  Expr *NewEnd = 0;
+  Expr *NewVar = 0;
+  Expr *NewVarCntExpr = 0;
+  Expr *NewFinal = 0;
+  SmallVector<Expr *, 4> VarCnts;
+
+  // Do the collapse.
+  if (!CollapseOpenMPLoop(Kind, Clauses, AStmt, StartLoc, EndLoc, NewVar,
+                          NewEnd, NewVarCntExpr, NewFinal, VarCnts)) {
+    return StmtError();
+  }
+
+  SmallVector<OMPClause *, 8> ClausesWithImplicit;
+  if (!CheckTaskLoopClauses(*this, DSAStack, Kind, Clauses,
+                            cast<CapturedStmt>(AStmt), ClausesWithImplicit))
+    return StmtError();
+
+  getCurFunction()->setHasBranchProtectedScope();
+
+  // Create variables for lower/upper bound of the chunk executed by each task.
+  Expr *LowerBound = 0;
+  Expr *UpperBound = 0;
+  if (NewVar && AStmt) {
+    AStmt = AddDistributedParallelArgsIntoCapturedStmt(
+        cast<CapturedStmt>(AStmt), NewVar, LowerBound, UpperBound);
+  }
+
+  // Add two arguments into captured stmt for index and last_iter.
+  CapturedStmt *CapturedBody =
+      AddSimdArgsIntoCapturedStmt(cast<CapturedStmt>(AStmt), NewVar);
+
+  // Rebuild the directive.
+  return OMPTaskLoopSimdDirective::Create(
+      Context, StartLoc, EndLoc, ClausesWithImplicit, CapturedBody, NewVar,
+      NewEnd, NewVarCntExpr, NewFinal, LowerBound, UpperBound, VarCnts);
+}
+
 StmtResult Sema::ActOnOpenMPTaskyieldDirective(SourceLocation StartLoc,
                                                SourceLocation EndLoc) {
   getCurFunction()->setHasBranchProtectedScope();
@@ -3476,12 +3887,47 @@ StmtResult Sema::ActOnOpenMPMasterDirective(Stmt *AStmt,
 
 StmtResult
 Sema::ActOnOpenMPCriticalDirective(const DeclarationNameInfo &DirName,
+                                   ArrayRef<OMPClause *> Clauses,
                                    Stmt *AStmt, SourceLocation StartLoc,
                                    SourceLocation EndLoc) {
+  OMPHintClause *HintClause = 0;
+  for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
+       I != E; ++I)
+    if (OMPHintClause *C = dyn_cast_or_null<OMPHintClause>(*I))
+      HintClause = C;
+
+  // OpenMP [2.13.2, critical construct, Restrictions]
+  // If the hint clause is specified, the critical construct must have a name.
+  if (HintClause && !DirName.getName()) {
+    Diag(HintClause->getLocStart(), diag::err_omp_hint_clause_no_name);
+    return StmtError();
+  }
+
   getCurFunction()->setHasBranchProtectedScope();
 
-  return OMPCriticalDirective::Create(Context, DirName, StartLoc, EndLoc,
-                                      AStmt);
+  OMPCriticalDirective *Dir = OMPCriticalDirective::Create(
+      Context, DirName, StartLoc, EndLoc, Clauses, AStmt);
+
+  // OpenMP [2.13.2, critical construct, Restrictions]
+  // If the hint clause is specified, each of the critical constructs with the
+  // same name must have a hint clause with the same value. A construct without
+  // the clause has the hint omp_lock_hint_none.
+  Expr *Hint = HintClause ? HintClause->getHint() : 0;
+  if (DirName.getName() && (!Hint || !Hint->isValueDependent())) {
+    uint64_t Value = Hint ? Hint->EvaluateKnownConstInt(Context).getZExtValue()
+                          : 0;
+    std::pair<OMPCriticalDirective *, uint64_t> Prev =
+        DSAStack->addCriticalWithHint(DirName, Dir, Value);
+    if (Prev.second != Value) {
+      Diag(HintClause ? HintClause->getLocStart() : StartLoc,
+           diag::err_omp_critical_with_hint);
+      Diag(Prev.first->getLocStart(), diag::note_omp_critical_hint_here)
+          << static_cast<unsigned>(Prev.second);
+      return StmtError();
+    }
+  }
+
+  return Dir;
 }
 
 StmtResult Sema::ActOnOpenMPBarrierDirective(SourceLocation StartLoc,
@@ -3498,12 +3944,14 @@ StmtResult Sema::ActOnOpenMPTaskwaitDirective(SourceLocation StartLoc,
   return OMPTaskwaitDirective::Create(Context, StartLoc, EndLoc);
 }
 
-StmtResult Sema::ActOnOpenMPTaskgroupDirective(Stmt *AStmt,
+StmtResult Sema::ActOnOpenMPTaskgroupDirective(ArrayRef<OMPClause *> Clauses,
+                                               Stmt *AStmt,
                                                SourceLocation StartLoc,
                                                SourceLocation EndLoc) {
   getCurFunction()->setHasBranchProtectedScope();
 
-  return OMPTaskgroupDirective::Create(Context, StartLoc, EndLoc, AStmt);
+  return OMPTaskgroupDirective::Create(Context, StartLoc, EndLoc, Clauses,
+                                       AStmt);
 }
 
 namespace {
@@ -4065,12 +4513,29 @@ StmtResult Sema::ActOnOpenMPFlushDirective(ArrayRef<OMPClause *> Clauses,
   return OMPFlushDirective::Create(Context, StartLoc, EndLoc, Clauses);
 }
 
-StmtResult Sema::ActOnOpenMPOrderedDirective(Stmt *AStmt,
+StmtResult Sema::ActOnOpenMPOrderedDirective(ArrayRef<OMPClause *> Clauses,
+                                             Stmt *AStmt,
                                              SourceLocation StartLoc,
                                              SourceLocation EndLoc) {
+  // Only the stand-alone form (with 'depend' clause) has no statement.
+  bool HasDepend = !AStmt;
+  // OpenMP [2.13.8, ordered Construct, Restrictions]
+  //  An ordered construct with the depend clause must be closely nested inside
+  //  a loop construct with an ordered clause with a parameter, and an ordered
+  //  construct without the depend clause must not.
+  if (DSAStack->getParentDirective() != OMPD_unknown) {
+    if (HasDepend && !DSAStack->isParentRegionDoacross()) {
+      Diag(StartLoc, diag::err_omp_ordered_depend_not_doacross);
+      return StmtError();
+    }
+    if (!HasDepend && DSAStack->isParentRegionDoacross()) {
+      Diag(StartLoc, diag::err_omp_ordered_not_depend_in_doacross);
+      return StmtError();
+    }
+  }
   getCurFunction()->setHasBranchProtectedScope();
 
-  return OMPOrderedDirective::Create(Context, StartLoc, EndLoc, AStmt);
+  return OMPOrderedDirective::Create(Context, StartLoc, EndLoc, Clauses, AStmt);
 }
 
 StmtResult Sema::ActOnOpenMPTeamsDirective(ArrayRef<OMPClause *> Clauses,
@@ -4295,6 +4760,9 @@ Sema::ActOnOpenMPTeamsDistributeDirective(ArrayRef<OMPClause *> Clauses,
 StmtResult Sema::ActOnOpenMPTeamsDistributeSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -4346,6 +4814,9 @@ StmtResult Sema::ActOnOpenMPTargetTeamsDistributeDirective(
 StmtResult Sema::ActOnOpenMPTargetTeamsDistributeSimdDirective(
     OpenMPDirectiveKind Kind, ArrayRef<OMPClause *> Clauses, Stmt *AStmt,
     SourceLocation StartLoc, SourceLocation EndLoc) {
+  if (!CheckSimdlenSafelenClauses(*this, Clauses))
+    return StmtError();
+
   // Prepare the output arguments for routine CollapseOpenMPLoop
   Expr *NewEnd = 0;
   Expr *NewVar = 0;
@@ -4400,9 +4871,24 @@ OMPClause *Sema::ActOnOpenMPSingleExprClause(OpenMPClauseKind Kind, Expr *Expr,
   case OMPC_thread_limit:
     Res = ActOnOpenMPThreadLimitClause(Expr, StartLoc, EndLoc);
     break;
+  case OMPC_grainsize:
+    Res = ActOnOpenMPGrainsizeClause(Expr, StartLoc, EndLoc);
+    break;
+  case OMPC_num_tasks:
+    Res = ActOnOpenMPNumTasksClause(Expr, StartLoc, EndLoc);
+    break;
+  case OMPC_priority:
+    Res = ActOnOpenMPPriorityClause(Expr, StartLoc, EndLoc);
+    break;
+  case OMPC_hint:
+    Res = ActOnOpenMPHintClause(Expr, StartLoc, EndLoc);
+    break;
   case OMPC_device:
     Res = ActOnOpenMPDeviceClause(Expr, StartLoc, EndLoc);
     break;
+  case OMPC_ordered:
+    Res = ActOnOpenMPOrderedClause(StartLoc, EndLoc, Expr);
+    break;
   default:
     break;
   }
@@ -4822,6 +5308,192 @@ OMPClause *Sema::ActOnOpenMPThreadLimitClause(Expr *E, SourceLocation StartLoc,
   return new (Context) OMPThreadLimitClause(ValExpr, StartLoc, EndLoc);
 }
 
+namespace {
+/// \brief Diagnoses the contextual conversion to an integer of the argument
+/// of the 'grainsize', 'num_tasks' and 'priority' clauses.
+class TaskClauseConvertDiagnoser : public Sema::ICEConvertDiagnoser {
+public:
+  TaskClauseConvertDiagnoser() : ICEConvertDiagnoser(true, false, true) {}
+  virtual Sema::SemaDiagnosticBuilder diagnoseNotInt(Sema &S,
+                                                     SourceLocation Loc,
+                                                     QualType T) {
+    return S.Diag(Loc, diag::err_typecheck_statement_requires_integer) << T;
+  }
+  virtual Sema::SemaDiagnosticBuilder
+  diagnoseIncomplete(Sema &S, SourceLocation Loc, QualType T) {
+    return S.Diag(Loc, diag::err_incomplete_class_type) << T;
+  }
+  virtual Sema::SemaDiagnosticBuilder
+  diagnoseExplicitConv(Sema &S, SourceLocation Loc, QualType T,
+                       QualType ConvTy) {
+    return S.Diag(Loc, diag::err_explicit_conversion) << T << ConvTy;
+  }
+
+  virtual Sema::SemaDiagnosticBuilder
+  noteExplicitConv(Sema &S, CXXConversionDecl *Conv, QualType ConvTy) {
+    return S.Diag(Conv->getLocation(), diag::note_conversion)
+           << ConvTy->isEnumeralType() << ConvTy;
+  }
+  virtual Sema::SemaDiagnosticBuilder
+  diagnoseAmbiguous(Sema &S, SourceLocation Loc, QualType T) {
+    return S.Diag(Loc, diag::err_multiple_conversions) << T;
+  }
+
+  virtual Sema::SemaDiagnosticBuilder
+  noteAmbiguous(Sema &S, CXXConversionDecl *Conv, QualType ConvTy) {
+    return S.Diag(Conv->getLocation(), diag::note_conversion)
+           << ConvTy->isEnumeralType() << ConvTy;
+  }
+
+  virtual Sema::SemaDiagnosticBuilder
+  diagnoseConversion(Sema &S, SourceLocation Loc, QualType T,
+                     QualType ConvTy) {
+    llvm_unreachable("conversion functions are permitted");
+  }
+};
+}
+
+OMPClause *Sema::ActOnOpenMPGrainsizeClause(Expr *E, SourceLocation StartLoc,
+                                            SourceLocation EndLoc) {
+  TaskClauseConvertDiagnoser ConvertDiagnoser;
+
+  if (!E)
+    return 0;
+
+  Expr *ValExpr = E;
+  if (!ValExpr->isTypeDependent() && !ValExpr->isValueDependent() &&
+      !ValExpr->isInstantiationDependent()) {
+    SourceLocation Loc = ValExpr->getExprLoc();
+    ExprResult Value =
+        PerformContextualImplicitConversion(Loc, ValExpr, ConvertDiagnoser);
+    if (Value.isInvalid() ||
+        !Value.get()->getType()->isIntegralOrUnscopedEnumerationType())
+      return 0;
+
+    llvm::APSInt Result;
+    if (Value.get()->isIntegerConstantExpr(Result, Context) &&
+        !Result.isStrictlyPositive()) {
+      Diag(Loc, diag::err_negative_expression_in_clause)
+          << ValExpr->getSourceRange();
+      return 0;
+    }
+    Value = DefaultLvalueConversion(Value.get());
+    if (Value.isInvalid())
+      return 0;
+    Value = PerformImplicitConversion(
+        Value.get(), Context.getIntTypeForBitwidth(64, true), AA_Converting);
+    if (Value.isInvalid())
+      return 0;
+    ValExpr = Value.get();
+  }
+
+  return new (Context) OMPGrainsizeClause(ValExpr, StartLoc, EndLoc);
+}
+
+OMPClause *Sema::ActOnOpenMPNumTasksClause(Expr *E, SourceLocation StartLoc,
+                                           SourceLocation EndLoc) {
+  TaskClauseConvertDiagnoser ConvertDiagnoser;
+
+  if (!E)
+    return 0;
+
+  Expr *ValExpr = E;
+  if (!ValExpr->isTypeDependent() && !ValExpr->isValueDependent() &&
+      !ValExpr->isInstantiationDependent()) {
+    SourceLocation Loc = ValExpr->getExprLoc();
+    ExprResult Value =
+        PerformContextualImplicitConversion(Loc, ValExpr, ConvertDiagnoser);
+    if (Value.isInvalid() ||
+        !Value.get()->getType()->isIntegralOrUnscopedEnumerationType())
+      return 0;
+
+    llvm::APSInt Result;
+    if (Value.get()->isIntegerConstantExpr(Result, Context) &&
+        !Result.isStrictlyPositive()) {
+      Diag(Loc, diag::err_negative_expression_in_clause)
+          << ValExpr->getSourceRange();
+      return 0;
+    }
+    Value = DefaultLvalueConversion(Value.get());
+    if (Value.isInvalid())
+      return 0;
+    Value = PerformImplicitConversion(
+        Value.get(), Context.getIntTypeForBitwidth(64, true), AA_Converting);
+    if (Value.isInvalid())
+      return 0;
+    ValExpr = Value.get();
+  }
+
+  return new (Context) OMPNumTasksClause(ValExpr, StartLoc, EndLoc);
+}
+
+OMPClause *Sema::ActOnOpenMPPriorityClause(Expr *E, SourceLocation StartLoc,
+                                           SourceLocation EndLoc) {
+  TaskClauseConvertDiagnoser ConvertDiagnoser;
+
+  if (!E)
+    return 0;
+
+  Expr *ValExpr = E;
+  if (!ValExpr->isTypeDependent() && !ValExpr->isValueDependent() &&
+      !ValExpr->isInstantiationDependent()) {
+    SourceLocation Loc = ValExpr->getExprLoc();
+    ExprResult Value =
+        PerformContextualImplicitConversion(Loc, ValExpr, ConvertDiagnoser);
+    if (Value.isInvalid() ||
+        !Value.get()->getType()->isIntegralOrUnscopedEnumerationType())
+      return 0;
+
+    llvm::APSInt Result;
+    if (Value.get()->isIntegerConstantExpr(Result, Context) &&
+        Result.isNegative()) {
+      Diag(Loc, diag::err_nonnegative_expression_in_clause)
+          << ValExpr->getSourceRange();
+      return 0;
+    }
+    Value = DefaultLvalueConversion(Value.get());
+    if (Value.isInvalid())
+      return 0;
+    Value = PerformImplicitConversion(
+        Value.get(), Context.getIntTypeForBitwidth(32, true), AA_Converting);
+    if (Value.isInvalid())
+      return 0;
+    ValExpr = Value.get();
+  }
+
+  return new (Context) OMPPriorityClause(ValExpr, StartLoc, EndLoc);
+}
+
+OMPClause *Sema::ActOnOpenMPHintClause(Expr *Hint, SourceLocation StartLoc,
+                                       SourceLocation EndLoc) {
+  // OpenMP [2.13.2, critical construct, Restrictions]
+  // The hint-expression that is applied to the critical construct must be a
+  // constant integer expression and a valid synchronization hint.
+  if (!Hint)
+    return 0;
+  if (Hint->isInstantiationDependent())
+    return new (Context) OMPHintClause(Hint, StartLoc, EndLoc);
+  llvm::APSInt Result;
+  ExprResult ICE = VerifyIntegerConstantExpression(Hint, &Result);
+  if (ICE.isInvalid())
+    return 0;
+  if (Result.isNegative()) {
+    Diag(Hint->getExprLoc(), diag::err_nonnegative_expression_in_clause)
+        << Hint->getSourceRange();
+    return 0;
+  }
+  // omp_lock_hint_uncontended and omp_lock_hint_contended, as well as
+  // omp_lock_hint_speculative and omp_lock_hint_nonspeculative, are mutually
+  // exclusive.
+  uint64_t Value = Result.getLimitedValue();
+  if ((Value & 0x3) == 0x3 || (Value & 0xC) == 0xC) {
+    Diag(Hint->getExprLoc(), diag::err_omp_invalid_hint)
+        << Hint->getSourceRange();
+    return 0;
+  }
+  return new (Context) OMPHintClause(ICE.get(), StartLoc, EndLoc);
+}
+
 OMPClause *Sema::ActOnOpenMPSimpleClause(OpenMPClauseKind Kind,
                                          unsigned Argument,
                                          SourceLocation ArgumentLoc,
@@ -4960,9 +5632,23 @@ OMPClause *Sema::ActOnOpenMPClause(OpenMPClauseKind Kind,
 }
 
 OMPClause *Sema::ActOnOpenMPOrderedClause(SourceLocation StartLoc,
-                                          SourceLocation EndLoc) {
+                                          SourceLocation EndLoc,
+                                          Expr *NumForLoops) {
+  Expr *Val = 0;
+  if (NumForLoops) {
+    // OpenMP [2.7.1, Loop construct, Description]
+    // The parameter of the ordered clause must be a constant positive integer
+    // expression if any.
+    Val = ActOnConstantPositiveSubExpressionInClause(NumForLoops);
+    if (!Val)
+      return 0;
+    unsigned N = 0;
+    if (IntegerLiteral *IL = dyn_cast<IntegerLiteral>(Val))
+      N = IL->getValue().getZExtValue();
+    DSAStack->setRegionDoacross(N);
+  }
   DSAStack->setRegionOrdered();
-  return new (Context) OMPOrderedClause(StartLoc, EndLoc);
+  return new (Context) OMPOrderedClause(Val, StartLoc, EndLoc);
 }
 
 OMPClause *Sema::ActOnOpenMPNowaitClause(SourceLocation StartLoc,
@@ -4982,12 +5668,14 @@ OMPClause *Sema::ActOnOpenMPMergeableClause(SourceLocation StartLoc,
 }
 
 OMPClause *Sema::ActOnOpenMPSingleExprWithTypeClause(
-    OpenMPClauseKind Kind, unsigned Argument, SourceLocation ArgumentLoc,
-    Expr *Expr, SourceLocation StartLoc, SourceLocation EndLoc) {
+    OpenMPClauseKind Kind, unsigned Modifier, SourceLocation ModifierLoc,
+    unsigned Argument, SourceLocation ArgumentLoc, Expr *Expr,
+    SourceLocation StartLoc, SourceLocation EndLoc) {
   OMPClause *Res = 0;
   switch (Kind) {
   case OMPC_schedule:
     Res = ActOnOpenMPScheduleClause(
+        static_cast<OpenMPScheduleClauseModifier>(Modifier), ModifierLoc,
         static_cast<OpenMPScheduleClauseKind>(Argument), ArgumentLoc, Expr,
         StartLoc, EndLoc);
     break;
@@ -4996,17 +5684,22 @@ OMPClause *Sema::ActOnOpenMPSingleExprWithTypeClause(
         static_cast<OpenMPDistScheduleClauseKind>(Argument), ArgumentLoc, Expr,
         StartLoc, EndLoc);
     break;
+  case OMPC_defaultmap:
+    Res = ActOnOpenMPDefaultmapClause(
+        static_cast<OpenMPDefaultmapClauseModifier>(Modifier), ModifierLoc,
+        static_cast<OpenMPDefaultmapClauseKind>(Argument), ArgumentLoc,
+        StartLoc, EndLoc);
+    break;
   default:
     break;
   }
   return Res;
 }
 
-OMPClause *Sema::ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Kind,
-                                           SourceLocation KindLoc,
-                                           Expr *ChunkSize,
-                                           SourceLocation StartLoc,
-                                           SourceLocation EndLoc) {
+OMPClause *Sema::ActOnOpenMPScheduleClause(
+    OpenMPScheduleClauseModifier Modifier, SourceLocation ModifierLoc,
+    OpenMPScheduleClauseKind Kind, SourceLocation KindLoc, Expr *ChunkSize,
+    SourceLocation StartLoc, SourceLocation EndLoc) {
   class CConvertDiagnoser : public ICEConvertDiagnoser {
   public:
     CConvertDiagnoser() : ICEConvertDiagnoser(true, false, true) {}
@@ -5072,6 +5765,14 @@ OMPClause *Sema::ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Kind,
         << Values << getOpenMPClauseName(OMPC_schedule);
     return 0;
   }
+  // OpenMP [2.7.1, Loop Construct, Restrictions]
+  //  The nonmonotonic modifier can only be specified with schedule(dynamic)
+  //  or schedule(guided).
+  if (Modifier == OMPC_SCHEDULE_MODIFIER_nonmonotonic &&
+      Kind != OMPC_SCHEDULE_dynamic && Kind != OMPC_SCHEDULE_guided) {
+    Diag(ModifierLoc, diag::err_omp_schedule_nonmonotonic_static);
+    return 0;
+  }
   ExprResult Value;
   if (ChunkSize) {
     if (!ChunkSize->isTypeDependent() && !ChunkSize->isValueDependent() &&
@@ -5105,8 +5806,8 @@ OMPClause *Sema::ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Kind,
   }
   Expr *ValExpr = Value.get();
 
-  return new (Context)
-      OMPScheduleClause(Kind, KindLoc, ValExpr, StartLoc, EndLoc);
+  return new (Context) OMPScheduleClause(Modifier, ModifierLoc, Kind, KindLoc,
+                                         ValExpr, StartLoc, EndLoc);
 }
 
 OMPClause *Sema::ActOnOpenMPDistScheduleClause(
@@ -5190,6 +5891,35 @@ OMPClause *Sema::ActOnOpenMPDistScheduleClause(
       OMPDistScheduleClause(Kind, KindLoc, ValExpr, StartLoc, EndLoc);
 }
 
+OMPClause *Sema::ActOnOpenMPDefaultmapClause(
+    OpenMPDefaultmapClauseModifier Modifier, SourceLocation ModifierLoc,
+    OpenMPDefaultmapClauseKind Kind, SourceLocation KindLoc,
+    SourceLocation StartLoc, SourceLocation EndLoc) {
+  // OpenMP [2.10.4, target Construct, Syntax]
+  //  defaultmap(tofrom:scalar)
+  if (Modifier != OMPC_DEFAULTMAP_MODIFIER_tofrom) {
+    std::string Values = "'";
+    Values += getOpenMPSimpleClauseTypeName(OMPC_defaultmap,
+                                            OMPC_DEFAULTMAP_MODIFIER_tofrom);
+    Values += "'";
+    Diag(ModifierLoc, diag::err_omp_unexpected_clause_value)
+        << Values << getOpenMPClauseName(OMPC_defaultmap);
+    return 0;
+  }
+  if (Kind != OMPC_DEFAULTMAP_scalar) {
+    std::string Values = "'";
+    Values +=
+        getOpenMPSimpleClauseTypeName(OMPC_defaultmap, OMPC_DEFAULTMAP_scalar);
+    Values += "'";
+    Diag(KindLoc, diag::err_omp_unexpected_clause_value)
+        << Values << getOpenMPClauseName(OMPC_defaultmap);
+    return 0;
+  }
+
+  return new (Context)
+      OMPDefaultmapClause(Modifier, ModifierLoc, Kind, KindLoc, StartLoc, EndLoc);
+}
+
 OMPClause *Sema::ActOnOpenMPVarListClause(
     OpenMPClauseKind Kind, ArrayRef<Expr *> VarList, SourceLocation StartLoc,
     SourceLocation EndLoc, unsigned Op, Expr *TailExpr, CXXScopeSpec &SS,
@@ -5215,10 +5945,12 @@ OMPClause *Sema::ActOnOpenMPVarListClause(
     Res = ActOnOpenMPCopyPrivateClause(VarList, StartLoc, EndLoc);
     break;
   case OMPC_reduction:
+  case OMPC_task_reduction:
+  case OMPC_in_reduction:
     Res = ActOnOpenMPReductionClause(
         VarList, StartLoc, EndLoc,
         static_cast<OpenMPReductionClauseOperator>(Op), SS,
-        GetNameFromUnqualifiedId(OpName));
+        GetNameFromUnqualifiedId(OpName), Kind);
     break;
   case OMPC_flush:
     Res = ActOnOpenMPFlushClause(VarList, StartLoc, EndLoc);
@@ -5247,6 +5979,9 @@ OMPClause *Sema::ActOnOpenMPVarListClause(
   case OMPC_from:
     Res = ActOnOpenMPFromClause(VarList, StartLoc, EndLoc);
     break;
+  case OMPC_is_device_ptr:
+    Res = ActOnOpenMPIsDevicePtrClause(VarList, StartLoc, EndLoc);
+    break;
   default:
     break;
   }
@@ -5678,7 +6413,10 @@ OMPClause *Sema::ActOnOpenMPFirstPrivateClause(ArrayRef<Expr *> VarList,
         Kind != OMPC_lastprivate &&
         !(Kind == OMPC_shared && !PrevRef &&
           (IsConstant || VD->isStaticDataMember()))) {
-      if ((CurrDir != OMPD_task || PrevRef) && StartLoc.isValid() &&
+      if (((CurrDir != OMPD_task && CurrDir != OMPD_taskloop &&
+            CurrDir != OMPD_taskloop_simd) ||
+           PrevRef) &&
+          StartLoc.isValid() &&
           EndLoc.isValid()) {
         Diag(ELoc, diag::err_omp_wrong_dsa)
             << getOpenMPClauseName(Kind)
@@ -5716,7 +6454,8 @@ OMPClause *Sema::ActOnOpenMPFirstPrivateClause(ArrayRef<Expr *> VarList,
          (CurrDir == OMPD_for || CurrDir == OMPD_sections ||
           CurrDir == OMPD_for_simd || CurrDir == OMPD_distribute_simd ||
           CurrDir == OMPD_single || CurrDir == OMPD_distribute)) ||
-        (CurrDir == OMPD_task &&
+        ((CurrDir == OMPD_task || CurrDir == OMPD_taskloop ||
+          CurrDir == OMPD_taskloop_simd) &&
          DSAStack->hasDSA(VD, OMPC_reduction, OMPD_parallel, PrevRef))) {
       if (Kind == OMPC_unknown) {
         Diag(ELoc, diag::err_omp_required_access)
@@ -6559,7 +7298,8 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
                                             SourceLocation EndLoc,
                                             OpenMPReductionClauseOperator Op,
                                             CXXScopeSpec &SS,
-                                            DeclarationNameInfo OpName) {
+                                            DeclarationNameInfo OpName,
+                                            OpenMPClauseKind CKind) {
   BinaryOperatorKind NewOp = BO_Assign;
   switch (Op) {
   case OMPC_REDUCTION_add:
@@ -6645,7 +7385,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
       DSARefChecker Check(DSAStack);
       if (Check.Visit(VD->getInit())) {
         Diag(ELoc, diag::err_omp_reduction_ref_type_arg)
-            << getOpenMPClauseName(OMPC_reduction);
+            << getOpenMPClauseName(CKind);
         bool IsDecl = VD->isThisDeclarationADefinition(Context) ==
                       VarDecl::DeclarationOnly;
         Diag(VD->getLocation(),
@@ -6664,7 +7404,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
     Type = Type.getNonReferenceType().getCanonicalType();
     if (Type->isArrayType()) {
       Diag(ELoc, diag::err_omp_clause_array_type_arg)
-          << getOpenMPClauseName(OMPC_reduction);
+          << getOpenMPClauseName(CKind);
       bool IsDecl =
           VD->isThisDeclarationADefinition(Context) == VarDecl::DeclarationOnly;
       Diag(VD->getLocation(),
@@ -6678,7 +7418,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
     //  const-qualified.
     if (Type.isConstant(Context)) {
       Diag(ELoc, diag::err_omp_const_variable)
-          << getOpenMPClauseName(OMPC_reduction);
+          << getOpenMPClauseName(CKind);
       bool IsDecl =
           VD->isThisDeclarationADefinition(Context) == VarDecl::DeclarationOnly;
       Diag(VD->getLocation(),
@@ -6696,7 +7436,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
         (!getLangOpts().CPlusPlus && !Type->isScalarType() &&
          !Type->isDependentType())) {
       Diag(ELoc, diag::err_omp_clause_not_arithmetic_type_arg)
-          << getOpenMPClauseName(OMPC_reduction) << getLangOpts().CPlusPlus;
+          << getOpenMPClauseName(CKind) << getLangOpts().CPlusPlus;
       bool IsDecl =
           VD->isThisDeclarationADefinition(Context) == VarDecl::DeclarationOnly;
       Diag(VD->getLocation(),
@@ -6716,17 +7456,23 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
     //  Any number of reduction clauses can be specified on the directive,
     //  but a list item can appear only once in the reduction clauses for that
     //  directive.
-    DeclRefExpr *PrevRef;
+    DeclRefExpr *PrevRef = DE;
+    if (CKind == OMPC_task_reduction &&
+        !DSAStack->addUniqueTaskReduction(VD, PrevRef, Op)) {
+      Diag(ELoc, diag::err_omp_once_referenced) << getOpenMPClauseName(CKind);
+      Diag(PrevRef->getExprLoc(), diag::note_omp_referenced);
+      continue;
+    }
     OpenMPClauseKind Kind = DSAStack->getTopDSA(VD, PrevRef);
-    if (Kind == OMPC_reduction) {
+    if (Kind == CKind) {
       Diag(ELoc, diag::err_omp_once_referenced)
-          << getOpenMPClauseName(OMPC_reduction);
+          << getOpenMPClauseName(CKind);
       if (PrevRef) {
         Diag(PrevRef->getExprLoc(), diag::note_omp_referenced);
       }
     } else if (Kind != OMPC_unknown) {
       Diag(ELoc, diag::err_omp_wrong_dsa)
-          << getOpenMPClauseName(Kind) << getOpenMPClauseName(OMPC_reduction);
+          << getOpenMPClauseName(Kind) << getOpenMPClauseName(CKind);
       if (PrevRef) {
         Diag(PrevRef->getExprLoc(), diag::note_omp_explicit_dsa)
             << getOpenMPClauseName(Kind);
@@ -6750,15 +7496,15 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
          CurrDir == OMPD_for_simd)) {
       if (Kind == OMPC_unknown) {
         Diag(ELoc, diag::err_omp_required_access)
-            << getOpenMPClauseName(OMPC_reduction)
+            << getOpenMPClauseName(CKind)
             << getOpenMPClauseName(OMPC_shared);
       } else if (DKind == OMPD_unknown) {
         Diag(ELoc, diag::err_omp_wrong_dsa)
-            << getOpenMPClauseName(Kind) << getOpenMPClauseName(OMPC_reduction);
+            << getOpenMPClauseName(Kind) << getOpenMPClauseName(CKind);
       } else {
         Diag(ELoc, diag::err_omp_dsa_with_directives)
             << getOpenMPClauseName(Kind) << getOpenMPDirectiveName(DKind)
-            << getOpenMPClauseName(OMPC_reduction)
+            << getOpenMPClauseName(CKind)
             << getOpenMPDirectiveName(CurrDir);
       }
       if (PrevRef) {
@@ -6771,6 +7517,28 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
     QualType RedTy = DE->getType().getUnqualifiedType();
     OMPDeclareReductionDecl::ReductionData *DRRD =
         TryToFindDeclareReductionDecl(*this, SS, OpName, RedTy, Op);
+    // Task reductions are combined by the runtime through the generated
+    // helper functions only, user-defined reductions are not supported there.
+    if (CKind != OMPC_reduction && (DRRD || Op == OMPC_REDUCTION_custom)) {
+      Diag(ELoc, diag::err_omp_task_reduction_custom)
+          << getOpenMPClauseName(CKind);
+      continue;
+    }
+
+    // OpenMP [2.17.7, in_reduction clause, Restrictions]
+    //  A list item that appears in an in_reduction clause of a task construct
+    //  must appear in a task_reduction clause in a construct associated with
+    //  a taskgroup region that includes the participating task in its
+    //  taskgroup set. The construct must specify the same
+    //  reduction-identifier.
+    if (CKind == OMPC_in_reduction) {
+      OpenMPReductionClauseOperator TGOp = OMPC_REDUCTION_unknown;
+      if (!DSAStack->getTaskReduction(VD, TGOp) || TGOp != Op) {
+        Diag(ELoc, diag::err_omp_in_reduction_not_task_reduction)
+            << VD << DE->getSourceRange();
+        continue;
+      }
+    }
     if (Op == OMPC_REDUCTION_custom && !DRRD) {
       LookupResult Lookup(*this, OpName, LookupOMPDeclareReduction);
       if (DiagnoseEmptyLookup(
@@ -6887,7 +7655,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
                                    CD->getAccess(), PD) == AR_inaccessible ||
             CD->isDeleted()) {
           Diag(ELoc, diag::err_omp_required_method)
-              << getOpenMPClauseName(OMPC_reduction) << 0;
+              << getOpenMPClauseName(CKind) << 0;
           bool IsDecl = VD->isThisDeclarationADefinition(Context) ==
                         VarDecl::DeclarationOnly;
           Diag(VD->getLocation(),
@@ -6902,7 +7670,7 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
         if (DD && (CheckDestructorAccess(ELoc, DD, PD) == AR_inaccessible ||
                    DD->isDeleted())) {
           Diag(ELoc, diag::err_omp_required_method)
-              << getOpenMPClauseName(OMPC_reduction) << 4;
+              << getOpenMPClauseName(CKind) << 4;
           bool IsDecl = VD->isThisDeclarationADefinition(Context) ==
                         VarDecl::DeclarationOnly;
           Diag(VD->getLocation(),
@@ -6956,12 +7724,23 @@ OMPClause *Sema::ActOnOpenMPReductionClause(ArrayRef<Expr *> VarList,
       HelperParams1.push_back(PtrDE1Expr);
       HelperParams2.push_back(PtrDE2Expr);
     }
-    DSAStack->addDSA(VD, DE, OMPC_reduction);
+    // Items of 'task_reduction' stay shared in the taskgroup region, so they
+    // are recorded separately from its data-sharing attributes.
+    if (CKind != OMPC_task_reduction)
+      DSAStack->addDSA(VD, DE, CKind);
   }
 
   if (Vars.empty())
     return 0;
 
+  if (CKind == OMPC_task_reduction)
+    return OMPTaskReductionClause::Create(
+        Context, StartLoc, EndLoc, Vars, OpExprs, HelperParams1, HelperParams2,
+        DefaultInits, Op, SS.getWithLocInContext(Context), OpName);
+  if (CKind == OMPC_in_reduction)
+    return OMPInReductionClause::Create(
+        Context, StartLoc, EndLoc, Vars, OpExprs, HelperParams1, HelperParams2,
+        DefaultInits, Op, SS.getWithLocInContext(Context), OpName);
   return OMPReductionClause::Create(
       Context, StartLoc, EndLoc, Vars, OpExprs, HelperParams1, HelperParams2,
       DefaultInits, Op, SS.getWithLocInContext(Context), OpName);
@@ -7082,6 +7861,65 @@ OMPClause *Sema::ActOnOpenMPDependClause(ArrayRef<Expr *> VarList,
   SmallVector<Expr *, 4> Vars;
   SmallVector<Expr *, 4> Begins;
   SmallVector<Expr *, 4> SizeInBytes;
+  if (Ty == OMPC_DEPEND_source || Ty == OMPC_DEPEND_sink) {
+    // OpenMP [2.13.8, ordered Construct, Syntax]
+    //  depend(source) and depend(sink : vec) clauses can appear only on the
+    //  stand-alone ordered construct.
+    if (DSAStack->getCurrentDirective() != OMPD_ordered) {
+      Diag(StartLoc, diag::err_omp_depend_source_sink_not_ordered)
+          << (Ty == OMPC_DEPEND_sink);
+      return 0;
+    }
+    if (Ty == OMPC_DEPEND_source)
+      return OMPDependClause::Create(Context, StartLoc, EndLoc, Vars, Begins,
+                                     SizeInBytes, Ty, TyLoc);
+    // OpenMP [2.13.8, ordered Construct, Description]
+    //  The sink vector must have exactly one expression per doacross loop.
+    unsigned NumLoops = DSAStack->getParentDoacrossLoops();
+    if (NumLoops > 0 && NumLoops != VarList.size()) {
+      Diag(StartLoc, diag::err_omp_depend_sink_wrong_vec) << NumLoops;
+      return 0;
+    }
+    // Each element of the sink vector is converted to the 64-bit iteration
+    // value expected by the runtime and stored as the 'begin' of the item.
+    for (ArrayRef<Expr *>::iterator I = VarList.begin(), E = VarList.end();
+         I != E; ++I) {
+      assert(*I && "Null expr in omp depend");
+      if ((*I)->isValueDependent() || (*I)->isTypeDependent() ||
+          (*I)->isInstantiationDependent()) {
+        // It will be analyzed later.
+        Vars.push_back(*I);
+        Begins.push_back(0);
+        SizeInBytes.push_back(0);
+        continue;
+      }
+      if (!(*I)->getType()->isIntegralOrUnscopedEnumerationType()) {
+        Diag((*I)->getExprLoc(), diag::err_omp_depend_sink_expected_int)
+            << (*I)->getSourceRange();
+        continue;
+      }
+      ExprResult Value = DefaultLvalueConversion(*I);
+      if (Value.isInvalid())
+        continue;
+      Value = PerformImplicitConversion(
+          Value.get(), Context.getIntTypeForBitwidth(64, true), AA_Converting);
+      if (Value.isInvalid())
+        continue;
+      Vars.push_back(*I);
+      Begins.push_back(Value.get());
+      SizeInBytes.push_back(0);
+    }
+    if (Vars.size() != VarList.size())
+      return 0;
+    return OMPDependClause::Create(Context, StartLoc, EndLoc, Vars, Begins,
+                                   SizeInBytes, Ty, TyLoc);
+  }
+  // OpenMP [2.13.8, ordered Construct, Syntax]
+  //  Only depend(source) and depend(sink : vec) are allowed on ordered.
+  if (DSAStack->getCurrentDirective() == OMPD_ordered) {
+    Diag(StartLoc, diag::err_omp_ordered_depend_type);
+    return 0;
+  }
   for (ArrayRef<Expr *>::iterator I = VarList.begin(), E = VarList.end();
        I != E; ++I) {
     assert(*I && "Null expr in omp depend");
@@ -7676,6 +8514,78 @@ OMPClause *Sema::ActOnOpenMPFromClause(ArrayRef<Expr *> VarList,
                                WholeEnds, CopyBegins, CopyEnds);
 }
 
+OMPClause *Sema::ActOnOpenMPIsDevicePtrClause(ArrayRef<Expr *> VarList,
+                                              SourceLocation StartLoc,
+                                              SourceLocation EndLoc) {
+  SmallVector<Expr *, 4> Vars;
+  for (ArrayRef<Expr *>::iterator I = VarList.begin(), E = VarList.end();
+       I != E; ++I) {
+    assert(*I && "Null expr in omp is_device_ptr");
+    if (isa<DependentScopeDeclRefExpr>(*I)) {
+      // It will be analyzed later.
+      Vars.push_back(*I);
+      continue;
+    }
+
+    SourceLocation ELoc = (*I)->getExprLoc();
+    // OpenMP [2.1, C/C++]
+    //  A list item is a variable name.
+    DeclRefExpr *DE = dyn_cast_or_null<DeclRefExpr>(*I);
+    if (!DE || !isa<VarDecl>(DE->getDecl())) {
+      Diag(ELoc, diag::err_omp_expected_var_name) << (*I)->getSourceRange();
+      continue;
+    }
+    VarDecl *VD = cast<VarDecl>(DE->getDecl());
+
+    QualType Type = VD->getType();
+    if (Type->isDependentType() || Type->isInstantiationDependentType()) {
+      // It will be analyzed later.
+      Vars.push_back(*I);
+      continue;
+    }
+
+    // OpenMP [2.10.4, Restrictions, C/C++]
+    //  A list item that appears in an is_device_ptr clause must have a type
+    //  of pointer.
+    if (!Type->isPointerType()) {
+      Diag(ELoc, diag::err_omp_expected_pointer_var)
+          << getOpenMPClauseName(OMPC_is_device_ptr)
+          << (*I)->getSourceRange();
+      continue;
+    }
+
+    // threadprivate variables cannot appear in a target construct.
+    DeclRefExpr *DRE = 0;
+    if (DSAStack->IsThreadprivate(VD, DRE)) {
+      SourceLocation Loc = DRE ? DRE->getLocation() : VD->getLocation();
+      Diag(Loc, diag::err_omp_threadprivate_in_target);
+      Diag(DE->getLocStart(), diag::note_used_here) << DE->getSourceRange();
+      continue;
+    }
+
+    // The pointer is already a device address, it cannot also be mapped by
+    // the same construct.
+    DSAStackTy::MapInfo MI = DSAStack->IsMappedInCurrentRegion(VD);
+    if (MI.RefExpr) {
+      Diag(DE->getExprLoc(), diag::err_omp_map_shared_storage)
+          << DE->getSourceRange();
+      Diag(MI.RefExpr->getExprLoc(), diag::note_used_here)
+          << MI.RefExpr->getSourceRange();
+      continue;
+    }
+
+    Vars.push_back(DE);
+    MI.RefExpr = DE;
+    MI.IsCEAN = false;
+    DSAStack->addMapInfoForVar(VD, MI);
+  }
+
+  if (Vars.empty())
+    return 0;
+
+  return OMPIsDevicePtrClause::Create(Context, StartLoc, EndLoc, Vars);
+}
+
 OMPClause *Sema::ActOnOpenMPLinearClause(ArrayRef<Expr *> VarList,
                                          SourceLocation StartLoc,
                                          SourceLocation EndLoc, Expr *Step,
@@ -8253,7 +9163,8 @@ bool Sema::isNotOpenMPCanonicalLoopForm(Stmt *S, OpenMPDirectiveKind Kind,
               CurrentDir == OMPD_teams_distribute ||
               CurrentDir == OMPD_target_teams_distribute ||
               CurrentDir == OMPD_teams_distribute_parallel_for ||
-              CurrentDir == OMPD_target_teams_distribute_parallel_for)) {
+              CurrentDir == OMPD_target_teams_distribute_parallel_for ||
+              CurrentDir == OMPD_taskloop)) {
     Diag(InitLoc, diag::err_omp_for_loop_var_dsa) << getOpenMPClauseName(CKind);
     if (PrevRef) {
       Diag(PrevRef->getExprLoc(), diag::note_omp_explicit_dsa)
@@ -8272,7 +9183,8 @@ bool Sema::isNotOpenMPCanonicalLoopForm(Stmt *S, OpenMPDirectiveKind Kind,
               CurrentDir == OMPD_target_teams_distribute_parallel_for_simd ||
               CurrentDir == OMPD_distribute_simd ||
               CurrentDir == OMPD_teams_distribute_simd ||
-              CurrentDir == OMPD_target_teams_distribute_simd)) {
+              CurrentDir == OMPD_target_teams_distribute_simd ||
+              CurrentDir == OMPD_taskloop_simd)) {
     // OpenMP [2.11.1.1, Data-sharing Attribute Rules for Variables Referenced
     // in a Construct, C/C++]
     // The loop iteration variable in the associated for-loop of a simd
@@ -1430,13 +1430,16 @@ public:
   ///
   /// By default, performs semantic analysis to build the new statement.
   /// Subclasses may override this routine to provide different behavior.
-  OMPClause *RebuildOMPScheduleClause(OpenMPScheduleClauseKind Kind,
+  OMPClause *RebuildOMPScheduleClause(OpenMPScheduleClauseModifier Modifier,
+                                      SourceLocation ModifierLoc,
+                                      OpenMPScheduleClauseKind Kind,
                                       SourceLocation KindLoc,
                                       Expr *ChunkSize,
                                       SourceLocation StartLoc,
                                       SourceLocation EndLoc) {
-    return getSema().ActOnOpenMPScheduleClause(Kind, KindLoc, ChunkSize,
-                                               StartLoc, EndLoc);
+    return getSema().ActOnOpenMPScheduleClause(Modifier, ModifierLoc, Kind,
+                                               KindLoc, ChunkSize, StartLoc,
+                                               EndLoc);
   }
 
   /// \brief Build a new OpenMP 'dist_schedule' clause.
@@ -1546,7 +1549,8 @@ public:
                                                   StartLoc, EndLoc);
   }
 
-  /// \brief Build a new OpenMP 'reduction' clause.
+  /// \brief Build a new OpenMP 'reduction', 'task_reduction' or
+  /// 'in_reduction' clause.
   ///
   /// By default, performs semantic analysis to build the new statement.
   /// Subclasses may override this routine to provide different behavior.
@@ -1555,10 +1559,11 @@ public:
                                        SourceLocation EndLoc,
                                        OpenMPReductionClauseOperator Op,
                                        CXXScopeSpec &SS,
-                                       DeclarationNameInfo OpName) {
+                                       DeclarationNameInfo OpName,
+                                       OpenMPClauseKind CKind = OMPC_reduction) {
     return getSema().ActOnOpenMPReductionClause(VarList,
                                                 StartLoc, EndLoc, Op,
-                                                SS, OpName);
+                                                SS, OpName, CKind);
   }
 
   /// \brief Build a new OpenMP 'depend' clause.
@@ -1611,9 +1616,10 @@ public:
   ///
   /// By default, performs semantic analysis to build the new statement.
   /// Subclasses may override this routine to provide different behavior.
-  OMPClause *RebuildOMPOrderedClause(SourceLocation StartLoc,
+  OMPClause *RebuildOMPOrderedClause(Expr *NumForLoops,
+                                     SourceLocation StartLoc,
                                      SourceLocation EndLoc) {
-    return getSema().ActOnOpenMPOrderedClause(StartLoc, EndLoc);
+    return getSema().ActOnOpenMPOrderedClause(StartLoc, EndLoc, NumForLoops);
   }
 
   /// \brief Build a new OpenMP 'nowait' clause.
@@ -1767,6 +1773,67 @@ public:
                                                   StartLoc, EndLoc);
   }
 
+  /// \brief Build a new OpenMP 'grainsize' clause.
+  ///
+  /// By default, performs semantic analysis to build the new statement.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPGrainsizeClause(Expr *Grainsize,
+                                       SourceLocation StartLoc,
+                                       SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPGrainsizeClause(Grainsize, StartLoc, EndLoc);
+  }
+
+  /// \brief Build a new OpenMP 'num_tasks' clause.
+  ///
+  /// By default, performs semantic analysis to build the new statement.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPNumTasksClause(Expr *NumTasks, SourceLocation StartLoc,
+                                      SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPNumTasksClause(NumTasks, StartLoc, EndLoc);
+  }
+
+  /// \brief Build a new OpenMP 'priority' clause.
+  ///
+  /// By default, performs semantic analysis to build the new statement.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPPriorityClause(Expr *Priority, SourceLocation StartLoc,
+                                      SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPPriorityClause(Priority, StartLoc, EndLoc);
+  }
+
+  /// \brief Build a new OpenMP 'hint' clause.
+  ///
+  /// By default, performs semantic analysis to build the new statement.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPHintClause(Expr *Hint, SourceLocation StartLoc,
+                                  SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPHintClause(Hint, StartLoc, EndLoc);
+  }
+
+  /// \brief Build a new OpenMP 'is_device_ptr' clause.
+  ///
+  /// By default, performs semantic analysis to build the new OpenMP clause.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPIsDevicePtrClause(ArrayRef<Expr *> VarList,
+                                         SourceLocation StartLoc,
+                                         SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPIsDevicePtrClause(VarList, StartLoc, EndLoc);
+  }
+
+  /// \brief Build a new OpenMP 'defaultmap' clause.
+  ///
+  /// By default, performs semantic analysis to build the new OpenMP clause.
+  /// Subclasses may override this routine to provide different behavior.
+  OMPClause *RebuildOMPDefaultmapClause(OpenMPDefaultmapClauseModifier Modifier,
+                                        SourceLocation ModifierLoc,
+                                        OpenMPDefaultmapClauseKind Kind,
+                                        SourceLocation KindLoc,
+                                        SourceLocation StartLoc,
+                                        SourceLocation EndLoc) {
+    return getSema().ActOnOpenMPDefaultmapClause(Modifier, ModifierLoc, Kind,
+                                                 KindLoc, StartLoc, EndLoc);
+  }
+
   /// \brief Build a new OpenMP 'linear' clause.
   ///
   /// By default, performs semantic analysis to build the new statement.
@@ -7369,6 +7436,26 @@ TreeTransform<Derived>::TransformOMPTaskDirective(OMPTaskDirective *D) {
   return Res;
 }
 
+template <typename Derived>
+StmtResult
+TreeTransform<Derived>::TransformOMPTaskLoopDirective(OMPTaskLoopDirective *D) {
+  DeclarationNameInfo DirName;
+  getDerived().getSema().StartOpenMPDSABlock(OMPD_taskloop, DirName, 0);
+  StmtResult Res = getDerived().TransformOMPExecutableDirective(D);
+  getDerived().getSema().EndOpenMPDSABlock(Res.get());
+  return Res;
+}
+
+template <typename Derived>
+StmtResult TreeTransform<Derived>::TransformOMPTaskLoopSimdDirective(
+    OMPTaskLoopSimdDirective *D) {
+  DeclarationNameInfo DirName;
+  getDerived().getSema().StartOpenMPDSABlock(OMPD_taskloop_simd, DirName, 0);
+  StmtResult Res = getDerived().TransformOMPExecutableDirective(D);
+  getDerived().getSema().EndOpenMPDSABlock(Res.get());
+  return Res;
+}
+
 template <typename Derived>
 StmtResult TreeTransform<Derived>::TransformOMPTaskyieldDirective(
     OMPTaskyieldDirective *D) {
@@ -7697,6 +7784,7 @@ TreeTransform<Derived>::TransformOMPScheduleClause(OMPScheduleClause *C) {
   }
 
   return getDerived().RebuildOMPScheduleClause(
+      C->getScheduleModifier(), C->getScheduleModifierLoc(),
       C->getScheduleKind(), C->getScheduleKindLoc(), E.get(), C->getLocStart(),
       C->getLocEnd());
 }
@@ -7838,7 +7926,20 @@ TreeTransform<Derived>::TransformOMPReductionClause(OMPReductionClause *C) {
   DeclarationNameInfo DNI =
       getDerived().TransformDeclarationNameInfo(C->getOpName());
   return getDerived().RebuildOMPReductionClause(
-      Vars, C->getLocStart(), C->getLocEnd(), C->getOperator(), SS, DNI);
+      Vars, C->getLocStart(), C->getLocEnd(), C->getOperator(), SS, DNI,
+      C->getClauseKind());
+}
+
+template <typename Derived>
+OMPClause *TreeTransform<Derived>::TransformOMPTaskReductionClause(
+    OMPTaskReductionClause *C) {
+  return getDerived().TransformOMPReductionClause(C);
+}
+
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPInReductionClause(OMPInReductionClause *C) {
+  return getDerived().TransformOMPReductionClause(C);
 }
 
 template <typename Derived>
@@ -7909,7 +8010,15 @@ OMPClause *TreeTransform<Derived>::TransformOMPFromClause(OMPFromClause *C) {
 template <typename Derived>
 OMPClause *
 TreeTransform<Derived>::TransformOMPOrderedClause(OMPOrderedClause *C) {
-  return getDerived().RebuildOMPOrderedClause(C->getLocStart(), C->getLocEnd());
+  Expr *NumForLoops = 0;
+  if (C->getNumForLoops()) {
+    ExprResult E = getDerived().TransformExpr(C->getNumForLoops());
+    if (E.isInvalid())
+      return 0;
+    NumForLoops = E.get();
+  }
+  return getDerived().RebuildOMPOrderedClause(NumForLoops, C->getLocStart(),
+                                              C->getLocEnd());
 }
 
 template <typename Derived>
@@ -8058,6 +8167,83 @@ TreeTransform<Derived>::TransformOMPThreadLimitClause(OMPThreadLimitClause *C) {
                                                   C->getLocEnd());
 }
 
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPGrainsizeClause(OMPGrainsizeClause *C) {
+  // Transform the grainsize expression.
+  ExprResult E = getDerived().TransformExpr(C->getGrainsize());
+
+  if (E.isInvalid())
+    return 0;
+
+  return getDerived().RebuildOMPGrainsizeClause(E.get(), C->getLocStart(),
+                                                C->getLocEnd());
+}
+
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPNumTasksClause(OMPNumTasksClause *C) {
+  // Transform the num_tasks expression.
+  ExprResult E = getDerived().TransformExpr(C->getNumTasks());
+
+  if (E.isInvalid())
+    return 0;
+
+  return getDerived().RebuildOMPNumTasksClause(E.get(), C->getLocStart(),
+                                               C->getLocEnd());
+}
+
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPPriorityClause(OMPPriorityClause *C) {
+  // Transform the priority expression.
+  ExprResult E = getDerived().TransformExpr(C->getPriority());
+
+  if (E.isInvalid())
+    return 0;
+
+  return getDerived().RebuildOMPPriorityClause(E.get(), C->getLocStart(),
+                                               C->getLocEnd());
+}
+
+template <typename Derived>
+OMPClause *TreeTransform<Derived>::TransformOMPHintClause(OMPHintClause *C) {
+  // Transform the hint expression.
+  ExprResult E = getDerived().TransformExpr(C->getHint());
+
+  if (E.isInvalid())
+    return 0;
+
+  return getDerived().RebuildOMPHintClause(E.get(), C->getLocStart(),
+                                           C->getLocEnd());
+}
+
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPIsDevicePtrClause(OMPIsDevicePtrClause *C) {
+  llvm::SmallVector<Expr *, 5> Vars;
+  Vars.reserve(C->varlist_size());
+  for (OMPIsDevicePtrClause::varlist_iterator I = C->varlist_begin(),
+                                              E = C->varlist_end();
+       I != E; ++I) {
+    ExprResult EVar = getDerived().TransformExpr(cast<Expr>(*I));
+    if (EVar.isInvalid())
+      return nullptr;
+    Vars.push_back(EVar.get());
+  }
+  return getDerived().RebuildOMPIsDevicePtrClause(Vars, C->getLocStart(),
+                                                  C->getLocEnd());
+}
+
+template <typename Derived>
+OMPClause *
+TreeTransform<Derived>::TransformOMPDefaultmapClause(OMPDefaultmapClause *C) {
+  return getDerived().RebuildOMPDefaultmapClause(
+      C->getDefaultmapModifier(), C->getDefaultmapModifierLoc(),
+      C->getDefaultmapKind(), C->getDefaultmapKindLoc(), C->getLocStart(),
+      C->getLocEnd());
+}
+
 template <typename Derived>
 OMPClause *
 TreeTransform<Derived>::TransformOMPLinearClause(OMPLinearClause *C) {
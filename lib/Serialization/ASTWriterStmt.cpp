@@ -1742,6 +1742,8 @@ void OMPClauseWriter::VisitOMPProcBindClause(OMPProcBindClause *C) {
 }
 
 void OMPClauseWriter::VisitOMPScheduleClause(OMPScheduleClause *C) {
+  Record.push_back(C->getScheduleModifier());
+  Writer.AddSourceLocation(C->getScheduleModifierLoc(), Record);
   Record.push_back(C->getScheduleKind());
   Writer.AddSourceLocation(C->getScheduleKindLoc(), Record);
   Writer.AddStmt(C->getChunkSize());
@@ -1880,7 +1882,26 @@ void OMPClauseWriter::VisitOMPReductionClause(OMPReductionClause *C) {
     Writer.AddStmt(*I);
 }
 
-void OMPClauseWriter::VisitOMPOrderedClause(OMPOrderedClause *C) { }
+void OMPClauseWriter::VisitOMPTaskReductionClause(OMPTaskReductionClause *C) {
+  VisitOMPReductionClause(C);
+}
+
+void OMPClauseWriter::VisitOMPInReductionClause(OMPInReductionClause *C) {
+  VisitOMPReductionClause(C);
+}
+
+void OMPClauseWriter::VisitOMPOrderedClause(OMPOrderedClause *C) {
+  Writer.AddStmt(C->getNumForLoops());
+  Record.push_back(C->getNumLoops());
+  for (unsigned I = 0, E = C->getNumLoops(); I < E; ++I)
+    Writer.AddStmt(C->getLoopCounter(I));
+  for (unsigned I = 0, E = C->getNumLoops(); I < E; ++I)
+    Writer.AddStmt(C->getLoopLowerBound(I));
+  for (unsigned I = 0, E = C->getNumLoops(); I < E; ++I)
+    Writer.AddStmt(C->getLoopUpperBound(I));
+  for (unsigned I = 0, E = C->getNumLoops(); I < E; ++I)
+    Writer.AddStmt(C->getLoopStep(I));
+}
 
 void OMPClauseWriter::VisitOMPNowaitClause(OMPNowaitClause *C) { }
 
@@ -2022,6 +2043,37 @@ void OMPClauseWriter::VisitOMPThreadLimitClause(OMPThreadLimitClause *C) {
   Writer.AddStmt(C->getThreadLimit());
 }
 
+void OMPClauseWriter::VisitOMPGrainsizeClause(OMPGrainsizeClause *C) {
+  Writer.AddStmt(C->getGrainsize());
+}
+
+void OMPClauseWriter::VisitOMPNumTasksClause(OMPNumTasksClause *C) {
+  Writer.AddStmt(C->getNumTasks());
+}
+
+void OMPClauseWriter::VisitOMPPriorityClause(OMPPriorityClause *C) {
+  Writer.AddStmt(C->getPriority());
+}
+
+void OMPClauseWriter::VisitOMPHintClause(OMPHintClause *C) {
+  Writer.AddStmt(C->getHint());
+}
+
+void OMPClauseWriter::VisitOMPIsDevicePtrClause(OMPIsDevicePtrClause *C) {
+  Record.push_back(C->varlist_size());
+  for (OMPIsDevicePtrClause::varlist_iterator I = C->varlist_begin(),
+                                              E = C->varlist_end();
+       I != E; ++I)
+    Writer.AddStmt(*I);
+}
+
+void OMPClauseWriter::VisitOMPDefaultmapClause(OMPDefaultmapClause *C) {
+  Record.push_back(C->getDefaultmapModifier());
+  Writer.AddSourceLocation(C->getDefaultmapModifierLoc(), Record);
+  Record.push_back(C->getDefaultmapKind());
+  Writer.AddSourceLocation(C->getDefaultmapKindLoc(), Record);
+}
+
 void OMPClauseWriter::VisitOMPLinearClause(OMPLinearClause *C) {
   Record.push_back(C->varlist_size());
   for (OMPLinearClause::varlist_iterator I = C->varlist_begin(),
@@ -2298,6 +2350,40 @@ void ASTStmtWriter::VisitOMPTaskDirective(OMPTaskDirective *D) {
   Code = serialization::STMT_OMP_TASK_DIRECTIVE;
 }
 
+void ASTStmtWriter::VisitOMPTaskLoopDirective(OMPTaskLoopDirective *D) {
+  VisitStmt(D);
+  Record.push_back(D->getNumClauses());
+  Record.push_back(D->getCollapsedNumber());
+  VisitOMPExecutableDirective(D);
+  Writer.AddStmt(D->getNewIterVar());
+  Writer.AddStmt(D->getNewIterEnd());
+  Writer.AddStmt(D->getInit());
+  Writer.AddStmt(D->getFinal());
+  Writer.AddStmt(D->getLowerBound());
+  Writer.AddStmt(D->getUpperBound());
+  for (unsigned i = 0, N = D->getCollapsedNumber(); i < N; ++i) {
+    Writer.AddStmt(D->getCounters()[i]);
+  }
+  Code = serialization::STMT_OMP_TASKLOOP_DIRECTIVE;
+}
+
+void ASTStmtWriter::VisitOMPTaskLoopSimdDirective(OMPTaskLoopSimdDirective *D) {
+  VisitStmt(D);
+  Record.push_back(D->getNumClauses());
+  Record.push_back(D->getCollapsedNumber());
+  VisitOMPExecutableDirective(D);
+  Writer.AddStmt(D->getNewIterVar());
+  Writer.AddStmt(D->getNewIterEnd());
+  Writer.AddStmt(D->getInit());
+  Writer.AddStmt(D->getFinal());
+  Writer.AddStmt(D->getLowerBound());
+  Writer.AddStmt(D->getUpperBound());
+  for (unsigned i = 0, N = D->getCollapsedNumber(); i < N; ++i) {
+    Writer.AddStmt(D->getCounters()[i]);
+  }
+  Code = serialization::STMT_OMP_TASKLOOP_SIMD_DIRECTIVE;
+}
+
 void ASTStmtWriter::VisitOMPTaskyieldDirective(OMPTaskyieldDirective *D) {
   VisitStmt(D);
   Record.push_back(D->getNumClauses());
@@ -2364,6 +2450,7 @@ void ASTStmtWriter::VisitOMPFlushDirective(OMPFlushDirective *D) {
 void ASTStmtWriter::VisitOMPOrderedDirective(OMPOrderedDirective *D) {
   VisitStmt(D);
   Record.push_back(D->getNumClauses());
+  Record.push_back(D->hasAssociatedStmt());
   VisitOMPExecutableDirective(D);
   Code = serialization::STMT_OMP_ORDERED_DIRECTIVE;
 }
@@ -0,0 +1,29 @@
+// RUN: %clang_cc1 -dump-tokens -ftrigraphs %s 2>&1 | FileCheck %s
+
+// Identifiers and whitespace runs longer than a vector register.
+
+// CHECK: identifier 'abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789'
+abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789
+
+// CHECK: identifier 'b' {{.*}}[LeadingSpace]
+	  	                                                                b
+
+// An escaped newline past the first vector.
+// CHECK: identifier 'abcdefghijklmnopqrstuvwxyz'
+abcdefghijklmnopqrst\
+uvwxyz
+
+// A trigraph past the first vector.
+// CHECK: identifier 'ABCDEFGHIJKLMNOPQRSTUVWXYZ'
+ABCDEFGHIJKLMNOPQRST??/
+UVWXYZ
+
+// CHECK: identifier 'abcdefghijklmnopqrstu$vwxyz'
+abcdefghijklmnopqrstu$vwxyz
+
+// CHECK: identifier 'abcdefghijklmnopqrstuévwxyz'
+abcdefghijklmnopqrstuévwxyz
+
+// CHECK: identifier 'c' {{.*}}[StartOfLine] [LeadingSpace]
+                                                  
+                                    c
@@ -0,0 +1,42 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+int a, v;
+float f;
+long double ld;
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+void foo(int n) {
+// CHECK: atomicrmw add i32* @a, i32 %{{.+}} monotonic
+// CHECK-NOT: call {{.*}}@__kmpc_atomic_fixed4_add(
+#pragma omp atomic
+  a += n;
+// CHECK: [[OLD:%.+]] = load atomic i32, i32* bitcast (float* @f to i32*) monotonic
+// CHECK: omp.atomic.cont:
+// CHECK: phi i32 [ [[OLD]],
+// CHECK: fadd float
+// CHECK: cmpxchg i32* bitcast (float* @f to i32*), i32 %{{.+}}, i32 %{{.+}} monotonic monotonic
+// CHECK: br i1 %{{.+}}, label %omp.atomic.exit, label %omp.atomic.cont
+#pragma omp atomic
+  f += n;
+// CHECK: load atomic i32, i32* @a monotonic
+#pragma omp atomic read
+  v = a;
+// CHECK: store atomic i32 %{{.+}}, i32* @a monotonic
+#pragma omp atomic write
+  a = n;
+// CHECK: [[PREV:%.+]] = atomicrmw sub i32* @a, i32 1 seq_cst
+// CHECK: [[NEW:%.+]] = sub i32 [[PREV]], 1
+// CHECK: store i32 [[NEW]], i32* @v
+// CHECK-NOT: call void @__kmpc_flush(
+#pragma omp atomic capture seq_cst
+  v = --a;
+// CHECK: atomicrmw xchg i32* @a, i32 %{{.+}} monotonic
+#pragma omp atomic capture
+  { v = a; a = n; }
+// Long double is left to the runtime.
+// CHECK: call void @__kmpc_atomic_float10_add(
+#pragma omp atomic
+  ld += n;
+// CHECK: ret void
+}
@@ -16,6 +16,10 @@ int main (int argc, char **argv) {
   a=2;
 // CHECK-NEXT: #pragma omp critical (name)
 // CHECK-NEXT: a = 2;
+#pragma omp critical (hinted) hint(8)
+  a=3;
+// CHECK-NEXT: #pragma omp critical (hinted) hint(8)
+// CHECK-NEXT: a = 3;
   return (0);
 }
 
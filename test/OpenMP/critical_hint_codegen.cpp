@@ -0,0 +1,40 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-inline-locks -emit-llvm -o - %s | FileCheck %s --check-prefix=INLINE
+// expected-no-diagnostics
+
+int a;
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+// INLINE-LABEL: define {{.*}}void @{{.*}}foo
+void foo() {
+// CHECK: call void @__kmpc_critical_with_hint({{.+}}, [8 x i32]* @.gomp_critical_user_spec.var, i32 8)
+// CHECK: call void @__kmpc_end_critical({{.+}}, [8 x i32]* @.gomp_critical_user_spec.var)
+// INLINE-NOT: call void @__kmpc_critical_with_hint({{.+}}@.gomp_critical_user_spec.var
+// INLINE: omp.critical.spin:
+// INLINE: [[CUR:%.+]] = load atomic i32, i32* {{.*}}@.gomp_critical_user_spec.var{{.*}} monotonic
+// INLINE: icmp eq i32 [[CUR]], 0
+// INLINE: omp.critical.try:
+// INLINE: cmpxchg i32* {{.*}}@.gomp_critical_user_spec.var{{.*}}, i32 0, i32 1 acquire monotonic
+// INLINE: omp.critical.acquired:
+// INLINE: store atomic i32 0, i32* {{.*}}@.gomp_critical_user_spec.var{{.*}} release
+// INLINE-NOT: call void @__kmpc_end_critical({{.+}}@.gomp_critical_user_spec.var
+#pragma omp critical (spec) hint(8)
+  a++;
+// Contended sections always go through the runtime.
+// CHECK: call void @__kmpc_critical_with_hint({{.+}}, [8 x i32]* @.gomp_critical_user_cont.var, i32 2)
+// CHECK: call void @__kmpc_end_critical({{.+}}, [8 x i32]* @.gomp_critical_user_cont.var)
+// INLINE: call void @__kmpc_critical_with_hint({{.+}}, [8 x i32]* @.gomp_critical_user_cont.var, i32 2)
+#pragma omp critical (cont) hint(2)
+  a--;
+// CHECK: call void @__kmpc_critical_with_hint({{.+}}, [8 x i32]* @.gomp_critical_user_contspec.var, i32 10)
+// CHECK: call void @__kmpc_end_critical({{.+}}, [8 x i32]* @.gomp_critical_user_contspec.var)
+// INLINE: call void @__kmpc_critical_with_hint({{.+}}, [8 x i32]* @.gomp_critical_user_contspec.var, i32 10)
+// INLINE: call void @__kmpc_end_critical({{.+}}, [8 x i32]* @.gomp_critical_user_contspec.var)
+#pragma omp critical (contspec) hint(10)
+  a -= 2;
+// CHECK: call void @__kmpc_critical({{.+}}, [8 x i32]* @.gomp_critical_user_.var)
+// CHECK: call void @__kmpc_end_critical({{.+}}, [8 x i32]* @.gomp_critical_user_.var)
+#pragma omp critical
+  a += 2;
+// CHECK: ret void
+}
@@ -50,6 +50,21 @@ int main() {
     }
   }
 
+  #pragma omp critical hint(1) // expected-error {{the name of the construct must be specified in presence of 'hint' clause}}
+  foo();
+  #pragma omp critical (bad) hint(3) // expected-error {{expression combines mutually exclusive lock hints}}
+  foo();
+  #pragma omp critical (bad) hint(-1) // expected-error {{expression is not a non-negative integer value}}
+  foo();
+  #pragma omp critical (bad) hint(foo()) // expected-error {{expression is not an integral constant expression}}
+  foo();
+  #pragma omp critical (hinted) hint(8) // expected-note {{previous construct with the same name has hint value 8}}
+  foo();
+  #pragma omp critical (hinted) hint(1) // expected-error {{constructs with the same name must have a 'hint' clause with the same value}}
+  foo();
+  #pragma omp critical (hinted) hint(8) hint(8) // expected-error {{directive '#pragma omp critical' cannot contain more than one 'hint' clause}}
+  foo();
+
   return 0;
 }
 
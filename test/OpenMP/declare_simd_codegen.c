@@ -0,0 +1,62 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -fopenmp -emit-llvm %s -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -fopenmp -emit-llvm %s -o - | FileCheck %s --check-prefix=WRAPPER
+
+#pragma omp declare simd uniform(b) linear(c:2) notinbranch
+double add(double a, double b, int c)
+{
+  return a + b + c;
+}
+
+#pragma omp declare simd
+float sq(float x);
+
+float use(float x)
+{
+  return sq(x);
+}
+
+#pragma omp declare simd inbranch
+float scale(float x)
+{
+  return 2.0f * x;
+}
+
+// CHECK-DAG: define <2 x double> @_ZGVbN2vul2_add(<2 x double> %a, double %b, i32 %c) [[SSE:#[0-9]+]]
+// CHECK-DAG: define <4 x double> @_ZGVcN4vul2_add(<4 x double> %a, double %b, i32 %c) [[AVX:#[0-9]+]]
+// CHECK-DAG: define <4 x double> @_ZGVdN4vul2_add(<4 x double> %a, double %b, i32 %c) [[AVX2:#[0-9]+]]
+// CHECK-DAG: define <8 x double> @_ZGVeN8vul2_add(<8 x double> %a, double %b, i32 %c) [[AVX512:#[0-9]+]]
+// The AVX-512 masks have one bit per lane, the other ISAs use vectors.
+// CHECK-DAG: define <4 x float> @_ZGVbM4v_scale(<4 x float> %x, <4 x float> %mask)
+// CHECK-DAG: define <16 x float> @_ZGVeM16v_scale(<16 x float> %x, i16 %mask)
+
+// The linear argument is computed from its stride, the scalar function is
+// called once per lane.
+// WRAPPER-LABEL: define <2 x double> @_ZGVbN2vul2_add(
+// WRAPPER: [[C:%.+]] = insertelement <2 x i32> undef, i32 %c, i32 0
+// WRAPPER: [[CV:%.+]] = shufflevector <2 x i32> [[C]], <2 x i32> undef, <2 x i32> zeroinitializer
+// WRAPPER: add <2 x i32> [[CV]], <i32 0, i32 2>
+// WRAPPER: loop.body:
+// WRAPPER: call double @add(
+// Variants of declared functions are defined where the function is.
+// WRAPPER-NOT: define {{.*}}@_ZGV{{.*}}_sq(
+// WRAPPER-LABEL: define <16 x float> @_ZGVeM16v_scale(
+// WRAPPER: [[MASK:%.+]] = bitcast i16 %mask to <16 x i1>
+// WRAPPER: extractelement <16 x i1> [[MASK]]
+
+// CHECK-DAG: "_ZGVbN2vul2_add"
+// CHECK-DAG: "_ZGVcN4vul2_add"
+// CHECK-DAG: "_ZGVdN4vul2_add"
+// CHECK-DAG: "_ZGVeN8vul2_add"
+// Without 'inbranch'/'notinbranch' both the masked and unmasked forms exist.
+// CHECK-DAG: "_ZGVbN4v_sq"
+// CHECK-DAG: "_ZGVbM4v_sq"
+// CHECK-DAG: "_ZGVcN8v_sq"
+// CHECK-DAG: "_ZGVcM8v_sq"
+// CHECK-DAG: "_ZGVdN8v_sq"
+// CHECK-DAG: "_ZGVdM8v_sq"
+// CHECK-DAG: "_ZGVeN16v_sq"
+// CHECK-DAG: "_ZGVeM16v_sq"
+// CHECK-DAG: attributes [[SSE]] = { {{.*}}"target-features"="+sse2"
+// CHECK-DAG: attributes [[AVX]] = { {{.*}}"target-features"="+avx"
+// CHECK-DAG: attributes [[AVX2]] = { {{.*}}"target-features"="+avx2"
+// CHECK-DAG: attributes [[AVX512]] = { {{.*}}"target-features"="+avx512f"
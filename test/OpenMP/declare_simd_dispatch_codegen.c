@@ -0,0 +1,32 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -fopenmp -emit-llvm %s -o - | FileCheck %s --check-prefix=CHECK --check-prefix=SSE
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -target-feature +avx -fopenmp -emit-llvm %s -o - | FileCheck %s --check-prefix=CHECK --check-prefix=AVX
+
+#pragma omp declare simd
+float sq(float x);
+
+#pragma omp declare simd uniform(b)
+float mul(float a, float b);
+
+// Calls outside simd loops are left alone, the vectorizer does not see them.
+// CHECK-LABEL: define float @use(
+// CHECK: call float @sq(float %{{[^)]+}})
+float use(float x)
+{
+  return sq(x);
+}
+
+// CHECK-LABEL: define void @loop(
+// CHECK: call float @sq(float %{{[^)]+}})
+// CHECK: ret void
+void loop(float *a, int n)
+{
+#pragma omp simd
+  for (int i = 0; i < n; ++i)
+    a[i] = sq(a[i]);
+}
+
+// Only the unmasked variant of the ISA of the translation unit that takes all
+// its arguments as vectors is used.
+// CHECK: !omp.simd.dispatch = !{[[SQ:![0-9]+]]}
+// SSE: [[SQ]] = !{!"sq", !"_ZGVbN4v_sq", i32 4}
+// AVX: [[SQ]] = !{!"sq", !"_ZGVcN8v_sq", i32 8}
@@ -0,0 +1,19 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-runtime-flush -emit-llvm -o - %s | FileCheck %s --check-prefix=RUNTIME
+// expected-no-diagnostics
+
+int a, b;
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+// RUNTIME-LABEL: define {{.*}}void @{{.*}}foo
+void foo() {
+// CHECK: fence seq_cst
+// RUNTIME: call void {{.*}}@__kmpc_flush({{[^,]+}})
+#pragma omp flush
+// CHECK: fence seq_cst
+// RUNTIME: call void {{.*}}@__kmpc_flush({{[^,]+}}, i32* @a, i32* @b)
+// RUNTIME-NOT: fence
+#pragma omp flush(a, b)
+// CHECK-NOT: @__kmpc_flush
+// CHECK: ret void
+}
@@ -48,6 +48,11 @@ int main (int argc, char **argv) {
 // CHECK-NEXT: #pragma omp for schedule(runtime)
   for (int i = 0; i < 10; ++i)foo();
 // CHECK-NEXT: for (int i = 0; i < 10; ++i)
+// CHECK-NEXT: foo();
+#pragma omp for schedule(nonmonotonic : dynamic, 4)
+// CHECK-NEXT: #pragma omp for schedule(nonmonotonic: dynamic, 4)
+  for (int i = 0; i < 10; ++i)foo();
+// CHECK-NEXT: for (int i = 0; i < 10; ++i)
 // CHECK-NEXT: foo();
   return (0);
 }
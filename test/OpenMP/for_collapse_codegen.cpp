@@ -0,0 +1,34 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+void foo(float *a, int n, int m, int k) {
+// The counters are recovered from the flat index once per chunk.
+// CHECK: call void @__kmpc_for_static_init_4(
+// CHECK: omp.loop.begin:
+// CHECK: [[POS:%.+]] = srem i32
+// CHECK: store i32 [[POS]], i32* [[POSADDR:%.+]],
+// CHECK: sdiv i32
+// CHECK: omp.loop.main:
+// CHECK-NOT: {{sdiv|srem}}
+// CHECK: omp.cont.block:
+// CHECK: add nsw i32 %{{.+}}, 1
+// CHECK: [[CUR:%.+]] = load i32, i32* [[POSADDR]]
+// CHECK: [[NEXT:%.+]] = add i32 [[CUR]], 1
+// CHECK: icmp slt i32 [[NEXT]],
+// CHECK: omp.collapse.step:
+// CHECK: store i32 [[NEXT]], i32* [[POSADDR]]
+// CHECK: br label %omp.collapse.next.end
+// CHECK: omp.collapse.wrap:
+// CHECK: store i32 0, i32* [[POSADDR]]
+// CHECK: omp.collapse.next.end:
+// CHECK-NOT: {{sdiv|srem}}
+// CHECK: omp.loop.fini:
+#pragma omp for collapse(3)
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < m; ++j)
+      for (int l = 0; l < k; l += 2)
+        a[(i * m + j) * k + l] = 0;
+// CHECK: call void @__kmpc_for_static_fini(
+// CHECK: ret void
+}
@@ -0,0 +1,36 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+void bar(float *, int);
+
+// The nonmonotonic dynamic schedule uses the work-stealing schedule of the
+// runtime (kmp_sch_static_steal).
+// CHECK-LABEL: define {{.*}}void @{{.*}}steal
+// CHECK: call void @__kmpc_dispatch_init_4(%{{.+}}, i32 %{{.+}}, i32 44, i32 %{{.+}}, i32 %{{.+}}, i32 1, i32 4)
+// CHECK: call i32 @__kmpc_dispatch_next_4(
+// CHECK: ret void
+void steal(float *a, int n) {
+#pragma omp for schedule(nonmonotonic: dynamic, 4)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
+
+// The other dynamic schedules keep the shared counter
+// (kmp_sch_dynamic_chunked).
+// CHECK-LABEL: define {{.*}}void @{{.*}}dynamic
+// CHECK: call void @__kmpc_dispatch_init_4(%{{.+}}, i32 %{{.+}}, i32 35, i32 %{{.+}}, i32 %{{.+}}, i32 1, i32 4)
+// CHECK: ret void
+void dynamic(float *a, int n) {
+#pragma omp for schedule(dynamic, 4)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}monotonic
+// CHECK: call void @__kmpc_dispatch_init_4(%{{.+}}, i32 %{{.+}}, i32 35, i32 %{{.+}}, i32 %{{.+}}, i32 1, i32 4)
+// CHECK: ret void
+void monotonic(float *a, int n) {
+#pragma omp for schedule(monotonic: dynamic, 4)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
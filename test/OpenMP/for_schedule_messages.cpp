@@ -30,6 +30,16 @@ int main(int argc, char **argv) {
   for (int i = 0; i < 10; ++i) foo();
   #pragma omp for schedule (dynamic, argv[1]=2) // expected-error {{statement requires expression of integer type ('char *' invalid)}} expected-error {{expected ')'}} expected-note {{to match this '('}}
   for (int i = 0; i < 10; ++i) foo();
+  #pragma omp for schedule (nonmonotonic) // expected-error {{expected 'static', 'dynamic', 'guided', 'auto' or 'runtime' in OpenMP clause 'schedule'}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp for schedule (nonmonotonic : static) // expected-error {{'nonmonotonic' modifier can only be specified with 'dynamic' or 'guided' schedule kind}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp for schedule (nonmonotonic : dynamic) ordered // expected-error {{'schedule' clause with 'nonmonotonic' modifier cannot be specified if an 'ordered' clause is specified}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp for schedule (monotonic : static, 2)
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp for schedule (nonmonotonic : guided)
+  for (int i = 0; i < 10; ++i) foo();
 
   return 0;
 }
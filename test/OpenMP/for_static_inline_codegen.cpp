@@ -0,0 +1,38 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-inline-static-schedule -emit-llvm -o - %s | FileCheck %s --implicit-check-not=__kmpc_for_static_init --implicit-check-not=__kmpc_for_static_fini
+// expected-no-diagnostics
+
+void foo(float *a, int n) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+// CHECK: call i32 @__kmpc_bound_thread_num(
+// CHECK: call i32 @__kmpc_bound_num_threads(
+// Greedy split of the runtime: every thread gets ceil(trip / nthreads)
+// iterations, clamped to the global upper bound.
+// CHECK: [[LB:%.+]] = load i32, i32* %lb{{[0-9]*}}
+// CHECK: [[UB:%.+]] = load i32, i32* %ub{{[0-9]*}}
+// CHECK: [[DIV:%.+]] = udiv i32 [[TRIP:%.+]], [[NTH:%.+]]
+// CHECK: [[REM:%.+]] = urem i32 [[TRIP]], [[NTH]]
+// CHECK: [[HASREM:%.+]] = icmp ne i32 [[REM]], 0
+// CHECK: [[EXTRA:%.+]] = zext i1 [[HASREM]] to i32
+// CHECK: [[CHUNK:%.+]] = add i32 [[DIV]], [[EXTRA]]
+// CHECK: [[OFF:%.+]] = mul i32 [[TID:%.+]], [[CHUNK]]
+// CHECK: [[MYLB:%.+]] = add i32 [[LB]], [[OFF]]
+// CHECK: [[END:%.+]] = add i32 [[MYLB]], [[CHUNK]]
+// CHECK: [[MYUB:%.+]] = sub i32 [[END]], 1
+// CHECK: [[WRAP:%.+]] = icmp slt i32 [[MYUB]], [[MYLB]]
+// CHECK: [[PAST:%.+]] = icmp sgt i32 [[MYUB]], [[UB]]
+// CHECK: [[CLAMP:%.+]] = or i1 [[WRAP]], [[PAST]]
+// CHECK: [[NEWUB:%.+]] = select i1 [[CLAMP]], i32 [[UB]], i32 [[MYUB]]
+// CHECK: store i32 [[MYLB]], i32* %lb{{[0-9]*}}
+// CHECK: store i32 [[NEWUB]], i32* %ub{{[0-9]*}}
+// CHECK: [[INRANGE:%.+]] = icmp sle i32 [[MYLB]], [[UB]]
+// CHECK: [[ATEND:%.+]] = icmp eq i32 [[NEWUB]], [[UB]]
+// CHECK: and i1 [[INRANGE]], [[ATEND]]
+#pragma omp for schedule(static)
+  for (int i = 0; i < n; ++i)
+    a[i] += 1.0f;
+// CHECK: mul i32 %{{.+}}, 4
+#pragma omp for schedule(static, 4)
+  for (int i = 0; i < n; ++i)
+    a[i] *= 2.0f;
+// CHECK: ret void
+}
@@ -0,0 +1,81 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-instrument -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s --check-prefix=NOINSTR
+// expected-no-diagnostics
+
+// CHECK: [[DESC:@.omp.region.desc.[0-9]+.]] = private constant { i32, i32, i8* } { i32 {{-?[0-9]+}}, i32 3, i8* getelementptr {{.*}}
+// NOINSTR-NOT: __kmpc_instr_region_
+
+int bar(int);
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+void foo(int *a, int n) {
+// CHECK: call void @__kmpc_instr_region_begin(i8* {{.*}}@.omp.region.desc.
+// CHECK: call void @__kmpc_critical(
+// CHECK: call void @__kmpc_instr_region_acquired(i8* {{.*}}[[DESC]]
+// CHECK: call void @__kmpc_end_critical(
+// CHECK: call void @__kmpc_instr_region_end(i8* {{.*}}[[DESC]]{{.*}}, i64 0)
+#pragma omp critical
+  a[0] = bar(n);
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+#pragma omp parallel
+  {
+#pragma omp for
+    for (int i = 0; i < n; ++i)
+      a[i] = bar(i);
+#pragma omp barrier
+  }
+}
+
+// The parallel region encloses the loop and the barriers.
+// CHECK: define internal void @.omp_microtask.(
+// CHECK: [[ITERS:%.omp.instr.iters.+]] = alloca i64
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: store i64 0, i64* [[ITERS]]
+// CHECK: call void @__kmpc_for_static_init_4(
+// CHECK: load i64, i64* [[ITERS]]
+// CHECK: add i64 %{{.+}}, 1
+// CHECK: call void @__kmpc_for_static_fini(
+// CHECK: [[N:%.+]] = load i64, i64* [[ITERS]]
+// CHECK: call void @__kmpc_instr_region_end(i8* {{.*}}, i32 %{{.+}}, i64 [[N]])
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: call {{.*}}@__kmpc_{{(cancel_)?}}barrier(
+// CHECK: call void @__kmpc_instr_region_end(
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: call {{.*}}@__kmpc_{{(cancel_)?}}barrier(
+// CHECK: call void @__kmpc_instr_region_end(
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: call {{.*}}@__kmpc_{{(cancel_)?}}barrier(
+// CHECK: call void @__kmpc_instr_region_end(
+// CHECK: call void @__kmpc_instr_region_end(
+// CHECK: ret void
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}baz
+void baz(int *a) {
+#pragma omp task
+  a[0] = bar(0);
+}
+
+// Tied task bodies are instrumented.
+// CHECK: define internal {{.*}}@.omp_ptask.(
+// CHECK: call void @__kmpc_instr_region_begin(
+// CHECK: call {{.*}}bar
+// CHECK: call void @__kmpc_instr_region_end(
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}qux
+void qux(int *a) {
+#pragma omp parallel
+  {
+    if (bar(0)) {
+#pragma omp cancel parallel
+    }
+    a[0] = bar(1);
+  }
+}
+
+// Cancellation leaves the parallel region through the exit hook.
+// CHECK: define internal void @.omp_microtask.{{[0-9]+}}(
+// CHECK: call void @__kmpc_instr_region_begin(i8* {{.*}}[[PDESC:@.omp.region.desc.[0-9]+.]]
+// CHECK: call i32 @__kmpc_cancel(
+// CHECK: call void @__kmpc_instr_region_end(i8* {{.*}}[[PDESC]]
+// CHECK: ret void
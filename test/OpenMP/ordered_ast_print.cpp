@@ -23,6 +23,20 @@ int main (int argc, char **argv) {
 // CHECK-NEXT: #pragma omp ordered
 // CHECK-NEXT: {
 // CHECK-NEXT: a = 2;
+// CHECK-NEXT: }
+  #pragma omp for ordered(2)
+  for (int i = 1; i < argc; ++i)
+    for (int j = 0; j < argc; ++j) {
+      #pragma omp ordered depend(sink : i - 1, j)
+      a = i + j;
+      #pragma omp ordered depend(source)
+    }
+// CHECK-NEXT: #pragma omp for ordered(2)
+// CHECK-NEXT: for (int i = 1; i < argc; ++i)
+// CHECK-NEXT: for (int j = 0; j < argc; ++j) {
+// CHECK-NEXT: #pragma omp ordered depend(sink: i - 1,j)
+// CHECK-NEXT: a = i + j;
+// CHECK-NEXT: #pragma omp ordered depend(source)
 // CHECK-NEXT: }
   return (0);
 }
@@ -0,0 +1,59 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+// The iteration space of both loops is described to the runtime, but only the
+// outer loop is distributed among the threads: the inner one is run in full
+// by each iteration.
+// CHECK-LABEL: define {{.*}}void @{{.*}}doacross
+// CHECK: %.doacross.dims. = alloca [6 x i64], align 8
+// CHECK: [[LO0:%.+]] = getelementptr inbounds [6 x i64], [6 x i64]* %.doacross.dims., i32 0, i32 0
+// CHECK: store i64 1, i64* [[LO0]]
+// CHECK: [[ST0:%.+]] = getelementptr inbounds [6 x i64], [6 x i64]* %.doacross.dims., i32 0, i32 2
+// CHECK: store i64 1, i64* [[ST0]]
+// CHECK: [[LO1:%.+]] = getelementptr inbounds [6 x i64], [6 x i64]* %.doacross.dims., i32 0, i32 3
+// CHECK: store i64 0, i64* [[LO1]]
+// CHECK: [[ST1:%.+]] = getelementptr inbounds [6 x i64], [6 x i64]* %.doacross.dims., i32 0, i32 5
+// CHECK: store i64 1, i64* [[ST1]]
+// CHECK: call void @__kmpc_doacross_init(%{{.+}}, i32 %{{.+}}, i32 2, i64* %{{.+}})
+// CHECK: for.cond:
+// CHECK: [[SINKI:%.+]] = sext i32 %{{.+}} to i64
+// CHECK: [[SINKJ:%.+]] = sext i32 %{{.+}} to i64
+// CHECK: store i64 [[SINKI]], i64* %{{.+}}
+// CHECK: store i64 [[SINKJ]], i64* %{{.+}}
+// CHECK: call void @__kmpc_doacross_wait(%{{.+}}, i32 %{{.+}}, i64* %{{.+}})
+// CHECK: [[SRCI:%.+]] = sext i32 %{{.+}} to i64
+// CHECK: [[SRCJ:%.+]] = sext i32 %{{.+}} to i64
+// CHECK: store i64 [[SRCI]], i64* %{{.+}}
+// CHECK: store i64 [[SRCJ]], i64* %{{.+}}
+// CHECK: call void @__kmpc_doacross_post(%{{.+}}, i32 %{{.+}}, i64* %{{.+}})
+// CHECK: for.inc:
+// CHECK: call void @__kmpc_doacross_fini(%{{.+}}, i32 %{{.+}})
+// CHECK: ret void
+void doacross(int n, float *a) {
+#pragma omp for ordered(2)
+  for (int i = 1; i < n; ++i)
+    for (int j = 0; j < 8; ++j) {
+#pragma omp ordered depend(sink : i - 1, j)
+      a[i * 8 + j] += a[(i - 1) * 8 + j];
+#pragma omp ordered depend(source)
+    }
+}
+
+// With collapse(2) both loops are distributed.
+// CHECK-LABEL: define {{.*}}void @{{.*}}collapsed
+// CHECK: call void @__kmpc_doacross_init(%{{.+}}, i32 %{{.+}}, i32 2, i64* %{{.+}})
+// CHECK-NOT: for.cond:
+// CHECK: call void @__kmpc_doacross_wait(
+// CHECK-NOT: for.cond:
+// CHECK: call void @__kmpc_doacross_post(
+// CHECK: call void @__kmpc_doacross_fini(
+// CHECK: ret void
+void collapsed(int n, float *a) {
+#pragma omp for collapse(2) ordered(2)
+  for (int i = 1; i < n; ++i)
+    for (int j = 0; j < 8; ++j) {
+#pragma omp ordered depend(sink : i - 1, j)
+      a[i * 8 + j] += a[(i - 1) * 8 + j];
+#pragma omp ordered depend(source)
+    }
+}
@@ -54,6 +54,33 @@ int main() {
     #pragma omp ordered // expected-error {{region cannot be closely nested inside explicit task region}}
     foo();
   }
+  #pragma omp for ordered(0) // expected-error {{expression is not a positive integer value}}
+  for (int i = 0; i < 10; ++i)
+    foo();
+  #pragma omp for ordered(1)
+  for (int i = 0; i < 10; ++i) {
+    #pragma omp ordered // expected-error {{'ordered' directive without 'depend' clause cannot be closely nested inside a loop region with 'ordered(n)' clause}}
+    foo();
+  }
+  #pragma omp for ordered
+  for (int i = 0; i < 10; ++i) {
+    #pragma omp ordered depend(source) // expected-error {{'ordered' directive with 'depend' clause must be closely nested inside a loop region with 'ordered(n)' clause}}
+  }
+  #pragma omp for ordered(2)
+  for (int i = 0; i < 10; ++i)
+    for (int j = 0; j < 10; ++j) {
+      #pragma omp ordered depend(sink : i - 1) // expected-error {{expected 2 iteration expressions in 'depend(sink : vec)' clause}}
+      #pragma omp ordered depend(sink : i - 1, 0.5) // expected-error {{expected expression of integer type in 'depend(sink : vec)' clause}}
+      #pragma omp ordered depend(in : i) // expected-error {{only 'depend(source)' or 'depend(sink : vec)' clauses are allowed in '#pragma omp ordered' directive}}
+      foo();
+      #pragma omp ordered depend(source)
+    }
+  #pragma omp for collapse(2) ordered(1) // expected-error {{the parameter of the 'ordered' clause must be greater than or equal to the parameter of the 'collapse' clause}}
+  for (int i = 0; i < 10; ++i)
+    for (int j = 0; j < 10; ++j)
+      foo();
+  #pragma omp task depend(source) // expected-error {{'depend(source)' clause is allowed only in '#pragma omp ordered' directive}}
+  foo();
 
   return 0;
 }
@@ -0,0 +1,55 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+struct Config {
+  int sizes[1024];
+  double scale;
+};
+
+void use(double);
+
+// A read-only aggregate is not copied, the threads read the original one.
+// CHECK-LABEL: define {{.*}}void @{{.*}}read_only
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: define internal void @.omp_microtask.{{[0-9.]*}}(
+// CHECK-NOT: alloca %struct.Config
+// CHECK-NOT: call void @llvm.memcpy
+// CHECK: call void @{{.*}}use
+// CHECK: ret void
+void read_only(int n) {
+  Config cfg;
+  cfg.scale = 2.0;
+  cfg.sizes[0] = n;
+#pragma omp parallel firstprivate(cfg)
+  use(cfg.scale * cfg.sizes[0]);
+}
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}written
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: define internal void @.omp_microtask.{{[0-9.]*}}(
+// CHECK: alloca %struct.Config
+// CHECK: call void @llvm.memcpy
+// CHECK: ret void
+void written(int n) {
+  Config cfg;
+  cfg.scale = 1.0;
+#pragma omp parallel firstprivate(cfg)
+  {
+    cfg.scale += n;
+    use(cfg.scale);
+  }
+}
+
+// The address escapes, the region must work on a copy.
+// CHECK-LABEL: define {{.*}}void @{{.*}}escaping
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: define internal void @.omp_microtask.{{[0-9.]*}}(
+// CHECK: alloca %struct.Config
+// CHECK: call void @llvm.memcpy
+// CHECK: ret void
+void escaping(Config *&p) {
+  Config cfg;
+  p = &cfg;
+#pragma omp parallel firstprivate(cfg)
+  use(cfg.scale);
+}
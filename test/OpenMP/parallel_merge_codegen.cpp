@@ -0,0 +1,107 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-merge-parallel -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+void foo(float *a, int n) {
+  int m = 0;
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK-NOT: @__kmpc_fork_call(
+// CHECK: ret void
+#pragma omp parallel
+  a[0] = 0.0f;
+  m = n / 2;
+#pragma omp parallel firstprivate(m)
+  a[1] = m;
+#pragma omp parallel
+  a[2] = 1.0f;
+}
+
+// The serial code between the regions runs on the master thread.
+// CHECK: define {{.*}}void @.omp_microtask.(
+// CHECK: call void @__kmpc_barrier(
+// CHECK: call i32 @__kmpc_master(
+// CHECK: call void @__kmpc_end_master(
+// CHECK: call void @__kmpc_barrier(
+// CHECK-NOT: @__kmpc_master(
+// CHECK: ret void
+
+// Regions with clauses affecting the team are not merged.
+void bar(int n) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}bar
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+#pragma omp parallel num_threads(n)
+  ;
+#pragma omp parallel
+  ;
+}
+
+int omp_get_thread_num(void);
+__attribute__((const)) int square(int);
+
+// Serial code calling a function that may have side effects is not merged.
+void baz(float *a) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}baz
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: call i32 @{{.*}}omp_get_thread_num
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+#pragma omp parallel
+  a[0] = 0.0f;
+  a[1] = omp_get_thread_num();
+#pragma omp parallel
+  a[2] = 1.0f;
+}
+
+// Calls to const and pure functions are.
+void qux(float *a, int n) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}qux
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK-NOT: @__kmpc_fork_call(
+// CHECK: ret void
+#pragma omp parallel
+  a[0] = 0.0f;
+  a[1] = square(n);
+#pragma omp parallel
+  a[2] = 1.0f;
+}
+
+// Regions that may be cancelled are not merged, cancelling one of them would
+// cancel the others too.
+void quux(float *a) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}quux
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK-NOT: @__kmpc_fork_call(
+// CHECK: ret void
+#pragma omp parallel
+  {
+    a[0] = 0.0f;
+#pragma omp cancel parallel
+  }
+#pragma omp parallel
+  {
+#pragma omp cancellation point parallel
+    a[1] = 1.0f;
+  }
+#pragma omp parallel
+  a[2] = 2.0f;
+}
+
+// Only the region with firstprivate variables synchronizes after copying them.
+void corge(float *a, int n) {
+// CHECK-LABEL: define {{.*}}void @{{.*}}corge
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK-NOT: @__kmpc_fork_call(
+// CHECK: ret void
+#pragma omp parallel firstprivate(n)
+  a[0] = n;
+#pragma omp parallel
+  a[1] = 1.0f;
+}
+// CHECK: define {{.*}}void @.omp_microtask.{{[0-9]*}}(
+// CHECK: call void @__kmpc_barrier(
+// CHECK: call void @__kmpc_barrier(
+// CHECK: call void @__kmpc_barrier(
+// CHECK-NOT: call void @__kmpc_barrier(
+// CHECK: ret void
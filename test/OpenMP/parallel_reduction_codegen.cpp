@@ -0,0 +1,90 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+void use(int, double, float, unsigned, long, int, int);
+
+// Scalar items with builtin operators are stored in the reduction record by
+// value, items of the same type and operator next to each other. The others
+// are stored as pointers after them.
+// CHECK-LABEL: define {{.*}}void @{{.*}}packed
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+// CHECK: define internal void @.omp_microtask.{{[0-9.]*}}(
+// CHECK: %reduction.rec.var = alloca { i32, i32, double, double, float, float, i32, i32, i64, i32, i32, i32* }
+// CHECK: call i32 @__kmpc_reduce{{(_nowait)?}}(%{{.+}}, i32 %{{.+}}, i32 12, i64 64, i8* %{{.+}}, void (i8*, i8*)* @.omp_reduction_op.,
+void packed(int n) {
+  int i1 = 0, i2 = 0, x1 = 0, x2 = 0, b1 = 1;
+  double d1 = 0.0, d2 = 0.0;
+  float f1 = 1.0f, f2 = 1.0f;
+  unsigned u1 = 0, u2 = 0;
+  long l1 = 0;
+#pragma omp parallel reduction(+: i1, d1, i2, d2) reduction(*: f1, f2) \
+                     reduction(max: u1, u2) reduction(min: l1)         \
+                     reduction(^: x1, x2) reduction(&&: b1)
+  {
+    i1 += n;
+    i2 -= n;
+    d1 += n;
+    d2 += 2.0 * n;
+    f1 *= n;
+    f2 *= 0.5f * n;
+    u1 = u1 > (unsigned)n ? u1 : n;
+    u2 = u2 > 2u * n ? u2 : 2u * n;
+    l1 = l1 < n ? l1 : n;
+    x1 ^= n;
+    x2 ^= 2 * n;
+    b1 = b1 && n;
+  }
+  use(i1 + i2, d1 + d2, f1 * f2, u1 + u2, l1, x1 ^ x2, b1);
+}
+
+// Each run of adjacent fields is combined with one vector operation.
+// CHECK: define internal void @.omp_reduction_op.(
+// CHECK: [[ILHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[IRHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[ISUM:%.+]] = add <2 x i32> [[ILHS]], [[IRHS]]
+// CHECK: store <2 x i32> [[ISUM]], <2 x i32>* %{{.+}}, align 4
+// CHECK: [[DLHS:%.+]] = load <2 x double>, <2 x double>* %{{.+}}, align 8
+// CHECK: [[DRHS:%.+]] = load <2 x double>, <2 x double>* %{{.+}}, align 8
+// CHECK: [[DSUM:%.+]] = fadd <2 x double> [[DLHS]], [[DRHS]]
+// CHECK: store <2 x double> [[DSUM]], <2 x double>* %{{.+}}, align 8
+// CHECK: [[FLHS:%.+]] = load <2 x float>, <2 x float>* %{{.+}}, align 4
+// CHECK: [[FRHS:%.+]] = load <2 x float>, <2 x float>* %{{.+}}, align 4
+// CHECK: [[FPROD:%.+]] = fmul <2 x float> [[FLHS]], [[FRHS]]
+// CHECK: store <2 x float> [[FPROD]], <2 x float>* %{{.+}}, align 4
+// CHECK: [[ULHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[URHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[UCMP:%.+]] = icmp ugt <2 x i32> [[ULHS]], [[URHS]]
+// CHECK: [[UMAX:%.+]] = select <2 x i1> [[UCMP]], <2 x i32> [[ULHS]], <2 x i32> [[URHS]]
+// CHECK: store <2 x i32> [[UMAX]], <2 x i32>* %{{.+}}, align 4
+// A run of one field is combined as a scalar.
+// CHECK: [[LLHS:%.+]] = load i64, i64* %{{.+}}, align 8
+// CHECK: [[LRHS:%.+]] = load i64, i64* %{{.+}}, align 8
+// CHECK: [[LCMP:%.+]] = icmp slt i64 [[LLHS]], [[LRHS]]
+// CHECK: [[LMIN:%.+]] = select i1 [[LCMP]], i64 [[LLHS]], i64 [[LRHS]]
+// CHECK: store i64 [[LMIN]], i64* %{{.+}}, align 8
+// CHECK: [[XLHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[XRHS:%.+]] = load <2 x i32>, <2 x i32>* %{{.+}}, align 4
+// CHECK: [[XOR:%.+]] = xor <2 x i32> [[XLHS]], [[XRHS]]
+// CHECK: store <2 x i32> [[XOR]], <2 x i32>* %{{.+}}, align 4
+// Items stored as pointers are combined one by one with the operator.
+// CHECK: load i32*, i32** %{{.+}}
+// CHECK: icmp ne i32
+// CHECK: ret void
+
+// Items stored as pointers only are laid out in clause order.
+// CHECK-LABEL: define {{.*}}void @{{.*}}unpacked
+// CHECK: define internal void @.omp_microtask.{{[0-9.]*}}(
+// CHECK: %reduction.rec.var = alloca { i32*, i8* }
+// CHECK: define internal void @.omp_reduction_op.{{[0-9]+}}(
+// CHECK-NOT: <2 x
+// CHECK: ret void
+void unpacked(int n) {
+  int b = 1;
+  bool c = false;
+#pragma omp parallel reduction(&&: b) reduction(||: c)
+  {
+    b = b && n;
+    c = c || n;
+  }
+  use(b, c, 0, 0, 0, 0, 0);
+}
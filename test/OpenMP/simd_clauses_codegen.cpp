@@ -0,0 +1,60 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+// 'simdlen' is used as the vectorization width, 'safelen' only bounds it.
+// CHECK-LABEL: define {{.*}}void @{{.*}}simd_simdlen
+void simd_simdlen(float *a, int n) {
+// CHECK: br label %{{.+}}, !llvm.loop [[SIMDLEN_LOOP:![0-9]+]]
+#pragma omp simd simdlen(4) safelen(8)
+  for (int i = 0; i < n; ++i)
+    a[i] += 1;
+}
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}for_simd_safelen
+void for_simd_safelen(float *a, int n) {
+// CHECK: call void @__kmpc_for_static_init_4(
+// CHECK: br label %{{.+}}, !llvm.loop [[SAFELEN_LOOP:![0-9]+]]
+#pragma omp for simd safelen(16)
+  for (int i = 0; i < n; ++i)
+    a[i] += 1;
+}
+
+// The alignment is also assumed on the pointers used by the loop body.
+// CHECK-LABEL: define {{.*}}void @{{.*}}distribute_simd_aligned
+void distribute_simd_aligned(float *a, int n) {
+// CHECK: [[PTRINT:%.+]] = ptrtoint float* %{{.+}} to i64
+// CHECK-NEXT: [[MASKED:%.+]] = and i64 [[PTRINT]], 31
+// CHECK-NEXT: [[COND:%.+]] = icmp eq i64 [[MASKED]], 0
+// CHECK-NEXT: call void @llvm.assume(i1 [[COND]])
+#pragma omp distribute simd aligned(a : 32) simdlen(8)
+  for (int i = 0; i < n; ++i)
+    a[i] += 1;
+}
+// CHECK: define internal void @__simd_for_helper{{.*}}(
+// CHECK: [[BODY_PTRINT:%.+]] = ptrtoint float* %{{.+}} to i64
+// CHECK-NEXT: [[BODY_MASKED:%.+]] = and i64 [[BODY_PTRINT]], 31
+// CHECK-NEXT: [[BODY_COND:%.+]] = icmp eq i64 [[BODY_MASKED]], 0
+// CHECK-NEXT: call void @llvm.assume(i1 [[BODY_COND]])
+
+// Linear variables are computed from the loop index with no-wrap arithmetic.
+// CHECK-LABEL: define {{.*}}void @{{.*}}simd_linear
+void simd_linear(float *a, float *p, int j, int n) {
+#pragma omp simd linear(j : 2) linear(p)
+  for (int i = 0; i < n; ++i)
+    a[i] = p[0] + j;
+}
+// CHECK: define internal void @__simd_for_helper{{.*}}(
+// CHECK: [[J_START:%.+]] = load i32, i32* %
+// CHECK: [[J_IDX:%.+]] = load i32, i32* %
+// CHECK: [[J_OFF:%.+]] = mul nsw i32 [[J_IDX]], 2
+// CHECK: add nsw i32 [[J_START]], [[J_OFF]]
+// CHECK: [[P_START:%.+]] = load float*, float** %
+// CHECK: [[P_IDX:%.+]] = load i32, i32* %
+// CHECK: [[P_OFF:%.+]] = mul nsw i32 [[P_IDX]], 1
+// CHECK: getelementptr inbounds float, float* [[P_START]], i32 [[P_OFF]]
+
+// CHECK: [[SIMDLEN_LOOP]] = distinct !{[[SIMDLEN_LOOP]], [[WIDTH_4:![0-9]+]], [[VEC_ENABLE:![0-9]+]]}
+// CHECK: [[WIDTH_4]] = !{!"llvm.loop.vectorize.width", i32 4}
+// CHECK: [[VEC_ENABLE]] = !{!"llvm.loop.vectorize.enable", i1 true}
+// CHECK: [[SAFELEN_LOOP]] = distinct !{[[SAFELEN_LOOP]], [[WIDTH_16:![0-9]+]], [[VEC_ENABLE]]}
+// CHECK: [[WIDTH_16]] = !{!"llvm.loop.vectorize.width", i32 16}
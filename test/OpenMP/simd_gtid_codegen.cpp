@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+int tp;
+#pragma omp threadprivate(tp)
+
+// The body of the simd loop gets the thread id from its caller instead of
+// calling __kmpc_global_thread_num on every iteration.
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+// CHECK: call i32 @__kmpc_global_thread_num(
+// CHECK-NOT: call i32 @__kmpc_global_thread_num(
+// CHECK: call i8* @__kmpc_threadprivate_cached(
+void foo(int *a, int n) {
+#pragma omp simd
+  for (int i = 0; i < n; ++i)
+    a[i] += tp;
+}
@@ -0,0 +1,48 @@
+// RUN: %clang_cc1 -verify -fopenmp -ferror-limit 100 %s
+
+template <int LEN, int SAFE>
+void tmain(int *a) {
+  // expected-error@+1 {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  #pragma omp simd simdlen(LEN) safelen(SAFE)
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+}
+
+int main(int argc, char **argv) {
+  int a[16];
+  #pragma omp simd simdlen // expected-error {{expected '(' after 'simdlen'}} expected-error {{expected expression}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp simd simdlen (0) // expected-error {{expression is not a positive integer value}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp simd simdlen (argc) // expected-error {{expression is not an integral constant expression}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp simd simdlen (4) simdlen(8) // expected-error {{directive '#pragma omp simd' cannot contain more than one 'simdlen' clause}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp simd simdlen (4) safelen(8)
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp simd simdlen (16) safelen(8) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp for simd safelen(2) simdlen (4) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp distribute simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp distribute parallel for simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp taskloop simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp taskloop simd simdlen (2) safelen(4)
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp target teams distribute simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp target teams distribute parallel for simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp target
+  #pragma omp teams distribute simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  #pragma omp target
+  #pragma omp teams distribute parallel for simd simdlen (4) safelen(2) // expected-error {{the value of 'simdlen' parameter must be less than or equal to the value of the 'safelen' parameter}}
+  for (int i = 0; i < 16; ++i) a[i] = 0;
+  // expected-note@+1 {{in instantiation of function template specialization 'tmain<8, 4>' requested here}}
+  tmain<8, 4>(a);
+  tmain<4, 8>(a);
+  return 0;
+}
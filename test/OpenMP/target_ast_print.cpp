@@ -19,6 +19,11 @@ int main (int argc, char **argv) {
 #pragma omp target if(b) device(c+e) map(b,c) map(to:d) map(from:e) map(alloc:f) map(tofrom: g) depend(in: argc) depend(out: c) depend(inout: d)
 // CHECK:      #pragma omp target if(b) device(c + e) map(tofrom: b,c) map(to: d) map(from: e) map(alloc: f) map(tofrom: g) depend(in: argc) depend(out: c) depend(inout: d)
   foo();
+// CHECK-NEXT: foo();
+  int *p, *q;
+#pragma omp target is_device_ptr(p,q) defaultmap(tofrom: scalar)
+// CHECK:      #pragma omp target is_device_ptr(p,q) defaultmap(tofrom: scalar)
+  foo();
 // CHECK-NEXT: foo();
   return (0);
 }
@@ -333,7 +333,15 @@ int GBL3=0;
 
 // We should have 5 values being mapped. The 4 globals and at local.
 // FIXME: @IF does not need to be mapped...
-// CK4: @.tgt_types = private constant [5 x i32] [i32 3, i32 3, i32 3, i32 3, i32 3]
+// 'at' and GBL3 are written in the region and are mapped 'to | from', GBL1,
+// GBL2 and IF are only read and are mapped 'to'.
+// CK4:     @.tgt_types = private constant [5 x i32] [
+// CK4-DAG: i32 3
+// CK4-DAG: i32 3
+// CK4-DAG: i32 1
+// CK4-DAG: i32 1
+// CK4-DAG: i32 1
+// CK4: ]
 
 // CK4-LABEL: @foo 
 void foo ()
@@ -642,3 +650,137 @@ void T1(){
 }
 
 #endif
+
+///##############################################
+///
+/// Test that data present from an enclosing target data region is not
+/// transferred again
+///
+///##############################################
+#ifdef TT8
+// RUN:   %clang -fopenmp -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-cuda \
+// RUN:   -DTT8 -O0 -S -emit-llvm %s 2>&1
+// RUN:   FileCheck -check-prefix=CK8 -input-file=target_codegen_for_c.ll %s
+
+// The map types in the #target inside the loop are 'alloc' for A (it is
+// present) and 'to | from' for B
+// CK8:     [[MT1:@.tgt_types[0-9]*]] = private constant [2 x i32] [
+// CK8-DAG: i32 0
+// CK8-DAG: i32 3
+// CK8: ]
+// A is transferred if the enclosing data environment is conditional
+// CK8:     [[MT2:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 1]
+// or created on another device
+// CK8:     [[MT3:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 1]
+// or on the default device, which may change in between
+// CK8:     [[MT4:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 1]
+// A section of P is not transferred if the same section is present
+// CK8:     [[MT5:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 32]
+// but it is if only a disjoint section is
+// CK8:     [[MT6:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 33]
+
+// CK8-LABEL: @T8
+void T8(int n, double *P){
+
+  double A[32];
+  double B[32];
+
+  #pragma omp target data map(tofrom: A) device(0)
+  {
+    for (int it=0; it<n; ++it){
+      // CK8:     call i32 @__tgt_target(i32 0, i8* {{.*}}, i32 2, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([2 x i32], [2 x i32]* [[MT1]], i32 0, i32 0))
+      #pragma omp target map(to: A) map(tofrom: B) device(0)
+      for (int i=0; i<32; ++i){
+        B[i] += A[i];
+      }
+    }
+  }
+
+  #pragma omp target data map(tofrom: A) if (n > 1) device(0)
+  {
+    // CK8:     call i32 @__tgt_target(i32 0, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT2]], i32 0, i32 0))
+    #pragma omp target map(to: A) device(0)
+    for (int i=0; i<32; ++i){
+      A[i] += 1.0;
+    }
+  }
+
+  #pragma omp target data map(tofrom: A) device(1)
+  {
+    // CK8:     call i32 @__tgt_target(i32 0, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT3]], i32 0, i32 0))
+    #pragma omp target map(to: A) device(0)
+    for (int i=0; i<32; ++i){
+      A[i] += 1.0;
+    }
+  }
+
+  #pragma omp target data map(tofrom: A)
+  {
+    // CK8:     call i32 @__tgt_target(i32 -1, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT4]], i32 0, i32 0))
+    #pragma omp target map(to: A)
+    for (int i=0; i<32; ++i){
+      A[i] += 1.0;
+    }
+  }
+
+  #pragma omp target data map(tofrom: P[0:10]) device(0)
+  {
+    // CK8:     call i32 @__tgt_target(i32 0, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT5]], i32 0, i32 0))
+    #pragma omp target map(to: P[0:10]) device(0)
+    for (int i=0; i<10; ++i){
+      P[i] += 1.0;
+    }
+    // CK8:     call i32 @__tgt_target(i32 0, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT6]], i32 0, i32 0))
+    #pragma omp target map(to: P[10:20]) device(0)
+    for (int i=10; i<30; ++i){
+      P[i] += 1.0;
+    }
+  }
+  return;
+}
+
+#endif
+
+///##############################################
+///
+/// Test the device pointer clauses and defaultmap
+///
+///##############################################
+#ifdef TT9
+// RUN:   %clang -fopenmp -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-cuda \
+// RUN:   -DTT9 -O0 -S -emit-llvm %s 2>&1
+// RUN:   FileCheck -check-prefix=CK9 -input-file=target_codegen_for_c.ll %s
+
+// is_device_ptr copies the pointer value
+// CK9:     [[MT2:@.tgt_types[0-9]*]] = private constant [1 x i32] [i32 1]
+// defaultmap(tofrom: scalar) maps read-only scalars 'to | from'
+// CK9:     [[MT3:@.tgt_types[0-9]*]] = private constant [2 x i32] [i32 3, i32 3]
+// scalars only read by a nested region are mapped 'to'
+// CK9:     [[MT4:@.tgt_types[0-9]*]] = private constant [3 x i32] [i32 3, i32 1, i32 1]
+
+// CK9-LABEL: @T9
+void T9(double *D, int n){
+
+  // CK9:     call i32 @__tgt_target(i32 -1, i8* {{.*}}, i32 1, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([1 x i32], [1 x i32]* [[MT2]], i32 0, i32 0))
+  #pragma omp target is_device_ptr(D)
+  {
+    D[0] = 1.0;
+  }
+
+  double S = 2.0;
+  // CK9:     call i32 @__tgt_target(i32 -1, i8* {{.*}}, i32 2, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([2 x i32], [2 x i32]* [[MT3]], i32 0, i32 0))
+  #pragma omp target defaultmap(tofrom: scalar)
+  {
+    n = n + S;
+  }
+
+  double R[4];
+  // CK9:     call i32 @__tgt_target(i32 -1, i8* {{.*}}, i32 3, i8** {{[^,]*}}, i8** {{[^,]*}}, i64* {{[^,]*}}, i32* getelementptr inbounds ([3 x i32], [3 x i32]* [[MT4]], i32 0, i32 0))
+  #pragma omp target
+  #pragma omp parallel for
+  for (int i = 0; i < 4; ++i)
+    R[i] = S * n;
+  return;
+}
+
+#endif
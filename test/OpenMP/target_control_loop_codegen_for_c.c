@@ -19,6 +19,7 @@
 // CK1: @__omptgt__SimdNumLanes = common addrspace(3) global i32 0
 // CK1: @__omptgt__[[KERNUNQ:[a-zA-Z0-9_\.]+]]__thread_limit = global i32 0
 // CK1: @__omptgt__[[KERNUNQ]]__simd_info = constant i8 1
+// CK1-NOT: __exec_mode
 
 int foo() {
 
@@ -228,7 +229,8 @@ int foo() {
 // CK3: @__omptgt__SimdNumLanes = common addrspace(3) global i32 0
 // CK3: @__omptgt__[[KERNUNQ3:[a-zA-Z0-9_\.]+]]__thread_limit = global i32 0
 // CK3: @__omptgt__[[KERNUNQ3]]__simd_info = constant i8 1
-// CK3: @__omptgt__shared_data_ = common addrspace(3) global [{{[0-9]+}} x i8] zeroinitializer
+// 'a' keeps its initial value, so it does not need to be shared
+// CK3-NOT: @__omptgt__shared_data_
 
 #include <stdio.h>
 
@@ -334,7 +336,7 @@ int foo() {
 // CK3: [[FSTSQ]]:
 // CK3-NEXT: %[[THLIMGBL:[a-zA-Z0-9_\.]+]] = load i32, i32* @__omptgt__[[KERNUNQ3]]__thread_limit
 // CK3-NEXT: call void @__kmpc_kernel_init(i32 %[[THLIMGBL]])
-// CK3-NEXT: store i32 1, i32* {{.*}} @__omptgt__shared_data_{{.*}} align 4
+// CK3-NEXT: store i32 1, i32* %{{.+}}, align 4
 // CK3-NEXT: store i32 1, i32 addrspace(3)* @__omptgt__SimdNumLanes
 // CK3-NEXT: %[[SMDNLNS:[a-zA-Z0-9_\.]+]] = load i32, i32 addrspace(3)* @__omptgt__SimdNumLanes
 // CK3-NEXT: %[[NTIDVAL:[a-zA-Z0-9_\.]+]] = call i32 @llvm.nvvm.read.ptx.sreg.ntid.x()
@@ -417,3 +419,145 @@ int foo() {
 // CK3-NEXT: br label %[[SYNC]]
 
 #endif
+
+///##############################################
+///
+/// Combined target teams distribute parallel for (SPMD kernel, no control
+/// loop)
+///
+///##############################################
+
+#ifdef TT4
+// RUN:   %clang -fopenmp -fopenmp-nvptx-spmd -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-linux \
+// RUN:   -DTT4 -O0 -S -emit-llvm %s 2>&1
+// RUN:   FileCheck -check-prefix=CK4 -input-file=target_control_loop_codegen_for_c.ll.tgt-nvptx64sm_35-nvidia-linux %s
+
+// CK4-NOT: @__omptgt__ControlState
+// CK4: @__omptgt__[[KERNUNQ:[a-zA-Z0-9_\.]+]]__thread_limit = global i32 0
+// CK4-NOT: @__omptgt__shared_data_
+// CK4: @__omptgt__[[KERNUNQ]]__simd_info = constant i8 1
+// CK4: @__omptgt__[[KERNUNQ]]__exec_mode = constant i8 0
+
+// The parallel region of a given size needs the control loop
+// CK4: @__omptgt__[[KERNUNQ2:[a-zA-Z0-9_\.]+]]__thread_limit = global i32 0
+// CK4: @__omptgt__[[KERNUNQ2]]__exec_mode = constant i8 1
+
+// So does a loop with a dynamic schedule
+// CK4: @__omptgt__[[KERNUNQ3:[a-zA-Z0-9_\.]+]]__thread_limit = global i32 0
+// CK4: @__omptgt__[[KERNUNQ3]]__exec_mode = constant i8 1
+
+void foo(int n, double *a, double *b) {
+
+#pragma omp target teams distribute parallel for map(to: b[0:n]) map(from: a[0:n])
+  for (int i = 0; i < n; ++i)
+    a[i] = b[i] * 2.0;
+
+#pragma omp target teams distribute parallel for num_threads(64) map(tofrom: a[0:n])
+  for (int i = 0; i < n; ++i)
+    a[i] += 1.0;
+
+#pragma omp target teams distribute parallel for schedule(dynamic) map(tofrom: a[0:n])
+  for (int i = 0; i < n; ++i)
+    a[i] -= 1.0;
+}
+
+// All the threads start in the region, there is no control loop
+// CK4: define {{.*}}void @__omptgt__[[KERNUNQ]]_(
+// CK4: %[[TLIM:[a-zA-Z0-9_\.]+]] = load i32, i32* @__omptgt__[[KERNUNQ]]__thread_limit
+// CK4-NEXT: call void @__kmpc_spmd_kernel_init(i32 %[[TLIM]])
+// CK4-NOT: switch i32
+// CK4-NOT: call {{.*}}@__kmpc_kernel_prepare_parallel
+// CK4-NOT: call {{.*}}@__kmpc_kernel_parallel
+// CK4: call void @__kmpc_for_static_init_4(
+// CK4-NOT: call {{.*}}@__kmpc_kernel_end_parallel
+// CK4: call void @__kmpc_spmd_kernel_deinit()
+// CK4-NEXT: ret void
+
+// CK4: define {{.*}}void @__omptgt__[[KERNUNQ2]]_(
+// CK4: call void @__kmpc_kernel_init(
+// CK4: call i32 @__kmpc_kernel_prepare_parallel(
+
+// CK4: define {{.*}}void @__omptgt__[[KERNUNQ3]]_(
+// CK4: call void @__kmpc_kernel_init(
+// CK4: call i32 @__kmpc_kernel_prepare_parallel(
+
+#endif
+
+///##############################################
+///
+/// Only the data that escapes to the workers is shared
+///
+///##############################################
+
+#ifdef TT5
+// RUN:   %clang -fopenmp -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-linux \
+// RUN:   -DTT5 -O0 -S -emit-llvm %s 2>&1
+// RUN:   FileCheck -check-prefix=CK5 -input-file=target_control_loop_codegen_for_c.ll.tgt-nvptx64sm_35-nvidia-linux %s
+
+// The sharing stack only holds 's'
+// CK5: @__omptgt__shared_data_ = common addrspace(3) global [8 x i8] zeroinitializer
+
+int bar() {
+  int b[1024];
+
+#pragma omp target
+  {
+    int a = 1;
+    int s = 0;
+    s += 2;
+
+#pragma omp parallel for
+    for (int i = 0 ; i < 1024 ; i++)
+      b[i] += a + s;
+  }
+
+  return b[0];
+}
+
+// Every thread initializes its own copy of 'a' before the control loop starts
+// CK5: define {{.*}}void @__omptgt__{{.*}}(
+// CK5: store i32 1, i32* %{{.+}}, align 4
+// CK5: call i32 @llvm.nvvm.read.ptx.sreg.tid.x()
+// CK5: call void @__kmpc_kernel_init(
+// CK5-NEXT: store i32 1, i32* %{{.+}}, align 4
+// CK5-NEXT: store i32 0, i32* {{.*}} @__omptgt__shared_data_{{.*}} align 4
+
+#endif
+
+///##############################################
+///
+/// A sharing stack that does not fit in shared memory
+///
+///##############################################
+
+#ifdef TT6
+// RUN:   %clang -fopenmp -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-linux \
+// RUN:   -DTT6 -O0 -S -emit-llvm %s 2>&1 | FileCheck -check-prefix=CK6-WARN %s
+// RUN:   FileCheck -check-prefix=CK6 -input-file=target_control_loop_codegen_for_c.ll.tgt-nvptx64sm_35-nvidia-linux %s
+// RUN:   %clang -fopenmp -target powerpc64le-ibm-linux-gnu -omptargets=nvptx64sm_35-nvidia-linux \
+// RUN:   -DTT6 -O0 -S -emit-llvm -Wno-openmp-shared-memory %s 2>&1 | FileCheck -check-prefix=CK6-NOWARN %s
+
+// CK6-WARN: warning: sharing stack of 65536 bytes per team exceeds the 49152 bytes of shared memory; using global memory instead [-Wopenmp-shared-memory]
+// CK6-NOWARN-NOT: warning: sharing stack
+
+// 'c' does not fit in the shared memory of a team, so global memory is used,
+// resized to hold the 65536 bytes of each of the 2048 teams
+// CK6: @__omptgt__shared_data_ = common addrspace(1) global [134217728 x i8] zeroinitializer
+
+int baz(int n) {
+  int b[1024];
+
+#pragma omp target
+  {
+    int c[16384];
+    c[0] = n;
+
+#pragma omp parallel for
+    for (int i = 0 ; i < 1024 ; i++)
+      b[i] = c[i] + c[0];
+  }
+
+  return b[0];
+}
+
+#endif
@@ -0,0 +1,36 @@
+// RUN: %clang_cc1 -verify -fopenmp -ferror-limit 100 %s
+
+int main(int argc, char **argv) {
+  int i = 0;
+  int *k = &i;
+  double *l;
+
+  #pragma omp target is_device_ptr // expected-error {{expected '(' after 'is_device_ptr'}} expected-error {{expected expression}}
+  {}
+  #pragma omp target is_device_ptr( // expected-error {{expected expression}} expected-error {{expected ')'}} expected-note {{to match this '('}}
+  {}
+  #pragma omp target is_device_ptr(i) // expected-error {{expected variable of pointer type in 'is_device_ptr' clause}}
+  {}
+  #pragma omp target is_device_ptr(k, l)
+  {}
+  #pragma omp target map(k) is_device_ptr(k) // expected-error {{variable already marked as mapped in current construct}} expected-note {{used here}}
+  {}
+  #pragma omp target teams is_device_ptr(argv)
+  {}
+  #pragma omp target data map(l[0:4]) use_device_ptr(l) // expected-warning {{extra tokens at the end of '#pragma omp target data' are ignored}}
+  {}
+
+  #pragma omp target defaultmap // expected-error {{expected '(' after 'defaultmap'}} expected-error {{expected 'tofrom' in OpenMP clause 'defaultmap'}}
+  {}
+  #pragma omp target defaultmap(tofrom: scalar)
+  {}
+  #pragma omp target defaultmap(to: scalar) // expected-error {{expected 'tofrom' in OpenMP clause 'defaultmap'}}
+  {}
+  #pragma omp target defaultmap(tofrom: array) // expected-error {{expected 'scalar' in OpenMP clause 'defaultmap'}}
+  {}
+  #pragma omp target defaultmap(tofrom: scalar) defaultmap(tofrom: scalar) // expected-error {{directive '#pragma omp target' cannot contain more than one 'defaultmap' clause}}
+  {}
+  #pragma omp target data map(l[0:4]) defaultmap(tofrom: scalar) // expected-error {{unexpected OpenMP clause 'defaultmap' in directive '#pragma omp target data'}}
+  {}
+  return 0;
+}
@@ -0,0 +1,75 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+int bar(int);
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo0
+void foo0(int *a) {
+// CHECK-NOT: @__kmpc_omp_task_alloc(
+// CHECK-NOT: @__kmpc_omp_task_begin_if0(
+// CHECK: call void @__kmpc_omp_wait_deps(
+// CHECK: call {{.*}}bar
+// CHECK: ret void
+#pragma omp task if (0) mergeable firstprivate(a) depend(in : a[0])
+  a[1] = bar(a[0]);
+}
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo1
+void foo1(int *a, int n) {
+// CHECK: br i1 %{{.+}}, label %[[THEN:.+]], label %[[ELSE:.+]]
+// CHECK: [[ELSE]]:
+// CHECK-NOT: @__kmpc_omp_task_alloc(
+// CHECK: call {{.*}}bar
+// CHECK: [[THEN]]:
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call {{.*}}@__kmpc_omp_task_with_deps(
+// CHECK-NOT: @__kmpc_omp_task_begin_if0(
+// CHECK: ret void
+#pragma omp task if (n > 10) mergeable
+  a[0] = bar(n);
+}
+
+// Tasks without 'mergeable' keep their descriptor.
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo2
+void foo2(int *a) {
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call void @__kmpc_omp_task_begin_if0(
+#pragma omp task if (0)
+  a[0] = bar(0);
+}
+
+// Tasks that generate or wait for child tasks keep their descriptor, so that
+// the children are not attached to the generating task.
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo3
+void foo3(int *a) {
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call void @__kmpc_omp_task_begin_if0(
+#pragma omp task if (0) mergeable
+  {
+#pragma omp task
+    a[0] = bar(0);
+#pragma omp taskwait
+  }
+}
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo4
+void foo4(int *a) {
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call void @__kmpc_omp_task_begin_if0(
+#pragma omp task if (0) mergeable
+#pragma omp taskgroup
+  a[0] = bar(0);
+}
+
+// A cancelled task must leave its own body, not the generating task.
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo5
+void foo5(int *a) {
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call void @__kmpc_omp_task_begin_if0(
+#pragma omp taskgroup
+#pragma omp task if (0) mergeable
+  {
+    a[0] = bar(0);
+#pragma omp cancel taskgroup
+  }
+}
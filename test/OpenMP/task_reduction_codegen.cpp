@@ -0,0 +1,41 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+int bar(int);
+
+// CHECK-LABEL: define {{.*}}void @{{.*}}foo
+void foo(int n) {
+  int sum = 0;
+  double prod = 1.0;
+// CHECK: [[RED_DATA:%.+]] = alloca [2 x { i8*, i64, i8*, i8*, i8*, i32 }]
+// CHECK: call void @__kmpc_taskgroup(
+// CHECK: store i8* bitcast (void (i8*)* @.omp_task_red_init. to i8*),
+// CHECK: store i8* bitcast (void (i8*, i8*)* @.omp_task_red_comb. to i8*),
+// CHECK: call i8* @__kmpc_task_reduction_init(i32 %{{.+}}, i32 2, i8* %{{.+}})
+// CHECK-NOT: @__kmpc_task_reduction_init(
+// CHECK: call void @__kmpc_end_taskgroup(
+#pragma omp taskgroup task_reduction(+: sum) task_reduction(*: prod)
+  {
+#pragma omp task in_reduction(+: sum)
+    sum += bar(n);
+#pragma omp task in_reduction(*: prod)
+    prod *= bar(n);
+  }
+}
+
+// The runtime hands each task the copy of its thread.
+// CHECK: define internal {{.*}}@.omp_ptask.(
+// CHECK: [[PRIV:%.+]] = call i8* @__kmpc_task_reduction_get_th_data(i32 %{{.+}}, i8* null, i8* %{{.+}})
+// CHECK: bitcast i8* [[PRIV]] to i32*
+// CHECK: call {{.*}}bar
+
+// Taskgroups without task reductions do not initialize any.
+// CHECK-LABEL: define {{.*}}void @{{.*}}baz
+void baz(int *a) {
+// CHECK: call void @__kmpc_taskgroup(
+// CHECK-NOT: @__kmpc_task_reduction_init(
+// CHECK: call void @__kmpc_end_taskgroup(
+#pragma omp taskgroup
+#pragma omp task
+  a[0] = bar(0);
+}
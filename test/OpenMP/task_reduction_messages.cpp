@@ -0,0 +1,48 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -ferror-limit 100 %s
+
+#pragma omp declare reduction(merge : int : omp_out += omp_in)
+
+void foo(int n) {
+  int sum = 0, other = 0;
+  float fsum = 0.0f;
+  const int c = 0; // expected-note {{'c' defined here}}
+  int arr[10]; // expected-note {{'arr' defined here}}
+#pragma omp taskgroup task_reduction // expected-error {{expected '(' after 'task_reduction'}} expected-error {{expected unqualified-id}} expected-error {{expected ':' in 'task_reduction' clause}}
+  ;
+#pragma omp taskgroup task_reduction(+ sum) // expected-error {{expected ':' in 'task_reduction' clause}}
+  ;
+#pragma omp taskgroup task_reduction(+: sum) task_reduction(*: sum) // expected-error {{variable can appear only once in OpenMP 'task_reduction' clause}} expected-note {{previously referenced here}}
+  ;
+#pragma omp taskgroup task_reduction(+: c) // expected-error {{const-qualified variable cannot be task_reduction}}
+  ;
+#pragma omp taskgroup task_reduction(+: arr) // expected-error {{arguments of OpenMP clause 'task_reduction' cannot be of array type}}
+  ;
+#pragma omp taskgroup task_reduction(|: fsum) // expected-error {{arguments of OpenMP clause 'reduction' with bitwise operators cannot be of floating type}}
+  ;
+#pragma omp taskgroup task_reduction(merge: sum) // expected-error {{user-defined reduction identifiers are not supported in 'task_reduction' clause}}
+  ;
+#pragma omp taskgroup in_reduction(+: sum) // expected-error {{unexpected OpenMP clause 'in_reduction' in directive '#pragma omp taskgroup'}} expected-error {{in_reduction variable 'sum' must appear with the same reduction identifier in a 'task_reduction' clause of an enclosing 'taskgroup'}}
+  ;
+#pragma omp task task_reduction(+: sum) // expected-error {{unexpected OpenMP clause 'task_reduction' in directive '#pragma omp task'}}
+  ;
+#pragma omp task in_reduction(+: sum) // expected-error {{in_reduction variable 'sum' must appear with the same reduction identifier in a 'task_reduction' clause of an enclosing 'taskgroup'}}
+  ;
+#pragma omp taskgroup task_reduction(+: sum) task_reduction(max: fsum)
+  {
+#pragma omp task in_reduction(+: sum)
+    sum += n;
+#pragma omp task in_reduction(max: fsum)
+    fsum = fsum > n ? fsum : n;
+#pragma omp task in_reduction(*: sum) // expected-error {{in_reduction variable 'sum' must appear with the same reduction identifier in a 'task_reduction' clause of an enclosing 'taskgroup'}}
+    sum *= n;
+#pragma omp task in_reduction(+: other) // expected-error {{in_reduction variable 'other' must appear with the same reduction identifier in a 'task_reduction' clause of an enclosing 'taskgroup'}}
+    other += n;
+#pragma omp task in_reduction(+: sum) in_reduction(+: sum) // expected-error {{variable can appear only once in OpenMP 'in_reduction' clause}} expected-note {{previously referenced here}}
+    sum += n;
+#pragma omp taskgroup
+    {
+#pragma omp task in_reduction(+: sum)
+      sum += n;
+    }
+  }
+}
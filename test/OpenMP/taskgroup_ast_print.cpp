@@ -23,4 +23,22 @@ int main (int argc, char **argv) {
   return (0);
 }
 
+void bar(int n) {
+  int sum = 0;
+  float prod = 1.0f;
+// CHECK-LABEL: void bar(int n)
+#pragma omp taskgroup task_reduction(+: sum) task_reduction(*: prod)
+  {
+#pragma omp task in_reduction(+: sum)
+    sum += n;
+#pragma omp task in_reduction(*: prod)
+    prod *= n;
+  }
+// CHECK: #pragma omp taskgroup task_reduction(+: sum) task_reduction(*: prod)
+// CHECK: #pragma omp task in_reduction(+: sum)
+// CHECK-NEXT: sum += n;
+// CHECK-NEXT: #pragma omp task in_reduction(*: prod)
+// CHECK-NEXT: prod *= n;
+}
+
 #endif
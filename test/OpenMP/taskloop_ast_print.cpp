@@ -0,0 +1,58 @@
+// RUN: %clang_cc1 -verify -fopenmp -ast-print %s | FileCheck %s
+// RUN: %clang_cc1 -fopenmp -x c++ -std=c++11 -emit-pch -o %t %s
+// RUN: %clang_cc1 -fopenmp -std=c++11 -include-pch %t -fsyntax-only -verify %s -ast-print | FileCheck %s
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+void foo() {}
+
+template <class T, int N>
+T tmain (T argc) {
+  T b = argc, c, d;
+  static T a;
+// CHECK: static T a;
+#pragma omp taskloop grainsize(N) priority(N)
+  for (T i = 0; i < argc; ++i)
+    a = i;
+// CHECK-NEXT: #pragma omp taskloop grainsize(N) priority(N)
+// CHECK-NEXT: for (T i = 0; i < argc; ++i)
+// CHECK-NEXT: a = i;
+#pragma omp taskloop simd num_tasks(argc) private(b) firstprivate(c) shared(d) safelen(N)
+  for (T i = 0; i < argc; ++i)
+    foo();
+// CHECK-NEXT: #pragma omp taskloop simd num_tasks(argc) private(b) firstprivate(c) shared(d) safelen(N)
+// CHECK-NEXT: for (T i = 0; i < argc; ++i)
+// CHECK-NEXT: foo();
+  return T();
+}
+
+int main (int argc, char **argv) {
+  int b = argc, c, d, e, f;
+  static int a;
+// CHECK: static int a;
+#pragma omp taskloop
+  for (int i = 0; i < 10; ++i)
+    a = 2;
+// CHECK-NEXT: #pragma omp taskloop
+// CHECK-NEXT: for (int i = 0; i < 10; ++i)
+// CHECK-NEXT: a = 2;
+#pragma omp taskloop if(b), final(a), untied, default(shared) mergeable, private(e),firstprivate(c),shared(d,f) collapse(2) grainsize(argc) priority(1)
+  for (int i = 0; i < 10; ++i)
+  for (int j = 0; j < 10; ++j)
+    foo();
+// CHECK-NEXT: #pragma omp taskloop if(b) final(a) untied default(shared) mergeable private(e) firstprivate(c) shared(d,f) collapse(2) grainsize(argc) priority(1)
+// CHECK-NEXT: for (int i = 0; i < 10; ++i)
+// CHECK-NEXT: for (int j = 0; j < 10; ++j)
+// CHECK-NEXT: foo();
+#pragma omp taskloop simd num_tasks(4) safelen(8)
+  for (int i = 0; i < argc; ++i)
+    a += i;
+// CHECK-NEXT: #pragma omp taskloop simd num_tasks(4) safelen(8)
+// CHECK-NEXT: for (int i = 0; i < argc; ++i)
+// CHECK-NEXT: a += i;
+  return tmain<int, 5>(argc);
+}
+
+#endif
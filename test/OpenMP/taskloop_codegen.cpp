@@ -0,0 +1,73 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -emit-llvm -o - %s | FileCheck %s
+// expected-no-diagnostics
+
+void bar(float *, int);
+
+// The iteration space is split into chunks of 'grainsize' iterations, one
+// task per chunk, all allocated by the encountering thread in a taskgroup.
+// CHECK-LABEL: define {{.*}}void @{{.*}}grainsize
+// CHECK: call void @__kmpc_taskgroup(
+// CHECK: store [[TY:i32|i64]] 0, [[TY]]* [[PLB:%.taskloop.lb.[0-9]*]]
+// CHECK: omp.taskloop.chunk.cond:
+// CHECK: [[LB:%.lb.[0-9]*]] = load [[TY]], [[TY]]* [[PLB]]
+// CHECK: icmp ult [[TY]] [[LB]], [[ITERS:%.+]]
+// CHECK: omp.taskloop.chunk.body:
+// CHECK: [[NEXT:%.+]] = add [[TY]] [[LB]], 4
+// CHECK: [[LAST:%.+]] = icmp ult [[TY]] [[NEXT]], [[ITERS]]
+// CHECK: [[END:%.+]] = select i1 [[LAST]], [[TY]] [[NEXT]], [[TY]] [[ITERS]]
+// CHECK: %.ub.{{[0-9]*}} = sub [[TY]] [[END]], 1
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call {{.*}}@__kmpc_omp_task_with_deps(
+// CHECK: store [[TY]] [[NEXT]], [[TY]]* [[PLB]]
+// CHECK: omp.taskloop.chunk.end:
+// CHECK: call void @__kmpc_end_taskgroup(
+// CHECK: ret void
+void grainsize(float *a, int n) {
+#pragma omp taskloop grainsize(4)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
+
+// With 'num_tasks' the grainsize is the number of iterations divided by the
+// number of tasks, rounded up, and at least one iteration.
+// CHECK-LABEL: define {{.*}}void @{{.*}}num_tasks
+// CHECK: [[SUM:%.+]] = add [[TY:i32|i64]] %{{.+}}, 8
+// CHECK: [[SUB:%.+]] = sub [[TY]] [[SUM]], 1
+// CHECK: [[DIV:%.+]] = udiv [[TY]] [[SUB]], 8
+// CHECK: [[SMALL:%.+]] = icmp ult [[TY]] [[DIV]], 1
+// CHECK: [[GRAIN:%.+]] = select i1 [[SMALL]], [[TY]] 1, [[TY]] [[DIV]]
+// CHECK: call void @__kmpc_taskgroup(
+// CHECK: omp.taskloop.chunk.body:
+// CHECK: add [[TY]] %.lb.{{[0-9]*}}, [[GRAIN]]
+// CHECK: call {{.*}}@__kmpc_omp_task_alloc(
+// CHECK: call void @__kmpc_end_taskgroup(
+// CHECK: ret void
+void num_tasks(float *a, int n) {
+#pragma omp taskloop num_tasks(8)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
+
+// A grainsize that is not a constant is clamped to at least one iteration.
+// CHECK-LABEL: define {{.*}}void @{{.*}}variable_grainsize
+// CHECK: [[SMALL:%.+]] = icmp ult [[TY:i32|i64]] [[G:%.+]], 1
+// CHECK: [[GRAIN:%.+]] = select i1 [[SMALL]], [[TY]] 1, [[TY]] [[G]]
+// CHECK: omp.taskloop.chunk.body:
+// CHECK: add [[TY]] %.lb.{{[0-9]*}}, [[GRAIN]]
+// CHECK: ret void
+void variable_grainsize(float *a, int n, int g) {
+#pragma omp taskloop grainsize(g)
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
+
+// Without 'grainsize' or 'num_tasks' 64 tasks are generated.
+// CHECK-LABEL: define {{.*}}void @{{.*}}default_tasks
+// CHECK: udiv [[TY:i32|i64]] %{{.+}}, 64
+// CHECK: call void @__kmpc_taskgroup(
+// CHECK: ret void
+void default_tasks(float *a, int n) {
+#pragma omp taskloop
+  for (int i = 0; i < n; ++i)
+    bar(a, i);
+}
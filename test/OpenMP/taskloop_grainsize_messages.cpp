@@ -0,0 +1,39 @@
+// RUN: %clang_cc1 -verify -fopenmp -ferror-limit 100 %s
+
+void foo() {
+}
+
+bool foobool(int argc) {
+  return argc;
+}
+
+struct S1; // expected-note {{declared here}}
+
+int main(int argc, char **argv) {
+  #pragma omp taskloop grainsize // expected-error {{expected '(' after 'grainsize'}} expected-error {{expected expression}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize ( // expected-error {{expected expression}} expected-error {{expected ')'}} expected-note {{to match this '('}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize () // expected-error {{expected expression}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (argc // expected-error {{expected ')'}} expected-note {{to match this '('}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (argc)) // expected-warning {{extra tokens at the end of '#pragma omp taskloop' are ignored}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (argc > 0 ? argc : 2)
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (foobool(argc)), grainsize (2) // expected-error {{directive '#pragma omp taskloop' cannot contain more than one 'grainsize' clause}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (S1) // expected-error {{'S1' does not refer to a value}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (0) // expected-error {{expression is not a positive integer value}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (argv) // expected-error {{statement requires expression of integer type ('char **' invalid)}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop grainsize (4) num_tasks(2) // expected-error {{'grainsize' and 'num_tasks' clauses are mutually exclusive and may not appear on the same '#pragma omp taskloop' directive}} expected-note {{previously specified here}}
+  for (int i = 0; i < 10; ++i) foo();
+  #pragma omp taskloop simd num_tasks(2) grainsize (4) // expected-error {{'grainsize' and 'num_tasks' clauses are mutually exclusive and may not appear on the same '#pragma omp taskloop simd' directive}} expected-note {{previously specified here}}
+  for (int i = 0; i < 10; ++i) foo();
+
+  return 0;
+}
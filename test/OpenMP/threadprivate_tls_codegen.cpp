@@ -0,0 +1,97 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -verify -fopenmp -fopenmp-use-tls -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -fopenmp-use-tls -emit-llvm -o - %s | FileCheck %s --check-prefix=NOTLS
+// expected-no-diagnostics
+
+struct S {
+  int a;
+  S(int a) : a(a) {}
+  ~S() {}
+};
+
+double scratch[64];
+#pragma omp threadprivate(scratch)
+S gs(5);
+#pragma omp threadprivate(gs)
+int init();
+int dyn = init();
+#pragma omp threadprivate(dyn)
+extern int ext;
+#pragma omp threadprivate(ext)
+
+// CHECK-DAG: @scratch = thread_local global [64 x double] zeroinitializer
+// CHECK-DAG: @gs = thread_local global %struct.S zeroinitializer
+// CHECK-DAG: @gs.tls.guard. = linkonce_odr thread_local global i8 0
+// CHECK-DAG: @dyn = thread_local global i32 0
+// CHECK-DAG: @dyn.tls.guard. = linkonce_odr thread_local global i8 0
+// CHECK-DAG: @ext = external thread_local global i32
+// CHECK-NOT: .cache. =
+// NOTLS: @scratch = global [64 x double] zeroinitializer
+// NOTLS: @scratch.cache. = common global i8** null
+
+// The copies of the other threads are constructed on first touch.
+// CHECK: define void @gs.tls.init.()
+// CHECK: store i8 1, i8* @gs.tls.guard.
+// CHECK: call i8* @__kmpc_ctor_{{.*}}gs(i8* bitcast (%struct.S* @gs to i8*))
+// CHECK: call i32 @__cxa_thread_atexit(void (i8*)* bitcast (i8* (i8*)* @__kmpc_dtor_{{.*}}gs to void (i8*)*), i8* bitcast (%struct.S* @gs to i8*), i8* @__dso_handle)
+
+// The copy of the initial thread is constructed with the variable.
+// CHECK: define internal void @__omp_threadprivate_{{.*}}gs()
+// CHECK: store i8 1, i8* @gs.tls.guard.
+
+// The copies of a variable with a dynamic initializer run it on first touch.
+// CHECK: define void @dyn.tls.init.()
+// CHECK: store i8 1, i8* @dyn.tls.guard.
+// CHECK: [[INIT:%.+]] = call i32 @{{.*}}init
+// CHECK: store i32 [[INIT]], i32* @dyn
+// CHECK: define internal void @dyn.tls.guard.init.()
+// CHECK: store i8 1, i8* @dyn.tls.guard.
+
+// CHECK-LABEL: define {{.*}}double @{{.*}}foo
+// NOTLS-LABEL: define {{.*}}double @{{.*}}foo
+double foo(int n) {
+  double sum = 0;
+// CHECK-NOT: @__kmpc_threadprivate_cached(
+// CHECK: getelementptr inbounds [64 x double], [64 x double]* @scratch
+// NOTLS: call i8* @__kmpc_threadprivate_cached(
+  for (int i = 0; i < n; ++i)
+    sum += scratch[i];
+// CHECK: [[GUARD:%.+]] = load i8, i8* @gs.tls.guard.
+// CHECK: icmp eq i8 [[GUARD]], 0
+// CHECK: omp.tls.init:
+// CHECK: call void @gs.tls.init.()
+// CHECK: omp.tls.cont:
+// CHECK: getelementptr inbounds {{\(?}}%struct.S, %struct.S* @gs
+  return sum + gs.a;
+}
+
+// Copyin broadcasts the addresses of the copies of the master thread.
+// CHECK-LABEL: define {{.*}}void @{{.*}}bar
+void bar() {
+// CHECK: call void {{.*}}@__kmpc_fork_call(
+#pragma omp parallel copyin(scratch)
+  scratch[0] += 1;
+}
+
+// CHECK: define internal void @.omp_microtask.(
+// CHECK: call i32 @__kmpc_bound_thread_num(
+// CHECK: store [64 x double]* @scratch, [64 x double]** %{{.+}}
+// CHECK: call void @__kmpc_copyprivate({{.+}}, i8* %{{.+}}, void (i8*, i8*)* @.omp_copyin_func., i32 %{{.+}})
+
+// CHECK: define internal void @.omp_copyin_func.(i8*, i8*)
+
+// CHECK-LABEL: define {{.*}}i32 @{{.*}}baz
+int baz() {
+// CHECK: [[GUARD:%.+]] = load i8, i8* @dyn.tls.guard.
+// CHECK: icmp eq i8 [[GUARD]], 0
+// CHECK: call void @dyn.tls.init.()
+// CHECK: load i32, i32* @dyn
+// The initialization function of an external variable may not be defined.
+// CHECK: [[GUARD:%.+]] = load i8, i8* @ext.tls.guard.
+// CHECK: icmp eq i8 [[GUARD]], 0
+// CHECK: br i1 icmp ne (void ()* @ext.tls.init., void ()* null)
+// CHECK: call void @ext.tls.init.()
+// CHECK: load i32, i32* @ext
+  return dyn + ext;
+}
+
+// CHECK: declare extern_weak void @ext.tls.init.()
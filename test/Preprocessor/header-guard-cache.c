@@ -0,0 +1,37 @@
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: cp %S/Inputs/header-guard-cache.h %t/guarded.h
+//
+// A header modified within the last seconds is not recorded, since it could
+// still be rewritten with the same size and modification time.
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s | FileCheck --check-prefix=ENTERED %s
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=ENTERED %s
+// RUN: touch -m -a -t 201101010000 %t/guarded.h
+//
+// The first compilation records the guard, which lets the next ones skip the
+// header without entering it when the guard is already defined.
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s | FileCheck --check-prefix=ENTERED %s
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=SKIPPED %s
+// RUN: %clang_cc1 -E -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=ENTERED %s
+//
+// A skipped header is still listed in the dependency file.
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s -DHEADER_GUARD_CACHE_H -dependency-file %t/deps -MT out -o %t/out.i
+// RUN: FileCheck --check-prefix=SKIPPED --input-file=%t/out.i %s
+// RUN: FileCheck --check-prefix=DEPS --input-file=%t/deps %s
+//
+// A truncated cache is ignored.
+// RUN: head -c 64 %t/cache > %t/cache.bad
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache.bad -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=ENTERED %s
+//
+// A header that changed is entered again, until its guard is recorded again.
+// RUN: echo "// changed" >> %t/guarded.h
+// RUN: touch -m -a -t 201101010001 %t/guarded.h
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=ENTERED %s
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s | FileCheck --check-prefix=ENTERED %s
+// RUN: %clang_cc1 -E -header-guard-cache %t/cache -I %t %s -DHEADER_GUARD_CACHE_H | FileCheck --check-prefix=SKIPPED %s
+
+#include "guarded.h"
+
+// ENTERED: # 1 "{{.*}}guarded.h" 1
+// SKIPPED-NOT: guarded.h
+// DEPS: out:
+// DEPS: guarded.h
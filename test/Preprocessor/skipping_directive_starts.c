@@ -0,0 +1,48 @@
+// RUN: %clang_cc1 -E %s | FileCheck --strict-whitespace %s
+// RUN: %clang_cc1 -E -trigraphs %s | FileCheck --strict-whitespace %s
+// RUN: %clang_cc1 -E -x c++ -std=c++14 %s | FileCheck --strict-whitespace %s
+
+// Lines that only look like directives inside comments and literals of a
+// skipped block must not end it.
+
+#if 0
+/* #else
+#endif */
+char *s = "#endif";
+char c = '#';
+"unterminated #else
+#else
+one
+#endif
+// CHECK: {{^}}one{{$}}
+
+#if 0
+// a line comment \
+#endif
+/*/ #endif */
+x; /* spans
+lines */ #endif
+#  if 1
+#  else
+#  endif
+/* before */ #elif 1
+two
+#endif
+// CHECK: {{^}}two{{$}}
+
+#ifdef UNDEFINED
+#include <not/a/header.h> /* #endif
+*/
+#error don't #endif
+#else
+three
+#endif
+// CHECK: {{^}}three{{$}}
+
+#if 0
+int x = 0;\
+#else
+%: else
+four
+#endif
+// CHECK: {{^}}four{{$}}
@@ -578,6 +578,12 @@ CXCursor cxcursor::MakeCXCursor(const Stmt *S, const Decl *Parent,
   case Stmt::OMPTaskDirectiveClass:
     K = CXCursor_OMPTaskDirective;
     break;
+  case Stmt::OMPTaskLoopDirectiveClass:
+    K = CXCursor_OMPTaskLoopDirective;
+    break;
+  case Stmt::OMPTaskLoopSimdDirectiveClass:
+    K = CXCursor_OMPTaskLoopSimdDirective;
+    break;
   case Stmt::OMPTaskyieldDirectiveClass:
     K = CXCursor_OMPTaskyieldDirective;
     break;